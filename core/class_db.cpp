@@ -1172,6 +1172,28 @@ StringName ClassDB::get_property_getter(StringName p_class, const StringName &p_
 	return StringName();
 }
 
+// Resolves the property the way get_property() does; false if it is missing or shadowed by a constant.
+bool ClassDB::get_property_setget(const StringName &p_class, const StringName &p_property, PropertySetGet *r_setget) {
+
+	ClassInfo *type = classes.getptr(p_class);
+	ClassInfo *check = type;
+	while (check) {
+		const PropertySetGet *psg = check->property_setget.getptr(p_property);
+		if (psg) {
+
+			*r_setget = *psg;
+			return true;
+		}
+
+		if (check->constant_map.has(p_property))
+			return false;
+
+		check = check->inherits_ptr;
+	}
+
+	return false;
+}
+
 bool ClassDB::has_property(const StringName &p_class, const StringName &p_property, bool p_no_inheritance) {
 
 	ClassInfo *type = classes.getptr(p_class);
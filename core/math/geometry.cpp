@@ -30,6 +30,7 @@
 
 #include "geometry.h"
 
+#include "core/math/math_kernels.h"
 #include "core/print_string.h"
 #include "thirdparty/misc/clipper.hpp"
 #include "thirdparty/misc/triangulator.h"
@@ -539,18 +540,8 @@ PoolVector<Face3> Geometry::wrap_geometry(PoolVector<Face3> p_array, real_t *p_e
 	PoolVector<Face3>::Read facesr = p_array.read();
 	const Face3 *faces = facesr.ptr();
 
-	AABB global_aabb;
-
-	for (int i = 0; i < face_count; i++) {
-
-		if (i == 0) {
-
-			global_aabb = faces[i].get_aabb();
-		} else {
-
-			global_aabb.merge_with(faces[i].get_aabb());
-		}
-	}
+	// Face3 is three packed vertices, so the faces can be bounded as a point array.
+	AABB global_aabb = MathKernels::compute_aabb(&faces[0].vertex[0], face_count * 3);
 
 	global_aabb.grow_by(0.01); // Avoid numerical error.
 
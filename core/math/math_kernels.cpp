@@ -0,0 +1,550 @@
+/*************************************************************************/
+/*  math_kernels.cpp                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "math_kernels.h"
+
+#include "core/os/copymem.h"
+
+#if defined(__AVX2__) && defined(__FMA__)
+#define MATH_KERNELS_SSE
+#define MATH_KERNELS_FMA
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MATH_KERNELS_SSE
+#include <emmintrin.h>
+#elif (defined(__ARM_NEON) || defined(__ARM_NEON__)) && defined(__aarch64__)
+// ARMv7 NEON lacks vector division and square root, so only AArch64 is used.
+#define MATH_KERNELS_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(MATH_KERNELS_SSE) || defined(MATH_KERNELS_NEON)
+#define MATH_KERNELS_SIMD
+#endif
+
+// Vector3 and Transform arrays can only be loaded directly when real_t is float.
+#if defined(MATH_KERNELS_SIMD) && !defined(REAL_T_IS_DOUBLE)
+#define MATH_KERNELS_SIMD_REAL
+#endif
+
+#ifdef MATH_KERNELS_SIMD
+
+#ifdef MATH_KERNELS_SSE
+
+typedef __m128 f4;
+
+static _FORCE_INLINE_ f4 f4_load(const float *p_ptr) { return _mm_loadu_ps(p_ptr); }
+static _FORCE_INLINE_ void f4_store(float *p_ptr, f4 p_v) { _mm_storeu_ps(p_ptr, p_v); }
+static _FORCE_INLINE_ f4 f4_splat(float p_v) { return _mm_set1_ps(p_v); }
+static _FORCE_INLINE_ f4 f4_set(float p_x, float p_y, float p_z, float p_w) { return _mm_setr_ps(p_x, p_y, p_z, p_w); }
+static _FORCE_INLINE_ f4 f4_add(f4 p_a, f4 p_b) { return _mm_add_ps(p_a, p_b); }
+static _FORCE_INLINE_ f4 f4_sub(f4 p_a, f4 p_b) { return _mm_sub_ps(p_a, p_b); }
+static _FORCE_INLINE_ f4 f4_mul(f4 p_a, f4 p_b) { return _mm_mul_ps(p_a, p_b); }
+static _FORCE_INLINE_ f4 f4_div(f4 p_a, f4 p_b) { return _mm_div_ps(p_a, p_b); }
+static _FORCE_INLINE_ f4 f4_sqrt(f4 p_v) { return _mm_sqrt_ps(p_v); }
+static _FORCE_INLINE_ f4 f4_min(f4 p_a, f4 p_b) { return _mm_min_ps(p_a, p_b); }
+static _FORCE_INLINE_ f4 f4_max(f4 p_a, f4 p_b) { return _mm_max_ps(p_a, p_b); }
+static _FORCE_INLINE_ f4 f4_abs(f4 p_v) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), p_v); }
+
+// p_a * p_b + p_c
+static _FORCE_INLINE_ f4 f4_madd(f4 p_a, f4 p_b, f4 p_c) {
+#ifdef MATH_KERNELS_FMA
+	return _mm_fmadd_ps(p_a, p_b, p_c);
+#else
+	return _mm_add_ps(_mm_mul_ps(p_a, p_b), p_c);
+#endif
+}
+
+// Lanes of p_v where p_mask is greater than zero, zero elsewhere.
+static _FORCE_INLINE_ f4 f4_select_positive(f4 p_mask, f4 p_v) {
+	return _mm_and_ps(_mm_cmpgt_ps(p_mask, _mm_setzero_ps()), p_v);
+}
+
+// Four packed Vector3 (x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3) to one register per axis.
+static _FORCE_INLINE_ void f4_load3(const float *p_ptr, f4 &r_x, f4 &r_y, f4 &r_z) {
+	f4 a = _mm_loadu_ps(p_ptr);
+	f4 b = _mm_loadu_ps(p_ptr + 4);
+	f4 c = _mm_loadu_ps(p_ptr + 8);
+
+	f4 x_hi = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2));
+	r_x = _mm_shuffle_ps(a, x_hi, _MM_SHUFFLE(2, 0, 3, 0));
+	f4 y_lo = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1));
+	f4 y_hi = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));
+	r_y = _mm_shuffle_ps(y_lo, y_hi, _MM_SHUFFLE(2, 0, 2, 0));
+	f4 z_lo = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));
+	f4 z_hi = _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0));
+	r_z = _mm_shuffle_ps(z_lo, z_hi, _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+static _FORCE_INLINE_ void f4_store3(float *p_ptr, f4 p_x, f4 p_y, f4 p_z) {
+	f4 xy = _mm_shuffle_ps(p_x, p_y, _MM_SHUFFLE(0, 0, 0, 0));
+	f4 zx = _mm_shuffle_ps(p_z, p_x, _MM_SHUFFLE(1, 1, 0, 0));
+	_mm_storeu_ps(p_ptr, _mm_shuffle_ps(xy, zx, _MM_SHUFFLE(2, 0, 2, 0)));
+	f4 yz = _mm_shuffle_ps(p_y, p_z, _MM_SHUFFLE(1, 1, 1, 1));
+	f4 xy2 = _mm_shuffle_ps(p_x, p_y, _MM_SHUFFLE(2, 2, 2, 2));
+	_mm_storeu_ps(p_ptr + 4, _mm_shuffle_ps(yz, xy2, _MM_SHUFFLE(2, 0, 2, 0)));
+	f4 zx3 = _mm_shuffle_ps(p_z, p_x, _MM_SHUFFLE(3, 3, 2, 2));
+	f4 yz3 = _mm_shuffle_ps(p_y, p_z, _MM_SHUFFLE(3, 3, 3, 3));
+	_mm_storeu_ps(p_ptr + 8, _mm_shuffle_ps(zx3, yz3, _MM_SHUFFLE(2, 0, 2, 0)));
+}
+
+static _FORCE_INLINE_ void f4_transpose(f4 &r_a, f4 &r_b, f4 &r_c, f4 &r_d) {
+	_MM_TRANSPOSE4_PS(r_a, r_b, r_c, r_d);
+}
+
+#else // MATH_KERNELS_NEON
+
+typedef float32x4_t f4;
+
+static _FORCE_INLINE_ f4 f4_load(const float *p_ptr) { return vld1q_f32(p_ptr); }
+static _FORCE_INLINE_ void f4_store(float *p_ptr, f4 p_v) { vst1q_f32(p_ptr, p_v); }
+static _FORCE_INLINE_ f4 f4_splat(float p_v) { return vdupq_n_f32(p_v); }
+static _FORCE_INLINE_ f4 f4_set(float p_x, float p_y, float p_z, float p_w) {
+	const float v[4] = { p_x, p_y, p_z, p_w };
+	return vld1q_f32(v);
+}
+static _FORCE_INLINE_ f4 f4_add(f4 p_a, f4 p_b) { return vaddq_f32(p_a, p_b); }
+static _FORCE_INLINE_ f4 f4_sub(f4 p_a, f4 p_b) { return vsubq_f32(p_a, p_b); }
+static _FORCE_INLINE_ f4 f4_mul(f4 p_a, f4 p_b) { return vmulq_f32(p_a, p_b); }
+static _FORCE_INLINE_ f4 f4_div(f4 p_a, f4 p_b) { return vdivq_f32(p_a, p_b); }
+static _FORCE_INLINE_ f4 f4_sqrt(f4 p_v) { return vsqrtq_f32(p_v); }
+static _FORCE_INLINE_ f4 f4_min(f4 p_a, f4 p_b) { return vminq_f32(p_a, p_b); }
+static _FORCE_INLINE_ f4 f4_max(f4 p_a, f4 p_b) { return vmaxq_f32(p_a, p_b); }
+static _FORCE_INLINE_ f4 f4_abs(f4 p_v) { return vabsq_f32(p_v); }
+static _FORCE_INLINE_ f4 f4_madd(f4 p_a, f4 p_b, f4 p_c) { return vfmaq_f32(p_c, p_a, p_b); }
+
+static _FORCE_INLINE_ f4 f4_select_positive(f4 p_mask, f4 p_v) {
+	return vreinterpretq_f32_u32(vandq_u32(vcgtq_f32(p_mask, vdupq_n_f32(0.0f)), vreinterpretq_u32_f32(p_v)));
+}
+
+static _FORCE_INLINE_ void f4_load3(const float *p_ptr, f4 &r_x, f4 &r_y, f4 &r_z) {
+	float32x4x3_t v = vld3q_f32(p_ptr);
+	r_x = v.val[0];
+	r_y = v.val[1];
+	r_z = v.val[2];
+}
+
+static _FORCE_INLINE_ void f4_store3(float *p_ptr, f4 p_x, f4 p_y, f4 p_z) {
+	float32x4x3_t v;
+	v.val[0] = p_x;
+	v.val[1] = p_y;
+	v.val[2] = p_z;
+	vst3q_f32(p_ptr, v);
+}
+
+static _FORCE_INLINE_ void f4_transpose(f4 &r_a, f4 &r_b, f4 &r_c, f4 &r_d) {
+	float32x4x2_t ab = vtrnq_f32(r_a, r_b);
+	float32x4x2_t cd = vtrnq_f32(r_c, r_d);
+	r_a = vcombine_f32(vget_low_f32(ab.val[0]), vget_low_f32(cd.val[0]));
+	r_b = vcombine_f32(vget_low_f32(ab.val[1]), vget_low_f32(cd.val[1]));
+	r_c = vcombine_f32(vget_high_f32(ab.val[0]), vget_high_f32(cd.val[0]));
+	r_d = vcombine_f32(vget_high_f32(ab.val[1]), vget_high_f32(cd.val[1]));
+}
+
+#endif
+
+static _FORCE_INLINE_ float f4_hmin(f4 p_v) {
+	float v[4];
+	f4_store(v, p_v);
+	return MIN(MIN(v[0], v[1]), MIN(v[2], v[3]));
+}
+
+static _FORCE_INLINE_ float f4_hmax(f4 p_v) {
+	float v[4];
+	f4_store(v, p_v);
+	return MAX(MAX(v[0], v[1]), MAX(v[2], v[3]));
+}
+
+#endif // MATH_KERNELS_SIMD
+
+#ifdef MATH_KERNELS_SIMD_REAL
+
+// Broadcast basis elements, used to transform four vectors stored one axis per register.
+// Written out element by element so that everything stays in registers.
+struct BasisSplat {
+	f4 m00, m01, m02;
+	f4 m10, m11, m12;
+	f4 m20, m21, m22;
+
+	_FORCE_INLINE_ BasisSplat(const Basis &p_basis) {
+		m00 = f4_splat(p_basis.elements[0][0]);
+		m01 = f4_splat(p_basis.elements[0][1]);
+		m02 = f4_splat(p_basis.elements[0][2]);
+		m10 = f4_splat(p_basis.elements[1][0]);
+		m11 = f4_splat(p_basis.elements[1][1]);
+		m12 = f4_splat(p_basis.elements[1][2]);
+		m20 = f4_splat(p_basis.elements[2][0]);
+		m21 = f4_splat(p_basis.elements[2][1]);
+		m22 = f4_splat(p_basis.elements[2][2]);
+	}
+
+	// r = basis * p + p_add
+	_FORCE_INLINE_ void xform(f4 p_x, f4 p_y, f4 p_z, f4 p_add_x, f4 p_add_y, f4 p_add_z, f4 &r_x, f4 &r_y, f4 &r_z) const {
+		r_x = f4_madd(m00, p_x, f4_madd(m01, p_y, f4_madd(m02, p_z, p_add_x)));
+		r_y = f4_madd(m10, p_x, f4_madd(m11, p_y, f4_madd(m12, p_z, p_add_y)));
+		r_z = f4_madd(m20, p_x, f4_madd(m21, p_y, f4_madd(m22, p_z, p_add_z)));
+	}
+};
+
+// A transform prepared to multiply other transforms stored as float arrays.
+struct TransformSplat {
+	BasisSplat basis;
+	f4 column0, column1, column2;
+	f4 origin;
+
+	_FORCE_INLINE_ TransformSplat(const Transform &p_xform) :
+			basis(p_xform.basis) {
+		const Basis &b = p_xform.basis;
+		column0 = f4_set(b.elements[0][0], b.elements[1][0], b.elements[2][0], 0.0f);
+		column1 = f4_set(b.elements[0][1], b.elements[1][1], b.elements[2][1], 0.0f);
+		column2 = f4_set(b.elements[0][2], b.elements[1][2], b.elements[2][2], 0.0f);
+		origin = f4_set(p_xform.origin.x, p_xform.origin.y, p_xform.origin.z, 0.0f);
+	}
+
+	// p_b is a Transform laid out as basis rows then origin; only lanes 0-2 of the results are used.
+	_FORCE_INLINE_ void multiply(const float *p_b, f4 &r_row0, f4 &r_row1, f4 &r_row2, f4 &r_origin) const {
+		f4 b0 = f4_load(p_b);
+		f4 b1 = f4_load(p_b + 3);
+		f4 b2 = f4_load(p_b + 6);
+		r_row0 = f4_madd(basis.m00, b0, f4_madd(basis.m01, b1, f4_mul(basis.m02, b2)));
+		r_row1 = f4_madd(basis.m10, b0, f4_madd(basis.m11, b1, f4_mul(basis.m12, b2)));
+		r_row2 = f4_madd(basis.m20, b0, f4_madd(basis.m21, b1, f4_mul(basis.m22, b2)));
+		r_origin = f4_madd(column0, f4_splat(p_b[9]), f4_madd(column1, f4_splat(p_b[10]), f4_madd(column2, f4_splat(p_b[11]), origin)));
+	}
+};
+
+static _FORCE_INLINE_ void _store_transform(float *p_ptr, f4 p_row0, f4 p_row1, f4 p_row2, f4 p_origin) {
+	// Each store spills one lane into the next row, so go through a scratch
+	// buffer to avoid writing past the transform.
+	float v[13];
+	f4_store(v, p_row0);
+	f4_store(v + 3, p_row1);
+	f4_store(v + 6, p_row2);
+	f4_store(v + 9, p_origin);
+	copymem(p_ptr, v, sizeof(float) * 12);
+}
+
+#endif // MATH_KERNELS_SIMD_REAL
+
+MathKernels::InstructionSet MathKernels::get_instruction_set() {
+
+#if defined(MATH_KERNELS_FMA)
+	return INSTRUCTION_SET_AVX2;
+#elif defined(MATH_KERNELS_SSE)
+	return INSTRUCTION_SET_SSE2;
+#elif defined(MATH_KERNELS_NEON)
+	return INSTRUCTION_SET_NEON;
+#else
+	return INSTRUCTION_SET_SCALAR;
+#endif
+}
+
+const char *MathKernels::get_instruction_set_name() {
+
+	static const char *names[] = { "Scalar", "SSE2", "AVX2", "NEON" };
+	return names[get_instruction_set()];
+}
+
+void MathKernels::xform_points(const Transform &p_xform, const Vector3 *p_src, Vector3 *r_dst, int p_count) {
+
+	int i = 0;
+
+#ifdef MATH_KERNELS_SIMD_REAL
+	BasisSplat basis(p_xform.basis);
+	f4 ox = f4_splat(p_xform.origin.x);
+	f4 oy = f4_splat(p_xform.origin.y);
+	f4 oz = f4_splat(p_xform.origin.z);
+
+	for (; i + 4 <= p_count; i += 4) {
+		f4 x, y, z;
+		f4_load3(p_src[i].coord, x, y, z);
+		basis.xform(x, y, z, ox, oy, oz, x, y, z);
+		f4_store3(r_dst[i].coord, x, y, z);
+	}
+#endif
+
+	for (; i < p_count; i++) {
+		r_dst[i] = p_xform.xform(p_src[i]);
+	}
+}
+
+void MathKernels::xform_vectors(const Basis &p_basis, const Vector3 *p_src, Vector3 *r_dst, int p_count) {
+
+	int i = 0;
+
+#ifdef MATH_KERNELS_SIMD_REAL
+	BasisSplat basis(p_basis);
+	f4 zero = f4_splat(0.0f);
+
+	for (; i + 4 <= p_count; i += 4) {
+		f4 x, y, z;
+		f4_load3(p_src[i].coord, x, y, z);
+		basis.xform(x, y, z, zero, zero, zero, x, y, z);
+		f4_store3(r_dst[i].coord, x, y, z);
+	}
+#endif
+
+	for (; i < p_count; i++) {
+		r_dst[i] = p_basis.xform(p_src[i]);
+	}
+}
+
+// Transforms normals by the inverse transpose of p_basis and renormalizes them.
+void MathKernels::xform_normals(const Basis &p_basis, const Vector3 *p_src, Vector3 *r_dst, int p_count) {
+
+	Basis normal_basis = p_basis.inverse().transposed();
+	int i = 0;
+
+#ifdef MATH_KERNELS_SIMD_REAL
+	BasisSplat basis(normal_basis);
+	f4 zero = f4_splat(0.0f);
+
+	for (; i + 4 <= p_count; i += 4) {
+		f4 x, y, z;
+		f4_load3(p_src[i].coord, x, y, z);
+		basis.xform(x, y, z, zero, zero, zero, x, y, z);
+
+		// Zero length normals stay zero, like Vector3::normalized().
+		f4 len = f4_sqrt(f4_madd(x, x, f4_madd(y, y, f4_mul(z, z))));
+		x = f4_select_positive(len, f4_div(x, len));
+		y = f4_select_positive(len, f4_div(y, len));
+		z = f4_select_positive(len, f4_div(z, len));
+		f4_store3(r_dst[i].coord, x, y, z);
+	}
+#endif
+
+	for (; i < p_count; i++) {
+		r_dst[i] = normal_basis.xform(p_src[i]).normalized();
+	}
+}
+
+AABB MathKernels::compute_aabb(const Vector3 *p_points, int p_count) {
+
+	if (p_count <= 0) {
+		return AABB();
+	}
+
+	Vector3 min = p_points[0];
+	Vector3 max = min;
+	int i = 1;
+
+#ifdef MATH_KERNELS_SIMD_REAL
+	if (p_count >= 8) {
+		f4 min_x, min_y, min_z;
+		f4_load3(p_points[0].coord, min_x, min_y, min_z);
+		f4 max_x = min_x;
+		f4 max_y = min_y;
+		f4 max_z = min_z;
+
+		for (i = 4; i + 4 <= p_count; i += 4) {
+			f4 x, y, z;
+			f4_load3(p_points[i].coord, x, y, z);
+			min_x = f4_min(min_x, x);
+			min_y = f4_min(min_y, y);
+			min_z = f4_min(min_z, z);
+			max_x = f4_max(max_x, x);
+			max_y = f4_max(max_y, y);
+			max_z = f4_max(max_z, z);
+		}
+
+		min = Vector3(f4_hmin(min_x), f4_hmin(min_y), f4_hmin(min_z));
+		max = Vector3(f4_hmax(max_x), f4_hmax(max_y), f4_hmax(max_z));
+	}
+#endif
+
+	for (; i < p_count; i++) {
+		const Vector3 &p = p_points[i];
+		for (int j = 0; j < 3; j++) {
+			min[j] = MIN(min[j], p[j]);
+			max[j] = MAX(max[j], p[j]);
+		}
+	}
+
+	return AABB(min, max - min);
+}
+
+void MathKernels::multiply_transforms(const Transform &p_xform, const Transform *p_src, Transform *r_dst, int p_count) {
+
+#ifdef MATH_KERNELS_SIMD_REAL
+	TransformSplat a(p_xform);
+
+	for (int i = 0; i < p_count; i++) {
+		f4 row0, row1, row2, origin;
+		a.multiply(&p_src[i].basis.elements[0].x, row0, row1, row2, origin);
+		_store_transform(&r_dst[i].basis.elements[0].x, row0, row1, row2, origin);
+	}
+#else
+	for (int i = 0; i < p_count; i++) {
+		r_dst[i] = p_xform * p_src[i];
+	}
+#endif
+}
+
+void MathKernels::multiply_transforms(const Transform *p_a, const Transform *p_b, Transform *r_dst, int p_count) {
+
+	for (int i = 0; i < p_count; i++) {
+#ifdef MATH_KERNELS_SIMD_REAL
+		f4 row0, row1, row2, origin;
+		TransformSplat(p_a[i]).multiply(&p_b[i].basis.elements[0].x, row0, row1, row2, origin);
+		_store_transform(&r_dst[i].basis.elements[0].x, row0, row1, row2, origin);
+#else
+		r_dst[i] = p_a[i] * p_b[i];
+#endif
+	}
+}
+
+// Writes p_a * p_b as three rows of four floats.
+void MathKernels::multiply_to_rows(const Transform &p_a, const Transform &p_b, float *r_rows) {
+
+#ifdef MATH_KERNELS_SIMD_REAL
+	f4 row0, row1, row2, origin;
+	TransformSplat(p_a).multiply(&p_b.basis.elements[0].x, row0, row1, row2, origin);
+
+	// The origin goes in the fourth lane of each row.
+	float o[4];
+	f4_store(o, origin);
+	f4_store(r_rows, row0);
+	f4_store(r_rows + 4, row1);
+	f4_store(r_rows + 8, row2);
+	r_rows[3] = o[0];
+	r_rows[7] = o[1];
+	r_rows[11] = o[2];
+#else
+	Transform t = p_a * p_b;
+	for (int i = 0; i < 3; i++) {
+		r_rows[i * 4 + 0] = t.basis.elements[i][0];
+		r_rows[i * 4 + 1] = t.basis.elements[i][1];
+		r_rows[i * 4 + 2] = t.basis.elements[i][2];
+		r_rows[i * 4 + 3] = t.origin[i];
+	}
+#endif
+}
+
+// Merged bounds of p_aabb placed by each of p_count transforms, stored as rows p_stride floats apart.
+AABB MathKernels::xform_aabb_rows(const AABB &p_aabb, const float *p_rows, int p_stride, int p_count) {
+
+	if (p_count <= 0) {
+		return AABB();
+	}
+
+#ifdef MATH_KERNELS_SIMD
+	Vector3 half = p_aabb.size * 0.5;
+	Vector3 center = p_aabb.position + half;
+	f4 cx = f4_splat(center.x);
+	f4 cy = f4_splat(center.y);
+	f4 cz = f4_splat(center.z);
+	f4 ex = f4_splat(half.x);
+	f4 ey = f4_splat(half.y);
+	f4 ez = f4_splat(half.z);
+
+	f4 min_v, max_v;
+
+	for (int i = 0; i < p_count; i++) {
+		const float *rows = &p_rows[i * p_stride];
+		f4 col0 = f4_load(rows);
+		f4 col1 = f4_load(rows + 4);
+		f4 col2 = f4_load(rows + 8);
+		f4 origin = f4_splat(0.0f);
+		f4_transpose(col0, col1, col2, origin);
+
+		f4 new_center = f4_madd(col0, cx, f4_madd(col1, cy, f4_madd(col2, cz, origin)));
+		f4 new_half = f4_madd(f4_abs(col0), ex, f4_madd(f4_abs(col1), ey, f4_mul(f4_abs(col2), ez)));
+		f4 lo = f4_sub(new_center, new_half);
+		f4 hi = f4_add(new_center, new_half);
+
+		if (i == 0) {
+			min_v = lo;
+			max_v = hi;
+		} else {
+			min_v = f4_min(min_v, lo);
+			max_v = f4_max(max_v, hi);
+		}
+	}
+
+	float min[4], max[4];
+	f4_store(min, min_v);
+	f4_store(max, max_v);
+	return AABB(Vector3(min[0], min[1], min[2]), Vector3(max[0] - min[0], max[1] - min[1], max[2] - min[2]));
+#else
+	AABB aabb;
+	for (int i = 0; i < p_count; i++) {
+		const float *rows = &p_rows[i * p_stride];
+		Transform xform;
+		for (int j = 0; j < 3; j++) {
+			xform.basis.elements[j][0] = rows[j * 4 + 0];
+			xform.basis.elements[j][1] = rows[j * 4 + 1];
+			xform.basis.elements[j][2] = rows[j * 4 + 2];
+			xform.origin[j] = rows[j * 4 + 3];
+		}
+
+		AABB laabb = xform.xform(p_aabb);
+		if (i == 0) {
+			aabb = laabb;
+		} else {
+			aabb.merge_with(laabb);
+		}
+	}
+	return aabb;
+#endif
+}
+
+// Matrix palette skinning: blends p_influences bone transforms (rows, 12 floats each) by weight.
+void MathKernels::blend_palette_rows(const float *p_palette, const int *p_bones, const float *p_weights, int p_influences, float *r_rows) {
+
+#ifdef MATH_KERNELS_SIMD
+	f4 row0 = f4_splat(0.0f);
+	f4 row1 = row0;
+	f4 row2 = row0;
+
+	for (int i = 0; i < p_influences; i++) {
+		const float *bone = &p_palette[p_bones[i] * 12];
+		f4 weight = f4_splat(p_weights[i]);
+		row0 = f4_madd(weight, f4_load(bone), row0);
+		row1 = f4_madd(weight, f4_load(bone + 4), row1);
+		row2 = f4_madd(weight, f4_load(bone + 8), row2);
+	}
+
+	f4_store(r_rows, row0);
+	f4_store(r_rows + 4, row1);
+	f4_store(r_rows + 8, row2);
+#else
+	for (int j = 0; j < 12; j++) {
+		r_rows[j] = 0.0f;
+	}
+
+	for (int i = 0; i < p_influences; i++) {
+		const float *bone = &p_palette[p_bones[i] * 12];
+		float weight = p_weights[i];
+		for (int j = 0; j < 12; j++) {
+			r_rows[j] += weight * bone[j];
+		}
+	}
+#endif
+}
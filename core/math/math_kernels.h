@@ -0,0 +1,72 @@
+/*************************************************************************/
+/*  math_kernels.h                                                       */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef MATH_KERNELS_H
+#define MATH_KERNELS_H
+
+#include "core/math/aabb.h"
+#include "core/math/transform.h"
+
+/**
+ * Bulk operations on arrays of vectors and transforms.
+ *
+ * Kernels use SSE2, AVX2 (with FMA) or NEON when the compiler targets them,
+ * and fall back to the scalar math types otherwise. "Rows" refers to the 3x4
+ * row-major float layout used by skeletons and multimeshes: each row holds a
+ * basis row followed by the matching origin component.
+ */
+
+class MathKernels {
+public:
+	enum InstructionSet {
+		INSTRUCTION_SET_SCALAR,
+		INSTRUCTION_SET_SSE2,
+		INSTRUCTION_SET_AVX2,
+		INSTRUCTION_SET_NEON,
+	};
+
+	static InstructionSet get_instruction_set();
+	static const char *get_instruction_set_name();
+
+	// r_dst may alias p_src in all of the array kernels.
+	static void xform_points(const Transform &p_xform, const Vector3 *p_src, Vector3 *r_dst, int p_count);
+	static void xform_vectors(const Basis &p_basis, const Vector3 *p_src, Vector3 *r_dst, int p_count);
+	static void xform_normals(const Basis &p_basis, const Vector3 *p_src, Vector3 *r_dst, int p_count);
+	static AABB compute_aabb(const Vector3 *p_points, int p_count);
+
+	static void multiply_transforms(const Transform &p_xform, const Transform *p_src, Transform *r_dst, int p_count);
+	static void multiply_transforms(const Transform *p_a, const Transform *p_b, Transform *r_dst, int p_count);
+	static void multiply_to_rows(const Transform &p_a, const Transform &p_b, float *r_rows);
+
+	static AABB xform_aabb_rows(const AABB &p_aabb, const float *p_rows, int p_stride, int p_count);
+	static void blend_palette_rows(const float *p_palette, const int *p_bones, const float *p_weights, int p_influences, float *r_rows);
+};
+
+#endif // MATH_KERNELS_H
@@ -0,0 +1,429 @@
+/*************************************************************************/
+/*  mesh_simplifier.cpp                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "mesh_simplifier.h"
+
+#include "core/math/aabb.h"
+#include "core/sort_array.h"
+#include "core/vector.h"
+
+namespace {
+
+struct Quadric {
+
+	// Symmetric 4x4 matrix of summed plane equations, plus the total weight.
+	double a2, ab, ac, ad, b2, bc, bd, c2, cd, d2, w;
+
+	void add_plane(const Vector3 &p_normal, double p_d, double p_weight) {
+
+		double a = p_normal.x, b = p_normal.y, c = p_normal.z;
+		a2 += a * a * p_weight;
+		ab += a * b * p_weight;
+		ac += a * c * p_weight;
+		ad += a * p_d * p_weight;
+		b2 += b * b * p_weight;
+		bc += b * c * p_weight;
+		bd += b * p_d * p_weight;
+		c2 += c * c * p_weight;
+		cd += c * p_d * p_weight;
+		d2 += p_d * p_d * p_weight;
+		w += p_weight;
+	}
+
+	void operator+=(const Quadric &p_q) {
+
+		a2 += p_q.a2;
+		ab += p_q.ab;
+		ac += p_q.ac;
+		ad += p_q.ad;
+		b2 += p_q.b2;
+		bc += p_q.bc;
+		bd += p_q.bd;
+		c2 += p_q.c2;
+		cd += p_q.cd;
+		d2 += p_q.d2;
+		w += p_q.w;
+	}
+
+	// Weighted mean of the squared distances from p_pos to the planes.
+	double error(const Vector3 &p_pos) const {
+
+		double x = p_pos.x, y = p_pos.y, z = p_pos.z;
+		double e = a2 * x * x + b2 * y * y + c2 * z * z + d2 +
+				   2.0 * (ab * x * y + ac * x * z + bc * y * z + ad * x + bd * y + cd * z);
+		return w > 0 ? MAX(e, 0.0) / w : 0;
+	}
+
+	Quadric() {
+		a2 = ab = ac = ad = b2 = bc = bd = c2 = cd = d2 = w = 0;
+	}
+};
+
+struct Collapse {
+
+	int from;
+	int to;
+	double error;
+
+	bool operator<(const Collapse &p_c) const {
+		return error < p_c.error;
+	}
+};
+
+struct PositionSort {
+
+	const Vector3 *positions;
+
+	bool operator()(int p_a, int p_b) const {
+		if (positions[p_a] == positions[p_b])
+			return p_a < p_b;
+		return positions[p_a] < positions[p_b];
+	}
+};
+
+_FORCE_INLINE_ uint64_t _edge_key(int p_a, int p_b) {
+
+	if (p_a > p_b)
+		SWAP(p_a, p_b);
+	return (uint64_t(uint32_t(p_a)) << 32) | uint64_t(uint32_t(p_b));
+}
+
+} // namespace
+
+PoolVector<int> MeshSimplifier::simplify(const PoolVector<Vector3> &p_vertices, const PoolVector<int> &p_indices, int p_target_index_count, float p_max_error, float *r_error) {
+
+	if (r_error) {
+		*r_error = 0;
+	}
+
+	int vertex_count = p_vertices.size();
+	ERR_FAIL_COND_V(p_indices.size() % 3 != 0, p_indices);
+
+	Vector<int> indices;
+	indices.resize(p_indices.size());
+	{
+		PoolVector<int>::Read r = p_indices.read();
+		for (int i = 0; i < p_indices.size(); i++) {
+			ERR_FAIL_INDEX_V(r[i], vertex_count, p_indices);
+			indices.write[i] = r[i];
+		}
+	}
+
+	if (indices.size() <= p_target_index_count || vertex_count == 0) {
+		return p_indices;
+	}
+
+	PoolVector<Vector3>::Read positions = p_vertices.read();
+
+	AABB bounds;
+	bounds.position = positions[0];
+	for (int i = 1; i < vertex_count; i++) {
+		bounds.expand_to(positions[i]);
+	}
+	double mesh_size = bounds.size.length();
+	if (mesh_size <= CMP_EPSILON) {
+		return p_indices;
+	}
+
+	// Vertices that share a position with another vertex sit on an attribute seam,
+	// moving them would tear the surface apart, so they stay where they are.
+	Vector<int> canonical;
+	canonical.resize(vertex_count);
+	Vector<bool> locked;
+	locked.resize(vertex_count);
+	{
+		Vector<int> order;
+		order.resize(vertex_count);
+		for (int i = 0; i < vertex_count; i++) {
+			order.write[i] = i;
+			locked.write[i] = false;
+		}
+
+		SortArray<int, PositionSort> sorter;
+		sorter.compare.positions = positions.ptr();
+		sorter.sort(order.ptrw(), vertex_count);
+
+		for (int i = 0; i < vertex_count;) {
+			int j = i + 1;
+			while (j < vertex_count && positions[order[j]] == positions[order[i]]) {
+				j++;
+			}
+			for (int k = i; k < j; k++) {
+				canonical.write[order[k]] = order[i];
+				locked.write[order[k]] = j - i > 1;
+			}
+			i = j;
+		}
+	}
+
+	// Edges used by a single triangle are open borders, edges used by more than two are
+	// not manifold; the vertices of both are kept as well.
+	{
+		Vector<uint64_t> edges;
+		edges.resize(indices.size());
+		for (int i = 0; i < indices.size(); i += 3) {
+			for (int e = 0; e < 3; e++) {
+				edges.write[i + e] = _edge_key(canonical[indices[i + e]], canonical[indices[i + (e + 1) % 3]]);
+			}
+		}
+		edges.sort();
+
+		for (int i = 0; i < edges.size();) {
+			int j = i + 1;
+			while (j < edges.size() && edges[j] == edges[i]) {
+				j++;
+			}
+			if (j - i != 2) {
+				int a = int(edges[i] >> 32);
+				int b = int(edges[i] & 0xFFFFFFFF);
+				locked.write[a] = true;
+				locked.write[b] = true;
+			}
+			i = j;
+		}
+
+		for (int i = 0; i < vertex_count; i++) {
+			if (locked[canonical[i]]) {
+				locked.write[i] = true;
+			}
+		}
+	}
+
+	Vector<Quadric> quadrics;
+	quadrics.resize(vertex_count);
+	for (int i = 0; i < indices.size(); i += 3) {
+
+		const Vector3 &a = positions[indices[i + 0]];
+		const Vector3 &b = positions[indices[i + 1]];
+		const Vector3 &c = positions[indices[i + 2]];
+		Vector3 normal = (b - a).cross(c - a);
+		real_t area = normal.length();
+		if (area <= CMP_EPSILON * CMP_EPSILON)
+			continue;
+		normal /= area;
+		double d = -normal.dot(a);
+
+		for (int k = 0; k < 3; k++) {
+			quadrics.write[indices[i + k]].add_plane(normal, d, area);
+		}
+	}
+
+	double max_error_sq = double(p_max_error) * mesh_size;
+	max_error_sq *= max_error_sq;
+	double reached_error_sq = 0;
+
+	Vector<int> remap;
+	remap.resize(vertex_count);
+	Vector<bool> touched;
+	touched.resize(vertex_count);
+	Vector<int> link_marks;
+	link_marks.resize(vertex_count);
+	for (int i = 0; i < vertex_count; i++) {
+		link_marks.write[i] = 0;
+	}
+	int link_stamp = 0;
+	Vector<int> adjacency_offsets;
+	adjacency_offsets.resize(vertex_count + 1);
+	Vector<int> adjacency;
+	Vector<Collapse> collapses;
+
+	int index_count = indices.size();
+
+	// Each pass collapses the cheapest edges with at most one collapse touching any
+	// vertex, then rebuilds the triangle list, until the target or the error is reached.
+	while (index_count > p_target_index_count) {
+
+		int *tri = indices.ptrw();
+
+		for (int i = 0; i <= vertex_count; i++) {
+			adjacency_offsets.write[i] = 0;
+		}
+		for (int i = 0; i < index_count; i++) {
+			adjacency_offsets.write[tri[i] + 1]++;
+		}
+		for (int i = 0; i < vertex_count; i++) {
+			adjacency_offsets.write[i + 1] += adjacency_offsets[i];
+		}
+		adjacency.resize(index_count);
+		{
+			Vector<int> fill = adjacency_offsets;
+			for (int i = 0; i < index_count; i++) {
+				adjacency.write[fill.write[tri[i]]++] = i / 3;
+			}
+		}
+
+		collapses.clear();
+		for (int i = 0; i < index_count; i += 3) {
+			for (int e = 0; e < 3; e++) {
+
+				int a = tri[i + e];
+				int b = tri[i + (e + 1) % 3];
+				if (a > b)
+					continue; // each edge is seen from both of its triangles
+
+				Quadric q = quadrics[a];
+				q += quadrics[b];
+
+				Collapse c;
+				c.error = 1e300;
+				if (!locked[a]) {
+					c.from = a;
+					c.to = b;
+					c.error = q.error(positions[b]);
+				}
+				if (!locked[b]) {
+					double error = q.error(positions[a]);
+					if (error < c.error) {
+						c.from = b;
+						c.to = a;
+						c.error = error;
+					}
+				}
+				if (c.error <= max_error_sq) {
+					collapses.push_back(c);
+				}
+			}
+		}
+
+		if (collapses.empty())
+			break;
+
+		collapses.sort();
+
+		for (int i = 0; i < vertex_count; i++) {
+			remap.write[i] = i;
+			touched.write[i] = false;
+		}
+
+		int collapsed = 0;
+		int pass_index_count = index_count;
+
+		for (int i = 0; i < collapses.size() && pass_index_count > p_target_index_count; i++) {
+
+			const Collapse &c = collapses[i];
+			if (touched[c.from] || touched[c.to])
+				continue;
+
+			// Reject collapses that would pinch the surface, the two endpoints may only share
+			// the vertices opposite to the edge in its two triangles.
+			link_stamp++;
+			for (int j = adjacency_offsets[c.from]; j < adjacency_offsets[c.from + 1]; j++) {
+				int t = adjacency[j] * 3;
+				for (int k = 0; k < 3; k++) {
+					link_marks.write[remap[tri[t + k]]] = link_stamp;
+				}
+			}
+
+			int shared = 0;
+			for (int j = adjacency_offsets[c.to]; j < adjacency_offsets[c.to + 1]; j++) {
+				int t = adjacency[j] * 3;
+				for (int k = 0; k < 3; k++) {
+					int v = remap[tri[t + k]];
+					if (v != c.from && v != c.to && link_marks[v] == link_stamp) {
+						link_marks.write[v] = 0; // count each vertex once
+						shared++;
+					}
+				}
+			}
+
+			if (shared > 2)
+				continue;
+
+			// Reject collapses that would flip a triangle around the removed vertex.
+			const Vector3 &from_pos = positions[c.from];
+			const Vector3 &to_pos = positions[c.to];
+			bool flips = false;
+			int removed = 0;
+
+			for (int j = adjacency_offsets[c.from]; j < adjacency_offsets[c.from + 1]; j++) {
+
+				int t = adjacency[j] * 3;
+				int v[3] = { remap[tri[t + 0]], remap[tri[t + 1]], remap[tri[t + 2]] };
+				if (v[0] == v[1] || v[1] == v[2] || v[2] == v[0])
+					continue;
+				if (v[0] == c.to || v[1] == c.to || v[2] == c.to) {
+					removed++;
+					continue;
+				}
+
+				int k = v[0] == c.from ? 0 : (v[1] == c.from ? 1 : 2);
+				const Vector3 &p1 = positions[v[(k + 1) % 3]];
+				const Vector3 &p2 = positions[v[(k + 2) % 3]];
+				Vector3 before = (p1 - from_pos).cross(p2 - from_pos);
+				Vector3 after = (p1 - to_pos).cross(p2 - to_pos);
+				if (before.dot(after) <= 0) {
+					flips = true;
+					break;
+				}
+			}
+
+			if (flips)
+				continue;
+
+			remap.write[c.from] = c.to;
+			quadrics.write[c.to] += quadrics[c.from];
+			touched.write[c.from] = true;
+			touched.write[c.to] = true;
+			pass_index_count -= removed * 3;
+			reached_error_sq = MAX(reached_error_sq, c.error);
+			collapsed++;
+		}
+
+		if (collapsed == 0)
+			break;
+
+		int write = 0;
+		for (int i = 0; i < index_count; i += 3) {
+			int a = remap[tri[i + 0]];
+			int b = remap[tri[i + 1]];
+			int c = remap[tri[i + 2]];
+			if (a == b || b == c || c == a)
+				continue;
+			tri[write++] = a;
+			tri[write++] = b;
+			tri[write++] = c;
+		}
+		index_count = write;
+	}
+
+	if (r_error) {
+		*r_error = Math::sqrt(reached_error_sq) / mesh_size;
+	}
+
+	PoolVector<int> result;
+	result.resize(index_count);
+	{
+		PoolVector<int>::Write w = result.write();
+		for (int i = 0; i < index_count; i++) {
+			w[i] = indices[i];
+		}
+	}
+	return result;
+}
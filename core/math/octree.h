@@ -348,6 +348,9 @@ private:
 	};
 
 	void _cull_convex(Octant *p_octant, _CullConvexData *p_cull);
+	void _cull_convex_threadsafe(const Octant *p_octant, _CullConvexData *p_cull) const;
+	_FORCE_INLINE_ bool _is_octant_culled(const Octant *p_octant, const _CullConvexData *p_cull) const;
+	_FORCE_INLINE_ bool _is_first_culled_owner(const Element *p_element, const Octant *p_octant, const _CullConvexData *p_cull) const;
 	void _cull_aabb(Octant *p_octant, const AABB &p_aabb, T **p_result_array, int *p_result_idx, int p_result_max, int *p_subindex_array, uint32_t p_mask);
 	void _cull_segment(Octant *p_octant, const Vector3 &p_from, const Vector3 &p_to, T **p_result_array, int *p_result_idx, int p_result_max, int *p_subindex_array, uint32_t p_mask);
 	void _cull_point(Octant *p_octant, const Vector3 &p_point, T **p_result_array, int *p_result_idx, int p_result_max, int *p_subindex_array, uint32_t p_mask);
@@ -377,6 +380,9 @@ public:
 	int get_subindex(OctreeElementID p_id) const;
 
 	int cull_convex(const Vector<Plane> &p_convex, T **p_result_array, int p_result_max, uint32_t p_mask = 0xFFFFFFFF);
+	// Same as cull_convex(), but does not write to the octree, so several can run at once
+	// on different threads as long as the octree is not modified meanwhile.
+	int cull_convex_threadsafe(const Plane *p_planes, int p_plane_count, T **p_result_array, int p_result_max, uint32_t p_mask = 0xFFFFFFFF) const;
 	int cull_aabb(const AABB &p_aabb, T **p_result_array, int p_result_max, int *p_subindex_array = NULL, uint32_t p_mask = 0xFFFFFFFF);
 	int cull_segment(const Vector3 &p_from, const Vector3 &p_to, T **p_result_array, int p_result_max, int *p_subindex_array = NULL, uint32_t p_mask = 0xFFFFFFFF);
 
@@ -1065,6 +1071,78 @@ void Octree<T, use_pairs, AL>::_cull_convex(Octant *p_octant, _CullConvexData *p
 	}
 }
 
+template <class T, bool use_pairs, class AL>
+bool Octree<T, use_pairs, AL>::_is_octant_culled(const Octant *p_octant, const _CullConvexData *p_cull) const {
+
+	// Mirrors the traversal: children are only entered if they intersect, the root always is.
+	while (p_octant != root) {
+		if (!p_octant->aabb.intersects_convex_shape(p_cull->planes, p_cull->plane_count))
+			return false;
+		p_octant = p_octant->parent;
+	}
+	return true;
+}
+
+template <class T, bool use_pairs, class AL>
+bool Octree<T, use_pairs, AL>::_is_first_culled_owner(const Element *p_element, const Octant *p_octant, const _CullConvexData *p_cull) const {
+
+	// Without pass stamps, an element in several octants is only reported from the
+	// first of them that the traversal reaches.
+	if (p_element->octant_owners.size() == 1)
+		return true;
+
+	for (const typename List<typename Element::OctantOwner, AL>::Element *F = p_element->octant_owners.front(); F; F = F->next()) {
+
+		const Octant *o = F->get().octant;
+		if (o == p_octant)
+			return true;
+		if (_is_octant_culled(o, p_cull))
+			return false;
+	}
+
+	return true;
+}
+
+template <class T, bool use_pairs, class AL>
+void Octree<T, use_pairs, AL>::_cull_convex_threadsafe(const Octant *p_octant, _CullConvexData *p_cull) const {
+
+	if (*p_cull->result_idx == p_cull->result_max)
+		return; //pointless
+
+	for (int l = 0; l < 2; l++) {
+
+		const List<Element *, AL> &list = l == 0 ? p_octant->elements : p_octant->pairable_elements;
+		if (!use_pairs && l == 1)
+			break;
+
+		for (const typename List<Element *, AL>::Element *I = list.front(); I; I = I->next()) {
+
+			const Element *e = I->get();
+
+			if (use_pairs && !(e->pairable_type & p_cull->mask))
+				continue;
+
+			if (e->aabb.intersects_convex_shape(p_cull->planes, p_cull->plane_count) && _is_first_culled_owner(e, p_octant, p_cull)) {
+
+				if (*p_cull->result_idx < p_cull->result_max) {
+					p_cull->result_array[*p_cull->result_idx] = e->userdata;
+					(*p_cull->result_idx)++;
+				} else {
+
+					return; // pointless to continue
+				}
+			}
+		}
+	}
+
+	for (int i = 0; i < 8; i++) {
+
+		if (p_octant->children[i] && p_octant->children[i]->aabb.intersects_convex_shape(p_cull->planes, p_cull->plane_count)) {
+			_cull_convex_threadsafe(p_octant->children[i], p_cull);
+		}
+	}
+}
+
 template <class T, bool use_pairs, class AL>
 void Octree<T, use_pairs, AL>::_cull_aabb(Octant *p_octant, const AABB &p_aabb, T **p_result_array, int *p_result_idx, int p_result_max, int *p_subindex_array, uint32_t p_mask) {
 
@@ -1306,6 +1384,26 @@ int Octree<T, use_pairs, AL>::cull_convex(const Vector<Plane> &p_convex, T **p_r
 	return result_count;
 }
 
+template <class T, bool use_pairs, class AL>
+int Octree<T, use_pairs, AL>::cull_convex_threadsafe(const Plane *p_planes, int p_plane_count, T **p_result_array, int p_result_max, uint32_t p_mask) const {
+
+	if (!root)
+		return 0;
+
+	int result_count = 0;
+	_CullConvexData cdata;
+	cdata.planes = p_planes;
+	cdata.plane_count = p_plane_count;
+	cdata.result_array = p_result_array;
+	cdata.result_max = p_result_max;
+	cdata.result_idx = &result_count;
+	cdata.mask = p_mask;
+
+	_cull_convex_threadsafe(root, &cdata);
+
+	return result_count;
+}
+
 template <class T, bool use_pairs, class AL>
 int Octree<T, use_pairs, AL>::cull_aabb(const AABB &p_aabb, T **p_result_array, int p_result_max, int *p_subindex_array, uint32_t p_mask) {
 
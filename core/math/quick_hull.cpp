@@ -31,6 +31,7 @@
 #include "quick_hull.h"
 
 #include "core/map.h"
+#include "core/math/math_kernels.h"
 
 uint32_t QuickHull::debug_stop_after = 0xFFFFFFFF;
 
@@ -38,15 +39,7 @@ Error QuickHull::build(const Vector<Vector3> &p_points, Geometry::MeshData &r_me
 
 	/* CREATE AABB VOLUME */
 
-	AABB aabb;
-	for (int i = 0; i < p_points.size(); i++) {
-
-		if (i == 0) {
-			aabb.position = p_points[i];
-		} else {
-			aabb.expand_to(p_points[i]);
-		}
-	}
+	AABB aabb = MathKernels::compute_aabb(p_points.ptr(), p_points.size());
 
 	if (aabb.size == Vector3()) {
 		return ERR_CANT_CREATE;
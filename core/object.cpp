@@ -41,19 +41,6 @@
 
 #ifdef DEBUG_ENABLED
 
-struct _ObjectDebugLock {
-
-	Object *obj;
-
-	_ObjectDebugLock(Object *p_obj) {
-		obj = p_obj;
-		obj->_lock_index.ref();
-	}
-	~_ObjectDebugLock() {
-		obj->_lock_index.unref();
-	}
-};
-
 #define OBJ_DEBUG_LOCK _ObjectDebugLock _debug_lock(this);
 
 #else
@@ -1994,54 +1981,129 @@ void postinitialize_handler(Object *p_object) {
 	p_object->_postinitialize();
 }
 
-HashMap<ObjectID, Object *> ObjectDB::instances;
-ObjectID ObjectDB::instance_counter = 1;
-HashMap<Object *, ObjectID, ObjectDB::ObjectPtrHash> ObjectDB::instance_checks;
+std::atomic<ObjectDB::ObjectSlot *> ObjectDB::slot_chunks[OBJECTDB_CHUNK_MAX];
+uint32_t ObjectDB::slot_count = 0;
+uint32_t ObjectDB::slot_free_head = OBJECTDB_SLOT_NONE;
+uint64_t ObjectDB::validator_counter = 0;
+std::atomic<uint32_t> ObjectDB::object_count(0);
+OAHashMap<Object *, uint32_t, ObjectDB::ObjectPtrHash> *ObjectDB::instance_checks = NULL;
+SpinLock ObjectDB::spin_lock;
+
 ObjectID ObjectDB::add_instance(Object *p_object) {
 
 	ERR_FAIL_COND_V(p_object->get_instance_id() != 0, 0);
 
-	rw_lock->write_lock();
-	ObjectID instance_id = ++instance_counter;
-	instances[instance_id] = p_object;
-	instance_checks[p_object] = instance_id;
+	spin_lock.lock();
+
+	uint32_t slot;
+	if (slot_free_head != OBJECTDB_SLOT_NONE) {
+		slot = slot_free_head;
+		slot_free_head = _get_slot(slot).next_free;
+	} else {
+		if (unlikely(slot_count == OBJECTDB_SLOT_MAX)) {
+			spin_lock.unlock();
+			ERR_FAIL_V_MSG(0, "Maximum amount of objects reached.");
+		}
+		slot = slot_count++;
+		if ((slot & OBJECTDB_CHUNK_MASK) == 0) {
+			slot_chunks[slot >> OBJECTDB_CHUNK_BITS].store(memnew_arr(ObjectSlot, OBJECTDB_CHUNK_SIZE), std::memory_order_release);
+		}
+	}
+
+	validator_counter = (validator_counter + 1) & OBJECTDB_VALIDATOR_MASK;
+	if (unlikely(validator_counter == 0)) {
+		validator_counter = 1; // Zero is reserved for free slots.
+	}
+
+	ObjectSlot &object_slot = _get_slot(slot);
+	object_slot.next_free = OBJECTDB_SLOT_NONE;
+	object_slot.object.store(p_object, std::memory_order_relaxed);
+	object_slot.validator.store(validator_counter, std::memory_order_release);
 
-	rw_lock->write_unlock();
+	ObjectID instance_id = (validator_counter << OBJECTDB_SLOT_BITS) | slot;
+	instance_checks->insert(p_object, slot);
+	object_count.fetch_add(1, std::memory_order_relaxed);
+
+	spin_lock.unlock();
 
 	return instance_id;
 }
 
 void ObjectDB::remove_instance(Object *p_object) {
 
-	rw_lock->write_lock();
+	ObjectID instance_id = p_object->get_instance_id();
+	uint32_t slot = instance_id & OBJECTDB_SLOT_MASK;
+
+	spin_lock.lock();
+
+	ObjectSlot &object_slot = _get_slot(slot);
+	object_slot.validator.store(0, std::memory_order_release);
+	object_slot.object.store(NULL, std::memory_order_relaxed);
+	object_slot.next_free = slot_free_head;
+	slot_free_head = slot;
 
-	instances.erase(p_object->get_instance_id());
-	instance_checks.erase(p_object);
+	instance_checks->remove(p_object);
+	object_count.fetch_sub(1, std::memory_order_relaxed);
 
-	rw_lock->write_unlock();
+	spin_lock.unlock();
 }
+
 Object *ObjectDB::get_instance(ObjectID p_instance_id) {
 
-	rw_lock->read_lock();
-	Object **obj = instances.getptr(p_instance_id);
-	rw_lock->read_unlock();
+	uint32_t slot = p_instance_id & OBJECTDB_SLOT_MASK;
+	uint64_t validator = (p_instance_id >> OBJECTDB_SLOT_BITS) & OBJECTDB_VALIDATOR_MASK;
+
+	if (validator == 0) {
+		return NULL;
+	}
+
+	ObjectSlot *chunk = slot_chunks[slot >> OBJECTDB_CHUNK_BITS].load(std::memory_order_acquire);
+	if (!chunk) {
+		return NULL;
+	}
+
+	ObjectSlot &object_slot = chunk[slot & OBJECTDB_CHUNK_MASK];
+	if (object_slot.validator.load(std::memory_order_acquire) != validator) {
+		return NULL;
+	}
+
+	Object *object = object_slot.object.load(std::memory_order_relaxed);
 
-	if (!obj)
+	// The slot may have been freed and reused while reading, validators are
+	// unique so checking again is enough to know the pointer belongs to the ID.
+	std::atomic_thread_fence(std::memory_order_acquire);
+	if (object_slot.validator.load(std::memory_order_relaxed) != validator) {
 		return NULL;
-	return *obj;
+	}
+
+	return object;
+}
+
+bool ObjectDB::instance_validate(Object *p_ptr) {
+
+	// The pointer may already be freed, so it is looked up by address and never read.
+	spin_lock.lock();
+
+	bool exists = instance_checks->has(p_ptr);
+
+	spin_lock.unlock();
+
+	return exists;
 }
 
 void ObjectDB::debug_objects(DebugFunc p_func) {
 
-	rw_lock->read_lock();
+	spin_lock.lock();
 
-	const ObjectID *K = NULL;
-	while ((K = instances.next(K))) {
+	for (uint32_t i = 0; i < slot_count; i++) {
 
-		p_func(instances[*K]);
+		ObjectSlot &object_slot = _get_slot(i);
+		if (object_slot.validator.load(std::memory_order_relaxed) != 0) {
+			p_func(object_slot.object.load(std::memory_order_relaxed));
+		}
 	}
 
-	rw_lock->read_unlock();
+	spin_lock.unlock();
 }
 
 void Object::get_argument_options(const StringName &p_function, int p_idx, List<String> *r_options) const {
@@ -2049,41 +2111,52 @@ void Object::get_argument_options(const StringName &p_function, int p_idx, List<
 
 int ObjectDB::get_object_count() {
 
-	rw_lock->read_lock();
-	int count = instances.size();
-	rw_lock->read_unlock();
-
-	return count;
+	return object_count.load(std::memory_order_relaxed);
 }
 
-RWLock *ObjectDB::rw_lock = NULL;
-
 void ObjectDB::setup() {
 
-	rw_lock = RWLock::create();
+	instance_checks = memnew((OAHashMap<Object *, uint32_t, ObjectPtrHash>));
 }
 
 void ObjectDB::cleanup() {
 
-	rw_lock->write_lock();
-	if (instances.size()) {
+	spin_lock.lock();
+	if (object_count) {
 
 		WARN_PRINT("ObjectDB Instances still exist!");
 		if (OS::get_singleton()->is_stdout_verbose()) {
-			const ObjectID *K = NULL;
-			while ((K = instances.next(K))) {
+			for (uint32_t i = 0; i < slot_count; i++) {
+
+				ObjectSlot &object_slot = _get_slot(i);
+				uint64_t validator = object_slot.validator.load(std::memory_order_relaxed);
+				if (validator == 0) {
+					continue;
+				}
 
+				Object *obj = object_slot.object.load(std::memory_order_relaxed);
 				String node_name;
-				if (instances[*K]->is_class("Node"))
-					node_name = " - Node name: " + String(instances[*K]->call("get_name"));
-				if (instances[*K]->is_class("Resource"))
-					node_name = " - Resource name: " + String(instances[*K]->call("get_name")) + " Path: " + String(instances[*K]->call("get_path"));
-				print_line("Leaked instance: " + String(instances[*K]->get_class()) + ":" + itos(*K) + node_name);
+				if (obj->is_class("Node"))
+					node_name = " - Node name: " + String(obj->call("get_name"));
+				if (obj->is_class("Resource"))
+					node_name = " - Resource name: " + String(obj->call("get_name")) + " Path: " + String(obj->call("get_path"));
+				print_line("Leaked instance: " + String(obj->get_class()) + ":" + itos((validator << OBJECTDB_SLOT_BITS) | i) + node_name);
 			}
 		}
 	}
-	instances.clear();
-	instance_checks.clear();
-	rw_lock->write_unlock();
-	memdelete(rw_lock);
+
+	for (uint32_t i = 0; i < OBJECTDB_CHUNK_MAX; i++) {
+		ObjectSlot *chunk = slot_chunks[i].load(std::memory_order_relaxed);
+		if (chunk) {
+			memdelete_arr(chunk);
+			slot_chunks[i].store(NULL, std::memory_order_relaxed);
+		}
+	}
+	slot_count = 0;
+	slot_free_head = OBJECTDB_SLOT_NONE;
+	object_count.store(0, std::memory_order_relaxed);
+
+	memdelete(instance_checks);
+	instance_checks = NULL;
+	spin_lock.unlock();
 }
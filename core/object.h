@@ -34,7 +34,9 @@
 #include "core/hash_map.h"
 #include "core/list.h"
 #include "core/map.h"
+#include "core/oa_hash_map.h"
 #include "core/os/rw_lock.h"
+#include "core/os/spin_lock.h"
 #include "core/set.h"
 #include "core/variant.h"
 #include "core/vmap.h"
@@ -691,6 +693,7 @@ public:
 	void get_meta_list(List<String> *p_list) const;
 
 #ifdef TOOLS_ENABLED
+	_FORCE_INLINE_ void _set_edited_flag() { _edited = true; } // what set() does, without bumping the edited version
 	void set_edited(bool p_edited);
 	bool is_edited() const;
 	uint32_t get_edited_version() const; //this function is used to check when something changed beyond a point, it's used mainly for generating previews
@@ -757,8 +760,43 @@ public:
 bool predelete_handler(Object *p_object);
 void postinitialize_handler(Object *p_object);
 
+#ifdef DEBUG_ENABLED
+
+// Keeps an object from being freed while one of its methods runs.
+struct _ObjectDebugLock {
+
+	Object *obj;
+
+	_ObjectDebugLock(Object *p_obj) {
+		obj = p_obj;
+		obj->_lock_index.ref();
+	}
+	~_ObjectDebugLock() {
+		obj->_lock_index.unref();
+	}
+};
+
+#endif
+
 class ObjectDB {
 
+	// An ObjectID is made of a slot index in the lower bits and a validator
+	// in the upper bits. Slots are reused once freed, but validators are
+	// never repeated, so stale IDs are rejected without any hashing.
+	enum {
+		OBJECTDB_SLOT_BITS = 24,
+		OBJECTDB_SLOT_MAX = 1 << OBJECTDB_SLOT_BITS,
+		OBJECTDB_SLOT_MASK = OBJECTDB_SLOT_MAX - 1,
+		OBJECTDB_CHUNK_BITS = 12,
+		OBJECTDB_CHUNK_SIZE = 1 << OBJECTDB_CHUNK_BITS,
+		OBJECTDB_CHUNK_MASK = OBJECTDB_CHUNK_SIZE - 1,
+		OBJECTDB_CHUNK_MAX = OBJECTDB_SLOT_MAX / OBJECTDB_CHUNK_SIZE,
+		OBJECTDB_SLOT_NONE = 0xFFFFFFFF,
+	};
+
+	static const int OBJECTDB_VALIDATOR_BITS = 63 - OBJECTDB_SLOT_BITS;
+	static const uint64_t OBJECTDB_VALIDATOR_MASK = (uint64_t(1) << OBJECTDB_VALIDATOR_BITS) - 1;
+
 	struct ObjectPtrHash {
 
 		static _FORCE_INLINE_ uint32_t hash(const Object *p_obj) {
@@ -772,36 +810,49 @@ class ObjectDB {
 		}
 	};
 
-	static HashMap<ObjectID, Object *> instances;
-	static HashMap<Object *, ObjectID, ObjectPtrHash> instance_checks;
+	struct ObjectSlot {
+		std::atomic<uint64_t> validator; // Zero when the slot is free.
+		std::atomic<Object *> object;
+		uint32_t next_free;
+
+		ObjectSlot() :
+				validator(0),
+				object(NULL),
+				next_free(OBJECTDB_SLOT_NONE) {}
+	};
+
+	// Chunks are allocated on demand and never moved or freed until cleanup,
+	// so readers can index them without taking the lock.
+	static std::atomic<ObjectSlot *> slot_chunks[OBJECTDB_CHUNK_MAX];
+	static uint32_t slot_count;
+	static uint32_t slot_free_head;
+	static uint64_t validator_counter;
+	static std::atomic<uint32_t> object_count;
+
+	// Live objects by address, so a pointer can be validated without reading it.
+	static OAHashMap<Object *, uint32_t, ObjectPtrHash> *instance_checks;
 
-	static ObjectID instance_counter;
 	friend class Object;
 	friend void unregister_core_types();
 
-	static RWLock *rw_lock;
+	static SpinLock spin_lock;
 	static void cleanup();
 	static ObjectID add_instance(Object *p_object);
 	static void remove_instance(Object *p_object);
 	friend void register_core_types();
 	static void setup();
 
+	_FORCE_INLINE_ static ObjectSlot &_get_slot(uint32_t p_slot) {
+		return slot_chunks[p_slot >> OBJECTDB_CHUNK_BITS].load(std::memory_order_relaxed)[p_slot & OBJECTDB_CHUNK_MASK];
+	}
+
 public:
 	typedef void (*DebugFunc)(Object *p_obj);
 
 	static Object *get_instance(ObjectID p_instance_id);
 	static void debug_objects(DebugFunc p_func);
 	static int get_object_count();
-
-	_FORCE_INLINE_ static bool instance_validate(Object *p_ptr) {
-		rw_lock->read_lock();
-
-		bool exists = instance_checks.has(p_ptr);
-
-		rw_lock->read_unlock();
-
-		return exists;
-	}
+	static bool instance_validate(Object *p_ptr);
 };
 
 //needed by macros
@@ -239,6 +239,10 @@ MAKE_TEMPLATE_TYPE_INFO(Vector, StringName, Variant::POOL_STRING_ARRAY)
 
 MAKE_TEMPLATE_TYPE_INFO(PoolVector, Plane, Variant::ARRAY)
 MAKE_TEMPLATE_TYPE_INFO(PoolVector, Face3, Variant::POOL_VECTOR3_ARRAY)
+#ifdef REAL_T_IS_DOUBLE
+MAKE_TEMPLATE_TYPE_INFO(Vector, double, Variant::POOL_REAL_ARRAY)
+MAKE_TEMPLATE_TYPE_INFO(PoolVector, float, Variant::POOL_REAL_ARRAY)
+#endif
 
 template <typename T>
 struct GetTypeInfo<T *, typename EnableIf<TypeInherits<Object, T>::value>::type> {
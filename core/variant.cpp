@@ -2031,6 +2031,38 @@ Variant::operator Vector<real_t>() const {
 	return to;
 }
 
+#ifdef REAL_T_IS_DOUBLE
+Variant::operator PoolVector<float>() const {
+
+	PoolVector<real_t> from = operator PoolVector<real_t>();
+	PoolVector<float> to;
+	int len = from.size();
+	to.resize(len);
+	{
+		PoolVector<real_t>::Read r = from.read();
+		PoolVector<float>::Write w = to.write();
+		for (int i = 0; i < len; i++) {
+
+			w[i] = r[i];
+		}
+	}
+	return to;
+}
+
+Variant::operator Vector<float>() const {
+
+	PoolVector<real_t> from = operator PoolVector<real_t>();
+	Vector<float> to;
+	int len = from.size();
+	to.resize(len);
+	for (int i = 0; i < len; i++) {
+
+		to.write[i] = from[i];
+	}
+	return to;
+}
+#endif
+
 Variant::operator Vector<String>() const {
 
 	PoolVector<String> from = operator PoolVector<String>();
@@ -2474,6 +2506,34 @@ Variant::Variant(const Vector<real_t> &p_array) {
 	*this = v;
 }
 
+#ifdef REAL_T_IS_DOUBLE
+Variant::Variant(const PoolVector<float> &p_float_array) {
+
+	type = NIL;
+	PoolVector<real_t> v;
+	int len = p_float_array.size();
+	v.resize(len);
+	{
+		PoolVector<float>::Read r = p_float_array.read();
+		PoolVector<real_t>::Write w = v.write();
+		for (int i = 0; i < len; i++)
+			w[i] = r[i];
+	}
+	*this = v;
+}
+
+Variant::Variant(const Vector<float> &p_array) {
+
+	type = NIL;
+	PoolVector<real_t> v;
+	int len = p_array.size();
+	v.resize(len);
+	for (int i = 0; i < len; i++)
+		v.set(i, p_array[i]);
+	*this = v;
+}
+#endif
+
 Variant::Variant(const Vector<String> &p_array) {
 
 	type = NIL;
@@ -212,11 +212,38 @@ public:
 	operator PoolVector<Color>() const;
 	operator PoolVector<Plane>() const;
 	operator PoolVector<Face3>() const;
+#ifdef REAL_T_IS_DOUBLE
+	operator PoolVector<float>() const;
+#endif
+
+	// The stored value without conversion or copy, for fast paths in script VMs.
+	// Unchecked, get_type() must match.
+	_FORCE_INLINE_ bool get_bool_unchecked() const { return _data._bool; }
+	_FORCE_INLINE_ int64_t get_int_unchecked() const { return _data._int; }
+	_FORCE_INLINE_ double get_real_unchecked() const { return _data._real; }
+	_FORCE_INLINE_ const Vector2 &get_vector2_unchecked() const { return *reinterpret_cast<const Vector2 *>(_data._mem); }
+	_FORCE_INLINE_ const Vector3 &get_vector3_unchecked() const { return *reinterpret_cast<const Vector3 *>(_data._mem); }
+	_FORCE_INLINE_ const Array &get_array_unchecked() const { return *reinterpret_cast<const Array *>(_data._mem); }
+	_FORCE_INLINE_ Array &get_array_unchecked() { return *reinterpret_cast<Array *>(_data._mem); }
+	template <class T>
+	_FORCE_INLINE_ const PoolVector<T> &get_pool_vector_unchecked() const { return *reinterpret_cast<const PoolVector<T> *>(_data._mem); }
+	template <class T>
+	_FORCE_INLINE_ PoolVector<T> &get_pool_vector_unchecked() { return *reinterpret_cast<PoolVector<T> *>(_data._mem); }
+
+	// Stores in place, skipping the type switches of operator=. Unchecked, get_type() must already match.
+	_FORCE_INLINE_ void set_bool_unchecked(bool p_value) { _data._bool = p_value; }
+	_FORCE_INLINE_ void set_int_unchecked(int64_t p_value) { _data._int = p_value; }
+	_FORCE_INLINE_ void set_real_unchecked(double p_value) { _data._real = p_value; }
+	_FORCE_INLINE_ void set_vector2_unchecked(const Vector2 &p_value) { *reinterpret_cast<Vector2 *>(_data._mem) = p_value; }
+	_FORCE_INLINE_ void set_vector3_unchecked(const Vector3 &p_value) { *reinterpret_cast<Vector3 *>(_data._mem) = p_value; }
 
 	operator Vector<Variant>() const;
 	operator Vector<uint8_t>() const;
 	operator Vector<int>() const;
 	operator Vector<real_t>() const;
+#ifdef REAL_T_IS_DOUBLE
+	operator Vector<float>() const;
+#endif
 	operator Vector<String>() const;
 	operator Vector<StringName>() const;
 	operator Vector<Vector3>() const;
@@ -273,6 +300,9 @@ public:
 	Variant(const PoolVector<uint8_t> &p_raw_array);
 	Variant(const PoolVector<int> &p_int_array);
 	Variant(const PoolVector<real_t> &p_real_array);
+#ifdef REAL_T_IS_DOUBLE
+	Variant(const PoolVector<float> &p_float_array); // helper
+#endif
 	Variant(const PoolVector<String> &p_string_array);
 	Variant(const PoolVector<Vector3> &p_vector3_array);
 	Variant(const PoolVector<Color> &p_color_array);
@@ -282,6 +312,9 @@ public:
 	Variant(const Vector<uint8_t> &p_array);
 	Variant(const Vector<int> &p_array);
 	Variant(const Vector<real_t> &p_array);
+#ifdef REAL_T_IS_DOUBLE
+	Variant(const Vector<float> &p_array); // helper
+#endif
 	Variant(const Vector<String> &p_array);
 	Variant(const Vector<StringName> &p_array);
 	Variant(const Vector<Vector3> &p_array);
@@ -35,9 +35,17 @@
 #include "core/os/keyboard.h"
 #include "core/string_buffer.h"
 
-CharType VariantParser::StreamFile::get_char() {
+uint32_t VariantParser::StreamFile::_read_buffer(CharType *p_buffer, uint32_t p_num_chars) {
 
-	return f->get_8();
+	// Read raw bytes at the end of the buffer, then widen them in place.
+	uint8_t *bytes = reinterpret_cast<uint8_t *>(p_buffer + p_num_chars) - p_num_chars;
+	uint32_t read = f->get_buffer(bytes, p_num_chars);
+
+	for (uint32_t i = 0; i < read; i++) {
+		p_buffer[i] = bytes[i];
+	}
+
+	return read;
 }
 
 bool VariantParser::StreamFile::is_utf8() const {
@@ -46,15 +54,24 @@ bool VariantParser::StreamFile::is_utf8() const {
 }
 bool VariantParser::StreamFile::is_eof() const {
 
-	return f->eof_reached();
+	return eof;
 }
 
-CharType VariantParser::StreamString::get_char() {
+uint32_t VariantParser::StreamString::_read_buffer(CharType *p_buffer, uint32_t p_num_chars) {
 
-	if (pos >= s.length())
+	int len = s.length();
+	if (pos >= len) {
 		return 0;
-	else
-		return s[pos++];
+	}
+
+	uint32_t read = MIN((uint32_t)(len - pos), p_num_chars);
+	const CharType *src = s.ptr() + pos;
+	for (uint32_t i = 0; i < read; i++) {
+		p_buffer[i] = src[i];
+	}
+	pos += read;
+
+	return read;
 }
 
 bool VariantParser::StreamString::is_utf8() const {
@@ -85,6 +102,104 @@ const char *VariantParser::tk_name[TK_MAX] = {
 	"ERROR"
 };
 
+#define READING_SIGN 0
+#define READING_INT 1
+#define READING_DEC 2
+#define READING_EXP 3
+#define READING_DONE 4
+
+// Reads the characters of a number starting at p_char into r_num, leaving the
+// first character past it in p_stream->saved. Returns whether it is a float.
+static bool _read_number(VariantParser::Stream *p_stream, CharType p_char, StringBuffer<> &r_num) {
+
+	int reading = READING_INT;
+
+	if (p_char == '-') {
+		r_num += '-';
+		p_char = p_stream->get_char();
+	}
+
+	CharType c = p_char;
+	bool exp_sign = false;
+	bool exp_beg = false;
+	bool is_float = false;
+
+	while (true) {
+
+		switch (reading) {
+			case READING_INT: {
+
+				if (c >= '0' && c <= '9') {
+					//pass
+				} else if (c == '.') {
+					reading = READING_DEC;
+					is_float = true;
+				} else if (c == 'e') {
+					reading = READING_EXP;
+					is_float = true;
+				} else {
+					reading = READING_DONE;
+				}
+
+			} break;
+			case READING_DEC: {
+
+				if (c >= '0' && c <= '9') {
+
+				} else if (c == 'e') {
+					reading = READING_EXP;
+				} else {
+					reading = READING_DONE;
+				}
+
+			} break;
+			case READING_EXP: {
+
+				if (c >= '0' && c <= '9') {
+					exp_beg = true;
+
+				} else if ((c == '-' || c == '+') && !exp_sign && !exp_beg) {
+					exp_sign = true;
+
+				} else {
+					reading = READING_DONE;
+				}
+			} break;
+		}
+
+		if (reading == READING_DONE)
+			break;
+		r_num += c;
+		c = p_stream->get_char();
+	}
+
+	p_stream->saved = c;
+
+	return is_float;
+}
+
+// Returns the next character that is not whitespace, taking p_stream->saved
+// into account and counting lines.
+static CharType _skip_whitespace(VariantParser::Stream *p_stream, int &line) {
+
+	while (true) {
+
+		CharType c;
+		if (p_stream->saved) {
+			c = p_stream->saved;
+			p_stream->saved = 0;
+		} else {
+			c = p_stream->get_char();
+		}
+
+		if (c == '\n') {
+			line++;
+		} else if (c == 0 || c > 32) {
+			return c;
+		}
+	}
+}
+
 Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, String &r_err_str) {
 
 	while (true) {
@@ -300,73 +415,7 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 					//a number
 
 					StringBuffer<> num;
-#define READING_SIGN 0
-#define READING_INT 1
-#define READING_DEC 2
-#define READING_EXP 3
-#define READING_DONE 4
-					int reading = READING_INT;
-
-					if (cchar == '-') {
-						num += '-';
-						cchar = p_stream->get_char();
-					}
-
-					CharType c = cchar;
-					bool exp_sign = false;
-					bool exp_beg = false;
-					bool is_float = false;
-
-					while (true) {
-
-						switch (reading) {
-							case READING_INT: {
-
-								if (c >= '0' && c <= '9') {
-									//pass
-								} else if (c == '.') {
-									reading = READING_DEC;
-									is_float = true;
-								} else if (c == 'e') {
-									reading = READING_EXP;
-									is_float = true;
-								} else {
-									reading = READING_DONE;
-								}
-
-							} break;
-							case READING_DEC: {
-
-								if (c >= '0' && c <= '9') {
-
-								} else if (c == 'e') {
-									reading = READING_EXP;
-								} else {
-									reading = READING_DONE;
-								}
-
-							} break;
-							case READING_EXP: {
-
-								if (c >= '0' && c <= '9') {
-									exp_beg = true;
-
-								} else if ((c == '-' || c == '+') && !exp_sign && !exp_beg) {
-									exp_sign = true;
-
-								} else {
-									reading = READING_DONE;
-								}
-							} break;
-						}
-
-						if (reading == READING_DONE)
-							break;
-						num += c;
-						c = p_stream->get_char();
-					}
-
-					p_stream->saved = c;
+					bool is_float = _read_number(p_stream, cchar, num);
 
 					r_token.type = TK_NUMBER;
 
@@ -448,31 +497,35 @@ Error VariantParser::_parse_construct(Stream *p_stream, Vector<T> &r_construct,
 		return ERR_PARSE_ERROR;
 	}
 
-	bool first = true;
+	// Numbers are read straight from the stream instead of going through
+	// get_token(), as Pool*Array constructors can hold millions of them.
+	CharType c = _skip_whitespace(p_stream, line);
+	if (c == ')') {
+		return OK;
+	}
+
 	while (true) {
 
-		if (!first) {
-			get_token(p_stream, token, line, r_err_str);
-			if (token.type == TK_COMMA) {
-				//do none
-			} else if (token.type == TK_PARENTHESIS_CLOSE) {
-				break;
-			} else {
-				r_err_str = "Expected ',' or ')' in constructor";
-				return ERR_PARSE_ERROR;
-			}
+		if (c != '-' && (c < '0' || c > '9')) {
+			r_err_str = "Expected float in constructor";
+			return ERR_PARSE_ERROR;
+		}
+
+		StringBuffer<> num;
+		if (_read_number(p_stream, c, num)) {
+			r_construct.push_back(num.as_double());
+		} else {
+			r_construct.push_back(num.as_int());
 		}
-		get_token(p_stream, token, line, r_err_str);
 
-		if (first && token.type == TK_PARENTHESIS_CLOSE) {
+		c = _skip_whitespace(p_stream, line);
+		if (c == ')') {
 			break;
-		} else if (token.type != TK_NUMBER) {
-			r_err_str = "Expected float in constructor";
+		} else if (c != ',') {
+			r_err_str = "Expected ',' or ')' in constructor";
 			return ERR_PARSE_ERROR;
 		}
-
-		r_construct.push_back(token.value);
-		first = false;
+		c = _skip_whitespace(p_stream, line);
 	}
 
 	return OK;
@@ -514,8 +567,8 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 			value = Variant();
 		else if (id == "Vector2") {
 
-			Vector<float> args;
-			Error err = _parse_construct<float>(p_stream, args, line, r_err_str);
+			Vector<real_t> args;
+			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
 			if (err)
 				return err;
 
@@ -527,8 +580,8 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 			return OK;
 		} else if (id == "Rect2") {
 
-			Vector<float> args;
-			Error err = _parse_construct<float>(p_stream, args, line, r_err_str);
+			Vector<real_t> args;
+			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
 			if (err)
 				return err;
 
@@ -540,8 +593,8 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 			return OK;
 		} else if (id == "Vector3") {
 
-			Vector<float> args;
-			Error err = _parse_construct<float>(p_stream, args, line, r_err_str);
+			Vector<real_t> args;
+			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
 			if (err)
 				return err;
 
@@ -553,8 +606,8 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 			return OK;
 		} else if (id == "Transform2D" || id == "Matrix32") { //compatibility
 
-			Vector<float> args;
-			Error err = _parse_construct<float>(p_stream, args, line, r_err_str);
+			Vector<real_t> args;
+			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
 			if (err)
 				return err;
 
@@ -569,8 +622,8 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 			return OK;
 		} else if (id == "Plane") {
 
-			Vector<float> args;
-			Error err = _parse_construct<float>(p_stream, args, line, r_err_str);
+			Vector<real_t> args;
+			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
 			if (err)
 				return err;
 
@@ -582,8 +635,8 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 			return OK;
 		} else if (id == "Quat") {
 
-			Vector<float> args;
-			Error err = _parse_construct<float>(p_stream, args, line, r_err_str);
+			Vector<real_t> args;
+			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
 			if (err)
 				return err;
 
@@ -596,8 +649,8 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 
 		} else if (id == "AABB" || id == "Rect3") {
 
-			Vector<float> args;
-			Error err = _parse_construct<float>(p_stream, args, line, r_err_str);
+			Vector<real_t> args;
+			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
 			if (err)
 				return err;
 
@@ -610,8 +663,8 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 
 		} else if (id == "Basis" || id == "Matrix3") { //compatibility
 
-			Vector<float> args;
-			Error err = _parse_construct<float>(p_stream, args, line, r_err_str);
+			Vector<real_t> args;
+			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
 			if (err)
 				return err;
 
@@ -623,8 +676,8 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 			return OK;
 		} else if (id == "Transform") {
 
-			Vector<float> args;
-			Error err = _parse_construct<float>(p_stream, args, line, r_err_str);
+			Vector<real_t> args;
+			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
 			if (err)
 				return err;
 
@@ -1096,16 +1149,16 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 
 		} else if (id == "PoolRealArray" || id == "FloatArray") {
 
-			Vector<float> args;
-			Error err = _parse_construct<float>(p_stream, args, line, r_err_str);
+			Vector<real_t> args;
+			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
 			if (err)
 				return err;
 
-			PoolVector<float> arr;
+			PoolVector<real_t> arr;
 			{
 				int len = args.size();
 				arr.resize(len);
-				PoolVector<float>::Write w = arr.write();
+				PoolVector<real_t>::Write w = arr.write();
 				for (int i = 0; i < len; i++) {
 					w[i] = args[i];
 				}
@@ -1167,8 +1220,8 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 
 		} else if (id == "PoolVector2Array" || id == "Vector2Array") {
 
-			Vector<float> args;
-			Error err = _parse_construct<float>(p_stream, args, line, r_err_str);
+			Vector<real_t> args;
+			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
 			if (err)
 				return err;
 
@@ -1188,8 +1241,8 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 
 		} else if (id == "PoolVector3Array" || id == "Vector3Array") {
 
-			Vector<float> args;
-			Error err = _parse_construct<float>(p_stream, args, line, r_err_str);
+			Vector<real_t> args;
+			Error err = _parse_construct<real_t>(p_stream, args, line, r_err_str);
 			if (err)
 				return err;
 
@@ -1564,8 +1617,15 @@ static String rtosfix(double p_value) {
 
 	if (p_value == 0.0)
 		return "0"; //avoid negative zero (-0) being written, which may annoy git, svn, etc. for changes when they don't exist.
-	else
-		return rtoss(p_value);
+
+#ifdef REAL_T_IS_DOUBLE
+	// rtoss() keeps six significant digits, which would snap large world coordinates on save.
+	char buf[64];
+	snprintf(buf, 64, "%.15lg", p_value);
+	return buf;
+#else
+	return rtoss(p_value);
+#endif
 }
 
 Error VariantWriter::write(const Variant &p_variant, StoreStringFunc p_store_string_func, void *p_store_string_ud, EncodeResourceFunc p_encode_res_func, void *p_encode_res_ud) {
@@ -39,22 +39,62 @@ class VariantParser {
 public:
 	struct Stream {
 
-		virtual CharType get_char() = 0;
+	private:
+		enum {
+			READAHEAD_SIZE = 2048
+		};
+
+		CharType readahead_buffer[READAHEAD_SIZE];
+		uint32_t readahead_pointer;
+		uint32_t readahead_filled;
+
+	protected:
+		bool eof;
+		virtual uint32_t _read_buffer(CharType *p_buffer, uint32_t p_num_chars) = 0;
+
+	public:
+		// Disable when the underlying source position must match what was
+		// parsed so far, as characters are otherwise consumed in blocks.
+		bool readahead_enabled;
+
+		_FORCE_INLINE_ CharType get_char() {
+
+			if (likely(readahead_pointer < readahead_filled)) {
+				return readahead_buffer[readahead_pointer++];
+			}
+
+			readahead_filled = eof ? 0 : _read_buffer(readahead_buffer, readahead_enabled ? READAHEAD_SIZE : 1);
+			if (readahead_filled == 0) {
+				eof = true;
+				return 0;
+			}
+
+			readahead_pointer = 1;
+			return readahead_buffer[0];
+		}
+
 		virtual bool is_utf8() const = 0;
 		virtual bool is_eof() const = 0;
 
 		CharType saved;
 
 		Stream() :
+				readahead_pointer(0),
+				readahead_filled(0),
+				eof(false),
+				readahead_enabled(true),
 				saved(0) {}
 		virtual ~Stream() {}
 	};
 
 	struct StreamFile : public Stream {
 
+	protected:
+		virtual uint32_t _read_buffer(CharType *p_buffer, uint32_t p_num_chars);
+
+	public:
 		FileAccess *f;
 
-		virtual CharType get_char();
 		virtual bool is_utf8() const;
 		virtual bool is_eof() const;
 
@@ -63,10 +103,13 @@ public:
 
 	struct StreamString : public Stream {
 
+	protected:
+		virtual uint32_t _read_buffer(CharType *p_buffer, uint32_t p_num_chars);
+
+	public:
 		String s;
 		int pos;
 
-		virtual CharType get_char();
 		virtual bool is_utf8() const;
 		virtual bool is_eof() const;
 
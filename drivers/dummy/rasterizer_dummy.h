@@ -140,12 +140,14 @@ public:
 		AABB aabb;
 		Vector<PoolVector<uint8_t> > blend_shapes;
 		Vector<AABB> bone_aabbs;
+		Vector<PoolVector<uint8_t> > lods;
 	};
 
 	struct DummyMesh : public RID_Data {
 		Vector<DummySurface> surfaces;
 		int blend_shape_count;
 		VS::BlendShapeMode blend_shape_mode;
+		Vector<float> lod_errors;
 	};
 
 	mutable RID_Owner<DummyTexture> texture_owner;
@@ -396,6 +398,22 @@ public:
 		return m->surfaces[p_surface].bone_aabbs;
 	}
 
+	void mesh_surface_set_lods(RID p_mesh, int p_surface, const Vector<PoolVector<uint8_t> > &p_index_arrays) {
+		DummyMesh *m = mesh_owner.getornull(p_mesh);
+		ERR_FAIL_COND(!m);
+		ERR_FAIL_INDEX(p_surface, m->surfaces.size());
+
+		m->surfaces.write[p_surface].lods = p_index_arrays;
+	}
+
+	Vector<PoolVector<uint8_t> > mesh_surface_get_lods(RID p_mesh, int p_surface) const {
+		DummyMesh *m = mesh_owner.getornull(p_mesh);
+		ERR_FAIL_COND_V(!m, Vector<PoolVector<uint8_t> >());
+		ERR_FAIL_INDEX_V(p_surface, m->surfaces.size(), Vector<PoolVector<uint8_t> >());
+
+		return m->surfaces[p_surface].lods;
+	}
+
 	void mesh_remove_surface(RID p_mesh, int p_index) {
 		DummyMesh *m = mesh_owner.getornull(p_mesh);
 		ERR_FAIL_COND(!m);
@@ -409,6 +427,18 @@ public:
 		return m->surfaces.size();
 	}
 
+	void mesh_set_lod_errors(RID p_mesh, const Vector<float> &p_errors) {
+		DummyMesh *m = mesh_owner.getornull(p_mesh);
+		ERR_FAIL_COND(!m);
+		m->lod_errors = p_errors;
+	}
+
+	Vector<float> mesh_get_lod_errors(RID p_mesh) const {
+		DummyMesh *m = mesh_owner.getornull(p_mesh);
+		ERR_FAIL_COND_V(!m, Vector<float>());
+		return m->lod_errors;
+	}
+
 	void mesh_set_custom_aabb(RID p_mesh, const AABB &p_aabb) {}
 	AABB mesh_get_custom_aabb(RID p_mesh) const { return AABB(); }
 
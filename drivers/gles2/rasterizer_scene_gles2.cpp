@@ -31,6 +31,7 @@
 #include "rasterizer_scene_gles2.h"
 
 #include "core/math/math_funcs.h"
+#include "core/math/math_kernels.h"
 #include "core/math/transform.h"
 #include "core/os/os.h"
 #include "core/project_settings.h"
@@ -1523,11 +1524,15 @@ void RasterizerSceneGLES2::_setup_geometry(RenderList::Element *p_element, Raste
 						PoolVector<uint8_t>::Read vertex_array_read = s->data.read();
 						const uint8_t *vertex_data = vertex_array_read.ptr();
 
+						const float *palette = p_skeleton->bone_data.ptr();
+						const int bone_count = p_skeleton->size;
+						int invalid_bone = -1;
+
 						for (int i = 0; i < s->array_len; i++) {
 
 							// do magic
 
-							size_t bones[4];
+							int bones[4];
 							float bone_weight[4];
 
 							if (s->attribs[VS::ARRAY_BONES].type == GL_UNSIGNED_BYTE) {
@@ -1562,36 +1567,30 @@ void RasterizerSceneGLES2::_setup_geometry(RenderList::Element *p_element, Raste
 								bone_weight[3] = (weight_ptr[3] / (float)0xFFFF);
 							}
 
-							Transform transform;
-
-							Transform bone_transforms[4] = {
-								storage->skeleton_bone_get_transform(p_element->instance->skeleton, bones[0]),
-								storage->skeleton_bone_get_transform(p_element->instance->skeleton, bones[1]),
-								storage->skeleton_bone_get_transform(p_element->instance->skeleton, bones[2]),
-								storage->skeleton_bone_get_transform(p_element->instance->skeleton, bones[3]),
-							};
-
-							transform.origin =
-									bone_weight[0] * bone_transforms[0].origin +
-									bone_weight[1] * bone_transforms[1].origin +
-									bone_weight[2] * bone_transforms[2].origin +
-									bone_weight[3] * bone_transforms[3].origin;
-
-							transform.basis =
-									bone_transforms[0].basis * bone_weight[0] +
-									bone_transforms[1].basis * bone_weight[1] +
-									bone_transforms[2].basis * bone_weight[2] +
-									bone_transforms[3].basis * bone_weight[3];
-
-							float row[3][4] = {
-								{ transform.basis[0][0], transform.basis[0][1], transform.basis[0][2], transform.origin[0] },
-								{ transform.basis[1][0], transform.basis[1][1], transform.basis[1][2], transform.origin[1] },
-								{ transform.basis[2][0], transform.basis[2][1], transform.basis[2][2], transform.origin[2] },
-							};
+							// Bones outside the skeleton use an identity transform.
+							int influences = 0;
+							float identity_weight = 0;
+							for (int j = 0; j < 4; j++) {
+								if (bones[j] < bone_count) {
+									bones[influences] = bones[j];
+									bone_weight[influences] = bone_weight[j];
+									influences++;
+								} else {
+									invalid_bone = bones[j];
+									identity_weight += bone_weight[j];
+								}
+							}
 
-							size_t transform_buffer_offset = i * 12;
+							// The skeleton already stores its bones as rows, blend them straight into the buffer.
+							float *rows = &buffer[i * 12];
+							MathKernels::blend_palette_rows(palette, bones, bone_weight, influences, rows);
+							rows[0] += identity_weight;
+							rows[5] += identity_weight;
+							rows[10] += identity_weight;
+						}
 
-							copymem(&buffer[transform_buffer_offset], row, sizeof(row));
+						if (invalid_bone >= 0) {
+							ERR_PRINT("Mesh uses bone " + itos(invalid_bone) + ", but its skeleton only has " + itos(bone_count) + " bones.");
 						}
 					}
 
@@ -1681,8 +1680,18 @@ void RasterizerSceneGLES2::_render_geometry(RenderList::Element *p_element) {
 			// drawing
 
 			if (s->index_array_len > 0) {
-				glDrawElements(gl_primitive[s->primitive], s->index_array_len, (s->array_len >= (1 << 16)) ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT, 0);
-				storage->info.render.vertices_count += s->index_array_len;
+				int index_count = s->index_array_len;
+				int index_offset = 0;
+
+				if (p_element->instance->lod_level > 0 && s->lods.size()) {
+					// Surfaces with fewer levels stay on their coarsest one.
+					const RasterizerStorageGLES2::Surface::LOD &lod = s->lods[MIN(p_element->instance->lod_level, s->lods.size()) - 1];
+					index_count = lod.index_count;
+					index_offset = lod.offset;
+				}
+
+				glDrawElements(gl_primitive[s->primitive], index_count, (s->array_len >= (1 << 16)) ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT, CAST_INT_TO_UCHAR_PTR(index_offset));
+				storage->info.render.vertices_count += index_count;
 			} else {
 				glDrawArrays(gl_primitive[s->primitive], 0, s->array_len);
 				storage->info.render.vertices_count += s->array_len;
@@ -1818,7 +1827,7 @@ void RasterizerSceneGLES2::_render_geometry(RenderList::Element *p_element) {
 				if (!c.normals.empty()) {
 					glEnableVertexAttribArray(VS::ARRAY_NORMAL);
 					glBufferSubData(GL_ARRAY_BUFFER, buf_ofs, sizeof(Vector3) * vertices, c.normals.ptr());
-					glVertexAttribPointer(VS::ARRAY_NORMAL, 3, GL_FLOAT, GL_FALSE, sizeof(Vector3), CAST_INT_TO_UCHAR_PTR(buf_ofs));
+					glVertexAttribPointer(VS::ARRAY_NORMAL, 3, GL_REAL, GL_FALSE, sizeof(Vector3), CAST_INT_TO_UCHAR_PTR(buf_ofs));
 					buf_ofs += sizeof(Vector3) * vertices;
 				} else {
 					glDisableVertexAttribArray(VS::ARRAY_NORMAL);
@@ -1827,7 +1836,7 @@ void RasterizerSceneGLES2::_render_geometry(RenderList::Element *p_element) {
 				if (!c.tangents.empty()) {
 					glEnableVertexAttribArray(VS::ARRAY_TANGENT);
 					glBufferSubData(GL_ARRAY_BUFFER, buf_ofs, sizeof(Plane) * vertices, c.tangents.ptr());
-					glVertexAttribPointer(VS::ARRAY_TANGENT, 4, GL_FLOAT, GL_FALSE, sizeof(Plane), CAST_INT_TO_UCHAR_PTR(buf_ofs));
+					glVertexAttribPointer(VS::ARRAY_TANGENT, 4, GL_REAL, GL_FALSE, sizeof(Plane), CAST_INT_TO_UCHAR_PTR(buf_ofs));
 					buf_ofs += sizeof(Plane) * vertices;
 				} else {
 					glDisableVertexAttribArray(VS::ARRAY_TANGENT);
@@ -1845,7 +1854,7 @@ void RasterizerSceneGLES2::_render_geometry(RenderList::Element *p_element) {
 				if (!c.uvs.empty()) {
 					glEnableVertexAttribArray(VS::ARRAY_TEX_UV);
 					glBufferSubData(GL_ARRAY_BUFFER, buf_ofs, sizeof(Vector2) * vertices, c.uvs.ptr());
-					glVertexAttribPointer(VS::ARRAY_TEX_UV, 2, GL_FLOAT, GL_FALSE, sizeof(Vector2), CAST_INT_TO_UCHAR_PTR(buf_ofs));
+					glVertexAttribPointer(VS::ARRAY_TEX_UV, 2, GL_REAL, GL_FALSE, sizeof(Vector2), CAST_INT_TO_UCHAR_PTR(buf_ofs));
 					buf_ofs += sizeof(Vector2) * vertices;
 				} else {
 					glDisableVertexAttribArray(VS::ARRAY_TEX_UV);
@@ -1854,7 +1863,7 @@ void RasterizerSceneGLES2::_render_geometry(RenderList::Element *p_element) {
 				if (!c.uv2s.empty()) {
 					glEnableVertexAttribArray(VS::ARRAY_TEX_UV2);
 					glBufferSubData(GL_ARRAY_BUFFER, buf_ofs, sizeof(Vector2) * vertices, c.uv2s.ptr());
-					glVertexAttribPointer(VS::ARRAY_TEX_UV2, 2, GL_FLOAT, GL_FALSE, sizeof(Vector2), CAST_INT_TO_UCHAR_PTR(buf_ofs));
+					glVertexAttribPointer(VS::ARRAY_TEX_UV2, 2, GL_REAL, GL_FALSE, sizeof(Vector2), CAST_INT_TO_UCHAR_PTR(buf_ofs));
 					buf_ofs += sizeof(Vector2) * vertices;
 				} else {
 					glDisableVertexAttribArray(VS::ARRAY_TEX_UV2);
@@ -1862,7 +1871,7 @@ void RasterizerSceneGLES2::_render_geometry(RenderList::Element *p_element) {
 
 				glEnableVertexAttribArray(VS::ARRAY_VERTEX);
 				glBufferSubData(GL_ARRAY_BUFFER, buf_ofs, sizeof(Vector3) * vertices, c.vertices.ptr());
-				glVertexAttribPointer(VS::ARRAY_VERTEX, 3, GL_FLOAT, GL_FALSE, sizeof(Vector3), CAST_INT_TO_UCHAR_PTR(buf_ofs));
+				glVertexAttribPointer(VS::ARRAY_VERTEX, 3, GL_REAL, GL_FALSE, sizeof(Vector3), CAST_INT_TO_UCHAR_PTR(buf_ofs));
 
 				glDrawArrays(gl_primitive[c.primitive], 0, c.vertices.size());
 			}
@@ -2264,7 +2273,16 @@ void RasterizerSceneGLES2::_render_render_list(RenderList::Element **p_elements,
 	RasterizerStorageGLES2::Skeleton *prev_skeleton = NULL;
 	RasterizerStorageGLES2::GeometryOwner *prev_owner = NULL;
 
-	Transform view_transform_inverse = p_view_transform.inverse();
+	// Large world builds render relative to the camera, so that only small
+	// offsets are converted to float when they reach the shaders.
+	Vector3 render_origin;
+#ifdef REAL_T_IS_DOUBLE
+	render_origin = p_view_transform.origin;
+#endif
+	Transform render_view_transform = p_view_transform;
+	render_view_transform.origin -= render_origin;
+
+	Transform view_transform_inverse = render_view_transform.inverse();
 	CameraMatrix projection_inverse = p_projection.inverse();
 
 	bool prev_base_pass = false;
@@ -2588,15 +2606,14 @@ void RasterizerSceneGLES2::_render_render_list(RenderList::Element **p_elements,
 					}
 
 					if (p_env->fog_height_enabled) {
-						state.scene_shader.set_uniform(SceneShaderGLES2::FOG_HEIGHT_MIN, p_env->fog_height_min);
-						state.scene_shader.set_uniform(SceneShaderGLES2::FOG_HEIGHT_MAX, p_env->fog_height_max);
-						state.scene_shader.set_uniform(SceneShaderGLES2::FOG_HEIGHT_MAX, p_env->fog_height_max);
+						state.scene_shader.set_uniform(SceneShaderGLES2::FOG_HEIGHT_MIN, p_env->fog_height_min - render_origin.y);
+						state.scene_shader.set_uniform(SceneShaderGLES2::FOG_HEIGHT_MAX, p_env->fog_height_max - render_origin.y);
 						state.scene_shader.set_uniform(SceneShaderGLES2::FOG_HEIGHT_CURVE, p_env->fog_height_curve);
 					}
 				}
 			}
 
-			state.scene_shader.set_uniform(SceneShaderGLES2::CAMERA_MATRIX, p_view_transform);
+			state.scene_shader.set_uniform(SceneShaderGLES2::CAMERA_MATRIX, render_view_transform);
 			state.scene_shader.set_uniform(SceneShaderGLES2::CAMERA_INVERSE_MATRIX, view_transform_inverse);
 			state.scene_shader.set_uniform(SceneShaderGLES2::PROJECTION_MATRIX, p_projection);
 			state.scene_shader.set_uniform(SceneShaderGLES2::PROJECTION_INVERSE_MATRIX, projection_inverse);
@@ -2620,7 +2637,9 @@ void RasterizerSceneGLES2::_render_render_list(RenderList::Element **p_elements,
 			state.scene_shader.set_uniform(SceneShaderGLES2::LIGHTMAP_ENERGY, lightmap_energy);
 		}
 
-		state.scene_shader.set_uniform(SceneShaderGLES2::WORLD_TRANSFORM, e->instance->transform);
+		Transform world_transform = e->instance->transform;
+		world_transform.origin -= render_origin;
+		state.scene_shader.set_uniform(SceneShaderGLES2::WORLD_TRANSFORM, world_transform);
 
 		if (use_lightmap_capture) { //this is per instance, must be set always if present
 			glUniform4fv(state.scene_shader.get_uniform_location(SceneShaderGLES2::LIGHTMAP_CAPTURES), 12, (const GLfloat *)e->instance->lightmap_capture_data.ptr());
@@ -2726,8 +2745,8 @@ void RasterizerSceneGLES2::_draw_sky(RasterizerStorageGLES2::Sky *p_sky, const C
 	glBufferData(GL_ARRAY_BUFFER, sizeof(Vector3) * 8, vertices, GL_DYNAMIC_DRAW);
 
 	// bind sky vertex array....
-	glVertexAttribPointer(VS::ARRAY_VERTEX, 3, GL_FLOAT, GL_FALSE, sizeof(Vector3) * 2, 0);
-	glVertexAttribPointer(VS::ARRAY_TEX_UV, 3, GL_FLOAT, GL_FALSE, sizeof(Vector3) * 2, CAST_INT_TO_UCHAR_PTR(sizeof(Vector3)));
+	glVertexAttribPointer(VS::ARRAY_VERTEX, 3, GL_REAL, GL_FALSE, sizeof(Vector3) * 2, 0);
+	glVertexAttribPointer(VS::ARRAY_TEX_UV, 3, GL_REAL, GL_FALSE, sizeof(Vector3) * 2, CAST_INT_TO_UCHAR_PTR(sizeof(Vector3)));
 	glEnableVertexAttribArray(VS::ARRAY_VERTEX);
 	glEnableVertexAttribArray(VS::ARRAY_TEX_UV);
 
@@ -46,6 +46,16 @@
 #include "shaders/particles.glsl.gen.h"
 */
 
+// Vertex arrays built from Vector2/Vector3 hold real_t, which is double in
+// large world builds.
+#ifndef GL_REAL
+#ifdef REAL_T_IS_DOUBLE
+#define GL_REAL GL_DOUBLE
+#else
+#define GL_REAL GL_FLOAT
+#endif
+#endif
+
 class RasterizerCanvasGLES2;
 class RasterizerSceneGLES2;
 
@@ -632,6 +642,14 @@ public:
 
 		Vector<BlendShape> blend_shapes;
 
+		// Simplified index lists, stored in index_id after the full one.
+		struct LOD {
+			int offset;
+			int index_count;
+		};
+
+		Vector<LOD> lods;
+
 		AABB aabb;
 
 		int array_len;
@@ -651,6 +669,7 @@ public:
 		PoolVector<uint8_t> data;
 		PoolVector<uint8_t> index_data;
 		Vector<PoolVector<uint8_t> > blend_shape_data;
+		Vector<PoolVector<uint8_t> > lod_data;
 
 		int total_data_size;
 
@@ -679,6 +698,8 @@ public:
 
 		AABB custom_aabb;
 
+		Vector<float> lod_errors;
+
 		mutable uint64_t last_pass;
 
 		SelfList<MultiMesh>::List multimeshes;
@@ -728,9 +749,15 @@ public:
 	virtual Vector<PoolVector<uint8_t> > mesh_surface_get_blend_shapes(RID p_mesh, int p_surface) const;
 	virtual Vector<AABB> mesh_surface_get_skeleton_aabb(RID p_mesh, int p_surface) const;
 
+	virtual void mesh_surface_set_lods(RID p_mesh, int p_surface, const Vector<PoolVector<uint8_t> > &p_index_arrays);
+	virtual Vector<PoolVector<uint8_t> > mesh_surface_get_lods(RID p_mesh, int p_surface) const;
+
 	virtual void mesh_remove_surface(RID p_mesh, int p_surface);
 	virtual int mesh_get_surface_count(RID p_mesh) const;
 
+	virtual void mesh_set_lod_errors(RID p_mesh, const Vector<float> &p_errors);
+	virtual Vector<float> mesh_get_lod_errors(RID p_mesh) const;
+
 	virtual void mesh_set_custom_aabb(RID p_mesh, const AABB &p_aabb);
 	virtual AABB mesh_get_custom_aabb(RID p_mesh) const;
 
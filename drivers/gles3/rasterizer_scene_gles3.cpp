@@ -1536,9 +1536,19 @@ void RasterizerSceneGLES3::_render_geometry(RenderList::Element *e) {
 #endif
 					if (s->index_array_len > 0) {
 
-				glDrawElements(gl_primitive[s->primitive], s->index_array_len, (s->array_len >= (1 << 16)) ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT, 0);
+				int index_count = s->index_array_len;
+				int index_offset = 0;
+
+				if (e->instance->lod_level > 0 && s->lods.size()) {
+					// Surfaces with fewer levels stay on their coarsest one.
+					const RasterizerStorageGLES3::Surface::LOD &lod = s->lods[MIN(e->instance->lod_level, s->lods.size()) - 1];
+					index_count = lod.index_count;
+					index_offset = lod.offset;
+				}
 
-				storage->info.render.vertices_count += s->index_array_len;
+				glDrawElements(gl_primitive[s->primitive], index_count, (s->array_len >= (1 << 16)) ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT, CAST_INT_TO_UCHAR_PTR(index_offset));
+
+				storage->info.render.vertices_count += index_count;
 
 			} else {
 
@@ -1638,7 +1648,7 @@ void RasterizerSceneGLES3::_render_geometry(RenderList::Element *e) {
 
 					glEnableVertexAttribArray(VS::ARRAY_NORMAL);
 					glBufferSubData(GL_ARRAY_BUFFER, buf_ofs, sizeof(Vector3) * vertices, c.normals.ptr());
-					glVertexAttribPointer(VS::ARRAY_NORMAL, 3, GL_FLOAT, false, sizeof(Vector3), CAST_INT_TO_UCHAR_PTR(buf_ofs));
+					glVertexAttribPointer(VS::ARRAY_NORMAL, 3, GL_REAL, false, sizeof(Vector3), CAST_INT_TO_UCHAR_PTR(buf_ofs));
 					buf_ofs += sizeof(Vector3) * vertices;
 
 				} else {
@@ -1650,7 +1660,7 @@ void RasterizerSceneGLES3::_render_geometry(RenderList::Element *e) {
 
 					glEnableVertexAttribArray(VS::ARRAY_TANGENT);
 					glBufferSubData(GL_ARRAY_BUFFER, buf_ofs, sizeof(Plane) * vertices, c.tangents.ptr());
-					glVertexAttribPointer(VS::ARRAY_TANGENT, 4, GL_FLOAT, false, sizeof(Plane), CAST_INT_TO_UCHAR_PTR(buf_ofs));
+					glVertexAttribPointer(VS::ARRAY_TANGENT, 4, GL_REAL, false, sizeof(Plane), CAST_INT_TO_UCHAR_PTR(buf_ofs));
 					buf_ofs += sizeof(Plane) * vertices;
 
 				} else {
@@ -1675,7 +1685,7 @@ void RasterizerSceneGLES3::_render_geometry(RenderList::Element *e) {
 
 					glEnableVertexAttribArray(VS::ARRAY_TEX_UV);
 					glBufferSubData(GL_ARRAY_BUFFER, buf_ofs, sizeof(Vector2) * vertices, c.uvs.ptr());
-					glVertexAttribPointer(VS::ARRAY_TEX_UV, 2, GL_FLOAT, false, sizeof(Vector2), CAST_INT_TO_UCHAR_PTR(buf_ofs));
+					glVertexAttribPointer(VS::ARRAY_TEX_UV, 2, GL_REAL, false, sizeof(Vector2), CAST_INT_TO_UCHAR_PTR(buf_ofs));
 					buf_ofs += sizeof(Vector2) * vertices;
 
 				} else {
@@ -1687,7 +1697,7 @@ void RasterizerSceneGLES3::_render_geometry(RenderList::Element *e) {
 
 					glEnableVertexAttribArray(VS::ARRAY_TEX_UV2);
 					glBufferSubData(GL_ARRAY_BUFFER, buf_ofs, sizeof(Vector2) * vertices, c.uvs2.ptr());
-					glVertexAttribPointer(VS::ARRAY_TEX_UV2, 2, GL_FLOAT, false, sizeof(Vector2), CAST_INT_TO_UCHAR_PTR(buf_ofs));
+					glVertexAttribPointer(VS::ARRAY_TEX_UV2, 2, GL_REAL, false, sizeof(Vector2), CAST_INT_TO_UCHAR_PTR(buf_ofs));
 					buf_ofs += sizeof(Vector2) * vertices;
 
 				} else {
@@ -1697,7 +1707,7 @@ void RasterizerSceneGLES3::_render_geometry(RenderList::Element *e) {
 
 				glEnableVertexAttribArray(VS::ARRAY_VERTEX);
 				glBufferSubData(GL_ARRAY_BUFFER, buf_ofs, sizeof(Vector3) * vertices, c.vertices.ptr());
-				glVertexAttribPointer(VS::ARRAY_VERTEX, 3, GL_FLOAT, false, sizeof(Vector3), CAST_INT_TO_UCHAR_PTR(buf_ofs));
+				glVertexAttribPointer(VS::ARRAY_VERTEX, 3, GL_REAL, false, sizeof(Vector3), CAST_INT_TO_UCHAR_PTR(buf_ofs));
 				glDrawArrays(gl_primitive[c.primitive], 0, c.vertices.size());
 			}
 
@@ -1714,7 +1724,7 @@ void RasterizerSceneGLES3::_render_geometry(RenderList::Element *e) {
 			RasterizerStorageGLES3::Surface *s = static_cast<RasterizerStorageGLES3::Surface *>(e->geometry);
 
 			if (!particles->use_local_coords) //not using local coordinates? then clear transform..
-				state.scene_shader.set_uniform(SceneShaderGLES3::WORLD_TRANSFORM, Transform());
+				state.scene_shader.set_uniform(SceneShaderGLES3::WORLD_TRANSFORM, Transform(Basis(), -state.render_origin));
 
 			int amount = particles->amount;
 
@@ -2222,7 +2232,9 @@ void RasterizerSceneGLES3::_render_list(RenderList::Element **p_elements, int p_
 
 		_set_cull(e->sort_key & RenderList::SORT_KEY_MIRROR_FLAG, e->sort_key & RenderList::SORT_KEY_CULL_DISABLED_FLAG, p_reverse_cull);
 
-		state.scene_shader.set_uniform(SceneShaderGLES3::WORLD_TRANSFORM, e->instance->transform);
+		Transform world_transform = e->instance->transform;
+		world_transform.origin -= state.render_origin;
+		state.scene_shader.set_uniform(SceneShaderGLES3::WORLD_TRANSFORM, world_transform);
 
 		_render_geometry(e);
 
@@ -2550,8 +2562,16 @@ void RasterizerSceneGLES3::_setup_environment(Environment *env, const CameraMatr
 	//store camera into ubo
 	store_camera(p_cam_projection, state.ubo_data.projection_matrix);
 	store_camera(p_cam_projection.inverse(), state.ubo_data.inv_projection_matrix);
-	store_transform(p_cam_transform, state.ubo_data.camera_matrix);
-	store_transform(p_cam_transform.affine_inverse(), state.ubo_data.camera_inverse_matrix);
+
+	// Large world builds render relative to the camera, so that only small
+	// offsets are converted to float when they reach the shaders.
+	Transform render_cam_transform = p_cam_transform;
+#ifdef REAL_T_IS_DOUBLE
+	state.render_origin = p_cam_transform.origin;
+	render_cam_transform.origin = Vector3();
+#endif
+	store_transform(render_cam_transform, state.ubo_data.camera_matrix);
+	store_transform(render_cam_transform.affine_inverse(), state.ubo_data.camera_inverse_matrix);
 
 	//time global variables
 	state.ubo_data.time = storage->frame.time[0];
@@ -2614,8 +2634,8 @@ void RasterizerSceneGLES3::_setup_environment(Environment *env, const CameraMatr
 		state.ubo_data.fog_transmit_enabled = env->fog_transmit_enabled;
 		state.ubo_data.fog_transmit_curve = env->fog_transmit_curve;
 		state.ubo_data.fog_height_enabled = env->fog_height_enabled;
-		state.ubo_data.fog_height_min = env->fog_height_min;
-		state.ubo_data.fog_height_max = env->fog_height_max;
+		state.ubo_data.fog_height_min = env->fog_height_min - state.render_origin.y;
+		state.ubo_data.fog_height_max = env->fog_height_max - state.render_origin.y;
 		state.ubo_data.fog_height_curve = env->fog_height_curve;
 
 	} else {
@@ -3359,10 +3379,10 @@ void RasterizerSceneGLES3::_render_mrts(Environment *env, const CameraMatrix &p_
 		}
 
 		float proj_info[4] = {
-			-2.0f / (ss[0] * p_cam_projection.matrix[0][0]),
-			-2.0f / (ss[1] * p_cam_projection.matrix[1][1]),
-			(1.0f - p_cam_projection.matrix[0][2]) / p_cam_projection.matrix[0][0],
-			(1.0f + p_cam_projection.matrix[1][2]) / p_cam_projection.matrix[1][1]
+			float(-2.0f / (ss[0] * p_cam_projection.matrix[0][0])),
+			float(-2.0f / (ss[1] * p_cam_projection.matrix[1][1])),
+			float((1.0f - p_cam_projection.matrix[0][2]) / p_cam_projection.matrix[0][0]),
+			float((1.0f + p_cam_projection.matrix[1][2]) / p_cam_projection.matrix[1][1])
 		};
 
 		glUniform4fv(state.ssao_shader.get_uniform(SsaoShaderGLES3::PROJ_INFO), 1, proj_info);
@@ -5046,9 +5066,9 @@ void RasterizerSceneGLES3::initialize() {
 		glGenVertexArrays(1, &state.sky_array);
 		glBindVertexArray(state.sky_array);
 		glBindBuffer(GL_ARRAY_BUFFER, state.sky_verts);
-		glVertexAttribPointer(VS::ARRAY_VERTEX, 3, GL_FLOAT, GL_FALSE, sizeof(Vector3) * 2, 0);
+		glVertexAttribPointer(VS::ARRAY_VERTEX, 3, GL_REAL, GL_FALSE, sizeof(Vector3) * 2, 0);
 		glEnableVertexAttribArray(VS::ARRAY_VERTEX);
-		glVertexAttribPointer(VS::ARRAY_TEX_UV, 3, GL_FLOAT, GL_FALSE, sizeof(Vector3) * 2, CAST_INT_TO_UCHAR_PTR(sizeof(Vector3)));
+		glVertexAttribPointer(VS::ARRAY_TEX_UV, 3, GL_REAL, GL_FALSE, sizeof(Vector3) * 2, CAST_INT_TO_UCHAR_PTR(sizeof(Vector3)));
 		glEnableVertexAttribArray(VS::ARRAY_TEX_UV);
 		glBindVertexArray(0);
 		glBindBuffer(GL_ARRAY_BUFFER, 0); //unbind
@@ -161,6 +161,8 @@ public:
 
 		GLuint scene_ubo;
 
+		Vector3 render_origin; // subtracted from world positions before they are sent to the GPU
+
 		struct EnvironmentRadianceUBO {
 
 			float transform[16];
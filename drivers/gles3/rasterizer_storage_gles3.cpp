@@ -30,6 +30,7 @@
 
 #include "rasterizer_storage_gles3.h"
 #include "core/engine.h"
+#include "core/math/math_kernels.h"
 #include "core/project_settings.h"
 #include "rasterizer_canvas_gles3.h"
 #include "rasterizer_scene_gles3.h"
@@ -4069,6 +4070,108 @@ Vector<AABB> RasterizerStorageGLES3::mesh_surface_get_skeleton_aabb(RID p_mesh,
 	return mesh->surfaces[p_surface]->skeleton_bone_aabb;
 }
 
+void RasterizerStorageGLES3::mesh_surface_set_lods(RID p_mesh, int p_surface, const Vector<PoolVector<uint8_t> > &p_index_arrays) {
+
+	Mesh *mesh = mesh_owner.getornull(p_mesh);
+	ERR_FAIL_COND(!mesh);
+	ERR_FAIL_INDEX(p_surface, mesh->surfaces.size());
+
+	Surface *surface = mesh->surfaces[p_surface];
+	ERR_FAIL_COND_MSG(!surface->index_id && p_index_arrays.size(), "Only surfaces with an index array can have LODs.");
+
+	int index_size = (surface->array_len >= (1 << 16)) ? 4 : 2;
+	int lods_size = 0;
+	for (int i = 0; i < p_index_arrays.size(); i++) {
+		ERR_FAIL_COND(p_index_arrays[i].size() % (index_size * 3) != 0);
+		lods_size += p_index_arrays[i].size();
+	}
+
+	int old_lods_size = 0;
+	for (int i = 0; i < surface->lods.size(); i++) {
+		old_lods_size += surface->lods[i].index_count * index_size;
+	}
+
+	if (!surface->index_id || (lods_size == 0 && old_lods_size == 0))
+		return;
+
+	PoolVector<uint8_t> index_array = mesh_surface_get_index_array(p_mesh, p_surface);
+
+	// Refilled in place, so the vertex arrays that already reference this buffer stay valid.
+	glBindVertexArray(0);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, surface->index_id);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, surface->index_array_byte_size + lods_size, NULL, GL_STATIC_DRAW);
+	{
+		PoolVector<uint8_t>::Read r = index_array.read();
+		glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, surface->index_array_byte_size, r.ptr());
+	}
+
+	surface->lods.resize(p_index_arrays.size());
+
+	int offset = surface->index_array_byte_size;
+	for (int i = 0; i < p_index_arrays.size(); i++) {
+
+		PoolVector<uint8_t>::Read r = p_index_arrays[i].read();
+		glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, offset, p_index_arrays[i].size(), r.ptr());
+
+		surface->lods.write[i].offset = offset;
+		surface->lods.write[i].index_count = p_index_arrays[i].size() / index_size;
+		offset += p_index_arrays[i].size();
+	}
+
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+	surface->total_data_size += lods_size - old_lods_size;
+	info.vertex_mem += lods_size - old_lods_size;
+}
+
+Vector<PoolVector<uint8_t> > RasterizerStorageGLES3::mesh_surface_get_lods(RID p_mesh, int p_surface) const {
+
+	const Mesh *mesh = mesh_owner.getornull(p_mesh);
+	ERR_FAIL_COND_V(!mesh, Vector<PoolVector<uint8_t> >());
+	ERR_FAIL_INDEX_V(p_surface, mesh->surfaces.size(), Vector<PoolVector<uint8_t> >());
+
+	Surface *surface = mesh->surfaces[p_surface];
+
+	Vector<PoolVector<uint8_t> > lods;
+	if (surface->lods.empty())
+		return lods;
+
+	int index_size = (surface->array_len >= (1 << 16)) ? 4 : 2;
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, surface->index_id);
+
+	for (int i = 0; i < surface->lods.size(); i++) {
+
+		const Surface::LOD &lod = surface->lods[i];
+		int size = lod.index_count * index_size;
+
+		PoolVector<uint8_t> data;
+		data.resize(size);
+
+		if (size > 0) {
+#if defined(GLES_OVER_GL) || defined(__EMSCRIPTEN__)
+			PoolVector<uint8_t>::Write w = data.write();
+			glGetBufferSubData(GL_ELEMENT_ARRAY_BUFFER, lod.offset, size, w.ptr());
+#else
+			void *ptr = glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, lod.offset, size, GL_MAP_READ_BIT);
+			ERR_CONTINUE(!ptr);
+			{
+				PoolVector<uint8_t>::Write w = data.write();
+				copymem(w.ptr(), ptr, size);
+			}
+			glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER);
+#endif
+		}
+
+		lods.push_back(data);
+	}
+
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+	return lods;
+}
+
 void RasterizerStorageGLES3::mesh_remove_surface(RID p_mesh, int p_surface) {
 
 	Mesh *mesh = mesh_owner.getornull(p_mesh);
@@ -4117,6 +4220,23 @@ int RasterizerStorageGLES3::mesh_get_surface_count(RID p_mesh) const {
 	return mesh->surfaces.size();
 }
 
+void RasterizerStorageGLES3::mesh_set_lod_errors(RID p_mesh, const Vector<float> &p_errors) {
+
+	Mesh *mesh = mesh_owner.getornull(p_mesh);
+	ERR_FAIL_COND(!mesh);
+
+	mesh->lod_errors = p_errors;
+	mesh->instance_change_notify(true, false);
+}
+
+Vector<float> RasterizerStorageGLES3::mesh_get_lod_errors(RID p_mesh) const {
+
+	const Mesh *mesh = mesh_owner.getornull(p_mesh);
+	ERR_FAIL_COND_V(!mesh, Vector<float>());
+
+	return mesh->lod_errors;
+}
+
 void RasterizerStorageGLES3::mesh_set_custom_aabb(RID p_mesh, const AABB &p_aabb) {
 
 	Mesh *mesh = mesh_owner.getornull(p_mesh);
@@ -4999,30 +5119,7 @@ void RasterizerStorageGLES3::update_dirty_multimeshes() {
 				}
 			} else {
 
-				for (int i = 0; i < count; i += stride) {
-
-					float *dataptr = &data[i];
-					Transform xform;
-
-					xform.basis.elements[0][0] = dataptr[0];
-					xform.basis.elements[0][1] = dataptr[1];
-					xform.basis.elements[0][2] = dataptr[2];
-					xform.origin.x = dataptr[3];
-					xform.basis.elements[1][0] = dataptr[4];
-					xform.basis.elements[1][1] = dataptr[5];
-					xform.basis.elements[1][2] = dataptr[6];
-					xform.origin.y = dataptr[7];
-					xform.basis.elements[2][0] = dataptr[8];
-					xform.basis.elements[2][1] = dataptr[9];
-					xform.basis.elements[2][2] = dataptr[10];
-					xform.origin.z = dataptr[11];
-
-					AABB laabb = xform.xform(mesh_aabb);
-					if (i == 0)
-						aabb = laabb;
-					else
-						aabb.merge_with(laabb);
-				}
+				aabb = MathKernels::xform_aabb_rows(mesh_aabb, data, stride, count / stride);
 			}
 
 			multimesh->aabb = aabb;
@@ -7743,11 +7840,11 @@ void RasterizerStorageGLES3::canvas_light_occluder_set_polylines(RID p_occluder,
 		if (!co->vertex_id) {
 			glGenBuffers(1, &co->vertex_id);
 			glBindBuffer(GL_ARRAY_BUFFER, co->vertex_id);
-			glBufferData(GL_ARRAY_BUFFER, lc * 6 * sizeof(real_t), vw.ptr(), GL_STATIC_DRAW);
+			glBufferData(GL_ARRAY_BUFFER, lc * 6 * sizeof(float), vw.ptr(), GL_STATIC_DRAW);
 		} else {
 
 			glBindBuffer(GL_ARRAY_BUFFER, co->vertex_id);
-			glBufferSubData(GL_ARRAY_BUFFER, 0, lc * 6 * sizeof(real_t), vw.ptr());
+			glBufferSubData(GL_ARRAY_BUFFER, 0, lc * 6 * sizeof(float), vw.ptr());
 		}
 
 		glBindBuffer(GL_ARRAY_BUFFER, 0); //unbind
@@ -55,6 +55,16 @@ class RasterizerSceneGLES3;
 #define _DECODE_EXT 0x8A49
 #define _SKIP_DECODE_EXT 0x8A4A
 
+// Vertex arrays built from Vector2/Vector3 hold real_t, which is double in
+// large world builds.
+#ifndef GL_REAL
+#ifdef REAL_T_IS_DOUBLE
+#define GL_REAL GL_DOUBLE
+#else
+#define GL_REAL GL_FLOAT
+#endif
+#endif
+
 void glTexStorage2DCustom(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height, GLenum format, GLenum type);
 
 class RasterizerStorageGLES3 : public RasterizerStorage {
@@ -652,6 +662,14 @@ public:
 
 		Vector<BlendShape> blend_shapes;
 
+		// Simplified index lists, stored in index_id after the full one.
+		struct LOD {
+			int offset;
+			int index_count;
+		};
+
+		Vector<LOD> lods;
+
 		AABB aabb;
 
 		int array_len;
@@ -705,6 +723,7 @@ public:
 		int blend_shape_count;
 		VS::BlendShapeMode blend_shape_mode;
 		AABB custom_aabb;
+		Vector<float> lod_errors;
 		mutable uint64_t last_pass;
 		SelfList<MultiMesh>::List multimeshes;
 		_FORCE_INLINE_ void update_multimeshes() {
@@ -754,9 +773,15 @@ public:
 	virtual Vector<PoolVector<uint8_t> > mesh_surface_get_blend_shapes(RID p_mesh, int p_surface) const;
 	virtual Vector<AABB> mesh_surface_get_skeleton_aabb(RID p_mesh, int p_surface) const;
 
+	virtual void mesh_surface_set_lods(RID p_mesh, int p_surface, const Vector<PoolVector<uint8_t> > &p_index_arrays);
+	virtual Vector<PoolVector<uint8_t> > mesh_surface_get_lods(RID p_mesh, int p_surface) const;
+
 	virtual void mesh_remove_surface(RID p_mesh, int p_surface);
 	virtual int mesh_get_surface_count(RID p_mesh) const;
 
+	virtual void mesh_set_lod_errors(RID p_mesh, const Vector<float> &p_errors);
+	virtual Vector<float> mesh_get_lod_errors(RID p_mesh) const;
+
 	virtual void mesh_set_custom_aabb(RID p_mesh, const AABB &p_aabb);
 	virtual AABB mesh_get_custom_aabb(RID p_mesh) const;
 
@@ -96,7 +96,14 @@ void ShaderGLES3::bind_uniforms() {
 			continue;
 		}
 
-		glUniformMatrix4fv(location, 1, false, &(C->get().matrix[0][0]));
+		GLfloat matrix[16];
+		for (int i = 0; i < 4; i++) {
+			for (int j = 0; j < 4; j++) {
+				matrix[i * 4 + j] = C->get().matrix[i][j];
+			}
+		}
+
+		glUniformMatrix4fv(location, 1, false, matrix);
 		C = C->next();
 	};
 
@@ -239,20 +239,20 @@ private:
 
 				Transform2D tr = p_value;
 				GLfloat matrix[16] = { /* build a 16x16 matrix */
-					tr.elements[0][0],
-					tr.elements[0][1],
+					(GLfloat)tr.elements[0][0],
+					(GLfloat)tr.elements[0][1],
 					0,
 					0,
-					tr.elements[1][0],
-					tr.elements[1][1],
+					(GLfloat)tr.elements[1][0],
+					(GLfloat)tr.elements[1][1],
 					0,
 					0,
 					0,
 					0,
 					1,
 					0,
-					tr.elements[2][0],
-					tr.elements[2][1],
+					(GLfloat)tr.elements[2][0],
+					(GLfloat)tr.elements[2][1],
 					0,
 					1
 				};
@@ -265,21 +265,21 @@ private:
 
 				Transform tr = p_value;
 				GLfloat matrix[16] = { /* build a 16x16 matrix */
-					tr.basis.elements[0][0],
-					tr.basis.elements[1][0],
-					tr.basis.elements[2][0],
+					(GLfloat)tr.basis.elements[0][0],
+					(GLfloat)tr.basis.elements[1][0],
+					(GLfloat)tr.basis.elements[2][0],
 					0,
-					tr.basis.elements[0][1],
-					tr.basis.elements[1][1],
-					tr.basis.elements[2][1],
+					(GLfloat)tr.basis.elements[0][1],
+					(GLfloat)tr.basis.elements[1][1],
+					(GLfloat)tr.basis.elements[2][1],
 					0,
-					tr.basis.elements[0][2],
-					tr.basis.elements[1][2],
-					tr.basis.elements[2][2],
+					(GLfloat)tr.basis.elements[0][2],
+					(GLfloat)tr.basis.elements[1][2],
+					(GLfloat)tr.basis.elements[2][2],
 					0,
-					tr.origin.x,
-					tr.origin.y,
-					tr.origin.z,
+					(GLfloat)tr.origin.x,
+					(GLfloat)tr.origin.y,
+					(GLfloat)tr.origin.z,
 					1
 				};
 
@@ -507,9 +507,9 @@ private:
 	SnapTarget snap_target[2];
 	Transform2D snap_transform;
 	void _snap_if_closer_float(
-			float p_value,
-			float &r_current_snap, SnapTarget &r_current_snap_target,
-			float p_target_value, SnapTarget p_snap_target,
+			real_t p_value,
+			real_t &r_current_snap, SnapTarget &r_current_snap_target,
+			real_t p_target_value, SnapTarget p_snap_target,
 			float p_radius = 10.0);
 	void _snap_if_closer_point(
 			Point2 p_value,
@@ -42,6 +42,7 @@
 #include "scene/3d/listener.h"
 #include "scene/3d/mesh_instance.h"
 #include "scene/3d/navigation_mesh.h"
+#include "scene/3d/occluder_instance.h"
 #include "scene/3d/particles.h"
 #include "scene/3d/physics_joint.h"
 #include "scene/3d/position_3d.h"
@@ -3706,6 +3707,58 @@ void CollisionPolygonSpatialGizmoPlugin::redraw(EditorSpatialGizmo *p_gizmo) {
 
 ////
 
+OccluderInstanceGizmoPlugin::OccluderInstanceGizmoPlugin() {
+	create_material("occluder_material", EDITOR_DEF("editors/3d_gizmos/gizmo_colors/occluder", Color(0.8, 0.5, 1)));
+}
+
+bool OccluderInstanceGizmoPlugin::has_gizmo(Spatial *p_spatial) {
+	return Object::cast_to<OccluderInstance>(p_spatial) != NULL;
+}
+
+String OccluderInstanceGizmoPlugin::get_name() const {
+	return "OccluderInstance";
+}
+
+int OccluderInstanceGizmoPlugin::get_priority() const {
+	return -1;
+}
+
+void OccluderInstanceGizmoPlugin::redraw(EditorSpatialGizmo *p_gizmo) {
+
+	OccluderInstance *occluder_instance = Object::cast_to<OccluderInstance>(p_gizmo->get_spatial_node());
+
+	p_gizmo->clear();
+
+	Ref<Occluder> occluder = occluder_instance->get_occluder();
+	if (occluder.is_null())
+		return;
+
+	PoolVector<Vector3> vertices = occluder->get_vertices();
+	PoolVector<int> indices = occluder->get_indices();
+	if (indices.size() % 3 != 0)
+		return;
+
+	PoolVector<Vector3>::Read vr = vertices.read();
+	PoolVector<int>::Read ir = indices.read();
+
+	Vector<Vector3> lines;
+	for (int i = 0; i < indices.size(); i += 3) {
+		for (int j = 0; j < 3; j++) {
+			int from = ir[i + j];
+			int to = ir[i + (j + 1) % 3];
+			ERR_FAIL_INDEX(from, vertices.size());
+			ERR_FAIL_INDEX(to, vertices.size());
+			lines.push_back(vr[from]);
+			lines.push_back(vr[to]);
+		}
+	}
+
+	p_gizmo->add_lines(lines, get_material("occluder_material", p_gizmo));
+	p_gizmo->add_collision_segments(lines);
+}
+
+////
+
 NavigationMeshSpatialGizmoPlugin::NavigationMeshSpatialGizmoPlugin() {
 	create_material("navigation_edge_material", EDITOR_DEF("editors/3d_gizmos/gizmo_colors/navigation_edge", Color(0.5, 1, 1)));
 	create_material("navigation_edge_material_disabled", EDITOR_DEF("editors/3d_gizmos/gizmo_colors/navigation_edge_disabled", Color(0.7, 0.7, 0.7)));
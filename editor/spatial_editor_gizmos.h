@@ -350,6 +350,17 @@ public:
 	CollisionPolygonSpatialGizmoPlugin();
 };
 
+class OccluderInstanceGizmoPlugin : public EditorSpatialGizmoPlugin {
+	GDCLASS(OccluderInstanceGizmoPlugin, EditorSpatialGizmoPlugin);
+
+public:
+	bool has_gizmo(Spatial *p_spatial);
+	String get_name() const;
+	int get_priority() const;
+	void redraw(EditorSpatialGizmo *p_gizmo);
+	OccluderInstanceGizmoPlugin();
+};
+
 class NavigationMeshSpatialGizmoPlugin : public EditorSpatialGizmoPlugin {
 
 	GDCLASS(NavigationMeshSpatialGizmoPlugin, EditorSpatialGizmoPlugin);
@@ -81,6 +81,8 @@ public:
 		PHYSICS_3D_ISLAND_COUNT,
 		//physics
 		AUDIO_OUTPUT_LATENCY,
+		RENDER_INSTANCES_UPDATED_IN_FRAME,
+		RENDER_INSTANCE_UPDATE_TIME,
 		MONITOR_MAX
 	};
 
@@ -579,6 +579,21 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 					txt += DADDR(3);
 					incr += 5;
 
+				} break;
+				case GDScriptFunction::OPCODE_OPERATOR_TYPED: {
+
+					int op = code[ip + 1];
+					txt += " op typed ";
+
+					String opname = Variant::get_operator_name(Variant::Operator(op));
+
+					txt += DADDR(5);
+					txt += " = ";
+					txt += DADDR(3);
+					txt += " " + opname + " ";
+					txt += DADDR(4);
+					incr += 6;
+
 				} break;
 				case GDScriptFunction::OPCODE_SET: {
 
@@ -611,19 +626,21 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 					txt += func.get_global_name(code[ip + 2]);
 					txt += "\"]=";
 					txt += DADDR(3);
-					incr += 4;
+					txt += " cache:" + itos(code[ip + 4]);
+					incr += 5;
 
 				} break;
 				case GDScriptFunction::OPCODE_GET_NAMED: {
 
 					txt += " get_named ";
-					txt += DADDR(3);
+					txt += DADDR(4);
 					txt += "=";
 					txt += DADDR(1);
 					txt += "[\"";
 					txt += func.get_global_name(code[ip + 2]);
 					txt += "\"]";
-					incr += 4;
+					txt += " cache:" + itos(code[ip + 3]);
+					incr += 5;
 
 				} break;
 				case GDScriptFunction::OPCODE_SET_MEMBER: {
@@ -779,7 +796,7 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 
 					int argc = code[ip + 1];
 					if (ret) {
-						txt += DADDR(4 + argc) + "=";
+						txt += DADDR(5 + argc) + "=";
 					}
 
 					txt += DADDR(2) + ".";
@@ -789,11 +806,12 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 					for (int i = 0; i < argc; i++) {
 						if (i > 0)
 							txt += ", ";
-						txt += DADDR(4 + i);
+						txt += DADDR(5 + i);
 					}
 					txt += ")";
+					txt += " cache:" + itos(code[ip + 4]);
 
-					incr = 5 + argc;
+					incr = 6 + argc;
 
 				} break;
 				case GDScriptFunction::OPCODE_CALL_BUILT_IN: {
@@ -1085,6 +1103,146 @@ MainLoop *test(TestType p_type) {
 
 	return NULL;
 }
+
+static const char *_benchmark_source =
+		"static func vector_math(n: int) -> float:\n"
+		"\tvar acc: Vector3 = Vector3()\n"
+		"\tvar step: Vector3 = Vector3(1, 2, 3)\n"
+		"\tfor i in range(n):\n"
+		"\t\tacc += step * 0.5\n"
+		"\t\tacc = acc.cross(step) * 0.001 + step\n"
+		"\treturn acc.x\n"
+		"\n"
+		"static func array_sum(values: PoolRealArray) -> float:\n"
+		"\tvar total: float = 0.0\n"
+		"\tfor x in values:\n"
+		"\t\ttotal += x\n"
+		"\treturn total\n"
+		"\n"
+		"static func string_build(n: int) -> int:\n"
+		"\tvar text: String = \"\"\n"
+		"\tfor i in range(n):\n"
+		"\t\ttext += str(i % 10)\n"
+		"\treturn text.length()\n"
+		"\n"
+		"static func int_loop(n: int) -> int:\n"
+		"\tvar total: int = 0\n"
+		"\tvar i: int = 0\n"
+		"\twhile i < n:\n"
+		"\t\ttotal += i % 7 * 3 - 1\n"
+		"\t\ti += 1\n"
+		"\treturn total\n"
+		"\n"
+		"static func constant_branch(n: int) -> float:\n"
+		"\tvar scale: float = 2.0\n"
+		"\tvar total: float = 0.0\n"
+		"\tfor i in range(n):\n"
+		"\t\tif scale * 0.5 > 0.0:\n"
+		"\t\t\ttotal += i * scale\n"
+		"\treturn total\n";
+
+static uint64_t _benchmark_run(Object *p_script, const StringName &p_func, const Variant &p_arg, int p_calls, Variant &r_ret) {
+
+	OS *os = OS::get_singleton();
+	uint64_t begin = os->get_ticks_usec();
+	for (int i = 0; i < p_calls; i++) {
+		r_ret = p_script->call(p_func, p_arg);
+	}
+	return os->get_ticks_usec() - begin;
+}
+
+static Ref<GDScript> _benchmark_compile(bool p_optimize) {
+
+	GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+	bool was_optimizing = language->is_bytecode_optimization_enabled();
+	language->set_bytecode_optimization_enabled(p_optimize);
+
+	Ref<GDScript> script;
+	script.instance();
+	script->set_source_code(_benchmark_source);
+	Error err = script->reload();
+
+	language->set_bytecode_optimization_enabled(was_optimizing);
+	ERR_FAIL_COND_V_MSG(err != OK, Ref<GDScript>(), "Could not compile the benchmark script.");
+	return script;
+}
+
+static int _benchmark_code_size(const Ref<GDScript> &p_script, const StringName &p_func) {
+
+	const Map<StringName, GDScriptFunction *>::Element *E = p_script->get_member_functions().find(p_func);
+	return E ? E->get()->get_code_size() : 0;
+}
+
+MainLoop *test_benchmark() {
+
+	Ref<GDScript> plain = _benchmark_compile(false);
+	Ref<GDScript> script = _benchmark_compile(true);
+	if (plain.is_null() || script.is_null())
+		return NULL;
+
+	PoolRealArray values;
+	values.resize(10000);
+	{
+		PoolRealArray::Write w = values.write();
+		for (int i = 0; i < values.size(); i++) {
+			w[i] = i * 0.25;
+		}
+	}
+
+	struct Kernel {
+		const char *name;
+		Variant arg;
+		int calls;
+	} kernels[] = {
+		{ "vector_math", 10000, 20 },
+		{ "array_sum", values, 20 },
+		{ "string_build", 10000, 20 },
+		{ "int_loop", 100000, 20 },
+		{ "constant_branch", 100000, 20 },
+	};
+
+	GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+	bool was_enabled = language->is_jit_enabled();
+	uint32_t was_threshold = language->get_jit_threshold();
+	bool ok = true;
+
+	for (unsigned int i = 0; i < sizeof(kernels) / sizeof(kernels[0]); i++) {
+
+		const Kernel &kernel = kernels[i];
+		Variant unoptimized;
+		Variant interpreted;
+		Variant compiled;
+
+		language->set_jit_enabled(false);
+		uint64_t unoptimized_usec = _benchmark_run(plain.ptr(), kernel.name, kernel.arg, kernel.calls, unoptimized);
+		uint64_t interpreter_usec = _benchmark_run(script.ptr(), kernel.name, kernel.arg, kernel.calls, interpreted);
+
+		language->set_jit_enabled(true);
+		language->set_jit_threshold(1);
+		uint64_t jit_usec = _benchmark_run(script.ptr(), kernel.name, kernel.arg, kernel.calls, compiled);
+
+		print_line(String(kernel.name) + ": bytecode " + itos(_benchmark_code_size(plain, kernel.name)) + " -> " + itos(_benchmark_code_size(script, kernel.name)) + " words, unoptimized " + itos(unoptimized_usec) + " usec, interpreter " + itos(interpreter_usec) + " usec, jit " + itos(jit_usec) + " usec, speedup " + rtos(jit_usec ? (double)interpreter_usec / jit_usec : 0.0) + "x");
+
+		if (unoptimized != interpreted) {
+			print_line("\tFAIL: optimized bytecode returned " + String(interpreted) + ", expected " + String(unoptimized));
+			ok = false;
+		}
+		if (interpreted != compiled) {
+			print_line("\tFAIL: jit returned " + String(compiled) + ", expected " + String(interpreted));
+			ok = false;
+		}
+	}
+
+	language->set_jit_enabled(was_enabled);
+	language->set_jit_threshold(was_threshold);
+
+	print_line(ok ? "gd_benchmark: OK" : "gd_benchmark: FAILED");
+	if (!ok) {
+		OS::get_singleton()->set_exit_code(EXIT_FAILURE);
+	}
+
+	return NULL;
+}
 } // namespace TestGDScript
 
 #else
@@ -1095,6 +1253,11 @@ MainLoop *test(TestType p_type) {
 	ERR_PRINT("The GDScript module is disabled, therefore GDScript tests cannot be used.");
 	return NULL;
 }
+
+MainLoop *test_benchmark() {
+	ERR_PRINT("The GDScript module is disabled, therefore GDScript tests cannot be used.");
+	return NULL;
+}
 } // namespace TestGDScript
 
 #endif
@@ -43,6 +43,7 @@ enum TestType {
 };
 
 MainLoop *test(TestType p_type);
+MainLoop *test_benchmark();
 } // namespace TestGDScript
 
 #endif // TEST_GDSCRIPT_H
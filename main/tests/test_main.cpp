@@ -50,9 +50,18 @@ const char **tests_get_names() {
 	static const char *test_names[] = {
 		"string",
 		"math",
+		"math_kernels",
+		"mesh_simplifier",
 		"physics",
+		"physics_stack",
+		"physics_heightmap",
+		"physics_motion_batch",
 		"physics_2d",
+		"physics_2d_motion_batch",
+		"physics_2d_separation_cache",
 		"render",
+		"canvas_cull",
+		"occlusion_buffer",
 		"oa_hash_map",
 		"gui",
 		"shaderlang",
@@ -60,6 +69,7 @@ const char **tests_get_names() {
 		"gd_parser",
 		"gd_compiler",
 		"gd_bytecode",
+		"gd_benchmark",
 		"ordered_hash_map",
 		"astar",
 		NULL
@@ -80,21 +90,66 @@ MainLoop *test_main(String p_test, const List<String> &p_args) {
 		return TestMath::test();
 	}
 
+	if (p_test == "math_kernels") {
+
+		return TestMath::test_kernels();
+	}
+
+	if (p_test == "mesh_simplifier") {
+
+		return TestMath::test_mesh_simplifier();
+	}
+
 	if (p_test == "physics") {
 
 		return TestPhysics::test();
 	}
 
+	if (p_test == "physics_stack") {
+
+		return TestPhysics::test_stack();
+	}
+
+	if (p_test == "physics_heightmap") {
+
+		return TestPhysics::test_heightmap();
+	}
+
+	if (p_test == "physics_motion_batch") {
+
+		return TestPhysics::test_motion_batch();
+	}
+
 	if (p_test == "physics_2d") {
 
 		return TestPhysics2D::test();
 	}
 
+	if (p_test == "physics_2d_motion_batch") {
+
+		return TestPhysics2D::test_motion_batch();
+	}
+
+	if (p_test == "physics_2d_separation_cache") {
+
+		return TestPhysics2D::test_separation_cache();
+	}
+
 	if (p_test == "render") {
 
 		return TestRender::test();
 	}
 
+	if (p_test == "canvas_cull") {
+
+		return TestRender::test_canvas_cull();
+	}
+
+	if (p_test == "occlusion_buffer") {
+
+		return TestRender::test_occlusion_buffer();
+	}
+
 	if (p_test == "oa_hash_map") {
 
 		return TestOAHashMap::test();
@@ -132,6 +187,11 @@ MainLoop *test_main(String p_test, const List<String> &p_args) {
 		return TestGDScript::test(TestGDScript::TEST_BYTECODE);
 	}
 
+	if (p_test == "gd_benchmark") {
+
+		return TestGDScript::test_benchmark();
+	}
+
 	if (p_test == "ordered_hash_map") {
 
 		return TestOrderedHashMap::test();
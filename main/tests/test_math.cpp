@@ -33,6 +33,9 @@
 #include "core/math/basis.h"
 #include "core/math/camera_matrix.h"
 #include "core/math/math_funcs.h"
+#include "core/math/math_kernels.h"
+#include "core/math/mesh_simplifier.h"
+#include "core/math/random_pcg.h"
 #include "core/math/transform.h"
 #include "core/os/file_access.h"
 #include "core/os/keyboard.h"
@@ -560,7 +563,7 @@ MainLoop *test() {
 	{
 		Vector3 v(1, 2, 3);
 		v.normalize();
-		float a = 0.3;
+		real_t a = 0.3;
 
 		Basis m(v, a);
 
@@ -670,4 +673,345 @@ MainLoop *test() {
 
 	return NULL;
 }
+
+// Microbenchmarks comparing the bulk math kernels with the equivalent scalar loops.
+
+static const int KERNEL_BENCH_POINTS = 65536;
+static const int KERNEL_BENCH_TRANSFORMS = 4096;
+static const int KERNEL_BENCH_PASSES = 64;
+
+static Transform _bench_random_transform(RandomPCG &p_rng) {
+
+	Vector3 axis = Vector3(p_rng.random(-1.0f, 1.0f), p_rng.random(-1.0f, 1.0f), p_rng.random(-1.0f, 1.0f));
+	if (axis.length_squared() < CMP_EPSILON) {
+		axis = Vector3(0, 1, 0);
+	}
+
+	Transform t;
+	t.basis = Basis(axis.normalized(), p_rng.random(-Math_PI, Math_PI)).scaled(Vector3(1, 1, 1) * p_rng.random(0.5f, 2.0f));
+	t.origin = Vector3(p_rng.random(-100.0f, 100.0f), p_rng.random(-100.0f, 100.0f), p_rng.random(-100.0f, 100.0f));
+	return t;
+}
+
+static void _bench_report(const String &p_name, uint64_t p_scalar_usec, uint64_t p_kernel_usec, real_t p_error) {
+
+	print_line(p_name + ": scalar " + itos(p_scalar_usec) + " usec, kernel " + itos(p_kernel_usec) + " usec, speedup " + rtos(p_kernel_usec ? (double)p_scalar_usec / p_kernel_usec : 0.0) + "x, max error " + rtos(p_error));
+}
+
+static real_t _bench_error(const Transform &p_a, const Transform &p_b) {
+
+	real_t error = (p_a.origin - p_b.origin).length();
+	for (int i = 0; i < 3; i++) {
+		error = MAX(error, (p_a.basis[i] - p_b.basis[i]).length());
+	}
+	return error;
+}
+
+MainLoop *test_kernels() {
+
+	OS *os = OS::get_singleton();
+	RandomPCG rng(1234);
+
+	print_line("Math kernels: " + String(MathKernels::get_instruction_set_name()));
+
+	Vector<Vector3> points;
+	Vector<Vector3> scalar_out;
+	Vector<Vector3> kernel_out;
+	points.resize(KERNEL_BENCH_POINTS);
+	scalar_out.resize(KERNEL_BENCH_POINTS);
+	kernel_out.resize(KERNEL_BENCH_POINTS);
+
+	for (int i = 0; i < KERNEL_BENCH_POINTS; i++) {
+		points.write[i] = Vector3(rng.random(-50.0f, 50.0f), rng.random(-50.0f, 50.0f), rng.random(-50.0f, 50.0f));
+	}
+
+	const Vector3 *src = points.ptr();
+	Vector3 *sdst = scalar_out.ptrw();
+	Vector3 *kdst = kernel_out.ptrw();
+	Transform xform = _bench_random_transform(rng);
+
+	{
+		uint64_t begin = os->get_ticks_usec();
+		for (int pass = 0; pass < KERNEL_BENCH_PASSES; pass++) {
+			for (int i = 0; i < KERNEL_BENCH_POINTS; i++) {
+				sdst[i] = xform.xform(src[i]);
+			}
+		}
+		uint64_t scalar = os->get_ticks_usec() - begin;
+
+		begin = os->get_ticks_usec();
+		for (int pass = 0; pass < KERNEL_BENCH_PASSES; pass++) {
+			MathKernels::xform_points(xform, src, kdst, KERNEL_BENCH_POINTS);
+		}
+		uint64_t kernel = os->get_ticks_usec() - begin;
+
+		real_t error = 0;
+		for (int i = 0; i < KERNEL_BENCH_POINTS; i++) {
+			error = MAX(error, (sdst[i] - kdst[i]).length());
+		}
+		_bench_report("xform_points", scalar, kernel, error);
+	}
+
+	{
+		Basis normal_basis = xform.basis.inverse().transposed();
+
+		uint64_t begin = os->get_ticks_usec();
+		for (int pass = 0; pass < KERNEL_BENCH_PASSES; pass++) {
+			for (int i = 0; i < KERNEL_BENCH_POINTS; i++) {
+				sdst[i] = normal_basis.xform(src[i]).normalized();
+			}
+		}
+		uint64_t scalar = os->get_ticks_usec() - begin;
+
+		begin = os->get_ticks_usec();
+		for (int pass = 0; pass < KERNEL_BENCH_PASSES; pass++) {
+			MathKernels::xform_normals(xform.basis, src, kdst, KERNEL_BENCH_POINTS);
+		}
+		uint64_t kernel = os->get_ticks_usec() - begin;
+
+		real_t error = 0;
+		for (int i = 0; i < KERNEL_BENCH_POINTS; i++) {
+			error = MAX(error, (sdst[i] - kdst[i]).length());
+		}
+		_bench_report("xform_normals", scalar, kernel, error);
+	}
+
+	{
+		AABB scalar_aabb;
+		uint64_t begin = os->get_ticks_usec();
+		for (int pass = 0; pass < KERNEL_BENCH_PASSES; pass++) {
+			scalar_aabb = AABB(src[0], Vector3());
+			for (int i = 1; i < KERNEL_BENCH_POINTS; i++) {
+				scalar_aabb.expand_to(src[i]);
+			}
+		}
+		uint64_t scalar = os->get_ticks_usec() - begin;
+
+		AABB kernel_aabb;
+		begin = os->get_ticks_usec();
+		for (int pass = 0; pass < KERNEL_BENCH_PASSES; pass++) {
+			kernel_aabb = MathKernels::compute_aabb(src, KERNEL_BENCH_POINTS);
+		}
+		uint64_t kernel = os->get_ticks_usec() - begin;
+
+		real_t error = MAX((scalar_aabb.position - kernel_aabb.position).length(), (scalar_aabb.size - kernel_aabb.size).length());
+		_bench_report("compute_aabb", scalar, kernel, error);
+	}
+
+	Vector<Transform> transforms;
+	Vector<Transform> scalar_xforms;
+	Vector<Transform> kernel_xforms;
+	transforms.resize(KERNEL_BENCH_TRANSFORMS);
+	scalar_xforms.resize(KERNEL_BENCH_TRANSFORMS);
+	kernel_xforms.resize(KERNEL_BENCH_TRANSFORMS);
+
+	for (int i = 0; i < KERNEL_BENCH_TRANSFORMS; i++) {
+		transforms.write[i] = _bench_random_transform(rng);
+	}
+
+	const Transform *tsrc = transforms.ptr();
+	Transform *tsdst = scalar_xforms.ptrw();
+	Transform *tkdst = kernel_xforms.ptrw();
+
+	{
+		uint64_t begin = os->get_ticks_usec();
+		for (int pass = 0; pass < KERNEL_BENCH_PASSES; pass++) {
+			for (int i = 0; i < KERNEL_BENCH_TRANSFORMS; i++) {
+				tsdst[i] = xform * tsrc[i];
+			}
+		}
+		uint64_t scalar = os->get_ticks_usec() - begin;
+
+		begin = os->get_ticks_usec();
+		for (int pass = 0; pass < KERNEL_BENCH_PASSES; pass++) {
+			MathKernels::multiply_transforms(xform, tsrc, tkdst, KERNEL_BENCH_TRANSFORMS);
+		}
+		uint64_t kernel = os->get_ticks_usec() - begin;
+
+		real_t error = 0;
+		for (int i = 0; i < KERNEL_BENCH_TRANSFORMS; i++) {
+			error = MAX(error, _bench_error(tsdst[i], tkdst[i]));
+		}
+		_bench_report("multiply_transforms", scalar, kernel, error);
+	}
+
+	// Skinning palette, stored as rows like the renderer's skeletons.
+	const int bone_count = 64;
+	Vector<float> palette;
+	palette.resize(bone_count * 12);
+	for (int i = 0; i < bone_count; i++) {
+		MathKernels::multiply_to_rows(Transform(), tsrc[i], &palette.write[i * 12]);
+	}
+
+	Vector<int> bones;
+	Vector<float> weights;
+	Vector<float> scalar_rows;
+	Vector<float> kernel_rows;
+	bones.resize(KERNEL_BENCH_POINTS * 4);
+	weights.resize(KERNEL_BENCH_POINTS * 4);
+	scalar_rows.resize(KERNEL_BENCH_POINTS * 12);
+	kernel_rows.resize(KERNEL_BENCH_POINTS * 12);
+
+	for (int i = 0; i < KERNEL_BENCH_POINTS * 4; i++) {
+		bones.write[i] = rng.rand() % bone_count;
+		weights.write[i] = 0.25;
+	}
+
+	{
+		const float *pal = palette.ptr();
+		const int *b = bones.ptr();
+		const float *w = weights.ptr();
+		float *srows = scalar_rows.ptrw();
+		float *krows = kernel_rows.ptrw();
+
+		uint64_t begin = os->get_ticks_usec();
+		for (int pass = 0; pass < KERNEL_BENCH_PASSES; pass++) {
+			for (int i = 0; i < KERNEL_BENCH_POINTS; i++) {
+				float *row = &srows[i * 12];
+				for (int j = 0; j < 12; j++) {
+					row[j] = 0;
+				}
+				for (int k = 0; k < 4; k++) {
+					const float *bone = &pal[b[i * 4 + k] * 12];
+					for (int j = 0; j < 12; j++) {
+						row[j] += w[i * 4 + k] * bone[j];
+					}
+				}
+			}
+		}
+		uint64_t scalar = os->get_ticks_usec() - begin;
+
+		begin = os->get_ticks_usec();
+		for (int pass = 0; pass < KERNEL_BENCH_PASSES; pass++) {
+			for (int i = 0; i < KERNEL_BENCH_POINTS; i++) {
+				MathKernels::blend_palette_rows(pal, &b[i * 4], &w[i * 4], 4, &krows[i * 12]);
+			}
+		}
+		uint64_t kernel = os->get_ticks_usec() - begin;
+
+		real_t error = 0;
+		for (int i = 0; i < KERNEL_BENCH_POINTS * 12; i++) {
+			error = MAX(error, Math::abs(srows[i] - krows[i]));
+		}
+		_bench_report("blend_palette_rows", scalar, kernel, error);
+
+		// The blended rows double as multimesh instance transforms.
+		AABB mesh_aabb(Vector3(-1, -1, -1), Vector3(2, 2, 2));
+		AABB scalar_aabb;
+		begin = os->get_ticks_usec();
+		for (int pass = 0; pass < KERNEL_BENCH_PASSES; pass++) {
+			for (int i = 0; i < KERNEL_BENCH_POINTS; i++) {
+				const float *row = &srows[i * 12];
+				Transform t;
+				for (int j = 0; j < 3; j++) {
+					t.basis.elements[j] = Vector3(row[j * 4 + 0], row[j * 4 + 1], row[j * 4 + 2]);
+					t.origin[j] = row[j * 4 + 3];
+				}
+				AABB laabb = t.xform(mesh_aabb);
+				if (i == 0) {
+					scalar_aabb = laabb;
+				} else {
+					scalar_aabb.merge_with(laabb);
+				}
+			}
+		}
+		scalar = os->get_ticks_usec() - begin;
+
+		AABB kernel_aabb;
+		begin = os->get_ticks_usec();
+		for (int pass = 0; pass < KERNEL_BENCH_PASSES; pass++) {
+			kernel_aabb = MathKernels::xform_aabb_rows(mesh_aabb, srows, 12, KERNEL_BENCH_POINTS);
+		}
+		kernel = os->get_ticks_usec() - begin;
+
+		error = MAX((scalar_aabb.position - kernel_aabb.position).length(), (scalar_aabb.size - kernel_aabb.size).length());
+		_bench_report("xform_aabb_rows", scalar, kernel, error);
+	}
+
+	return NULL;
+}
+
+// Simplifies a closed sphere level by level, checking every level stays a valid
+// outward facing surface that only uses the original vertices.
+MainLoop *test_mesh_simplifier() {
+
+	OS *os = OS::get_singleton();
+
+	const int rings = 64;
+	const int segments = 128;
+
+	PoolVector<Vector3> vertices;
+	vertices.push_back(Vector3(0, 1, 0));
+	for (int r = 1; r < rings; r++) {
+		real_t phi = Math_PI * r / rings;
+		for (int s = 0; s < segments; s++) {
+			real_t theta = Math_PI * 2.0 * s / segments;
+			vertices.push_back(Vector3(Math::sin(phi) * Math::cos(theta), Math::cos(phi), Math::sin(phi) * Math::sin(theta)));
+		}
+	}
+	vertices.push_back(Vector3(0, -1, 0));
+	int bottom = vertices.size() - 1;
+
+	PoolVector<int> indices;
+	for (int r = 0; r < rings; r++) {
+		for (int s = 0; s < segments; s++) {
+
+			int a = r == 0 ? 0 : 1 + (r - 1) * segments + s;
+			int b = r == 0 ? 0 : 1 + (r - 1) * segments + (s + 1) % segments;
+			int c = r == rings - 1 ? bottom : 1 + r * segments + s;
+			int d = r == rings - 1 ? bottom : 1 + r * segments + (s + 1) % segments;
+
+			if (r > 0) {
+				indices.push_back(a);
+				indices.push_back(b);
+				indices.push_back(c);
+			}
+			if (r < rings - 1) {
+				indices.push_back(b);
+				indices.push_back(d);
+				indices.push_back(c);
+			}
+		}
+	}
+
+	bool ok = true;
+	PoolVector<int> current = indices;
+
+	for (int level = 0; level < 5; level++) {
+
+		float error = 0;
+		uint64_t begin = os->get_ticks_usec();
+		PoolVector<int> simplified = MeshSimplifier::simplify(vertices, current, current.size() / 6 * 3, 0.05, &error);
+		uint64_t elapsed = os->get_ticks_usec() - begin;
+
+		int bad = 0;
+		for (int i = 0; i < simplified.size(); i += 3) {
+
+			int a = simplified[i], b = simplified[i + 1], c = simplified[i + 2];
+			if (a < 0 || b < 0 || c < 0 || a > bottom || b > bottom || c > bottom || a == b || b == c || c == a) {
+				bad++;
+				continue;
+			}
+
+			Vector3 center = (vertices[a] + vertices[b] + vertices[c]) / 3.0;
+			if ((vertices[b] - vertices[a]).cross(vertices[c] - vertices[a]).dot(center) <= 0) {
+				bad++;
+			}
+		}
+
+		print_line("LOD " + itos(level + 1) + ": " + itos(current.size() / 3) + " -> " + itos(simplified.size() / 3) + " triangles, error " + rtos(error) + ", " + rtos(elapsed / 1000.0) + " msec");
+
+		if (bad || simplified.size() >= current.size() || error > 0.05) {
+			print_line("\tFAIL: " + itos(bad) + " bad triangles");
+			ok = false;
+			break;
+		}
+
+		current = simplified;
+	}
+
+	print_line(ok ? "Mesh simplifier: OK" : "Mesh simplifier: FAILED");
+
+	return NULL;
+}
 } // namespace TestMath
@@ -36,6 +36,8 @@
 namespace TestMath {
 
 MainLoop *test();
+MainLoop *test_kernels();
+MainLoop *test_mesh_simplifier();
 }
 
 #endif
@@ -36,6 +36,7 @@
 #include "core/os/main_loop.h"
 #include "core/os/os.h"
 #include "core/print_string.h"
+#include "servers/physics/shape_sw.h"
 #include "servers/physics_server.h"
 #include "servers/visual_server.h"
 
@@ -429,10 +430,234 @@ public:
 	}
 };
 
+class TestPhysicsStackMainLoop : public MainLoop {
+
+	GDCLASS(TestPhysicsStackMainLoop, MainLoop);
+
+	enum {
+		STACK_BASE = 12,
+		STACK_COLUMNS = 4,
+		STEP_COUNT = 600,
+	};
+
+	RID space;
+	RID box_shape;
+	RID plane_shape;
+	List<RID> bodies;
+
+public:
+	virtual void init() {
+
+		PhysicsServer *ps = PhysicsServer::get_singleton();
+
+		space = ps->space_create();
+		ps->space_set_active(space, true);
+
+		plane_shape = ps->shape_create(PhysicsServer::SHAPE_PLANE);
+		ps->shape_set_data(plane_shape, Plane(Vector3(0, 1, 0), 0));
+		RID ground = ps->body_create(PhysicsServer::BODY_MODE_STATIC);
+		ps->body_set_space(ground, space);
+		ps->body_add_shape(ground, plane_shape);
+		bodies.push_back(ground);
+
+		box_shape = ps->shape_create(PhysicsServer::SHAPE_BOX);
+		ps->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+
+		// Pyramids of boxes resting on each other, the worst case for the contact solver.
+		int box_count = 0;
+		for (int column = 0; column < STACK_COLUMNS; column++) {
+			for (int row = 0; row < STACK_BASE; row++) {
+				for (int i = 0; i < STACK_BASE - row; i++) {
+
+					Transform t;
+					t.origin = Vector3(i - (STACK_BASE - row) * 0.5 + 0.5, 0.5 + row, column * 3.0);
+
+					RID body = ps->body_create(PhysicsServer::BODY_MODE_RIGID);
+					ps->body_set_space(body, space);
+					ps->body_add_shape(body, box_shape);
+					ps->body_set_state(body, PhysicsServer::BODY_STATE_TRANSFORM, t);
+					bodies.push_back(body);
+					box_count++;
+				}
+			}
+		}
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+
+		for (int i = 0; i < STEP_COUNT; i++) {
+			ps->sync();
+			ps->flush_queries();
+			ps->step(1.0 / 60.0);
+		}
+
+		uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+		print_line("Stacked boxes: " + itos(box_count) + ", steps: " + itos(STEP_COUNT));
+		print_line("Total: " + rtos(elapsed / 1000.0) + " msec, per step: " + rtos(elapsed / 1000.0 / STEP_COUNT) + " msec");
+		print_line("Contact pairs: " + itos(ps->get_process_info(PhysicsServer::INFO_COLLISION_PAIRS)));
+	}
+
+	virtual bool iteration(float p_time) {
+
+		return true;
+	}
+
+	virtual bool idle(float p_time) {
+
+		return true;
+	}
+
+	virtual void finish() {
+
+		PhysicsServer *ps = PhysicsServer::get_singleton();
+
+		for (List<RID>::Element *E = bodies.front(); E; E = E->next()) {
+			ps->free(E->get());
+		}
+		ps->free(box_shape);
+		ps->free(plane_shape);
+		ps->free(space);
+	}
+};
+
 namespace TestPhysics {
 
 MainLoop *test() {
 
 	return memnew(TestPhysicsMainLoop);
 }
+
+MainLoop *test_stack() {
+
+	return memnew(TestPhysicsStackMainLoop);
+}
+
+MainLoop *test_heightmap() {
+
+	// An 8x8 height map sloping up along X, hit by rays cast straight down.
+	const int size = 8;
+	const real_t slope = 0.25;
+
+	PoolVector<real_t> heights;
+	heights.resize(size * size);
+	{
+		PoolVector<real_t>::Write w = heights.write();
+		for (int z = 0; z < size; z++) {
+			for (int x = 0; x < size; x++) {
+				w[z * size + x] = x * slope;
+			}
+		}
+	}
+
+	Dictionary data;
+	data["width"] = size;
+	data["depth"] = size;
+	data["heights"] = heights;
+
+	HeightMapShapeSW shape;
+	shape.set_data(data);
+
+	// The shape is centered on its origin in X and Z.
+	const real_t half = (size - 1) * 0.5;
+	const Vector3 expected_normal = Vector3(-slope, 1, 0).normalized();
+
+	int errors = 0;
+	for (int i = 0; i < 16; i++) {
+
+		Vector3 from((i % 4) * 1.7 - half + 0.3, 10, (i / 4) * 1.6 - half + 0.4);
+		Vector3 point, normal;
+		if (!shape.intersect_segment(from, from - Vector3(0, 20, 0), point, normal)) {
+			print_line("physics_heightmap: ERROR, ray " + itos(i) + " missed");
+			errors++;
+			continue;
+		}
+
+		real_t expected_height = (from.x + half) * slope;
+		if (Math::abs(point.y - expected_height) > CMP_EPSILON * 10 || normal.distance_to(expected_normal) > CMP_EPSILON * 10) {
+			print_line("physics_heightmap: ERROR, ray " + itos(i) + " hit " + String(point) + " with normal " + String(normal));
+			errors++;
+		}
+	}
+
+	print_line(errors ? "physics_heightmap: FAILED" : "physics_heightmap: OK");
+
+	return NULL;
+}
+MainLoop *test_motion_batch() {
+
+	PhysicsServer *ps = PhysicsServer::get_singleton();
+
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+
+	RID floor_shape = ps->shape_create(PhysicsServer::SHAPE_BOX);
+	ps->shape_set_data(floor_shape, Vector3(50, 1, 50));
+	RID floor = ps->body_create(PhysicsServer::BODY_MODE_STATIC);
+	ps->body_add_shape(floor, floor_shape);
+	ps->body_set_space(floor, space);
+
+	// Enough queries to take the parallel path; even ones fall onto the floor, odd ones slide along Z.
+	const int count = 16;
+	RID box_shape = ps->shape_create(PhysicsServer::SHAPE_BOX);
+	ps->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+
+	Vector<RID> bodies;
+	Vector<PhysicsServer::MotionQuery> queries;
+	for (int i = 0; i < count; i++) {
+
+		RID body = ps->body_create(PhysicsServer::BODY_MODE_KINEMATIC);
+		ps->body_add_shape(body, box_shape);
+		ps->body_set_space(body, space);
+
+		PhysicsServer::MotionQuery query;
+		query.body = body;
+		query.from.origin = Vector3(i * 3 - count * 1.5, 3, 0);
+		query.motion = (i % 2) ? Vector3(0, 0, 4) : Vector3(0, -5, 0);
+		ps->body_set_state(body, PhysicsServer::BODY_STATE_TRANSFORM, query.from);
+
+		bodies.push_back(body);
+		queries.push_back(query);
+	}
+
+	Vector<PhysicsServer::MotionResult> results;
+	results.resize(count);
+	Vector<bool> collided;
+	collided.resize(count);
+	int hits = ps->body_test_motion_batch(queries.ptr(), count, results.ptrw(), collided.ptrw());
+
+	int errors = 0;
+	if (hits != count / 2) {
+		print_line("physics_motion_batch: ERROR, " + itos(hits) + " motions collided");
+		errors++;
+	}
+
+	for (int i = 0; i < count; i++) {
+
+		const PhysicsServer::MotionQuery &q = queries[i];
+		PhysicsServer::MotionResult single;
+		bool single_collided = ps->body_test_motion(q.body, q.from, q.motion, q.infinite_inertia, &single, q.exclude_raycast_shapes);
+
+		const PhysicsServer::MotionResult &r = results[i];
+		if (collided[i] != single_collided || collided[i] == bool(i % 2) || r.motion.distance_to(single.motion) > CMP_EPSILON || r.remainder.distance_to(single.remainder) > CMP_EPSILON) {
+			print_line("physics_motion_batch: ERROR, motion " + itos(i) + " moved " + String(r.motion) + " instead of " + String(single.motion));
+			errors++;
+		}
+		if (single_collided && r.collider != floor) {
+			print_line("physics_motion_batch: ERROR, motion " + itos(i) + " hit the wrong collider");
+			errors++;
+		}
+	}
+
+	for (int i = 0; i < count; i++) {
+		ps->free(bodies[i]);
+	}
+	ps->free(box_shape);
+	ps->free(floor);
+	ps->free(floor_shape);
+	ps->free(space);
+
+	print_line(errors ? "physics_motion_batch: FAILED" : "physics_motion_batch: OK");
+
+	return NULL;
+}
 } // namespace TestPhysics
@@ -36,6 +36,9 @@
 namespace TestPhysics {
 
 MainLoop *test();
+MainLoop *test_stack();
+MainLoop *test_heightmap();
+MainLoop *test_motion_batch();
 }
 
 #endif
@@ -432,4 +432,151 @@ MainLoop *test() {
 
 	return memnew(TestPhysics2DMainLoop);
 }
+MainLoop *test_motion_batch() {
+
+	Physics2DServer *ps = Physics2DServer::get_singleton();
+
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+
+	RID floor_shape = ps->rectangle_shape_create();
+	ps->shape_set_data(floor_shape, Vector2(500, 10));
+	RID floor = ps->body_create();
+	ps->body_set_mode(floor, Physics2DServer::BODY_MODE_STATIC);
+	ps->body_add_shape(floor, floor_shape);
+	ps->body_set_space(floor, space);
+
+	// Enough queries to take the parallel path; even ones fall onto the floor, odd ones move up.
+	const int count = 16;
+	RID box_shape = ps->rectangle_shape_create();
+	ps->shape_set_data(box_shape, Vector2(8, 8));
+
+	Vector<RID> bodies;
+	Vector<Physics2DServer::MotionQuery> queries;
+	for (int i = 0; i < count; i++) {
+
+		RID body = ps->body_create();
+		ps->body_set_mode(body, Physics2DServer::BODY_MODE_KINEMATIC);
+		ps->body_add_shape(body, box_shape);
+		ps->body_set_space(body, space);
+
+		Physics2DServer::MotionQuery query;
+		query.body = body;
+		query.from.elements[2] = Vector2(i * 30 - count * 15, -50);
+		query.motion = (i % 2) ? Vector2(0, -100) : Vector2(0, 100);
+		ps->body_set_state(body, Physics2DServer::BODY_STATE_TRANSFORM, query.from);
+
+		bodies.push_back(body);
+		queries.push_back(query);
+	}
+
+	Vector<Physics2DServer::MotionResult> results;
+	results.resize(count);
+	Vector<bool> collided;
+	collided.resize(count);
+	int hits = ps->body_test_motion_batch(queries.ptr(), count, results.ptrw(), collided.ptrw());
+
+	int errors = 0;
+	if (hits != count / 2) {
+		print_line("physics_2d_motion_batch: ERROR, " + itos(hits) + " motions collided");
+		errors++;
+	}
+
+	for (int i = 0; i < count; i++) {
+
+		const Physics2DServer::MotionQuery &q = queries[i];
+		Physics2DServer::MotionResult single;
+		bool single_collided = ps->body_test_motion(q.body, q.from, q.motion, q.infinite_inertia, q.margin, &single, q.exclude_raycast_shapes);
+
+		const Physics2DServer::MotionResult &r = results[i];
+		if (collided[i] != single_collided || collided[i] == bool(i % 2) || r.motion.distance_to(single.motion) > CMP_EPSILON || r.remainder.distance_to(single.remainder) > CMP_EPSILON) {
+			print_line("physics_2d_motion_batch: ERROR, motion " + itos(i) + " moved " + String(r.motion) + " instead of " + String(single.motion));
+			errors++;
+		}
+		if (single_collided && r.collider != floor) {
+			print_line("physics_2d_motion_batch: ERROR, motion " + itos(i) + " hit the wrong collider");
+			errors++;
+		}
+	}
+
+	for (int i = 0; i < count; i++) {
+		ps->free(bodies[i]);
+	}
+	ps->free(box_shape);
+	ps->free(floor);
+	ps->free(floor_shape);
+	ps->free(space);
+
+	print_line(errors ? "physics_2d_motion_batch: FAILED" : "physics_2d_motion_batch: OK");
+
+	return NULL;
+}
+MainLoop *test_separation_cache() {
+
+	Physics2DServer *ps = Physics2DServer::get_singleton();
+	const real_t step = 1.0 / 60.0;
+
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+
+	// Two circles whose bounds overlap while the shapes are 2.6 units apart,
+	// so the pair exists and caches its separating gap.
+	RID static_shape = ps->circle_shape_create();
+	ps->shape_set_data(static_shape, 10);
+	RID static_body = ps->body_create();
+	ps->body_set_mode(static_body, Physics2DServer::BODY_MODE_STATIC);
+	ps->body_add_shape(static_body, static_shape);
+	ps->body_set_space(static_body, space);
+
+	RID shape = ps->circle_shape_create();
+	ps->shape_set_data(shape, 10);
+	RID body = ps->body_create();
+	ps->body_add_shape(body, shape);
+	ps->body_set_param(body, Physics2DServer::BODY_PARAM_GRAVITY_SCALE, 0);
+	ps->body_set_state(body, Physics2DServer::BODY_STATE_CAN_SLEEP, false);
+	ps->body_set_state(body, Physics2DServer::BODY_STATE_TRANSFORM, Transform2D(0, Vector2(16, 16)));
+	ps->body_set_space(body, space);
+
+	int errors = 0;
+
+	for (int i = 0; i < 10; i++) {
+		ps->step(step);
+	}
+
+	// Growing the static circle without moving anything must not reuse the cached gap.
+	ps->shape_set_data(static_shape, 14);
+	for (int i = 0; i < 30; i++) {
+		ps->step(step);
+	}
+
+	Vector2 pos = Transform2D(ps->body_get_state(body, Physics2DServer::BODY_STATE_TRANSFORM)).get_origin();
+	if (pos.length() < Vector2(16, 16).length() + 0.5) {
+		print_line("physics_2d_separation_cache: ERROR, overlap after a shape change was not resolved, body at " + String(pos));
+		errors++;
+	}
+
+	// A body closing the cached gap must still collide instead of passing through.
+	ps->shape_set_data(static_shape, 10);
+	ps->body_set_state(body, Physics2DServer::BODY_STATE_TRANSFORM, Transform2D(0, Vector2(16, 16)));
+	ps->body_set_state(body, Physics2DServer::BODY_STATE_LINEAR_VELOCITY, Vector2(-30, -30));
+	for (int i = 0; i < 60; i++) {
+		ps->step(step);
+	}
+
+	pos = Transform2D(ps->body_get_state(body, Physics2DServer::BODY_STATE_TRANSFORM)).get_origin();
+	if (pos.length() < 19 || pos.x < 0 || pos.y < 0) {
+		print_line("physics_2d_separation_cache: ERROR, approaching body was not stopped, body at " + String(pos));
+		errors++;
+	}
+
+	ps->free(body);
+	ps->free(shape);
+	ps->free(static_body);
+	ps->free(static_shape);
+	ps->free(space);
+
+	print_line(errors ? "physics_2d_separation_cache: FAILED" : "physics_2d_separation_cache: OK");
+
+	return NULL;
+}
 } // namespace TestPhysics2D
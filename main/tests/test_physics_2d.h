@@ -36,6 +36,8 @@
 namespace TestPhysics2D {
 
 MainLoop *test();
+MainLoop *test_motion_batch();
+MainLoop *test_separation_cache();
 }
 
 #endif // TEST_PHYSICS_2D_H
@@ -36,6 +36,10 @@
 #include "core/os/main_loop.h"
 #include "core/os/os.h"
 #include "core/print_string.h"
+#include "drivers/dummy/rasterizer_dummy.h"
+#include "servers/visual/occlusion_buffer.h"
+#include "servers/visual/visual_server_canvas.h"
+#include "servers/visual/visual_server_globals.h"
 #include "servers/visual_server.h"
 
 #define OBJECT_COUNT 50
@@ -242,4 +246,234 @@ MainLoop *test() {
 
 	return memnew(TestMainLoop);
 }
+
+class CanvasCullCounter : public RasterizerCanvasDummy {
+public:
+	int drawn;
+
+	void canvas_render_items(Item *p_item_list, int p_z, const Color &p_modulate, Light *p_light, const Transform2D &p_transform) {
+		for (Item *ci = p_item_list; ci; ci = ci->next) {
+			drawn++;
+		}
+	}
+
+	CanvasCullCounter() { drawn = 0; }
+};
+
+// Renders a scrolling view over a large 2D world with and without the
+// canvas spatial index, using a counting rasterizer so only culling is timed.
+static void _canvas_cull_run(VisualServerCanvas *p_canvas, CanvasCullCounter *p_counter, RID p_canvas_rid, const Vector<RID> &p_moving, bool p_index, const String &p_label, int &r_drawn) {
+
+	OS *os = OS::get_singleton();
+	const int frames = 60;
+	const Rect2 clip(0, 0, 1024, 600);
+
+	p_canvas->canvas_set_use_spatial_index(p_canvas_rid, p_index);
+	VisualServerCanvas::Canvas *canvas = p_canvas->canvas_owner.getornull(p_canvas_rid);
+
+	p_counter->drawn = 0;
+	uint64_t begin = os->get_ticks_usec();
+
+	for (int f = 0; f < frames; f++) {
+		for (int i = 0; i < p_moving.size(); i++) {
+			p_canvas->canvas_item_set_transform(p_moving[i], Transform2D(0, Vector2((i * 37 + f * 5) % 12800, (i * 53 + f * 3) % 8000)));
+		}
+		Transform2D view(0, Vector2(-f * 180.0, -f * 110.0));
+		p_canvas->render_canvas(canvas, view, NULL, NULL, clip);
+	}
+
+	uint64_t elapsed = os->get_ticks_usec() - begin;
+	r_drawn = p_counter->drawn;
+	print_line(p_label + (p_index ? " indexed: " : " linear:  ") + rtos(elapsed / (1000.0 * frames)) + " ms/frame, " + itos(r_drawn / frames) + " items drawn/frame");
+}
+
+MainLoop *test_canvas_cull() {
+
+	VisualServerCanvas *vs_canvas = memnew(VisualServerCanvas);
+	CanvasCullCounter *counter = memnew(CanvasCullCounter);
+	RasterizerCanvas *prev_render = VSG::canvas_render;
+	VSG::canvas_render = counter;
+
+	const int tiles_x = 400;
+	const int tiles_y = 250;
+	const int chunk = 25;
+	const float tile_size = 32;
+
+	for (int layout = 0; layout < 2; layout++) {
+
+		bool nested = layout == 1;
+		Vector<RID> rids;
+		Vector<RID> moving;
+
+		RID canvas_rid = vs_canvas->canvas_create();
+		RID root = vs_canvas->canvas_item_create();
+		vs_canvas->canvas_item_set_parent(root, canvas_rid);
+		rids.push_back(root);
+
+		HashMap<int, RID> chunks;
+
+		for (int y = 0; y < tiles_y; y++) {
+			for (int x = 0; x < tiles_x; x++) {
+
+				RID parent = root;
+				Vector2 origin;
+				if (nested) {
+					int key = (y / chunk) * (tiles_x / chunk) + x / chunk;
+					origin = Vector2(x / chunk, y / chunk) * chunk * tile_size;
+					if (!chunks.has(key)) {
+						RID c = vs_canvas->canvas_item_create();
+						vs_canvas->canvas_item_set_parent(c, root);
+						vs_canvas->canvas_item_set_transform(c, Transform2D(0, origin));
+						chunks[key] = c;
+						rids.push_back(c);
+					}
+					parent = chunks[key];
+				}
+
+				RID item = vs_canvas->canvas_item_create();
+				vs_canvas->canvas_item_set_parent(item, parent);
+				vs_canvas->canvas_item_set_transform(item, Transform2D(0, Vector2(x, y) * tile_size - origin));
+				vs_canvas->canvas_item_add_rect(item, Rect2(0, 0, tile_size, tile_size), Color(1, 1, 1));
+				rids.push_back(item);
+			}
+		}
+
+		for (int i = 0; i < 500; i++) {
+			RID item = vs_canvas->canvas_item_create();
+			vs_canvas->canvas_item_set_parent(item, root);
+			vs_canvas->canvas_item_add_rect(item, Rect2(0, 0, 16, 16), Color(1, 0, 0));
+			moving.push_back(item);
+			rids.push_back(item);
+		}
+
+		String label = nested ? "canvas_cull nested" : "canvas_cull flat";
+		int drawn_linear = 0;
+		int drawn_indexed = 0;
+		_canvas_cull_run(vs_canvas, counter, canvas_rid, moving, false, label, drawn_linear);
+		_canvas_cull_run(vs_canvas, counter, canvas_rid, moving, true, label, drawn_indexed);
+
+		if (drawn_linear != drawn_indexed) {
+			print_line("canvas_cull: ERROR, indexed culling drew " + itos(drawn_indexed) + " items, expected " + itos(drawn_linear));
+		}
+
+		for (int i = rids.size() - 1; i >= 0; i--) {
+			vs_canvas->free(rids[i]);
+		}
+		vs_canvas->free(canvas_rid);
+	}
+
+	VSG::canvas_render = prev_render;
+	memdelete(counter);
+	memdelete(vs_canvas);
+
+	return NULL;
+}
+
+MainLoop *test_occlusion_buffer() {
+
+	OcclusionBuffer buffer;
+	buffer.set_size(256, 144);
+
+	CameraMatrix projection;
+	projection.set_perspective(70, 256.0 / 144.0, 0.05, 500);
+
+	// A 20x20 wall in front of the camera, and a ground plane that crosses the near plane.
+	const Vector3 quad[4] = { Vector3(-10, -10, 0), Vector3(10, -10, 0), Vector3(10, 10, 0), Vector3(-10, 10, 0) };
+	const Vector3 ground[4] = { Vector3(-50, -2, 5), Vector3(50, -2, 5), Vector3(50, -2, -50), Vector3(-50, -2, -50) };
+	const int indices[6] = { 0, 1, 2, 0, 2, 3 };
+	Vector<int> neighbors;
+	OcclusionBuffer::get_coplanar_neighbors(quad, 4, indices, 6, neighbors);
+
+	buffer.begin(projection, Transform());
+	buffer.add_occluder(Transform(Basis(), Vector3(0, 0, -10)), quad, 4, indices, 6, neighbors.ptr());
+	buffer.add_occluder(Transform(), ground, 4, indices, 6, neighbors.ptr());
+	for (int i = 0; i < buffer.get_band_count(); i++) {
+		buffer.rasterize_band(i);
+	}
+	buffer.finish();
+
+	struct Case {
+		AABB aabb;
+		bool occluded;
+		const char *name;
+	};
+
+	const Case cases[] = {
+		{ AABB(Vector3(-1, 0, -21), Vector3(2, 2, 2)), true, "behind wall" },
+		{ AABB(Vector3(-8, -8, -30), Vector3(16, 16, 2)), true, "large, behind wall" },
+		{ AABB(Vector3(-1, -6, -8), Vector3(2, 2, 2)), true, "under ground" },
+		{ AABB(Vector3(-1, 0, -8), Vector3(2, 2, 2)), false, "in front of wall" },
+		{ AABB(Vector3(-1, 0, -11), Vector3(2, 2, 2)), false, "crossing wall" },
+		{ AABB(Vector3(30, 0, -21), Vector3(2, 2, 2)), false, "beside wall" },
+		{ AABB(Vector3(-40, -8, -30), Vector3(16, 16, 2)), false, "past wall edge" },
+		{ AABB(Vector3(19.8, -0.2, -20.5), Vector3(0.22, 0.4, 0.5)), false, "less than a texel past wall edge" },
+		{ AABB(Vector3(-1, -1.5, -8), Vector3(2, 2, 2)), false, "on ground" },
+		{ AABB(Vector3(-1, -1, -1), Vector3(2, 2, 2)), false, "around camera" },
+	};
+
+	int errors = 0;
+	for (unsigned int i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+		if (buffer.is_occluded(cases[i].aabb) != cases[i].occluded) {
+			print_line("occlusion_buffer: ERROR, wrong result for box " + String(cases[i].name));
+			errors++;
+		}
+	}
+
+	// City blocks: a grid of buildings, each a box occluder with props behind its walls.
+	const Vector3 box[8] = {
+		Vector3(-1, 0, -1), Vector3(1, 0, -1), Vector3(1, 0, 1), Vector3(-1, 0, 1),
+		Vector3(-1, 1, -1), Vector3(1, 1, -1), Vector3(1, 1, 1), Vector3(-1, 1, 1)
+	};
+	const int box_indices[36] = {
+		0, 1, 2, 0, 2, 3, 4, 6, 5, 4, 7, 6,
+		0, 4, 5, 0, 5, 1, 1, 5, 6, 1, 6, 2,
+		2, 6, 7, 2, 7, 3, 3, 7, 4, 3, 4, 0
+	};
+
+	Vector<int> box_neighbors;
+	OcclusionBuffer::get_coplanar_neighbors(box, 8, box_indices, 36, box_neighbors);
+
+	Transform camera(Basis(Vector3(1, 0, 0), -0.1), Vector3(0, 2, 10));
+	const int blocks = 20;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+
+	buffer.begin(projection, camera);
+	for (int x = 0; x < blocks; x++) {
+		for (int z = 0; z < blocks; z++) {
+			Transform xform(Basis().scaled(Vector3(8, 20, 8)), Vector3((x - blocks / 2) * 24, 0, -z * 24));
+			buffer.add_occluder(xform, box, 8, box_indices, 36, box_neighbors.ptr());
+		}
+	}
+	for (int i = 0; i < buffer.get_band_count(); i++) {
+		buffer.rasterize_band(i);
+	}
+	buffer.finish();
+
+	uint64_t raster_time = OS::get_singleton()->get_ticks_usec() - begin;
+
+	int tested = 0;
+	int occluded = 0;
+	for (int x = 0; x < blocks * 6; x++) {
+		for (int z = 0; z < blocks * 6; z++) {
+			tested++;
+			if (buffer.is_occluded(AABB(Vector3((x - blocks * 3) * 4 + 1, 0, -z * 4 + 1), Vector3(2, 2, 2)))) {
+				occluded++;
+			}
+		}
+	}
+
+	uint64_t test_time = OS::get_singleton()->get_ticks_usec() - begin - raster_time;
+
+	print_line("occlusion_buffer: " + itos(buffer.get_triangle_count()) + " triangles drawn in " + itos(raster_time) + " usec, " + itos(occluded) + " of " + itos(tested) + " boxes occluded, tested in " + itos(test_time) + " usec");
+
+	if (occluded == 0) {
+		print_line("occlusion_buffer: ERROR, nothing was occluded behind the city blocks");
+		errors++;
+	}
+
+	print_line(errors ? "occlusion_buffer: FAILED" : "occlusion_buffer: OK");
+
+	return NULL;
+}
+
 } // namespace TestRender
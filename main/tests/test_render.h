@@ -36,6 +36,8 @@
 namespace TestRender {
 
 MainLoop *test();
+MainLoop *test_canvas_cull();
+MainLoop *test_occlusion_buffer();
 }
 
 #endif
@@ -37,6 +37,7 @@
 #include "core/os/file_access.h"
 #include "core/os/os.h"
 #include "core/project_settings.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_compiler.h"
 
 ///////////////////////////
@@ -552,6 +553,18 @@ Error GDScript::reload(bool p_keep_state) {
 
 	ERR_FAIL_COND_V(!p_keep_state && has_instances, ERR_ALREADY_IN_USE);
 
+	if (source.find("%BASE%") != -1) {
+		//loading a template, don't parse
+		return OK;
+	}
+
+	GDScriptParser parser;
+	Error err = _parse(parser);
+	return _compile(parser, err, p_keep_state);
+}
+
+Error GDScript::_parse(GDScriptParser &r_parser) const {
+
 	String basedir = path;
 
 	if (basedir == "")
@@ -560,26 +573,30 @@ Error GDScript::reload(bool p_keep_state) {
 	if (basedir != "")
 		basedir = basedir.get_base_dir();
 
-	if (source.find("%BASE%") != -1) {
-		//loading a template, don't parse
-		return OK;
-	}
+	return r_parser.parse(source, basedir, false, path);
+}
+
+Error GDScript::_compile(GDScriptParser &p_parser, Error p_parse_error, bool p_keep_state) {
 
 	valid = false;
-	GDScriptParser parser;
-	Error err = parser.parse(source, basedir, false, path);
-	if (err) {
+
+	dependencies.clear();
+	for (const List<String>::Element *E = p_parser.get_dependencies().front(); E; E = E->next()) {
+		dependencies.insert(E->get());
+	}
+
+	if (p_parse_error) {
 		if (ScriptDebugger::get_singleton()) {
-			GDScriptLanguage::get_singleton()->debug_break_parse(get_path(), parser.get_error_line(), "Parser Error: " + parser.get_error());
+			GDScriptLanguage::get_singleton()->debug_break_parse(get_path(), p_parser.get_error_line(), "Parser Error: " + p_parser.get_error());
 		}
-		_err_print_error("GDScript::reload", path.empty() ? "built-in" : (const char *)path.utf8().get_data(), parser.get_error_line(), ("Parse Error: " + parser.get_error()).utf8().get_data(), ERR_HANDLER_SCRIPT);
+		_err_print_error("GDScript::reload", path.empty() ? "built-in" : (const char *)path.utf8().get_data(), p_parser.get_error_line(), ("Parse Error: " + p_parser.get_error()).utf8().get_data(), ERR_HANDLER_SCRIPT);
 		ERR_FAIL_V(ERR_PARSE_ERROR);
 	}
 
-	bool can_run = ScriptServer::is_scripting_enabled() || parser.is_tool_script();
+	bool can_run = ScriptServer::is_scripting_enabled() || p_parser.is_tool_script();
 
 	GDScriptCompiler compiler;
-	err = compiler.compile(&parser, this, p_keep_state);
+	Error err = compiler.compile(&p_parser, this, p_keep_state);
 
 	if (err) {
 
@@ -594,7 +611,7 @@ Error GDScript::reload(bool p_keep_state) {
 		}
 	}
 #ifdef DEBUG_ENABLED
-	for (const List<GDScriptWarning>::Element *E = parser.get_warnings().front(); E; E = E->next()) {
+	for (const List<GDScriptWarning>::Element *E = p_parser.get_warnings().front(); E; E = E->next()) {
 		const GDScriptWarning &warning = E->get();
 		if (ScriptDebugger::get_singleton()) {
 			Vector<ScriptLanguage::StackInfo> si;
@@ -762,6 +779,24 @@ Error GDScript::load_byte_code(const String &p_path) {
 	ERR_FAIL_COND_V(bytecode.size() == 0, ERR_PARSE_ERROR);
 	path = p_path;
 
+	if (GDScriptBytecodeCache::is_compiled_buffer(bytecode)) {
+
+		Vector<uint8_t> tokens;
+		if (GDScriptBytecodeCache::load_buffer(this, bytecode, tokens) == OK) {
+
+			valid = true;
+			for (Map<StringName, Ref<GDScript> >::Element *E = subclasses.front(); E; E = E->next()) {
+
+				_set_subclass_path(E->get(), path);
+			}
+			return OK;
+		}
+
+		// Engine or project changed since export, compile from the embedded tokens instead.
+		bytecode = tokens;
+		ERR_FAIL_COND_V(bytecode.size() == 0, ERR_PARSE_ERROR);
+	}
+
 	String basedir = path;
 
 	if (basedir == "")
@@ -947,6 +982,10 @@ void GDScript::_save_orphaned_subclasses() {
 }
 
 GDScript::~GDScript() {
+	if (GDScriptLanguage::get_singleton()) {
+		GDScriptLanguage::get_singleton()->invalidate_inline_caches();
+	}
+
 	for (Map<StringName, GDScriptFunction *>::Element *E = member_functions.front(); E; E = E->next()) {
 		memdelete(E->get());
 	}
@@ -1468,6 +1507,16 @@ Error GDScriptLanguage::execute_file(const String &p_path) {
 	return OK;
 }
 void GDScriptLanguage::finish() {
+
+#ifdef DEBUG_ENABLED
+	if (reload_pool) {
+		reload_pool->finish();
+		memdelete(reload_pool);
+		reload_pool = NULL;
+	}
+#endif
+
+	GDScriptFramePool::clear();
 }
 
 void GDScriptLanguage::profiling_start() {
@@ -1596,6 +1645,180 @@ struct GDScriptDepSort {
 	}
 };
 
+#ifdef DEBUG_ENABLED
+
+void GDScriptLanguage::_reload_parse(uint32_t p_index, ReloadParse *p_parses) {
+
+	ReloadParse &parse = p_parses[p_index];
+	parse.error = parse.script->_parse(*parse.parser);
+}
+
+static void _add_reload_dependency(const String &p_path, int p_self, const Map<String, int> &p_indices, Vector<int> &r_dependencies) {
+
+	const Map<String, int>::Element *E = p_indices.find(p_path);
+	if (E && E->get() != p_self && r_dependencies.find(E->get()) == -1) {
+		r_dependencies.push_back(E->get());
+	}
+}
+
+void GDScriptLanguage::_reload_scripts(const List<Ref<GDScript> > &p_scripts, bool p_keep_state) {
+
+	Vector<Ref<GDScript> > scripts;
+	Map<String, int> indices;
+	for (const List<Ref<GDScript> >::Element *E = p_scripts.front(); E; E = E->next()) {
+		if (E->get()->source.find("%BASE%") != -1) {
+			continue; // templates aren't parsed
+		}
+		indices[E->get()->get_path()] = scripts.size();
+		scripts.push_back(E->get());
+	}
+
+	// Dependencies from the last parse, refreshed by every parse below since the source may have changed.
+	Vector<Vector<int> > dependencies;
+	dependencies.resize(scripts.size());
+	for (int i = 0; i < scripts.size(); i++) {
+		const GDScript *script = scripts[i].ptr();
+		for (const Set<String>::Element *E = script->dependencies.front(); E; E = E->next()) {
+			_add_reload_dependency(E->get(), i, indices, dependencies.write[i]);
+		}
+		if (script->base.is_valid()) {
+			_add_reload_dependency(script->base->get_path(), i, indices, dependencies.write[i]);
+		}
+	}
+
+	Vector<bool> compiled;
+	Vector<bool> cache_only;
+	compiled.resize(scripts.size());
+	cache_only.resize(scripts.size());
+	for (int i = 0; i < scripts.size(); i++) {
+		compiled.write[i] = false;
+		cache_only.write[i] = true;
+	}
+
+	if (!reload_pool && scripts.size() > 1) {
+		reload_pool = memnew(ThreadWorkPool);
+		reload_pool->init();
+	}
+
+	// Scripts whose dependencies are compiled already are parsed in parallel and then compiled
+	// one by one. Worker threads only see cached resources, a script that has to load something
+	// is parsed again on this thread, and one that gained a dependency waits for it.
+	int remaining = scripts.size();
+	while (remaining > 0) {
+
+		Vector<ReloadParse> parses;
+		Vector<ReloadParse> serial_parses;
+		for (int i = 0; i < scripts.size(); i++) {
+			if (compiled[i]) {
+				continue;
+			}
+			bool ready = true;
+			for (int j = 0; j < dependencies[i].size(); j++) {
+				if (!compiled[dependencies[i][j]]) {
+					ready = false;
+					break;
+				}
+			}
+			if (ready) {
+				ReloadParse parse;
+				parse.script = scripts[i];
+				parse.parser = memnew(GDScriptParser);
+				parse.parser->set_cache_only(cache_only[i]);
+				parse.error = OK;
+				parse.index = i;
+				if (cache_only[i]) {
+					parses.push_back(parse);
+				} else {
+					serial_parses.push_back(parse);
+				}
+			}
+		}
+
+		// Only cyclic dependencies left, the first script is compiled against what the others have now.
+		bool forced = parses.empty() && serial_parses.empty();
+		if (forced) {
+			for (int i = 0; i < scripts.size(); i++) {
+				if (!compiled[i]) {
+					ReloadParse parse;
+					parse.script = scripts[i];
+					parse.parser = memnew(GDScriptParser);
+					parse.error = OK;
+					parse.index = i;
+					serial_parses.push_back(parse);
+					break;
+				}
+			}
+		}
+
+		if (parses.size()) {
+			if (reload_pool) {
+				reload_pool->do_work(parses.size(), this, &GDScriptLanguage::_reload_parse, parses.ptrw());
+			} else {
+				_reload_parse(0, parses.ptrw());
+			}
+		}
+		for (int i = 0; i < serial_parses.size(); i++) {
+			_reload_parse(i, serial_parses.ptrw());
+			parses.push_back(serial_parses[i]);
+		}
+
+		// Decide against the compiled state the scripts were parsed with.
+		Vector<bool> accepted;
+		accepted.resize(parses.size());
+		for (int i = 0; i < parses.size(); i++) {
+
+			const ReloadParse &parse = parses[i];
+			accepted.write[i] = forced;
+			if (forced) {
+				continue;
+			}
+
+			if (parse.parser->has_uncached_dependency()) {
+				cache_only.write[parse.index] = false;
+				continue;
+			}
+
+			Vector<int> fresh_dependencies;
+			for (const List<String>::Element *E = parse.parser->get_dependencies().front(); E; E = E->next()) {
+				_add_reload_dependency(E->get(), parse.index, indices, fresh_dependencies);
+			}
+			dependencies.write[parse.index] = fresh_dependencies;
+
+			bool ready = true;
+			for (int j = 0; j < fresh_dependencies.size(); j++) {
+				if (!compiled[fresh_dependencies[j]]) {
+					ready = false;
+					break;
+				}
+			}
+			accepted.write[i] = ready;
+		}
+
+		for (int i = 0; i < parses.size(); i++) {
+
+			ReloadParse &parse = parses.write[i];
+			if (accepted[i]) {
+				print_verbose("GDScript: Reloading: " + parse.script->get_path());
+
+				if (lock) {
+					lock->lock();
+				}
+				bool keep_state = p_keep_state || parse.script->instances.size(); // dependents still in use
+				if (lock) {
+					lock->unlock();
+				}
+
+				parse.script->_compile(*parse.parser, parse.error, keep_state);
+				compiled.write[parse.index] = true;
+				remaining--;
+			}
+			memdelete(parse.parser);
+		}
+	}
+}
+
+#endif
+
 void GDScriptLanguage::reload_all_scripts() {
 
 #ifdef DEBUG_ENABLED
@@ -1621,14 +1844,41 @@ void GDScriptLanguage::reload_all_scripts() {
 
 	//as scripts are going to be reloaded, must proceed without locking here
 
-	scripts.sort_custom<GDScriptDepSort>(); //update in inheritance dependency order
-
+	// Only scripts that changed on disk or failed to compile, and the scripts depending on them.
+	Set<String> outdated;
 	for (List<Ref<GDScript> >::Element *E = scripts.front(); E; E = E->next()) {
-
-		print_verbose("GDScript: Reloading: " + E->get()->get_path());
+		String old_source = E->get()->get_source_code();
 		E->get()->load_source_code(E->get()->get_path());
-		E->get()->reload(true);
+		if (!E->get()->is_valid() || E->get()->get_source_code() != old_source) {
+			outdated.insert(E->get()->get_path());
+		}
+	}
+
+	bool grown = !outdated.empty();
+	while (grown) {
+		grown = false;
+		for (List<Ref<GDScript> >::Element *E = scripts.front(); E; E = E->next()) {
+			if (outdated.has(E->get()->get_path())) {
+				continue;
+			}
+			for (Set<String>::Element *F = E->get()->dependencies.front(); F; F = F->next()) {
+				if (outdated.has(F->get())) {
+					outdated.insert(E->get()->get_path());
+					grown = true;
+					break;
+				}
+			}
+		}
+	}
+
+	List<Ref<GDScript> > to_reload;
+	for (List<Ref<GDScript> >::Element *E = scripts.front(); E; E = E->next()) {
+		if (outdated.has(E->get()->get_path())) {
+			to_reload.push_back(E->get());
+		}
 	}
+
+	_reload_scripts(to_reload, true);
 #endif
 }
 
@@ -1663,16 +1913,43 @@ void GDScriptLanguage::reload_tool_script(const Ref<Script> &p_script, bool p_so
 
 	scripts.sort_custom<GDScriptDepSort>(); //update in inheritance dependency order
 
+	// Besides inheriting scripts, those preloading it or naming it by class_name are reloaded too.
+	Set<String> reload_paths;
+	if (p_script.is_valid()) {
+		reload_paths.insert(p_script->get_path());
+	}
+
+	bool grown = true;
+	while (grown) {
+		grown = false;
+		for (List<Ref<GDScript> >::Element *E = scripts.front(); E; E = E->next()) {
+			if (reload_paths.has(E->get()->get_path())) {
+				continue;
+			}
+			for (Set<String>::Element *F = E->get()->dependencies.front(); F; F = F->next()) {
+				if (reload_paths.has(F->get())) {
+					reload_paths.insert(E->get()->get_path());
+					grown = true;
+					break;
+				}
+			}
+		}
+	}
+
+	List<Ref<GDScript> > reload_order;
+
 	for (List<Ref<GDScript> >::Element *E = scripts.front(); E; E = E->next()) {
 
 		bool reload = E->get() == p_script || to_reload.has(E->get()->get_base());
+		bool dependent = !reload && reload_paths.has(E->get()->get_path());
 
-		if (!reload)
+		if (!reload && !dependent)
 			continue;
 
 		to_reload.insert(E->get(), Map<ObjectID, List<Pair<StringName, Variant> > >());
+		reload_order.push_back(E->get());
 
-		if (!p_soft_reload) {
+		if (!p_soft_reload && reload) {
 
 			//save state and remove script from instances
 			Map<ObjectID, List<Pair<StringName, Variant> > > &map = to_reload[E->get()];
@@ -1716,10 +1993,11 @@ void GDScriptLanguage::reload_tool_script(const Ref<Script> &p_script, bool p_so
 		}
 	}
 
+	_reload_scripts(reload_order, p_soft_reload);
+
 	for (Map<Ref<GDScript>, Map<ObjectID, List<Pair<StringName, Variant> > > >::Element *E = to_reload.front(); E; E = E->next()) {
 
 		Ref<GDScript> scr = E->key();
-		scr->reload(p_soft_reload);
 
 		//restore state if saved
 		for (Map<ObjectID, List<Pair<StringName, Variant> > >::Element *F = E->get().front(); F; F = F->next()) {
@@ -2146,6 +2424,10 @@ GDScriptWarning::Code GDScriptWarning::get_code_from_name(const String &p_name)
 GDScriptLanguage::GDScriptLanguage() {
 
 	calls = 0;
+	inline_cache_epoch = 1;
+#ifdef DEBUG_ENABLED
+	reload_pool = NULL;
+#endif
 	ERR_FAIL_COND(singleton);
 	singleton = this;
 	strings._init = StaticCString::create("_init");
@@ -2169,6 +2451,11 @@ GDScriptLanguage::GDScriptLanguage() {
 	int dmcs = GLOBAL_DEF("debug/settings/gdscript/max_call_stack", 1024);
 	ProjectSettings::get_singleton()->set_custom_property_info("debug/settings/gdscript/max_call_stack", PropertyInfo(Variant::INT, "debug/settings/gdscript/max_call_stack", PROPERTY_HINT_RANGE, "1024,4096,1,or_greater")); //minimum is 1024
 
+	jit_enabled = GLOBAL_DEF("debug/settings/gdscript/jit", true);
+	jit_threshold = GLOBAL_DEF("debug/settings/gdscript/jit_hot_call_count", 1000);
+	ProjectSettings::get_singleton()->set_custom_property_info("debug/settings/gdscript/jit_hot_call_count", PropertyInfo(Variant::INT, "debug/settings/gdscript/jit_hot_call_count", PROPERTY_HINT_RANGE, "1,100000,1,or_greater"));
+	bytecode_optimization = GLOBAL_DEF("debug/settings/gdscript/optimize_bytecode", true);
+
 	if (ScriptDebugger::get_singleton()) {
 		//debugging enabled!
 
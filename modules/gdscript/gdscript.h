@@ -33,9 +33,12 @@
 
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/os/thread_work_pool.h"
 #include "core/script_language.h"
 #include "gdscript_function.h"
 
+class GDScriptParser;
+
 class GDScriptNativeClass : public Reference {
 
 	GDCLASS(GDScriptNativeClass, Reference);
@@ -72,6 +75,7 @@ class GDScript : public Script {
 	friend class GDScriptCompiler;
 	friend class GDScriptFunctions;
 	friend class GDScriptLanguage;
+	friend class GDScriptBytecodeCache;
 
 	Variant _static_ref; //used for static call
 	Ref<GDScriptNativeClass> native;
@@ -130,6 +134,14 @@ class GDScript : public Script {
 
 #endif
 
+	// Paths this script extends, preloads or names by class_name, as of its last parse.
+	Set<String> dependencies;
+
+	// Parsing only reads other scripts, so scripts that don't depend on each other can be
+	// parsed on worker threads. Compiling must happen on one thread at a time.
+	Error _parse(GDScriptParser &r_parser) const;
+	Error _compile(GDScriptParser &p_parser, Error p_parse_error, bool p_keep_state);
+
 	bool _update_exports();
 
 	void _save_orphaned_subclasses();
@@ -359,9 +371,46 @@ class GDScriptLanguage : public ScriptLanguage {
 
 	Map<String, ObjectID> orphan_subclasses;
 
+	uint32_t inline_cache_epoch;
+
+	bool jit_enabled;
+	uint32_t jit_threshold;
+	bool bytecode_optimization;
+
+#ifdef DEBUG_ENABLED
+	ThreadWorkPool *reload_pool;
+
+	struct ReloadParse {
+		Ref<GDScript> script;
+		GDScriptParser *parser;
+		Error error;
+		int index;
+	};
+
+	void _reload_parse(uint32_t p_index, ReloadParse *p_parses);
+	void _reload_scripts(const List<Ref<GDScript> > &p_scripts, bool p_keep_state);
+#endif
+
 public:
 	int calls;
 
+	// Call site caches hold raw script and function pointers, bump this whenever those may go away.
+	_FORCE_INLINE_ void invalidate_inline_caches() {
+		if (atomic_increment(&inline_cache_epoch) == 0)
+			atomic_increment(&inline_cache_epoch);
+	}
+	_FORCE_INLINE_ uint32_t get_inline_cache_epoch() const { return inline_cache_epoch; }
+
+	// Fully typed functions move to the second execution tier after this many calls.
+	void set_jit_enabled(bool p_enabled) { jit_enabled = p_enabled; }
+	bool is_jit_enabled() const { return jit_enabled; }
+	void set_jit_threshold(uint32_t p_calls) { jit_threshold = p_calls; }
+	uint32_t get_jit_threshold() const { return jit_threshold; }
+
+	// Read by the compiler, affects scripts compiled afterwards.
+	void set_bytecode_optimization_enabled(bool p_enabled) { bytecode_optimization = p_enabled; }
+	bool is_bytecode_optimization_enabled() const { return bytecode_optimization; }
+
 	bool debug_break(const String &p_error, bool p_allow_continue = true);
 	bool debug_break_parse(const String &p_file, int p_line, const String &p_error);
 
@@ -0,0 +1,865 @@
+/*************************************************************************/
+/*  gdscript_bytecode_cache.cpp                                          */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "gdscript_bytecode_cache.h"
+
+#include "core/io/marshalls.h"
+#include "core/io/resource_loader.h"
+#include "core/os/copymem.h"
+#include "core/version.h"
+#include "gdscript.h"
+#include "gdscript_compiler.h"
+#include "gdscript_functions.h"
+
+#define COMPILED_FORMAT_VERSION 2
+
+enum {
+	FLAG_DEBUG = 1,
+};
+
+enum {
+	TAG_PLAIN,
+	TAG_NULL_OBJECT,
+	TAG_NATIVE_CLASS,
+	TAG_GDSCRIPT,
+	TAG_RESOURCE,
+};
+
+// Anything the bytecode depends on without naming it: opcodes, operators, built-in functions...
+static uint32_t _get_layout_hash() {
+
+	uint32_t hash = String(VERSION_FULL_CONFIG).hash();
+	hash = hash_djb2_one_32(GDScriptFunction::OPCODE_END, hash);
+	hash = hash_djb2_one_32(GDScriptFunction::ADDR_BITS, hash);
+	hash = hash_djb2_one_32(GDScriptFunctions::FUNC_MAX, hash);
+	hash = hash_djb2_one_32(Variant::VARIANT_MAX, hash);
+	hash = hash_djb2_one_32(Variant::OP_MAX, hash);
+	hash = hash_djb2_one_32(sizeof(real_t), hash);
+	return hash;
+}
+
+static uint32_t _get_build_flags() {
+
+#ifdef DEBUG_ENABLED
+	return FLAG_DEBUG;
+#else
+	return 0;
+#endif
+}
+
+static bool _is_plain(const Variant &p_value) {
+
+	switch (p_value.get_type()) {
+		case Variant::OBJECT:
+		case Variant::_RID: {
+			return false;
+		} break;
+		case Variant::ARRAY: {
+			Array array = p_value;
+			for (int i = 0; i < array.size(); i++) {
+				if (!_is_plain(array[i]))
+					return false;
+			}
+		} break;
+		case Variant::DICTIONARY: {
+			Dictionary dict = p_value;
+			List<Variant> keys;
+			dict.get_key_list(&keys);
+			for (List<Variant>::Element *E = keys.front(); E; E = E->next()) {
+				if (!_is_plain(E->get()) || !_is_plain(dict[E->get()]))
+					return false;
+			}
+		} break;
+		default: {
+		}
+	}
+	return true;
+}
+
+struct GDScriptBytecodeCache::Writer {
+
+	Vector<uint8_t> buffer;
+
+	uint8_t *grow(int p_size) {
+		int ofs = buffer.size();
+		buffer.resize(ofs + p_size);
+		return &buffer.write[ofs];
+	}
+
+	void put_u32(uint32_t p_value) {
+		encode_uint32(p_value, grow(4));
+	}
+
+	void put_buffer(const uint8_t *p_data, int p_size) {
+		if (p_size)
+			copymem(grow(p_size), p_data, p_size);
+	}
+
+	void put_string(const String &p_string) {
+		CharString utf8 = p_string.utf8();
+		put_u32(utf8.length());
+		put_buffer((const uint8_t *)utf8.get_data(), utf8.length());
+	}
+
+	void put_plain_variant(const Variant &p_value) {
+		int len;
+		encode_variant(p_value, NULL, len);
+		encode_variant(p_value, grow(len), len);
+	}
+};
+
+struct GDScriptBytecodeCache::Reader {
+
+	const uint8_t *ptr;
+	int left;
+	bool failed;
+
+	bool take(int p_size) {
+		if (failed || p_size < 0 || p_size > left) {
+			failed = true;
+			return false;
+		}
+		return true;
+	}
+
+	void skip(int p_size) {
+		if (take(p_size)) {
+			ptr += p_size;
+			left -= p_size;
+		}
+	}
+
+	uint32_t get_u32() {
+		if (!take(4))
+			return 0;
+		uint32_t value = decode_uint32(ptr);
+		skip(4);
+		return value;
+	}
+
+	// Element counts are bounded by what is left, so garbage can't cause huge allocations.
+	int get_count() {
+		uint32_t count = get_u32();
+		if (count > (uint32_t)left) {
+			failed = true;
+			return 0;
+		}
+		return count;
+	}
+
+	String get_string() {
+		int len = get_count();
+		if (!take(len))
+			return String();
+		String s;
+		s.parse_utf8((const char *)ptr, len);
+		skip(len);
+		return s;
+	}
+
+	Variant get_plain_variant() {
+		if (failed)
+			return Variant();
+		Variant value;
+		int len;
+		if (decode_variant(value, ptr, left, &len) != OK) {
+			failed = true;
+			return Variant();
+		}
+		skip(len);
+		return value;
+	}
+
+	Reader(const uint8_t *p_ptr, int p_size) {
+		ptr = p_ptr;
+		left = p_size;
+		failed = false;
+	}
+};
+
+/* Writing */
+
+bool GDScriptBytecodeCache::_write_variant(Writer &w, const Variant &p_value) {
+
+	if (p_value.get_type() != Variant::OBJECT) {
+		if (!_is_plain(p_value))
+			return false;
+		w.put_u32(TAG_PLAIN);
+		w.put_plain_variant(p_value);
+		return true;
+	}
+
+	Object *obj = p_value;
+	if (!obj) {
+		w.put_u32(TAG_NULL_OBJECT);
+		return true;
+	}
+
+	GDScriptNativeClass *native = Object::cast_to<GDScriptNativeClass>(obj);
+	if (native) {
+		w.put_u32(TAG_NATIVE_CLASS);
+		w.put_string(native->get_name());
+		return true;
+	}
+
+	GDScript *script = Object::cast_to<GDScript>(obj);
+	if (script) {
+		// Inner classes are found again from the file they were declared in.
+		Vector<String> chain;
+		const GDScript *root = script;
+		while (root->_owner) {
+			chain.push_back(root->name);
+			root = root->_owner;
+		}
+		if (root->path == String())
+			return false; // built-in script
+
+		w.put_u32(TAG_GDSCRIPT);
+		w.put_string(root->path);
+		w.put_u32(chain.size());
+		for (int i = chain.size() - 1; i >= 0; i--) {
+			w.put_string(chain[i]);
+		}
+		return true;
+	}
+
+	Resource *res = Object::cast_to<Resource>(obj);
+	if (res && res->get_path() != String() && res->get_path().find("::") == -1) {
+		w.put_u32(TAG_RESOURCE);
+		w.put_string(res->get_path());
+		return true;
+	}
+
+	return false; // instances and sub-resources can only come from the source
+}
+
+bool GDScriptBytecodeCache::_write_data_type(Writer &w, const GDScriptDataType &p_type) {
+
+	w.put_u32(p_type.has_type);
+	w.put_u32(p_type.kind);
+	w.put_u32(p_type.builtin_type);
+	w.put_string(p_type.native_type);
+	return _write_variant(w, p_type.script_type);
+}
+
+bool GDScriptBytecodeCache::_write_function(Writer &w, const GDScriptFunction *p_func, const Vector<StringName> &p_globals) {
+
+	w.put_string(p_func->name);
+	w.put_u32(p_func->_static);
+	w.put_u32(p_func->_fully_typed);
+	w.put_u32(p_func->rpc_mode);
+	w.put_u32(p_func->_initial_line);
+	w.put_u32(p_func->_argument_count);
+	w.put_u32(p_func->_stack_size);
+	w.put_u32(p_func->_call_size);
+	w.put_u32(p_func->_inline_cache_count);
+
+	w.put_u32(p_func->constants.size());
+	for (int i = 0; i < p_func->constants.size(); i++) {
+		if (!_write_variant(w, p_func->constants[i]))
+			return false;
+	}
+
+	w.put_u32(p_func->global_names.size());
+	for (int i = 0; i < p_func->global_names.size(); i++) {
+		w.put_string(p_func->global_names[i]);
+	}
+
+	w.put_u32(p_func->default_arguments.size());
+	for (int i = 0; i < p_func->default_arguments.size(); i++) {
+		w.put_u32(p_func->default_arguments[i]);
+	}
+
+	// Global indices depend on registration order at runtime, so they are stored by name.
+	// Immediate operands are always below 1 << ADDR_BITS, so any word tagged as a global is an address.
+	Vector<int> code = p_func->code;
+	Vector<StringName> globals;
+	for (int i = 0; i < code.size(); i++) {
+
+		int type = (code[i] & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS;
+		int index = code[i] & GDScriptFunction::ADDR_MASK;
+		StringName global;
+
+		if (type == GDScriptFunction::ADDR_TYPE_GLOBAL) {
+			ERR_FAIL_INDEX_V(index, p_globals.size(), false);
+			global = p_globals[index];
+#ifdef TOOLS_ENABLED
+		} else if (type == GDScriptFunction::ADDR_TYPE_NAMED_GLOBAL) {
+			// Autoloads are named globals in the editor and plain globals in exported projects.
+			ERR_FAIL_INDEX_V(index, p_func->named_globals.size(), false);
+			global = p_func->named_globals[index];
+#endif
+		} else {
+			continue;
+		}
+
+		int pos = globals.find(global);
+		if (pos == -1) {
+			pos = globals.size();
+			globals.push_back(global);
+		}
+		code.write[i] = pos | (GDScriptFunction::ADDR_TYPE_GLOBAL << GDScriptFunction::ADDR_BITS);
+	}
+
+	w.put_u32(globals.size());
+	for (int i = 0; i < globals.size(); i++) {
+		w.put_string(globals[i]);
+	}
+
+	w.put_u32(code.size());
+	for (int i = 0; i < code.size(); i++) {
+		w.put_u32(code[i]);
+	}
+
+	w.put_u32(p_func->argument_types.size());
+	for (int i = 0; i < p_func->argument_types.size(); i++) {
+		if (!_write_data_type(w, p_func->argument_types[i]))
+			return false;
+	}
+	if (!_write_data_type(w, p_func->return_type))
+		return false;
+
+#ifdef TOOLS_ENABLED
+	w.put_u32(p_func->arg_names.size());
+	for (int i = 0; i < p_func->arg_names.size(); i++) {
+		w.put_string(p_func->arg_names[i]);
+	}
+#else
+	w.put_u32(0);
+#endif
+
+	w.put_u32(p_func->stack_debug.size());
+	for (const List<GDScriptFunction::StackDebug>::Element *E = p_func->stack_debug.front(); E; E = E->next()) {
+		w.put_u32(E->get().line);
+		w.put_u32(E->get().pos);
+		w.put_u32(E->get().added);
+		w.put_string(E->get().identifier);
+	}
+
+	return true;
+}
+
+void GDScriptBytecodeCache::_write_tree(Writer &w, const GDScript *p_script) {
+
+	w.put_u32(p_script->subclasses.size());
+	for (const Map<StringName, Ref<GDScript> >::Element *E = p_script->subclasses.front(); E; E = E->next()) {
+		w.put_string(E->key());
+		_write_tree(w, E->get().ptr());
+	}
+}
+
+bool GDScriptBytecodeCache::_write_class(Writer &w, const GDScript *p_script, const Vector<StringName> &p_globals) {
+
+	w.put_string(p_script->name);
+	w.put_u32(p_script->tool);
+
+	if (p_script->base.is_valid()) {
+		w.put_u32(1);
+		if (!_write_variant(w, p_script->base))
+			return false;
+	} else {
+		ERR_FAIL_COND_V(p_script->native.is_null(), false);
+		w.put_u32(0);
+		w.put_string(p_script->native->get_name());
+	}
+
+	w.put_u32(p_script->members.size());
+	for (const Set<StringName>::Element *E = p_script->members.front(); E; E = E->next()) {
+		w.put_string(E->get());
+	}
+
+	w.put_u32(p_script->member_indices.size());
+	for (const Map<StringName, GDScript::MemberInfo>::Element *E = p_script->member_indices.front(); E; E = E->next()) {
+		w.put_string(E->key());
+		w.put_u32(E->get().index);
+		w.put_string(E->get().setter);
+		w.put_string(E->get().getter);
+		w.put_u32(E->get().rpc_mode);
+		if (!_write_data_type(w, E->get().data_type))
+			return false;
+	}
+
+	w.put_u32(p_script->member_info.size());
+	for (const Map<StringName, PropertyInfo>::Element *E = p_script->member_info.front(); E; E = E->next()) {
+		w.put_string(E->key());
+		w.put_u32(E->get().type);
+		w.put_string(E->get().name);
+		w.put_string(E->get().class_name);
+		w.put_u32(E->get().hint);
+		w.put_string(E->get().hint_string);
+		w.put_u32(E->get().usage);
+	}
+
+	w.put_u32(p_script->_signals.size());
+	for (const Map<StringName, Vector<StringName> >::Element *E = p_script->_signals.front(); E; E = E->next()) {
+		w.put_string(E->key());
+		w.put_u32(E->get().size());
+		for (int i = 0; i < E->get().size(); i++) {
+			w.put_string(E->get()[i]);
+		}
+	}
+
+	w.put_u32(p_script->constants.size());
+	for (const Map<StringName, Variant>::Element *E = p_script->constants.front(); E; E = E->next()) {
+		w.put_string(E->key());
+		if (!_write_variant(w, E->get()))
+			return false;
+	}
+
+	w.put_u32(p_script->member_functions.size());
+	for (const Map<StringName, GDScriptFunction *>::Element *E = p_script->member_functions.front(); E; E = E->next()) {
+		if (!_write_function(w, E->get(), p_globals))
+			return false;
+	}
+
+	w.put_u32(p_script->subclasses.size());
+	for (const Map<StringName, Ref<GDScript> >::Element *E = p_script->subclasses.front(); E; E = E->next()) {
+		w.put_string(E->key());
+		if (!_write_class(w, E->get().ptr(), p_globals))
+			return false;
+	}
+
+	return true;
+}
+
+/* Reading */
+
+bool GDScriptBytecodeCache::_read_variant(Reader &r, GDScript *p_root, Variant &r_value) {
+
+	switch (r.get_u32()) {
+		case TAG_PLAIN: {
+			r_value = r.get_plain_variant();
+			return !r.failed;
+		} break;
+		case TAG_NULL_OBJECT: {
+			r_value = Variant((Object *)NULL);
+			return !r.failed;
+		} break;
+		case TAG_NATIVE_CLASS: {
+			StringName name = r.get_string();
+			const Map<StringName, int>::Element *E = GDScriptLanguage::get_singleton()->get_global_map().find(name);
+			if (r.failed || !E)
+				return false;
+			r_value = GDScriptLanguage::get_singleton()->get_global_array()[E->get()];
+			return Object::cast_to<GDScriptNativeClass>(r_value.operator Object *()) != NULL;
+		} break;
+		case TAG_GDSCRIPT: {
+			String path = r.get_string();
+			if (r.failed)
+				return false;
+
+			Ref<GDScript> script;
+			if (path == p_root->get_path()) {
+				script = Ref<GDScript>(p_root);
+			} else {
+				script = ResourceLoader::load(path);
+			}
+
+			int depth = r.get_count();
+			for (int i = 0; i < depth; i++) {
+				StringName name = r.get_string();
+				if (script.is_null() || !script->subclasses.has(name))
+					return false;
+				script = script->subclasses[name];
+			}
+			if (r.failed || script.is_null())
+				return false;
+			r_value = script;
+			return true;
+		} break;
+		case TAG_RESOURCE: {
+			String path = r.get_string();
+			if (r.failed)
+				return false;
+			RES res = ResourceLoader::load(path);
+			if (res.is_null())
+				return false;
+			r_value = res;
+			return true;
+		} break;
+	}
+
+	return false;
+}
+
+bool GDScriptBytecodeCache::_read_data_type(Reader &r, GDScript *p_root, GDScriptDataType &r_type) {
+
+	r_type.has_type = r.get_u32();
+	uint32_t kind = r.get_u32();
+	uint32_t builtin_type = r.get_u32();
+	if (kind > GDScriptDataType::GDSCRIPT || builtin_type >= Variant::VARIANT_MAX)
+		return false;
+	r_type.kind = (decltype(r_type.kind))kind;
+	r_type.builtin_type = (Variant::Type)builtin_type;
+	r_type.native_type = r.get_string();
+
+	Variant script_type;
+	if (!_read_variant(r, p_root, script_type))
+		return false;
+	r_type.script_type = script_type;
+	return !r.failed;
+}
+
+bool GDScriptBytecodeCache::_read_function(Reader &r, GDScript *p_script, GDScript *p_root) {
+
+	StringName name = r.get_string();
+	if (r.failed)
+		return false;
+
+	if (p_script->member_functions.has(name))
+		memdelete(p_script->member_functions[name]);
+	// Owned by the script from here on, so a failed load is cleaned up with it.
+	GDScriptFunction *func = memnew(GDScriptFunction);
+	p_script->member_functions[name] = func;
+
+	func->name = name;
+	func->_script = p_script;
+	func->source = p_root->get_path();
+	func->_static = r.get_u32();
+	func->_fully_typed = r.get_u32();
+	func->rpc_mode = (MultiplayerAPI::RPCMode)r.get_u32();
+	func->_initial_line = r.get_u32();
+	func->_argument_count = r.get_u32();
+	func->_stack_size = r.get_u32();
+	func->_call_size = r.get_u32();
+
+	int cache_count = r.get_count();
+	if (cache_count) {
+		func->inline_caches.resize(cache_count);
+		func->_inline_caches_ptr = func->inline_caches.ptrw();
+		zeromem(func->_inline_caches_ptr, sizeof(GDScriptInlineCache) * cache_count);
+	}
+	func->_inline_cache_count = cache_count;
+
+	func->constants.resize(r.get_count());
+	for (int i = 0; i < func->constants.size(); i++) {
+		if (!_read_variant(r, p_root, func->constants.write[i]))
+			return false;
+	}
+	func->_constants_ptr = func->constants.size() ? func->constants.ptrw() : NULL;
+	func->_constant_count = func->constants.size();
+
+	func->global_names.resize(r.get_count());
+	for (int i = 0; i < func->global_names.size(); i++) {
+		func->global_names.write[i] = r.get_string();
+	}
+	func->_global_names_ptr = func->global_names.size() ? func->global_names.ptr() : NULL;
+	func->_global_names_count = func->global_names.size();
+
+	func->default_arguments.resize(r.get_count());
+	for (int i = 0; i < func->default_arguments.size(); i++) {
+		func->default_arguments.write[i] = r.get_u32();
+	}
+	func->_default_arg_ptr = func->default_arguments.size() ? func->default_arguments.ptr() : NULL;
+	func->_default_arg_count = func->default_arguments.size() ? func->default_arguments.size() - 1 : 0;
+
+	Vector<int> globals;
+	globals.resize(r.get_count());
+	for (int i = 0; i < globals.size(); i++) {
+		const Map<StringName, int>::Element *E = GDScriptLanguage::get_singleton()->get_global_map().find(r.get_string());
+		if (!E)
+			return false; // autoload or class removed since export
+		globals.write[i] = E->get();
+	}
+
+	func->code.resize(r.get_count());
+	for (int i = 0; i < func->code.size(); i++) {
+		int word = r.get_u32();
+		if (((word & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS) == GDScriptFunction::ADDR_TYPE_GLOBAL) {
+			int index = word & GDScriptFunction::ADDR_MASK;
+			if (index >= globals.size())
+				return false;
+			word = globals[index] | (GDScriptFunction::ADDR_TYPE_GLOBAL << GDScriptFunction::ADDR_BITS);
+		}
+		func->code.write[i] = word;
+	}
+	func->_code_ptr = func->code.size() ? func->code.ptr() : NULL;
+	func->_code_size = func->code.size();
+
+	func->argument_types.resize(r.get_count());
+	for (int i = 0; i < func->argument_types.size(); i++) {
+		if (!_read_data_type(r, p_root, func->argument_types.write[i]))
+			return false;
+	}
+	if (!_read_data_type(r, p_root, func->return_type))
+		return false;
+
+	int arg_name_count = r.get_count();
+	for (int i = 0; i < arg_name_count; i++) {
+		StringName arg_name = r.get_string();
+#ifdef TOOLS_ENABLED
+		func->arg_names.push_back(arg_name);
+#endif
+	}
+
+	int stack_debug_count = r.get_count();
+	for (int i = 0; i < stack_debug_count; i++) {
+		GDScriptFunction::StackDebug sd;
+		sd.line = r.get_u32();
+		sd.pos = r.get_u32();
+		sd.added = r.get_u32();
+		sd.identifier = r.get_string();
+		func->stack_debug.push_back(sd);
+	}
+
+	if (r.failed || func->_code_size == 0 || func->code[func->_code_size - 1] != GDScriptFunction::OPCODE_END)
+		return false;
+
+#ifdef DEBUG_ENABLED
+	func->func_cname = (String(func->source) + " - " + String(name)).utf8();
+	func->_func_cname = func->func_cname.get_data();
+
+	if (ScriptDebugger::get_singleton()) {
+		String signature = p_script->get_path() + "::" + itos(func->_initial_line);
+		if (p_script->name != String()) {
+			signature += "::" + p_script->name + "." + String(name);
+		} else {
+			signature += "::" + String(name);
+		}
+		func->profile.signature = signature;
+	}
+#endif
+
+	if (name == GDScriptLanguage::get_singleton()->strings._init)
+		p_script->initializer = func;
+
+	return true;
+}
+
+bool GDScriptBytecodeCache::_read_tree(Reader &r, GDScript *p_script) {
+
+	p_script->subclasses.clear();
+
+	int count = r.get_count();
+	for (int i = 0; i < count; i++) {
+		StringName name = r.get_string();
+		if (r.failed)
+			return false;
+
+		Ref<GDScript> subclass;
+		subclass.instance();
+		subclass->_owner = p_script;
+		subclass->fully_qualified_name = p_script->fully_qualified_name + "::" + name;
+		p_script->subclasses.insert(name, subclass);
+
+		if (!_read_tree(r, subclass.ptr()))
+			return false;
+	}
+
+	return !r.failed;
+}
+
+bool GDScriptBytecodeCache::_read_class(Reader &r, GDScript *p_script, GDScript *p_root) {
+
+	p_script->name = r.get_string();
+	p_script->tool = r.get_u32();
+
+	p_script->native = Ref<GDScriptNativeClass>();
+	p_script->base = Ref<GDScript>();
+	p_script->_base = NULL;
+	p_script->initializer = NULL;
+
+	if (r.get_u32()) {
+		Variant base;
+		if (!_read_variant(r, p_root, base))
+			return false;
+		p_script->base = base;
+		if (p_script->base.is_null())
+			return false;
+		p_script->_base = p_script->base.ptr();
+	} else {
+		const Map<StringName, int>::Element *E = GDScriptLanguage::get_singleton()->get_global_map().find(r.get_string());
+		if (!E)
+			return false;
+		p_script->native = GDScriptLanguage::get_singleton()->get_global_array()[E->get()];
+		if (p_script->native.is_null())
+			return false;
+	}
+
+	p_script->members.clear();
+	int member_count = r.get_count();
+	for (int i = 0; i < member_count; i++) {
+		p_script->members.insert(r.get_string());
+	}
+
+	p_script->member_indices.clear();
+	int index_count = r.get_count();
+	for (int i = 0; i < index_count; i++) {
+		StringName name = r.get_string();
+		GDScript::MemberInfo minfo;
+		minfo.index = r.get_u32();
+		minfo.setter = r.get_string();
+		minfo.getter = r.get_string();
+		minfo.rpc_mode = (MultiplayerAPI::RPCMode)r.get_u32();
+		if (!_read_data_type(r, p_root, minfo.data_type) || minfo.index < 0 || minfo.index >= index_count)
+			return false;
+		p_script->member_indices[name] = minfo;
+	}
+
+	p_script->member_info.clear();
+	int info_count = r.get_count();
+	for (int i = 0; i < info_count; i++) {
+		StringName name = r.get_string();
+		PropertyInfo pinfo;
+		pinfo.type = (Variant::Type)r.get_u32();
+		pinfo.name = r.get_string();
+		pinfo.class_name = r.get_string();
+		pinfo.hint = (PropertyHint)r.get_u32();
+		pinfo.hint_string = r.get_string();
+		pinfo.usage = r.get_u32();
+		p_script->member_info[name] = pinfo;
+	}
+
+	p_script->_signals.clear();
+	int signal_count = r.get_count();
+	for (int i = 0; i < signal_count; i++) {
+		StringName name = r.get_string();
+		Vector<StringName> args;
+		args.resize(r.get_count());
+		for (int j = 0; j < args.size(); j++) {
+			args.write[j] = r.get_string();
+		}
+		p_script->_signals[name] = args;
+	}
+
+	p_script->constants.clear();
+	int constant_count = r.get_count();
+	for (int i = 0; i < constant_count; i++) {
+		StringName name = r.get_string();
+		Variant value;
+		if (!_read_variant(r, p_root, value))
+			return false;
+		p_script->constants[name] = value;
+	}
+
+	int function_count = r.get_count();
+	for (int i = 0; i < function_count; i++) {
+		if (!_read_function(r, p_script, p_root))
+			return false;
+	}
+	if (!p_script->initializer)
+		return false;
+
+	int subclass_count = r.get_count();
+	if (subclass_count != p_script->subclasses.size())
+		return false;
+	for (int i = 0; i < subclass_count; i++) {
+		StringName name = r.get_string();
+		if (r.failed || !p_script->subclasses.has(name))
+			return false;
+		if (!_read_class(r, p_script->subclasses[name].ptr(), p_root))
+			return false;
+	}
+
+	p_script->valid = !r.failed;
+	return p_script->valid;
+}
+
+/* Public */
+
+bool GDScriptBytecodeCache::is_compiled_buffer(const Vector<uint8_t> &p_buffer) {
+
+	return p_buffer.size() >= 20 && p_buffer[0] == 'G' && p_buffer[1] == 'D' && p_buffer[2] == 'S' && p_buffer[3] == 'A';
+}
+
+Error GDScriptBytecodeCache::make_buffer(const String &p_path, const Vector<uint8_t> &p_tokens, bool p_debug, Vector<uint8_t> &r_buffer) {
+
+	GDScriptParser parser;
+	Error err = parser.parse_bytecode(p_tokens, p_path.get_base_dir(), p_path);
+	if (err)
+		return err;
+
+	// A fresh script, so the one the editor uses keeps its editor-only code.
+	Ref<GDScript> script;
+	script.instance();
+	script->set_script_path(p_path);
+
+	GDScriptCompiler compiler;
+	compiler.set_export_target(p_debug);
+	err = compiler.compile(&parser, script.ptr());
+	if (err)
+		return err;
+
+	for (Map<StringName, Ref<GDScript> >::Element *E = script->subclasses.front(); E; E = E->next()) {
+		script->_set_subclass_path(E->get(), p_path);
+	}
+
+	const Map<StringName, int> &global_map = GDScriptLanguage::get_singleton()->get_global_map();
+	Vector<StringName> globals;
+	globals.resize(global_map.size());
+	for (const Map<StringName, int>::Element *E = global_map.front(); E; E = E->next()) {
+		globals.write[E->get()] = E->key();
+	}
+
+	Writer w;
+	w.put_buffer((const uint8_t *)"GDSA", 4);
+	w.put_u32(COMPILED_FORMAT_VERSION);
+	w.put_u32(_get_layout_hash());
+	w.put_u32(p_debug ? FLAG_DEBUG : 0);
+	w.put_u32(p_tokens.size());
+	w.put_buffer(p_tokens.ptr(), p_tokens.size());
+
+	_write_tree(w, script.ptr());
+	if (!_write_class(w, script.ptr(), globals))
+		return ERR_UNAVAILABLE; // references something that can't be named, keep the tokens
+
+	r_buffer = w.buffer;
+	return OK;
+}
+
+Error GDScriptBytecodeCache::load_buffer(GDScript *p_script, const Vector<uint8_t> &p_buffer, Vector<uint8_t> &r_tokens) {
+
+	ERR_FAIL_COND_V(!is_compiled_buffer(p_buffer), ERR_INVALID_DATA);
+
+	Reader r(p_buffer.ptr() + 4, p_buffer.size() - 4);
+	uint32_t version = r.get_u32();
+	uint32_t layout = r.get_u32();
+	uint32_t flags = r.get_u32();
+	int token_size = r.get_count();
+	ERR_FAIL_COND_V(!r.take(token_size), ERR_INVALID_DATA);
+
+	r_tokens.resize(token_size);
+	if (token_size)
+		copymem(r_tokens.ptrw(), r.ptr, token_size);
+	r.skip(token_size);
+
+	if (version != COMPILED_FORMAT_VERSION || layout != _get_layout_hash() || flags != _get_build_flags())
+		return ERR_FILE_UNRECOGNIZED; // exported with another engine build
+
+	p_script->_owner = NULL;
+	p_script->fully_qualified_name = p_script->path;
+
+	if (!_read_tree(r, p_script) || !_read_class(r, p_script, p_script) || r.failed) {
+		p_script->valid = false;
+		return ERR_INVALID_DATA;
+	}
+
+	return OK;
+}
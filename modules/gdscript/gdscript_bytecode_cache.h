@@ -0,0 +1,72 @@
+/*************************************************************************/
+/*  gdscript_bytecode_cache.h                                            */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef GDSCRIPT_BYTECODE_CACHE_H
+#define GDSCRIPT_BYTECODE_CACHE_H
+
+#include "core/ustring.h"
+#include "core/variant.h"
+#include "core/vector.h"
+
+class GDScript;
+class GDScriptFunction;
+struct GDScriptDataType;
+
+// Ahead-of-time compiled scripts for exported projects.
+// The buffer holds the compiled classes and functions of one script file plus its
+// tokenized source, which is compiled instead whenever the compiled part was made
+// by a different engine build or references something that no longer exists.
+class GDScriptBytecodeCache {
+
+	struct Writer;
+	struct Reader;
+
+	static bool _write_variant(Writer &w, const Variant &p_value);
+	static bool _write_data_type(Writer &w, const GDScriptDataType &p_type);
+	static bool _write_function(Writer &w, const GDScriptFunction *p_func, const Vector<StringName> &p_globals);
+	static void _write_tree(Writer &w, const GDScript *p_script);
+	static bool _write_class(Writer &w, const GDScript *p_script, const Vector<StringName> &p_globals);
+
+	static bool _read_variant(Reader &r, GDScript *p_root, Variant &r_value);
+	static bool _read_data_type(Reader &r, GDScript *p_root, GDScriptDataType &r_type);
+	static bool _read_function(Reader &r, GDScript *p_script, GDScript *p_root);
+	static bool _read_tree(Reader &r, GDScript *p_script);
+	static bool _read_class(Reader &r, GDScript *p_script, GDScript *p_root);
+
+public:
+	static bool is_compiled_buffer(const Vector<uint8_t> &p_buffer);
+
+	// Compiles tokenized source for an exported debug or release build.
+	static Error make_buffer(const String &p_path, const Vector<uint8_t> &p_tokens, bool p_debug, Vector<uint8_t> &r_buffer);
+	// Restores p_script, r_tokens gets the embedded source when the compiled part can't be used.
+	static Error load_buffer(GDScript *p_script, const Vector<uint8_t> &p_buffer, Vector<uint8_t> &r_tokens);
+};
+
+#endif // GDSCRIPT_BYTECODE_CACHE_H
@@ -31,6 +31,7 @@
 #include "gdscript_compiler.h"
 
 #include "gdscript.h"
+#include "gdscript_optimizer.h"
 
 bool GDScriptCompiler::_is_class_member_property(CodeGen &codegen, const StringName &p_name) {
 
@@ -74,6 +75,26 @@ void GDScriptCompiler::_set_error(const String &p_error, const GDScriptParser::N
 	}
 }
 
+void GDScriptCompiler::_push_operator(CodeGen &codegen, Variant::Operator op, const GDScriptParser::Node *p_a, const GDScriptParser::Node *p_b) {
+
+	// Operands of known built-in types get the typed form, which skips the generic dispatch
+	// and stores into a destination already holding the result type in place.
+	GDScriptParser::DataType type_a = p_a->get_datatype();
+	GDScriptParser::DataType type_b = p_b->get_datatype();
+	int typed = -1;
+	if (type_a.has_type && !type_a.is_meta_type && type_a.kind == GDScriptParser::DataType::BUILTIN && type_b.has_type && !type_b.is_meta_type && type_b.kind == GDScriptParser::DataType::BUILTIN)
+		typed = GDScriptFunction::get_typed_operands(op, type_a.builtin_type, type_b.builtin_type);
+
+	if (typed != -1) {
+		codegen.opcodes.push_back(GDScriptFunction::OPCODE_OPERATOR_TYPED);
+		codegen.opcodes.push_back(op);
+		codegen.opcodes.push_back(typed);
+	} else {
+		codegen.opcodes.push_back(GDScriptFunction::OPCODE_OPERATOR); // perform operator
+		codegen.opcodes.push_back(op); //which operator
+	}
+}
+
 bool GDScriptCompiler::_create_unary_operator(CodeGen &codegen, const GDScriptParser::OperatorNode *on, Variant::Operator op, int p_stack_level) {
 
 	ERR_FAIL_COND_V(on->arguments.size() != 1, false);
@@ -82,8 +103,7 @@ bool GDScriptCompiler::_create_unary_operator(CodeGen &codegen, const GDScriptPa
 	if (src_address_a < 0)
 		return false;
 
-	codegen.opcodes.push_back(GDScriptFunction::OPCODE_OPERATOR); // perform operator
-	codegen.opcodes.push_back(op); //which operator
+	_push_operator(codegen, op, on->arguments[0], on->arguments[0]);
 	codegen.opcodes.push_back(src_address_a); // argument 1
 	codegen.opcodes.push_back(src_address_a); // argument 2 (repeated)
 	//codegen.opcodes.push_back(GDScriptFunction::ADDR_TYPE_NIL); // argument 2 (unary only takes one parameter)
@@ -104,8 +124,7 @@ bool GDScriptCompiler::_create_binary_operator(CodeGen &codegen, const GDScriptP
 	if (src_address_b < 0)
 		return false;
 
-	codegen.opcodes.push_back(GDScriptFunction::OPCODE_OPERATOR); // perform operator
-	codegen.opcodes.push_back(op); //which operator
+	_push_operator(codegen, op, on->arguments[0], on->arguments[1]);
 	codegen.opcodes.push_back(src_address_a); // argument 1
 	codegen.opcodes.push_back(src_address_b); // argument 2 (unary only takes one parameter)
 	return true;
@@ -659,8 +678,11 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 						codegen.opcodes.push_back(p_root ? GDScriptFunction::OPCODE_CALL : GDScriptFunction::OPCODE_CALL_RETURN); // perform operator
 						codegen.opcodes.push_back(on->arguments.size() - 2);
 						codegen.alloc_call(on->arguments.size() - 2);
-						for (int i = 0; i < arguments.size(); i++)
+						for (int i = 0; i < arguments.size(); i++) {
 							codegen.opcodes.push_back(arguments[i]);
+							if (i == 1)
+								codegen.opcodes.push_back(codegen.alloc_inline_cache()); // after base and name
+						}
 					}
 				} break;
 				case GDScriptParser::OperatorNode::OP_YIELD: {
@@ -752,6 +774,8 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 					codegen.opcodes.push_back(named ? GDScriptFunction::OPCODE_GET_NAMED : GDScriptFunction::OPCODE_GET); // perform operator
 					codegen.opcodes.push_back(from); // argument 1
 					codegen.opcodes.push_back(index); // argument 2 (unary only takes one parameter)
+					if (named)
+						codegen.opcodes.push_back(codegen.alloc_inline_cache());
 
 				} break;
 				case GDScriptParser::OperatorNode::OP_AND: {
@@ -1054,6 +1078,8 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 							codegen.opcodes.push_back(named ? GDScriptFunction::OPCODE_GET_NAMED : GDScriptFunction::OPCODE_GET);
 							codegen.opcodes.push_back(prev_pos);
 							codegen.opcodes.push_back(key_idx);
+							if (named)
+								codegen.opcodes.push_back(codegen.alloc_inline_cache());
 							slevel++;
 							codegen.alloc_stack(slevel);
 							int dst_pos = (GDScriptFunction::ADDR_TYPE_STACK << GDScriptFunction::ADDR_BITS) | slevel;
@@ -1062,6 +1088,8 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 
 							//add in reverse order, since it will be reverted
 
+							if (named)
+								setchain.push_back(codegen.alloc_inline_cache());
 							setchain.push_back(dst_pos);
 							setchain.push_back(key_idx);
 							setchain.push_back(prev_pos);
@@ -1101,6 +1129,8 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 						codegen.opcodes.push_back(prev_pos);
 						codegen.opcodes.push_back(set_index);
 						codegen.opcodes.push_back(set_value);
+						if (named)
+							codegen.opcodes.push_back(codegen.alloc_inline_cache());
 
 						for (int i = 0; i < setchain.size(); i++) {
 
@@ -1273,12 +1303,12 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Blo
 
 		switch (s->type) {
 			case GDScriptParser::Node::TYPE_NEWLINE: {
-#ifdef DEBUG_ENABLED
-				const GDScriptParser::NewLineNode *nl = static_cast<const GDScriptParser::NewLineNode *>(s);
-				codegen.opcodes.push_back(GDScriptFunction::OPCODE_LINE);
-				codegen.opcodes.push_back(nl->line);
-				codegen.current_line = nl->line;
-#endif
+				if (debug_code) {
+					const GDScriptParser::NewLineNode *nl = static_cast<const GDScriptParser::NewLineNode *>(s);
+					codegen.opcodes.push_back(GDScriptFunction::OPCODE_LINE);
+					codegen.opcodes.push_back(nl->line);
+					codegen.current_line = nl->line;
+				}
 			} break;
 			case GDScriptParser::Node::TYPE_CONTROL_FLOW: {
 				// try subblocks
@@ -1513,7 +1543,8 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Blo
 				}
 			} break;
 			case GDScriptParser::Node::TYPE_ASSERT: {
-#ifdef DEBUG_ENABLED
+				if (!debug_code)
+					break;
 				// try subblocks
 
 				const GDScriptParser::AssertNode *as = static_cast<const GDScriptParser::AssertNode *>(s);
@@ -1532,13 +1563,11 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Blo
 				codegen.opcodes.push_back(GDScriptFunction::OPCODE_ASSERT);
 				codegen.opcodes.push_back(ret2);
 				codegen.opcodes.push_back(message_ret);
-#endif
 			} break;
 			case GDScriptParser::Node::TYPE_BREAKPOINT: {
-#ifdef DEBUG_ENABLED
-				// try subblocks
-				codegen.opcodes.push_back(GDScriptFunction::OPCODE_BREAKPOINT);
-#endif
+				if (debug_code) {
+					codegen.opcodes.push_back(GDScriptFunction::OPCODE_BREAKPOINT);
+				}
 			} break;
 			case GDScriptParser::Node::TYPE_LOCAL_VAR: {
 
@@ -1554,6 +1583,8 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Blo
 				codegen.add_stack_identifier(lv->name, p_stack_level++);
 				codegen.alloc_stack(p_stack_level);
 				new_identifiers++;
+				if (!lv->datatype.has_type)
+					codegen.untyped_locals = true;
 
 			} break;
 			default: {
@@ -1579,7 +1610,9 @@ Error GDScriptCompiler::_parse_function(GDScript *p_script, const GDScriptParser
 	codegen.stack_max = 0;
 	codegen.current_line = 0;
 	codegen.call_max = 0;
-	codegen.debug_stack = ScriptDebugger::get_singleton() != NULL;
+	codegen.inline_cache_count = 0;
+	codegen.untyped_locals = false;
+	codegen.debug_stack = debug_stack;
 	Vector<StringName> argnames;
 
 	int stack_level = 0;
@@ -1666,6 +1699,11 @@ Error GDScriptCompiler::_parse_function(GDScript *p_script, const GDScriptParser
 
 	codegen.opcodes.push_back(GDScriptFunction::OPCODE_END);
 
+	if (optimize_code) {
+		GDScriptOptimizer optimizer(codegen.constant_map, codegen.stack_max, p_func ? p_func->arguments.size() : 0, debug_code);
+		optimizer.optimize(codegen.opcodes, defarg_addr);
+	}
+
 	/*
 	if (String(p_func->name)=="") { //initializer func
 		gdfunc = &p_script->initializer;
@@ -1725,6 +1763,18 @@ Error GDScriptCompiler::_parse_function(GDScript *p_script, const GDScriptParser
 		gdfunc->_global_names_ptr = NULL;
 		gdfunc->_global_names_count = 0;
 	}
+	//call site caches, start empty
+	if (codegen.inline_cache_count) {
+
+		gdfunc->inline_caches.resize(codegen.inline_cache_count);
+		gdfunc->_inline_caches_ptr = gdfunc->inline_caches.ptrw();
+		zeromem(gdfunc->_inline_caches_ptr, sizeof(GDScriptInlineCache) * codegen.inline_cache_count);
+		gdfunc->_inline_cache_count = codegen.inline_cache_count;
+
+	} else {
+		gdfunc->_inline_caches_ptr = NULL;
+		gdfunc->_inline_cache_count = 0;
+	}
 
 #ifdef TOOLS_ENABLED
 	// Named globals
@@ -1761,6 +1811,11 @@ Error GDScriptCompiler::_parse_function(GDScript *p_script, const GDScriptParser
 	}
 
 	gdfunc->_argument_count = p_func ? p_func->arguments.size() : 0;
+	gdfunc->_fully_typed = p_func && !codegen.untyped_locals && gdfunc->return_type.has_type;
+	for (int i = 0; i < gdfunc->argument_types.size(); i++) {
+		if (!gdfunc->argument_types[i].has_type)
+			gdfunc->_fully_typed = false;
+	}
 	gdfunc->_stack_size = codegen.stack_max;
 	gdfunc->_call_size = codegen.call_max;
 	gdfunc->name = func_name;
@@ -1841,6 +1896,7 @@ Error GDScriptCompiler::_parse_class_level(GDScript *p_script, const GDScriptPar
 	p_script->_base = NULL;
 	p_script->members.clear();
 	p_script->constants.clear();
+	GDScriptLanguage::get_singleton()->invalidate_inline_caches();
 	for (Map<StringName, GDScriptFunction *>::Element *E = p_script->member_functions.front(); E; E = E->next()) {
 		memdelete(E->get());
 	}
@@ -2189,5 +2245,19 @@ int GDScriptCompiler::get_error_column() const {
 	return err_column;
 }
 
+void GDScriptCompiler::set_export_target(bool p_debug) {
+
+	debug_code = p_debug;
+	debug_stack = p_debug;
+}
+
 GDScriptCompiler::GDScriptCompiler() {
+
+#ifdef DEBUG_ENABLED
+	debug_code = true;
+#else
+	debug_code = false;
+#endif
+	debug_stack = ScriptDebugger::get_singleton() != NULL;
+	optimize_code = !GDScriptLanguage::get_singleton() || GDScriptLanguage::get_singleton()->is_bytecode_optimization_enabled();
 }
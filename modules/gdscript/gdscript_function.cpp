@@ -30,9 +30,12 @@
 
 #include "gdscript_function.h"
 
+#include "core/core_string_names.h"
 #include "core/os/os.h"
 #include "gdscript.h"
 #include "gdscript_functions.h"
+#include "gdscript_jit.h"
+#include "scene/main/scene_tree.h"
 
 Variant *GDScriptFunction::_get_variant(int p_address, GDScriptInstance *p_instance, GDScript *p_script, Variant &self, Variant *p_stack, String &r_error) const {
 
@@ -159,6 +162,323 @@ static String _get_var_type(const Variant *p_var) {
 }
 #endif // DEBUG_ENABLED
 
+// Fast paths for integer indexing and iteration of arrays and int ranges, skipping the generic
+// Variant dispatch and the temporary Variants it creates. They return false to
+// fall back to the generic path, which also takes care of reporting errors.
+
+template <class T>
+static _FORCE_INLINE_ bool _get_pool_indexed(const Variant *p_base, int64_t p_index, Variant *r_dst) {
+
+	const PoolVector<T> &arr = p_base->get_pool_vector_unchecked<T>();
+	if (p_index < 0 || p_index >= arr.size())
+		return false;
+	T value = arr.read()[p_index]; // dst may be the base itself
+	*r_dst = value;
+	return true;
+}
+
+bool GDScriptFunction::_get_indexed_fast(const Variant *p_base, const Variant *p_index, Variant *r_dst) {
+
+	if (p_index->get_type() != Variant::INT)
+		return false;
+	int64_t index = *p_index;
+
+	switch (p_base->get_type()) {
+		case Variant::ARRAY: {
+			const Array &arr = p_base->get_array_unchecked();
+			if (index < 0 || index >= arr.size())
+				return false;
+			if (r_dst == p_base) {
+				Variant value = arr[index];
+				*r_dst = value;
+			} else {
+				*r_dst = arr[index];
+			}
+			return true;
+		} break;
+		case Variant::POOL_INT_ARRAY: return _get_pool_indexed<int>(p_base, index, r_dst);
+		case Variant::POOL_REAL_ARRAY: return _get_pool_indexed<real_t>(p_base, index, r_dst);
+		case Variant::POOL_VECTOR2_ARRAY: return _get_pool_indexed<Vector2>(p_base, index, r_dst);
+		case Variant::POOL_VECTOR3_ARRAY: return _get_pool_indexed<Vector3>(p_base, index, r_dst);
+		default: {
+		}
+	}
+	return false;
+}
+
+template <class T>
+static _FORCE_INLINE_ bool _set_pool_indexed(Variant *p_base, int64_t p_index, const T &p_value) {
+
+	PoolVector<T> &arr = p_base->get_pool_vector_unchecked<T>();
+	if (p_index < 0 || p_index >= arr.size())
+		return false;
+	arr.write()[p_index] = p_value;
+	return true;
+}
+
+bool GDScriptFunction::_set_indexed_fast(Variant *p_base, const Variant *p_index, const Variant *p_value) {
+
+	if (p_index->get_type() != Variant::INT)
+		return false;
+	int64_t index = *p_index;
+
+	// Values needing a conversion take the generic path.
+	switch (p_base->get_type()) {
+		case Variant::ARRAY: {
+			Array &arr = p_base->get_array_unchecked();
+			if (index < 0 || index >= arr.size())
+				return false;
+			arr.set(index, *p_value);
+			return true;
+		} break;
+		case Variant::POOL_INT_ARRAY: {
+			return p_value->get_type() == Variant::INT && _set_pool_indexed<int>(p_base, index, *p_value);
+		} break;
+		case Variant::POOL_REAL_ARRAY: {
+			return p_value->get_type() == Variant::REAL && _set_pool_indexed<real_t>(p_base, index, *p_value);
+		} break;
+		case Variant::POOL_VECTOR2_ARRAY: {
+			return p_value->get_type() == Variant::VECTOR2 && _set_pool_indexed<Vector2>(p_base, index, *p_value);
+		} break;
+		case Variant::POOL_VECTOR3_ARRAY: {
+			return p_value->get_type() == Variant::VECTOR3 && _set_pool_indexed<Vector3>(p_base, index, *p_value);
+		} break;
+		default: {
+		}
+	}
+	return false;
+}
+
+// Stores into slots that already hold the type write the value in place, so typed locals
+// and the temporaries feeding them keep their storage and skip the operator= type switches.
+static _FORCE_INLINE_ void _store_bool(Variant *r_dst, bool p_value) {
+	if (likely(r_dst->get_type() == Variant::BOOL))
+		r_dst->set_bool_unchecked(p_value);
+	else
+		*r_dst = p_value;
+}
+
+static _FORCE_INLINE_ void _store_int(Variant *r_dst, int64_t p_value) {
+	if (likely(r_dst->get_type() == Variant::INT))
+		r_dst->set_int_unchecked(p_value);
+	else
+		*r_dst = p_value;
+}
+
+static _FORCE_INLINE_ void _store_real(Variant *r_dst, double p_value) {
+	if (likely(r_dst->get_type() == Variant::REAL))
+		r_dst->set_real_unchecked(p_value);
+	else
+		*r_dst = p_value;
+}
+
+static _FORCE_INLINE_ void _store_vector2(Variant *r_dst, const Vector2 &p_value) {
+	if (likely(r_dst->get_type() == Variant::VECTOR2))
+		r_dst->set_vector2_unchecked(p_value);
+	else
+		*r_dst = p_value;
+}
+
+static _FORCE_INLINE_ void _store_vector3(Variant *r_dst, const Vector3 &p_value) {
+	if (likely(r_dst->get_type() == Variant::VECTOR3))
+		r_dst->set_vector3_unchecked(p_value);
+	else
+		*r_dst = p_value;
+}
+
+// Iteration keeps the same integer counter as Variant::iter_next, so both paths can mix.
+template <class T>
+static _FORCE_INLINE_ bool _iterate_pool(const Variant *p_container, int64_t p_index, Variant *r_counter, Variant *r_iterator) {
+
+	const PoolVector<T> &arr = p_container->get_pool_vector_unchecked<T>();
+	if (p_index >= arr.size())
+		return false;
+	*r_counter = p_index;
+	*r_iterator = arr.read()[p_index];
+	return true;
+}
+
+bool GDScriptFunction::_iterate_fast(const Variant *p_container, int64_t p_index, Variant *r_counter, Variant *r_iterator, bool &r_more) {
+
+	switch (p_container->get_type()) {
+		case Variant::INT: {
+			r_more = p_index < p_container->get_int_unchecked();
+			if (r_more) {
+				_store_int(r_counter, p_index);
+				_store_int(r_iterator, p_index);
+			}
+		} break;
+		case Variant::ARRAY: {
+			const Array &arr = p_container->get_array_unchecked();
+			r_more = p_index < arr.size();
+			if (r_more) {
+				*r_counter = p_index;
+				*r_iterator = arr[p_index];
+			}
+		} break;
+		case Variant::POOL_INT_ARRAY: r_more = _iterate_pool<int>(p_container, p_index, r_counter, r_iterator); break;
+		case Variant::POOL_REAL_ARRAY: r_more = _iterate_pool<real_t>(p_container, p_index, r_counter, r_iterator); break;
+		case Variant::POOL_VECTOR2_ARRAY: r_more = _iterate_pool<Vector2>(p_container, p_index, r_counter, r_iterator); break;
+		case Variant::POOL_VECTOR3_ARRAY: r_more = _iterate_pool<Vector3>(p_container, p_index, r_counter, r_iterator); break;
+		default: {
+			return false;
+		}
+	}
+	return true;
+}
+
+int GDScriptFunction::get_typed_operands(Variant::Operator p_op, Variant::Type p_type_a, Variant::Type p_type_b) {
+
+	bool compare = p_op == Variant::OP_EQUAL || p_op == Variant::OP_NOT_EQUAL || p_op == Variant::OP_LESS || p_op == Variant::OP_LESS_EQUAL || p_op == Variant::OP_GREATER || p_op == Variant::OP_GREATER_EQUAL;
+	bool arithmetic = p_op == Variant::OP_ADD || p_op == Variant::OP_SUBTRACT || p_op == Variant::OP_MULTIPLY || p_op == Variant::OP_DIVIDE;
+
+	if (p_type_a == Variant::INT && p_type_b == Variant::INT)
+		return compare || arithmetic || p_op == Variant::OP_MODULE || p_op == Variant::OP_NEGATE ? TYPED_INT : -1;
+	if (p_type_a == Variant::REAL && p_type_b == Variant::REAL)
+		return compare || arithmetic || p_op == Variant::OP_NEGATE ? TYPED_REAL : -1;
+	if (p_type_a == Variant::INT && p_type_b == Variant::REAL)
+		return compare || arithmetic ? TYPED_INT_REAL : -1;
+	if (p_type_a == Variant::REAL && p_type_b == Variant::INT)
+		return compare || arithmetic ? TYPED_REAL_INT : -1;
+
+	bool vector_op = p_op == Variant::OP_EQUAL || p_op == Variant::OP_NOT_EQUAL || arithmetic || p_op == Variant::OP_NEGATE;
+	if (p_type_a == Variant::VECTOR2 && p_type_b == Variant::VECTOR2)
+		return vector_op ? TYPED_VECTOR2 : -1;
+	if (p_type_a == Variant::VECTOR3 && p_type_b == Variant::VECTOR3)
+		return vector_op ? TYPED_VECTOR3 : -1;
+
+	bool scale_op = p_op == Variant::OP_MULTIPLY || p_op == Variant::OP_DIVIDE;
+	if (p_type_a == Variant::VECTOR2 && p_type_b == Variant::REAL)
+		return scale_op ? TYPED_VECTOR2_REAL : -1;
+	if (p_type_a == Variant::VECTOR3 && p_type_b == Variant::REAL)
+		return scale_op ? TYPED_VECTOR3_REAL : -1;
+
+	return -1;
+}
+
+// Same results as Variant::evaluate(). Returns false when the operands don't have the expected
+// types after all, or the operation fails, so the caller can take the generic path.
+static _FORCE_INLINE_ bool _evaluate_typed(Variant::Operator p_op, int p_operands, const Variant &p_a, const Variant &p_b, Variant *r_dst) {
+
+	switch (p_operands) {
+		case GDScriptFunction::TYPED_INT: {
+			if (unlikely(p_a.get_type() != Variant::INT || p_b.get_type() != Variant::INT))
+				return false;
+			int64_t a = p_a.get_int_unchecked();
+			int64_t b = p_b.get_int_unchecked();
+			switch (p_op) {
+				case Variant::OP_EQUAL: _store_bool(r_dst, a == b); return true;
+				case Variant::OP_NOT_EQUAL: _store_bool(r_dst, a != b); return true;
+				case Variant::OP_LESS: _store_bool(r_dst, a < b); return true;
+				case Variant::OP_LESS_EQUAL: _store_bool(r_dst, a <= b); return true;
+				case Variant::OP_GREATER: _store_bool(r_dst, a > b); return true;
+				case Variant::OP_GREATER_EQUAL: _store_bool(r_dst, a >= b); return true;
+				case Variant::OP_ADD: _store_int(r_dst, a + b); return true;
+				case Variant::OP_SUBTRACT: _store_int(r_dst, a - b); return true;
+				case Variant::OP_MULTIPLY: _store_int(r_dst, a * b); return true;
+				case Variant::OP_DIVIDE: {
+					if (b == 0)
+						return false;
+					_store_int(r_dst, a / b);
+					return true;
+				}
+				case Variant::OP_MODULE: {
+					if (b == 0)
+						return false;
+					_store_int(r_dst, a % b);
+					return true;
+				}
+				case Variant::OP_NEGATE: _store_int(r_dst, -a); return true;
+				default: return false;
+			}
+		}
+		case GDScriptFunction::TYPED_REAL:
+		case GDScriptFunction::TYPED_INT_REAL:
+		case GDScriptFunction::TYPED_REAL_INT: {
+			Variant::Type type_a = p_operands == GDScriptFunction::TYPED_INT_REAL ? Variant::INT : Variant::REAL;
+			Variant::Type type_b = p_operands == GDScriptFunction::TYPED_REAL_INT ? Variant::INT : Variant::REAL;
+			if (unlikely(p_a.get_type() != type_a || p_b.get_type() != type_b))
+				return false;
+			double a = type_a == Variant::INT ? (double)p_a.get_int_unchecked() : p_a.get_real_unchecked();
+			double b = type_b == Variant::INT ? (double)p_b.get_int_unchecked() : p_b.get_real_unchecked();
+			switch (p_op) {
+				case Variant::OP_EQUAL: _store_bool(r_dst, a == b); return true;
+				case Variant::OP_NOT_EQUAL: _store_bool(r_dst, a != b); return true;
+				case Variant::OP_LESS: _store_bool(r_dst, a < b); return true;
+				case Variant::OP_LESS_EQUAL: _store_bool(r_dst, a <= b); return true;
+				case Variant::OP_GREATER: _store_bool(r_dst, a > b); return true;
+				case Variant::OP_GREATER_EQUAL: _store_bool(r_dst, a >= b); return true;
+				case Variant::OP_ADD: _store_real(r_dst, a + b); return true;
+				case Variant::OP_SUBTRACT: _store_real(r_dst, a - b); return true;
+				case Variant::OP_MULTIPLY: _store_real(r_dst, a * b); return true;
+				case Variant::OP_DIVIDE: {
+#ifdef DEBUG_ENABLED
+					if (b == 0)
+						return false;
+#endif
+					_store_real(r_dst, a / b);
+					return true;
+				}
+				case Variant::OP_NEGATE: _store_real(r_dst, -a); return true;
+				default: return false;
+			}
+		}
+		case GDScriptFunction::TYPED_VECTOR2: {
+			if (unlikely(p_a.get_type() != Variant::VECTOR2 || p_b.get_type() != Variant::VECTOR2))
+				return false;
+			const Vector2 &a = p_a.get_vector2_unchecked();
+			const Vector2 &b = p_b.get_vector2_unchecked();
+			switch (p_op) {
+				case Variant::OP_EQUAL: _store_bool(r_dst, a == b); return true;
+				case Variant::OP_NOT_EQUAL: _store_bool(r_dst, a != b); return true;
+				case Variant::OP_ADD: _store_vector2(r_dst, a + b); return true;
+				case Variant::OP_SUBTRACT: _store_vector2(r_dst, a - b); return true;
+				case Variant::OP_MULTIPLY: _store_vector2(r_dst, a * b); return true;
+				case Variant::OP_DIVIDE: _store_vector2(r_dst, a / b); return true;
+				case Variant::OP_NEGATE: _store_vector2(r_dst, -a); return true;
+				default: return false;
+			}
+		}
+		case GDScriptFunction::TYPED_VECTOR3: {
+			if (unlikely(p_a.get_type() != Variant::VECTOR3 || p_b.get_type() != Variant::VECTOR3))
+				return false;
+			const Vector3 &a = p_a.get_vector3_unchecked();
+			const Vector3 &b = p_b.get_vector3_unchecked();
+			switch (p_op) {
+				case Variant::OP_EQUAL: _store_bool(r_dst, a == b); return true;
+				case Variant::OP_NOT_EQUAL: _store_bool(r_dst, a != b); return true;
+				case Variant::OP_ADD: _store_vector3(r_dst, a + b); return true;
+				case Variant::OP_SUBTRACT: _store_vector3(r_dst, a - b); return true;
+				case Variant::OP_MULTIPLY: _store_vector3(r_dst, a * b); return true;
+				case Variant::OP_DIVIDE: _store_vector3(r_dst, a / b); return true;
+				case Variant::OP_NEGATE: _store_vector3(r_dst, -a); return true;
+				default: return false;
+			}
+		}
+		case GDScriptFunction::TYPED_VECTOR2_REAL: {
+			if (unlikely(p_a.get_type() != Variant::VECTOR2 || p_b.get_type() != Variant::REAL))
+				return false;
+			real_t b = p_b.get_real_unchecked();
+			switch (p_op) {
+				case Variant::OP_MULTIPLY: _store_vector2(r_dst, p_a.get_vector2_unchecked() * b); return true;
+				case Variant::OP_DIVIDE: _store_vector2(r_dst, p_a.get_vector2_unchecked() / b); return true;
+				default: return false;
+			}
+		}
+		case GDScriptFunction::TYPED_VECTOR3_REAL: {
+			if (unlikely(p_a.get_type() != Variant::VECTOR3 || p_b.get_type() != Variant::REAL))
+				return false;
+			real_t b = p_b.get_real_unchecked();
+			switch (p_op) {
+				case Variant::OP_MULTIPLY: _store_vector3(r_dst, p_a.get_vector3_unchecked() * b); return true;
+				case Variant::OP_DIVIDE: _store_vector3(r_dst, p_a.get_vector3_unchecked() / b); return true;
+				default: return false;
+			}
+		}
+	}
+	return false;
+}
+
 String GDScriptFunction::_get_call_error(const Variant::CallError &p_err, const String &p_where, const Variant **argptrs) const {
 
 	String err_text;
@@ -189,10 +509,260 @@ String GDScriptFunction::_get_call_error(const Variant::CallError &p_err, const
 	return err_text;
 }
 
+/* Inline caches */
+
+bool GDScriptFunction::_inline_cache_receiver(const Variant *p_base, Object *&r_object, GDScriptInstance *&r_instance, const GDScript *&r_script) {
+
+	if (p_base->get_type() != Variant::OBJECT)
+		return false;
+
+	Object *obj = *p_base;
+	if (!obj)
+		return false;
+#ifdef DEBUG_ENABLED
+	if (ScriptDebugger::get_singleton() && !p_base->is_ref() && !ObjectDB::instance_validate(obj))
+		return false; // let the generic path report the stray pointer
+#endif
+
+	ScriptInstance *si = obj->get_script_instance();
+	if (si) {
+		// Other languages resolve members dynamically, leave them to the generic path.
+		if (si->get_language() != GDScriptLanguage::get_singleton() || si->is_placeholder())
+			return false;
+		r_instance = static_cast<GDScriptInstance *>(si);
+		r_script = r_instance->script.ptr();
+	} else {
+		r_instance = NULL;
+		r_script = NULL;
+	}
+
+	r_object = obj;
+	return true;
+}
+
+const GDScriptInlineCache::Entry *GDScriptFunction::_inline_cache_find(const GDScriptInlineCache *p_cache, const Object *p_object, const GDScript *p_script) {
+
+	const StringName *class_name = &p_object->get_class_name();
+	uint32_t epoch = GDScriptLanguage::get_singleton()->get_inline_cache_epoch();
+
+	for (int i = 0; i < GDScriptInlineCache::MAX_ENTRIES; i++) {
+		const GDScriptInlineCache::Entry &e = p_cache->entries[i];
+		if (e.epoch == epoch && e.class_name == class_name && e.script == p_script)
+			return &e;
+	}
+	return NULL;
+}
+
+GDScriptInlineCache::Entry *GDScriptFunction::_inline_cache_slot(GDScriptInlineCache *p_cache) {
+
+	// Only the main thread fills entries, other threads just read published ones.
+	if (Thread::get_caller_id() != Thread::get_main_id())
+		return NULL;
+
+	uint32_t epoch = GDScriptLanguage::get_singleton()->get_inline_cache_epoch();
+	for (int i = 0; i < GDScriptInlineCache::MAX_ENTRIES; i++) {
+		if (p_cache->entries[i].epoch != epoch)
+			return &p_cache->entries[i];
+	}
+	return NULL; // megamorphic, entries are never replaced while valid
+}
+
+void GDScriptFunction::_inline_cache_publish(GDScriptInlineCache::Entry *p_entry, const Object *p_object, const GDScript *p_script) {
+
+	p_entry->class_name = &p_object->get_class_name();
+	p_entry->script = p_script;
+	// Stale entries never match, so writing the epoch last makes the entry visible atomically.
+	atomic_exchange_if_greater(&p_entry->epoch, GDScriptLanguage::get_singleton()->get_inline_cache_epoch());
+}
+
+void GDScriptFunction::_inline_cache_fill_call(GDScriptInlineCache *p_cache, const Object *p_object, const GDScript *p_script, const StringName &p_method) {
+
+	if (p_method == CoreStringNames::get_singleton()->_free)
+		return; // has to go through Object::call every time
+
+	GDScriptInlineCache::Entry *e = _inline_cache_slot(p_cache);
+	if (!e)
+		return;
+
+	for (const GDScript *sptr = p_script; sptr; sptr = sptr->_base) {
+		const Map<StringName, GDScriptFunction *>::Element *E = sptr->member_functions.find(p_method);
+		if (E) {
+			e->kind = GDScriptInlineCache::KIND_FUNCTION;
+			e->function = E->get();
+			_inline_cache_publish(e, p_object, p_script);
+			return;
+		}
+	}
+
+	MethodBind *method = ClassDB::get_method(p_object->get_class_name(), p_method);
+	if (!method)
+		return;
+
+	e->kind = GDScriptInlineCache::KIND_METHOD;
+	e->method = method;
+	_inline_cache_publish(e, p_object, p_script);
+}
+
+void GDScriptFunction::_inline_cache_fill_property(GDScriptInlineCache *p_cache, const Object *p_object, const GDScript *p_script, const StringName &p_name, bool p_set) {
+
+	GDScriptInlineCache::Entry *e = _inline_cache_slot(p_cache);
+	if (!e)
+		return;
+
+	if (p_script) {
+		// Mirrors GDScriptInstance::set() and get(), anything dynamic is not cached.
+		const Map<StringName, GDScript::MemberInfo>::Element *E = p_script->member_indices.find(p_name);
+		if (E) {
+			if ((p_set ? E->get().setter : E->get().getter) != StringName())
+				return;
+
+			e->kind = GDScriptInlineCache::KIND_MEMBER;
+			e->index = E->get().index;
+			e->member_type = &E->get().data_type;
+			_inline_cache_publish(e, p_object, p_script);
+			return;
+		}
+
+		const StringName &fallback = p_set ? GDScriptLanguage::get_singleton()->strings._set : GDScriptLanguage::get_singleton()->strings._get;
+		for (const GDScript *sptr = p_script; sptr; sptr = sptr->_base) {
+			if (sptr->member_functions.has(fallback) || (!p_set && sptr->constants.has(p_name)))
+				return;
+		}
+	}
+
+	ClassDB::PropertySetGet psg;
+	if (!ClassDB::get_property_setget(p_object->get_class_name(), p_name, &psg))
+		return;
+
+	const StringName &accessor = p_set ? psg.setter : psg.getter;
+	MethodBind *method = p_set ? psg._setptr : psg._getptr;
+
+	if (psg.index >= 0) {
+		// Indexed accessors go through Object::call, so a script function of that name would win.
+		for (const GDScript *sptr = p_script; sptr; sptr = sptr->_base) {
+			if (sptr->member_functions.has(accessor))
+				return;
+		}
+		method = accessor != StringName() ? ClassDB::get_method(p_object->get_class_name(), accessor) : NULL;
+	}
+
+	if (!method)
+		return;
+
+	e->kind = GDScriptInlineCache::KIND_PROPERTY;
+	e->index = psg.index;
+	e->method = method;
+	_inline_cache_publish(e, p_object, p_script);
+}
+
+bool GDScriptFunction::_inline_cache_call(GDScriptInlineCache *p_cache, const Variant *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant *r_ret, Variant::CallError &r_error) {
+
+	Object *obj;
+	GDScriptInstance *instance;
+	const GDScript *script;
+	if (!_inline_cache_receiver(p_base, obj, instance, script))
+		return false;
+
+	const GDScriptInlineCache::Entry *e = _inline_cache_find(p_cache, obj, script);
+	if (!e) {
+		_inline_cache_fill_call(p_cache, obj, script, p_method);
+		return false;
+	}
+
+	r_error.error = Variant::CallError::CALL_OK;
+
+	Variant ret;
+	{
+#ifdef DEBUG_ENABLED
+		_ObjectDebugLock debug_lock(obj);
+#endif
+		if (e->kind == GDScriptInlineCache::KIND_FUNCTION) {
+			ret = e->function->call(instance, p_args, p_argcount, r_error);
+		} else {
+			ret = e->method->call(obj, p_args, p_argcount, r_error);
+		}
+	}
+
+	if (r_error.error == Variant::CallError::CALL_OK && r_ret)
+		*r_ret = ret;
+	return true;
+}
+
+bool GDScriptFunction::_inline_cache_get(GDScriptInlineCache *p_cache, const Variant *p_base, const StringName &p_name, Variant &r_ret) {
+
+	Object *obj;
+	GDScriptInstance *instance;
+	const GDScript *script;
+	if (!_inline_cache_receiver(p_base, obj, instance, script))
+		return false;
+
+	const GDScriptInlineCache::Entry *e = _inline_cache_find(p_cache, obj, script);
+	if (!e) {
+		_inline_cache_fill_property(p_cache, obj, script, p_name, false);
+		return false;
+	}
+
+	if (e->kind == GDScriptInlineCache::KIND_MEMBER) {
+		r_ret = instance->members[e->index];
+		return true;
+	}
+
+	Variant::CallError ce;
+	if (e->index >= 0) {
+		Variant index = e->index;
+		const Variant *arg[1] = { &index };
+		r_ret = e->method->call(obj, arg, 1, ce);
+	} else {
+		r_ret = e->method->call(obj, NULL, 0, ce);
+	}
+	return ce.error == Variant::CallError::CALL_OK; // the slow path reports the error
+}
+
+bool GDScriptFunction::_inline_cache_set(GDScriptInlineCache *p_cache, const Variant *p_base, const StringName &p_name, const Variant &p_value, bool &r_valid) {
+
+	Object *obj;
+	GDScriptInstance *instance;
+	const GDScript *script;
+	if (!_inline_cache_receiver(p_base, obj, instance, script))
+		return false;
+
+	const GDScriptInlineCache::Entry *e = _inline_cache_find(p_cache, obj, script);
+	if (!e) {
+		_inline_cache_fill_property(p_cache, obj, script, p_name, true);
+		return false;
+	}
+
+	if (e->kind == GDScriptInlineCache::KIND_MEMBER && !e->member_type->is_type(p_value))
+		return false; // needs a conversion, or fails with the proper error
+
+#ifdef TOOLS_ENABLED
+	obj->_set_edited_flag();
+#endif
+
+	if (e->kind == GDScriptInlineCache::KIND_MEMBER) {
+		instance->members.write[e->index] = p_value;
+		r_valid = true;
+		return true;
+	}
+
+	Variant::CallError ce;
+	if (e->index >= 0) {
+		Variant index = e->index;
+		const Variant *arg[2] = { &index, &p_value };
+		e->method->call(obj, arg, 2, ce);
+	} else {
+		const Variant *arg[1] = { &p_value };
+		e->method->call(obj, arg, 1, ce);
+	}
+	r_valid = ce.error == Variant::CallError::CALL_OK;
+	return true;
+}
+
 #if defined(__GNUC__)
 #define OPCODES_TABLE                         \
 	static const void *switch_table_ops[] = { \
 		&&OPCODE_OPERATOR,                    \
+		&&OPCODE_OPERATOR_TYPED,              \
 		&&OPCODE_EXTENDS_TEST,                \
 		&&OPCODE_IS_BUILTIN,                  \
 		&&OPCODE_SET,                         \
@@ -281,17 +851,20 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #endif
 
 	uint32_t alloca_size = 0;
+	uint8_t *frame = NULL; // pooled frame owned by this call, handed over on yield
 	GDScript *script;
 	int ip = 0;
 	int line = _initial_line;
 
 	if (p_state) {
-		//use existing (supplied) state (yielded)
-		stack = (Variant *)p_state->stack.ptr();
-		call_args = (Variant **)&p_state->stack.ptr()[sizeof(Variant) * p_state->stack_size]; //ptr() to avoid bounds check
+		//use existing (supplied) state (yielded), in place
+		frame = p_state->stack;
+		p_state->stack = NULL;
+		alloca_size = p_state->alloca_size;
+		stack = p_state->stack_size ? (Variant *)frame : NULL;
+		call_args = frame ? (Variant **)&frame[sizeof(Variant) * p_state->stack_size] : NULL;
 		line = p_state->line;
 		ip = p_state->ip;
-		alloca_size = p_state->stack.size();
 		script = p_state->script.ptr();
 		p_instance = p_state->instance;
 		defarg = p_state->defarg;
@@ -323,7 +896,13 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 		if (alloca_size) {
 
-			uint8_t *aptr = (uint8_t *)alloca(alloca_size);
+			uint8_t *aptr;
+			if (_yields) {
+				frame = GDScriptFramePool::alloc(alloca_size);
+				aptr = frame;
+			} else {
+				aptr = (uint8_t *)alloca(alloca_size);
+			}
 
 			if (_stack_size) {
 
@@ -433,6 +1012,43 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	bool yielded = false;
 #endif
 
+	if (!p_state && _fully_typed && !_jit_disabled && GDScriptLanguage::get_singleton()->jit_enabled) {
+
+		GDScriptJIT *jit = _jit;
+		if (!jit && ++_jit_call_count >= GDScriptLanguage::get_singleton()->jit_threshold) {
+			jit = _jit_compile();
+		}
+
+#ifdef DEBUG_ENABLED
+		// Breakpoints and stepping need the interpreter.
+		if (ScriptDebugger::get_singleton())
+			jit = NULL;
+#endif
+
+		if (jit) {
+			GDScriptJIT::Frame frame;
+			frame.bases[ADDR_TYPE_SELF] = &self;
+			frame.bases[ADDR_TYPE_CLASS] = &script->_static_ref;
+			frame.bases[ADDR_TYPE_MEMBER] = p_instance ? p_instance->members.ptrw() : NULL;
+			frame.bases[ADDR_TYPE_CLASS_CONSTANT] = NULL;
+			frame.bases[ADDR_TYPE_LOCAL_CONSTANT] = _constants_ptr;
+			frame.bases[ADDR_TYPE_STACK] = stack;
+			frame.bases[ADDR_TYPE_STACK_VARIABLE] = stack;
+			frame.bases[ADDR_TYPE_GLOBAL] = GDScriptLanguage::get_singleton()->get_global_array();
+			frame.bases[ADDR_TYPE_NAMED_GLOBAL] = NULL;
+			frame.bases[ADDR_TYPE_NIL] = &nil;
+			frame.call_args = call_args;
+			frame.retvalue = &retvalue;
+			frame.defarg = defarg;
+
+			if (jit->run(frame, ip, line)) {
+				ip = _code_size - 1; // OPCODE_END, leave through the regular exit
+			} else if (++_jit_deopt_count >= GDScriptJIT::MAX_DEOPTS) {
+				_jit_disabled = true; // keeps bailing out, not worth it
+			}
+		}
+	}
+
 #ifdef DEBUG_ENABLED
 	OPCODE_WHILE(ip < _code_size) {
 		int last_opcode = _code_ptr[ip];
@@ -479,6 +1095,41 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_OPERATOR_TYPED) {
+
+				CHECK_SPACE(6);
+
+				Variant::Operator op = (Variant::Operator)_code_ptr[ip + 1];
+				int operands = _code_ptr[ip + 2];
+				GD_ERR_BREAK(op >= Variant::OP_MAX || operands < 0 || operands >= TYPED_MAX);
+
+				GET_VARIANT_PTR(a, 3);
+				GET_VARIANT_PTR(b, 4);
+				GET_VARIANT_PTR(dst, 5);
+
+				if (unlikely(!_evaluate_typed(op, operands, *a, *b, dst))) {
+
+					bool valid;
+					Variant ret;
+					Variant::evaluate(op, *a, *b, ret, valid);
+#ifdef DEBUG_ENABLED
+					if (!valid) {
+
+						if (ret.get_type() == Variant::STRING) {
+							err_text = ret;
+							err_text += " in operator '" + Variant::get_operator_name(op) + "'.";
+						} else {
+							err_text = "Invalid operands '" + Variant::get_type_name(a->get_type()) + "' and '" + Variant::get_type_name(b->get_type()) + "' in operator '" + Variant::get_operator_name(op) + "'.";
+						}
+						OPCODE_BREAK;
+					}
+#endif
+					*dst = ret;
+				}
+				ip += 6;
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_EXTENDS_TEST) {
 
 				CHECK_SPACE(4);
@@ -572,8 +1223,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GET_VARIANT_PTR(index, 2);
 				GET_VARIANT_PTR(value, 3);
 
-				bool valid;
-				dst->set(*index, *value, &valid);
+				bool valid = _set_indexed_fast(dst, index, value);
+				if (!valid)
+					dst->set(*index, *value, &valid);
 
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -599,6 +1251,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GET_VARIANT_PTR(index, 2);
 				GET_VARIANT_PTR(dst, 3);
 
+				if (_get_indexed_fast(src, index, dst)) {
+					ip += 4;
+					DISPATCH_OPCODE;
+				}
+
 				bool valid;
 #ifdef DEBUG_ENABLED
 				//allow better error message in cases where src and dst are the same stack position
@@ -626,7 +1283,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 			OPCODE(OPCODE_SET_NAMED) {
 
-				CHECK_SPACE(3);
+				CHECK_SPACE(4);
 
 				GET_VARIANT_PTR(dst, 1);
 				GET_VARIANT_PTR(value, 3);
@@ -636,8 +1293,13 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
+				int cache = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache < 0 || cache >= _inline_cache_count);
+
 				bool valid;
-				dst->set_named(*index, *value, &valid);
+				if (!_inline_cache_set(&_inline_caches_ptr[cache], dst, *index, *value, valid)) {
+					dst->set_named(*index, *value, &valid);
+				}
 
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -646,30 +1308,31 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					OPCODE_BREAK;
 				}
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_GET_NAMED) {
 
-				CHECK_SPACE(4);
+				CHECK_SPACE(5);
 
 				GET_VARIANT_PTR(src, 1);
-				GET_VARIANT_PTR(dst, 3);
+				GET_VARIANT_PTR(dst, 4);
 
 				int indexname = _code_ptr[ip + 2];
 
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
-				bool valid;
-#ifdef DEBUG_ENABLED
-				//allow better error message in cases where src and dst are the same stack position
-				Variant ret = src->get_named(*index, &valid);
+				int cache = _code_ptr[ip + 3];
+				GD_ERR_BREAK(cache < 0 || cache >= _inline_cache_count);
 
-#else
-				*dst = src->get_named(*index, &valid);
-#endif
+				//src and dst may be the same stack position, so always go through a temporary
+				Variant ret;
+				bool valid = _inline_cache_get(&_inline_caches_ptr[cache], src, *index, ret);
+				if (!valid) {
+					ret = src->get_named(*index, &valid);
+				}
 #ifdef DEBUG_ENABLED
 				if (!valid) {
 					if (src->has_method(*index)) {
@@ -679,9 +1342,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					}
 					OPCODE_BREAK;
 				}
-				*dst = ret;
 #endif
-				ip += 4;
+				*dst = ret;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1060,8 +1723,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(nameg < 0 || nameg >= _global_names_count);
 				const StringName *methodname = &_global_names_ptr[nameg];
 
+				int cache = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache < 0 || cache >= _inline_cache_count);
+
 				GD_ERR_BREAK(argc < 0);
-				ip += 4;
+				ip += 5;
 				CHECK_SPACE(argc + 1);
 				Variant **argptrs = call_args;
 
@@ -1079,13 +1745,16 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 #endif
 				Variant::CallError err;
+				Variant *ret = NULL;
 				if (call_ret) {
 
-					GET_VARIANT_PTR(ret, argc);
-					base->call_ptr(*methodname, (const Variant **)argptrs, argc, ret, err);
-				} else {
+					GET_VARIANT_PTR(dst, argc);
+					ret = dst;
+				}
+
+				if (!_inline_cache_call(&_inline_caches_ptr[cache], base, *methodname, (const Variant **)argptrs, argc, ret, err)) {
 
-					base->call_ptr(*methodname, (const Variant **)argptrs, argc, NULL, err);
+					base->call_ptr(*methodname, (const Variant **)argptrs, argc, ret, err);
 				}
 #ifdef DEBUG_ENABLED
 				if (GDScriptLanguage::get_singleton()->profiling) {
@@ -1260,30 +1929,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					CHECK_SPACE(2);
 				}
 
-				Ref<GDScriptFunctionState> gdfs = memnew(GDScriptFunctionState);
-				gdfs->function = this;
-
-				gdfs->state.stack.resize(alloca_size);
-				//copy variant stack
-				for (int i = 0; i < _stack_size; i++) {
-					memnew_placement(&gdfs->state.stack.write[sizeof(Variant) * i], Variant(stack[i]));
-				}
-				gdfs->state.stack_size = _stack_size;
-				gdfs->state.self = self;
-				gdfs->state.alloca_size = alloca_size;
-				gdfs->state.script = Ref<GDScript>(_script);
-				gdfs->state.ip = ip + ipofs;
-				gdfs->state.line = line;
-				gdfs->state.instance_id = (p_instance && p_instance->get_owner()) ? p_instance->get_owner()->get_instance_id() : 0;
-				//gdfs->state.result_pos=ip+ipofs-1;
-				gdfs->state.defarg = defarg;
-				gdfs->state.instance = p_instance;
-				gdfs->function = this;
-
-				retvalue = gdfs;
+				// Resolve the signal before the stack is handed to the state.
+				Object *obj = NULL;
+				String signal;
 
 				if (_code_ptr[ip] == OPCODE_YIELD_SIGNAL) {
-					//do the oneshot connect
 					GET_VARIANT_PTR(argobj, 1);
 					GET_VARIANT_PTR(argname, 2);
 
@@ -1298,8 +1948,8 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					}
 #endif
 
-					Object *obj = argobj->operator Object *();
-					String signal = argname->operator String();
+					obj = argobj->operator Object *();
+					signal = argname->operator String();
 
 #ifdef DEBUG_ENABLED
 					if (!obj) {
@@ -1317,15 +1967,57 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 						err_text = "Second argument of yield() is an empty string (for signal name).";
 						OPCODE_BREAK;
 					}
+#endif
+				}
 
-					Error err = obj->connect(signal, gdfs.ptr(), "_signal_callback", varray(gdfs), Object::CONNECT_ONESHOT);
-					if (err != OK) {
-						err_text = "Error connecting to signal: " + signal + " during yield().";
-						OPCODE_BREAK;
+				Ref<GDScriptFunctionState> gdfs = memnew(GDScriptFunctionState);
+				gdfs->function = this;
+
+				if (frame) {
+					// Already pooled, the state takes the frame without copying.
+					gdfs->state.stack = frame;
+					frame = NULL;
+				} else if (alloca_size) {
+					// First yield of this function, move the alloca stack once.
+					gdfs->state.stack = GDScriptFramePool::alloc(alloca_size);
+					for (int i = 0; i < _stack_size; i++) {
+						memnew_placement(&gdfs->state.stack[sizeof(Variant) * i], Variant(stack[i]));
+						stack[i].~Variant();
 					}
+					_yields = true;
+				}
+				stack = NULL; // no longer ours to free
+				gdfs->state.stack_size = _stack_size;
+				gdfs->state.self = self;
+				gdfs->state.alloca_size = alloca_size;
+				gdfs->state.script = Ref<GDScript>(_script);
+				gdfs->state.ip = ip + ipofs;
+				gdfs->state.line = line;
+				gdfs->state.instance_id = (p_instance && p_instance->get_owner()) ? p_instance->get_owner()->get_instance_id() : 0;
+				//gdfs->state.result_pos=ip+ipofs-1;
+				gdfs->state.defarg = defarg;
+				gdfs->state.instance = p_instance;
+				gdfs->function = this;
+
+				retvalue = gdfs;
+
+				if (obj) {
+					SceneTreeTimer *timer = Object::cast_to<SceneTreeTimer>(obj);
+					if (timer && signal == "timeout") {
+						// Resumed straight from the timer wheel, without a signal connection.
+						timer->add_resume_state(gdfs);
+					} else {
+						//do the oneshot connect
+#ifdef DEBUG_ENABLED
+						Error err = obj->connect(signal, gdfs.ptr(), "_signal_callback", varray(gdfs), Object::CONNECT_ONESHOT);
+						if (err != OK) {
+							err_text = "Error connecting to signal: " + signal + " during yield().";
+							OPCODE_BREAK;
+						}
 #else
-					obj->connect(signal, gdfs.ptr(), "_signal_callback", varray(gdfs), Object::CONNECT_ONESHOT);
+						obj->connect(signal, gdfs.ptr(), "_signal_callback", varray(gdfs), Object::CONNECT_ONESHOT);
 #endif
+					}
 				}
 
 #ifdef DEBUG_ENABLED
@@ -1420,28 +2112,35 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 				GET_VARIANT_PTR(counter, 1);
 				GET_VARIANT_PTR(container, 2);
+				GET_VARIANT_PTR(iterator, 4);
 
-				bool valid;
-				if (!container->iter_init(*counter, valid)) {
+				bool more;
+				if (!_iterate_fast(container, 0, counter, iterator, more)) {
+
+					bool valid;
+					more = container->iter_init(*counter, valid);
 #ifdef DEBUG_ENABLED
 					if (!valid) {
 						err_text = "Unable to iterate on object of type '" + Variant::get_type_name(container->get_type()) + "'.";
 						OPCODE_BREAK;
 					}
 #endif
+					if (more) {
+						*iterator = container->iter_get(*counter, valid);
+#ifdef DEBUG_ENABLED
+						if (!valid) {
+							err_text = "Unable to obtain iterator object of type '" + Variant::get_type_name(container->get_type()) + "'.";
+							OPCODE_BREAK;
+						}
+#endif
+					}
+				}
+
+				if (!more) {
 					int jumpto = _code_ptr[ip + 3];
 					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
 					ip = jumpto;
 				} else {
-					GET_VARIANT_PTR(iterator, 4);
-
-					*iterator = container->iter_get(*counter, valid);
-#ifdef DEBUG_ENABLED
-					if (!valid) {
-						err_text = "Unable to obtain iterator object of type '" + Variant::get_type_name(container->get_type()) + "'.";
-						OPCODE_BREAK;
-					}
-#endif
 					ip += 5; //skip regular iterate which is always next
 				}
 			}
@@ -1453,28 +2152,36 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 				GET_VARIANT_PTR(counter, 1);
 				GET_VARIANT_PTR(container, 2);
+				GET_VARIANT_PTR(iterator, 4);
 
-				bool valid;
-				if (!container->iter_next(*counter, valid)) {
+				// The container can't change type, so a fast path counter is always an int here.
+				bool more;
+				if (counter->get_type() != Variant::INT || !_iterate_fast(container, counter->get_int_unchecked() + 1, counter, iterator, more)) {
+
+					bool valid;
+					more = container->iter_next(*counter, valid);
 #ifdef DEBUG_ENABLED
 					if (!valid) {
 						err_text = "Unable to iterate on object of type '" + Variant::get_type_name(container->get_type()) + "' (type changed since first iteration?).";
 						OPCODE_BREAK;
 					}
 #endif
+					if (more) {
+						*iterator = container->iter_get(*counter, valid);
+#ifdef DEBUG_ENABLED
+						if (!valid) {
+							err_text = "Unable to obtain iterator object of type '" + Variant::get_type_name(container->get_type()) + "' (but was obtained on first iteration?).";
+							OPCODE_BREAK;
+						}
+#endif
+					}
+				}
+
+				if (!more) {
 					int jumpto = _code_ptr[ip + 3];
 					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
 					ip = jumpto;
 				} else {
-					GET_VARIANT_PTR(iterator, 4);
-
-					*iterator = container->iter_get(*counter, valid);
-#ifdef DEBUG_ENABLED
-					if (!valid) {
-						err_text = "Unable to obtain iterator object of type '" + Variant::get_type_name(container->get_type()) + "' (but was obtained on first iteration?).";
-						OPCODE_BREAK;
-					}
-#endif
 					ip += 5; //loop again
 				}
 			}
@@ -1609,13 +2316,19 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			GDScriptLanguage::get_singleton()->exit_function();
 #endif
 
-		if (_stack_size) {
+		if (stack) {
 			//free stack
 			for (int i = 0; i < _stack_size; i++)
 				stack[i].~Variant();
 		}
+		if (frame) {
+			GDScriptFramePool::free(frame, alloca_size);
+		}
 
 #ifdef DEBUG_ENABLED
+	} else {
+		// Kept alive until resume() has emitted "completed", see above.
+		p_state->stack = frame;
 	}
 #endif
 
@@ -1742,11 +2455,38 @@ void GDScriptFunction::debug_get_stack_member_state(int p_line, List<Pair<String
 	}
 }
 
+GDScriptJIT *GDScriptFunction::_jit_compile() {
+
+	GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+	if (language->lock) {
+		language->lock->lock();
+	}
+
+	if (!_jit && !_jit_disabled) {
+		_jit = GDScriptJIT::compile(this);
+		_jit_disabled = !_jit;
+	}
+
+	if (language->lock) {
+		language->lock->unlock();
+	}
+
+	return _jit;
+}
+
 GDScriptFunction::GDScriptFunction() :
 		function_list(this) {
 
 	_stack_size = 0;
 	_call_size = 0;
+	_inline_caches_ptr = NULL;
+	_inline_cache_count = 0;
+	_fully_typed = false;
+	_yields = false;
+	_jit = NULL;
+	_jit_disabled = false;
+	_jit_call_count = 0;
+	_jit_deopt_count = 0;
 	rpc_mode = MultiplayerAPI::RPC_MODE_DISABLED;
 	name = "<anonymous>";
 #ifdef DEBUG_ENABLED
@@ -1775,6 +2515,10 @@ GDScriptFunction::GDScriptFunction() :
 }
 
 GDScriptFunction::~GDScriptFunction() {
+
+	if (_jit) {
+		memdelete(_jit);
+	}
 #ifdef DEBUG_ENABLED
 	if (GDScriptLanguage::get_singleton()->lock) {
 		GDScriptLanguage::get_singleton()->lock->lock();
@@ -1789,6 +2533,76 @@ GDScriptFunction::~GDScriptFunction() {
 
 /////////////////////
 
+SpinLock GDScriptFramePool::spin_lock;
+GDScriptFramePool::FreeFrame *GDScriptFramePool::free_frames[MAX_CLASS_SHIFT - MIN_CLASS_SHIFT + 1] = {};
+uint32_t GDScriptFramePool::free_count[MAX_CLASS_SHIFT - MIN_CLASS_SHIFT + 1] = {};
+
+int GDScriptFramePool::_get_class(uint32_t p_size) {
+
+	int shift = MIN_CLASS_SHIFT;
+	while ((1u << shift) < p_size) {
+		shift++;
+	}
+	return shift <= MAX_CLASS_SHIFT ? shift - MIN_CLASS_SHIFT : -1;
+}
+
+uint8_t *GDScriptFramePool::alloc(uint32_t p_size) {
+
+	int size_class = _get_class(p_size);
+	if (size_class < 0)
+		return (uint8_t *)memalloc(p_size); // too large to be worth keeping around
+
+	spin_lock.lock();
+	FreeFrame *frame = free_frames[size_class];
+	if (frame) {
+		free_frames[size_class] = frame->next;
+		free_count[size_class]--;
+	}
+	spin_lock.unlock();
+
+	if (!frame)
+		return (uint8_t *)memalloc(1u << (size_class + MIN_CLASS_SHIFT));
+	return (uint8_t *)frame;
+}
+
+void GDScriptFramePool::free(uint8_t *p_frame, uint32_t p_size) {
+
+	int size_class = _get_class(p_size);
+	if (size_class >= 0) {
+
+		spin_lock.lock();
+		bool keep = free_count[size_class] < MAX_FREE_PER_CLASS;
+		if (keep) {
+			FreeFrame *frame = (FreeFrame *)p_frame;
+			frame->next = free_frames[size_class];
+			free_frames[size_class] = frame;
+			free_count[size_class]++;
+		}
+		spin_lock.unlock();
+
+		if (keep)
+			return;
+	}
+
+	memfree(p_frame);
+}
+
+void GDScriptFramePool::clear() {
+
+	spin_lock.lock();
+	for (int i = 0; i <= MAX_CLASS_SHIFT - MIN_CLASS_SHIFT; i++) {
+		while (free_frames[i]) {
+			FreeFrame *frame = free_frames[i];
+			free_frames[i] = frame->next;
+			memfree(frame);
+		}
+		free_count[i] = 0;
+	}
+	spin_lock.unlock();
+}
+
+/////////////////////
+
 Variant GDScriptFunctionState::_signal_callback(const Variant **p_args, int p_argcount, Variant::CallError &r_error) {
 
 	Variant arg;
@@ -1876,12 +2690,7 @@ Variant GDScriptFunctionState::resume(const Variant &p_arg) {
 #ifdef DEBUG_ENABLED
 		if (ScriptDebugger::get_singleton())
 			GDScriptLanguage::get_singleton()->exit_function();
-		if (state.stack_size) {
-			//free stack
-			Variant *stack = (Variant *)state.stack.ptr();
-			for (int i = 0; i < state.stack_size; i++)
-				stack[i].~Variant();
-		}
+		_free_stack();
 #endif
 	}
 
@@ -1900,15 +2709,25 @@ void GDScriptFunctionState::_bind_methods() {
 GDScriptFunctionState::GDScriptFunctionState() {
 
 	function = NULL;
+	state.stack = NULL;
+	state.stack_size = 0;
+	state.alloca_size = 0;
+}
+
+void GDScriptFunctionState::_free_stack() {
+
+	if (!state.stack)
+		return;
+
+	Variant *stack = (Variant *)state.stack;
+	for (int i = 0; i < state.stack_size; i++)
+		stack[i].~Variant();
+	GDScriptFramePool::free(state.stack, state.alloca_size);
+	state.stack = NULL;
 }
 
 GDScriptFunctionState::~GDScriptFunctionState() {
 
-	if (function != NULL) {
-		//never called, deinitialize stack
-		for (int i = 0; i < state.stack_size; i++) {
-			Variant *v = (Variant *)&state.stack[sizeof(Variant) * i];
-			v->~Variant();
-		}
-	}
+	//never resumed, deinitialize stack
+	_free_stack();
 }
@@ -31,6 +31,7 @@
 #ifndef GDSCRIPT_FUNCTION_H
 #define GDSCRIPT_FUNCTION_H
 
+#include "core/os/spin_lock.h"
 #include "core/os/thread.h"
 #include "core/pair.h"
 #include "core/reference.h"
@@ -152,10 +153,74 @@ struct GDScriptDataType {
 			builtin_type(Variant::NIL) {}
 };
 
+class GDScriptFunction;
+class GDScriptJIT;
+class MethodBind;
+
+// Recycles stack frames of functions that yield. Such functions run on a pooled frame
+// instead of alloca, so yielding hands the frame to GDScriptFunctionState as is and
+// resuming runs on it in place. Frames are grouped in power of two size classes.
+class GDScriptFramePool {
+
+	enum {
+		MIN_CLASS_SHIFT = 6,
+		MAX_CLASS_SHIFT = 16,
+		MAX_FREE_PER_CLASS = 256,
+	};
+
+	struct FreeFrame {
+		FreeFrame *next;
+	};
+
+	static SpinLock spin_lock;
+	static FreeFrame *free_frames[MAX_CLASS_SHIFT - MIN_CLASS_SHIFT + 1];
+	static uint32_t free_count[MAX_CLASS_SHIFT - MIN_CLASS_SHIFT + 1];
+
+	static int _get_class(uint32_t p_size);
+
+public:
+	static uint8_t *alloc(uint32_t p_size);
+	static void free(uint8_t *p_frame, uint32_t p_size);
+	static void clear();
+};
+
+// Per call site cache for OPCODE_CALL, OPCODE_GET_NAMED and OPCODE_SET_NAMED on object receivers.
+// Entries are keyed by the receiver's native class and GDScript, and only trusted while the
+// language epoch they were filled in is current. Once all entries are taken the site is megamorphic.
+struct GDScriptInlineCache {
+
+	enum {
+		MAX_ENTRIES = 4
+	};
+
+	enum Kind {
+		KIND_METHOD, // native method, bypasses the script
+		KIND_FUNCTION, // GDScript member function
+		KIND_MEMBER, // GDScript member variable without setget
+		KIND_PROPERTY, // native property setter or getter, with index if >= 0
+	};
+
+	struct Entry {
+		uint32_t epoch; // zero while unused
+		const StringName *class_name;
+		const GDScript *script;
+		Kind kind;
+		int index;
+		union {
+			MethodBind *method;
+			GDScriptFunction *function;
+			const GDScriptDataType *member_type;
+		};
+	};
+
+	Entry entries[MAX_ENTRIES];
+};
+
 class GDScriptFunction {
 public:
 	enum Opcode {
 		OPCODE_OPERATOR,
+		OPCODE_OPERATOR_TYPED,
 		OPCODE_EXTENDS_TEST,
 		OPCODE_IS_BUILTIN,
 		OPCODE_SET,
@@ -213,6 +278,19 @@ public:
 		ADDR_TYPE_NIL = 9
 	};
 
+	// Static operand types of OPCODE_OPERATOR_TYPED.
+	enum TypedOperands {
+		TYPED_INT,
+		TYPED_REAL,
+		TYPED_INT_REAL,
+		TYPED_REAL_INT,
+		TYPED_VECTOR2,
+		TYPED_VECTOR3,
+		TYPED_VECTOR2_REAL,
+		TYPED_VECTOR3_REAL,
+		TYPED_MAX
+	};
+
 	struct StackDebug {
 
 		int line;
@@ -223,6 +301,8 @@ public:
 
 private:
 	friend class GDScriptCompiler;
+	friend class GDScriptBytecodeCache;
+	friend class GDScriptJIT;
 
 	StringName source;
 
@@ -231,6 +311,8 @@ private:
 	int _constant_count;
 	const StringName *_global_names_ptr;
 	int _global_names_count;
+	GDScriptInlineCache *_inline_caches_ptr;
+	int _inline_cache_count;
 #ifdef TOOLS_ENABLED
 	const StringName *_named_globals_ptr;
 	int _named_globals_count;
@@ -244,13 +326,21 @@ private:
 	int _call_size;
 	int _initial_line;
 	bool _static;
+	bool _fully_typed; // arguments, return value and locals all have static types
+	bool _yields; // set on the first yield, from then on calls run on pooled frames
 	MultiplayerAPI::RPCMode rpc_mode;
 
+	GDScriptJIT *_jit;
+	bool _jit_disabled;
+	uint32_t _jit_call_count;
+	uint32_t _jit_deopt_count;
+
 	GDScript *_script;
 
 	StringName name;
 	Vector<Variant> constants;
 	Vector<StringName> global_names;
+	Vector<GDScriptInlineCache> inline_caches;
 #ifdef TOOLS_ENABLED
 	Vector<StringName> named_globals;
 #endif
@@ -268,6 +358,29 @@ private:
 	_FORCE_INLINE_ Variant *_get_variant(int p_address, GDScriptInstance *p_instance, GDScript *p_script, Variant &self, Variant *p_stack, String &r_error) const;
 	_FORCE_INLINE_ String _get_call_error(const Variant::CallError &p_err, const String &p_where, const Variant **argptrs) const;
 
+	static _FORCE_INLINE_ bool _inline_cache_receiver(const Variant *p_base, Object *&r_object, GDScriptInstance *&r_instance, const GDScript *&r_script);
+	static _FORCE_INLINE_ const GDScriptInlineCache::Entry *_inline_cache_find(const GDScriptInlineCache *p_cache, const Object *p_object, const GDScript *p_script);
+	static GDScriptInlineCache::Entry *_inline_cache_slot(GDScriptInlineCache *p_cache);
+	static void _inline_cache_publish(GDScriptInlineCache::Entry *p_entry, const Object *p_object, const GDScript *p_script);
+	static void _inline_cache_fill_call(GDScriptInlineCache *p_cache, const Object *p_object, const GDScript *p_script, const StringName &p_method);
+	static void _inline_cache_fill_property(GDScriptInlineCache *p_cache, const Object *p_object, const GDScript *p_script, const StringName &p_name, bool p_set);
+	static bool _inline_cache_call(GDScriptInlineCache *p_cache, const Variant *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant *r_ret, Variant::CallError &r_error);
+	static bool _inline_cache_get(GDScriptInlineCache *p_cache, const Variant *p_base, const StringName &p_name, Variant &r_ret);
+	static bool _inline_cache_set(GDScriptInlineCache *p_cache, const Variant *p_base, const StringName &p_name, const Variant &p_value, bool &r_valid);
+
+	GDScriptJIT *_jit_compile();
+
+public:
+	// Also used by the JIT tier.
+	static bool _get_indexed_fast(const Variant *p_base, const Variant *p_index, Variant *r_dst);
+	static bool _set_indexed_fast(Variant *p_base, const Variant *p_index, const Variant *p_value);
+	static bool _iterate_fast(const Variant *p_container, int64_t p_index, Variant *r_counter, Variant *r_iterator, bool &r_more);
+
+	// TypedOperands for an operator on operands of these types, or -1 when it has no typed form.
+	static int get_typed_operands(Variant::Operator p_op, Variant::Type p_type_a, Variant::Type p_type_b);
+
+private:
+
 	friend class GDScriptLanguage;
 
 	SelfList<GDScriptFunction> function_list;
@@ -295,7 +408,7 @@ public:
 
 		ObjectID instance_id;
 		GDScriptInstance *instance;
-		Vector<uint8_t> stack;
+		uint8_t *stack; // pooled frame of alloca_size bytes, owned by the state while suspended
 		int stack_size;
 		Variant self;
 		uint32_t alloca_size;
@@ -354,6 +467,7 @@ class GDScriptFunctionState : public Reference {
 	GDScriptFunction::CallState state;
 	Variant _signal_callback(const Variant **p_args, int p_argcount, Variant::CallError &r_error);
 	Ref<GDScriptFunctionState> first_state;
+	void _free_stack();
 
 protected:
 	static void _bind_methods();
@@ -0,0 +1,744 @@
+/*************************************************************************/
+/*  gdscript_jit.cpp                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "gdscript_jit.h"
+
+#include "gdscript.h"
+#include "gdscript_functions.h"
+
+enum {
+	EXIT = -1,
+	DEOPT = -2,
+};
+
+#define OPERAND(m_addr) (p_frame.bases[(m_addr) >> GDScriptFunction::ADDR_BITS] + ((m_addr)&GDScriptFunction::ADDR_MASK))
+
+/* Handlers */
+
+static int _assign(GDScriptJIT::Frame &p_frame, const GDScriptJIT::Insn &p_insn) {
+
+	*OPERAND(p_insn.a) = *OPERAND(p_insn.b);
+	return p_insn.next;
+}
+
+static int _assign_true(GDScriptJIT::Frame &p_frame, const GDScriptJIT::Insn &p_insn) {
+
+	*OPERAND(p_insn.a) = true;
+	return p_insn.next;
+}
+
+static int _assign_false(GDScriptJIT::Frame &p_frame, const GDScriptJIT::Insn &p_insn) {
+
+	*OPERAND(p_insn.a) = false;
+	return p_insn.next;
+}
+
+static int _assign_typed_builtin(GDScriptJIT::Frame &p_frame, const GDScriptJIT::Insn &p_insn) {
+
+	const Variant *src = OPERAND(p_insn.b);
+	if (src->get_type() == p_insn.d) {
+		*OPERAND(p_insn.a) = *src;
+	} else if (p_insn.d == Variant::REAL && src->get_type() == Variant::INT) {
+		*OPERAND(p_insn.a) = (double)src->get_int_unchecked();
+	} else {
+		return DEOPT;
+	}
+	return p_insn.next;
+}
+
+template <Variant::Operator op>
+static int _operator(GDScriptJIT::Frame &p_frame, const GDScriptJIT::Insn &p_insn) {
+
+	const Variant *a = OPERAND(p_insn.a);
+	const Variant *b = OPERAND(p_insn.b);
+	Variant::Type type_a = a->get_type();
+	Variant::Type type_b = b->get_type();
+
+	if (type_a == Variant::INT && type_b == Variant::INT) {
+
+		int64_t x = a->get_int_unchecked();
+		int64_t y = b->get_int_unchecked();
+		Variant *dst = OPERAND(p_insn.c);
+		switch (op) {
+			case Variant::OP_ADD: *dst = x + y; break;
+			case Variant::OP_SUBTRACT: *dst = x - y; break;
+			case Variant::OP_MULTIPLY: *dst = x * y; break;
+			case Variant::OP_DIVIDE: {
+				if (y == 0)
+					return DEOPT;
+				*dst = x / y;
+			} break;
+			case Variant::OP_MODULE: {
+				if (y == 0)
+					return DEOPT;
+				*dst = x % y;
+			} break;
+			case Variant::OP_EQUAL: *dst = x == y; break;
+			case Variant::OP_NOT_EQUAL: *dst = x != y; break;
+			case Variant::OP_LESS: *dst = x < y; break;
+			case Variant::OP_LESS_EQUAL: *dst = x <= y; break;
+			case Variant::OP_GREATER: *dst = x > y; break;
+			case Variant::OP_GREATER_EQUAL: *dst = x >= y; break;
+			default: {
+			}
+		}
+		return p_insn.next;
+	}
+
+	// Mixed int and float operands promote to float, like Variant::evaluate().
+	if (op != Variant::OP_MODULE && (type_a == Variant::REAL || type_a == Variant::INT) && (type_b == Variant::REAL || type_b == Variant::INT)) {
+
+		double x = type_a == Variant::REAL ? a->get_real_unchecked() : (double)a->get_int_unchecked();
+		double y = type_b == Variant::REAL ? b->get_real_unchecked() : (double)b->get_int_unchecked();
+		Variant *dst = OPERAND(p_insn.c);
+		switch (op) {
+			case Variant::OP_ADD: *dst = x + y; break;
+			case Variant::OP_SUBTRACT: *dst = x - y; break;
+			case Variant::OP_MULTIPLY: *dst = x * y; break;
+			case Variant::OP_DIVIDE: {
+				if (y == 0)
+					return DEOPT;
+				*dst = x / y;
+			} break;
+			case Variant::OP_EQUAL: *dst = x == y; break;
+			case Variant::OP_NOT_EQUAL: *dst = x != y; break;
+			case Variant::OP_LESS: *dst = x < y; break;
+			case Variant::OP_LESS_EQUAL: *dst = x <= y; break;
+			case Variant::OP_GREATER: *dst = x > y; break;
+			case Variant::OP_GREATER_EQUAL: *dst = x >= y; break;
+			default: {
+			}
+		}
+		return p_insn.next;
+	}
+
+	// Operators have no side effects, so a failure here is simply evaluated again by the interpreter.
+	Variant ret;
+	bool valid;
+	Variant::evaluate(op, *a, *b, ret, valid);
+	if (!valid)
+		return DEOPT;
+	*OPERAND(p_insn.c) = ret;
+	return p_insn.next;
+}
+
+static int _operator_generic(GDScriptJIT::Frame &p_frame, const GDScriptJIT::Insn &p_insn) {
+
+	Variant ret;
+	bool valid;
+	Variant::evaluate((Variant::Operator)p_insn.d, *OPERAND(p_insn.a), *OPERAND(p_insn.b), ret, valid);
+	if (!valid)
+		return DEOPT;
+	*OPERAND(p_insn.c) = ret;
+	return p_insn.next;
+}
+
+static int _construct(GDScriptJIT::Frame &p_frame, const GDScriptJIT::Insn &p_insn) {
+
+	for (int i = 0; i < p_insn.c; i++) {
+		p_frame.call_args[i] = OPERAND(p_insn.args[i]);
+	}
+
+	Variant::CallError err;
+	Variant ret = Variant::construct((Variant::Type)p_insn.d, (const Variant **)p_frame.call_args, p_insn.c, err);
+	if (err.error != Variant::CallError::CALL_OK)
+		return DEOPT;
+	*OPERAND(p_insn.a) = ret;
+	return p_insn.next;
+}
+
+static int _construct_array(GDScriptJIT::Frame &p_frame, const GDScriptJIT::Insn &p_insn) {
+
+	Array array;
+	array.resize(p_insn.c);
+	for (int i = 0; i < p_insn.c; i++) {
+		array[i] = *OPERAND(p_insn.args[i]);
+	}
+	*OPERAND(p_insn.a) = array;
+	return p_insn.next;
+}
+
+static int _call_built_in(GDScriptJIT::Frame &p_frame, const GDScriptJIT::Insn &p_insn) {
+
+	for (int i = 0; i < p_insn.c; i++) {
+		p_frame.call_args[i] = OPERAND(p_insn.args[i]);
+	}
+
+	// Built-in functions validate their arguments before doing anything.
+	Variant::CallError err;
+	Variant ret;
+	GDScriptFunctions::call((GDScriptFunctions::Function)p_insn.d, (const Variant **)p_frame.call_args, p_insn.c, ret, err);
+	if (err.error != Variant::CallError::CALL_OK)
+		return DEOPT;
+	*OPERAND(p_insn.a) = ret;
+	return p_insn.next;
+}
+
+static int _call(GDScriptJIT::Frame &p_frame, const GDScriptJIT::Insn &p_insn) {
+
+	// Only methods of built-in types, which check their arguments before running.
+	// Objects may run script code, they go back to the interpreter and its inline caches.
+	Variant *base = OPERAND(p_insn.a);
+	if (base->get_type() == Variant::OBJECT)
+		return DEOPT;
+
+	for (int i = 0; i < p_insn.c; i++) {
+		p_frame.call_args[i] = OPERAND(p_insn.args[i]);
+	}
+
+	Variant::CallError err;
+	base->call_ptr(*p_insn.name, (const Variant **)p_frame.call_args, p_insn.c, p_insn.b >= 0 ? OPERAND(p_insn.b) : NULL, err);
+	if (err.error != Variant::CallError::CALL_OK)
+		return DEOPT;
+	return p_insn.next;
+}
+
+static int _get(GDScriptJIT::Frame &p_frame, const GDScriptJIT::Insn &p_insn) {
+
+	const Variant *src = OPERAND(p_insn.a);
+	const Variant *index = OPERAND(p_insn.b);
+	Variant *dst = OPERAND(p_insn.c);
+
+	if (GDScriptFunction::_get_indexed_fast(src, index, dst))
+		return p_insn.next;
+	if (src->get_type() == Variant::OBJECT)
+		return DEOPT;
+
+	bool valid;
+	Variant ret = src->get(*index, &valid);
+	if (!valid)
+		return DEOPT;
+	*dst = ret;
+	return p_insn.next;
+}
+
+static int _set(GDScriptJIT::Frame &p_frame, const GDScriptJIT::Insn &p_insn) {
+
+	Variant *dst = OPERAND(p_insn.a);
+	const Variant *index = OPERAND(p_insn.b);
+	const Variant *value = OPERAND(p_insn.c);
+
+	if (GDScriptFunction::_set_indexed_fast(dst, index, value))
+		return p_insn.next;
+	if (dst->get_type() == Variant::OBJECT)
+		return DEOPT;
+
+	bool valid;
+	dst->set(*index, *value, &valid);
+	return valid ? p_insn.next : DEOPT;
+}
+
+static int _get_named(GDScriptJIT::Frame &p_frame, const GDScriptJIT::Insn &p_insn) {
+
+	const Variant *src = OPERAND(p_insn.a);
+	if (src->get_type() == Variant::OBJECT)
+		return DEOPT;
+
+	bool valid;
+	Variant ret = src->get_named(*p_insn.name, &valid);
+	if (!valid)
+		return DEOPT;
+	*OPERAND(p_insn.c) = ret;
+	return p_insn.next;
+}
+
+static int _set_named(GDScriptJIT::Frame &p_frame, const GDScriptJIT::Insn &p_insn) {
+
+	Variant *dst = OPERAND(p_insn.a);
+	if (dst->get_type() == Variant::OBJECT)
+		return DEOPT;
+
+	bool valid;
+	dst->set_named(*p_insn.name, *OPERAND(p_insn.b), &valid);
+	return valid ? p_insn.next : DEOPT;
+}
+
+static int _jump(GDScriptJIT::Frame &p_frame, const GDScriptJIT::Insn &p_insn) {
+
+	return p_insn.target;
+}
+
+static _FORCE_INLINE_ bool _booleanize(const Variant *p_value) {
+
+	return p_value->get_type() == Variant::BOOL ? p_value->get_bool_unchecked() : p_value->booleanize();
+}
+
+static int _jump_if(GDScriptJIT::Frame &p_frame, const GDScriptJIT::Insn &p_insn) {
+
+	return _booleanize(OPERAND(p_insn.a)) ? p_insn.target : p_insn.next;
+}
+
+static int _jump_if_not(GDScriptJIT::Frame &p_frame, const GDScriptJIT::Insn &p_insn) {
+
+	return _booleanize(OPERAND(p_insn.a)) ? p_insn.next : p_insn.target;
+}
+
+static int _jump_to_def_argument(GDScriptJIT::Frame &p_frame, const GDScriptJIT::Insn &p_insn) {
+
+	return p_insn.args[p_frame.defarg];
+}
+
+static int _iterate_begin(GDScriptJIT::Frame &p_frame, const GDScriptJIT::Insn &p_insn) {
+
+	Variant *counter = OPERAND(p_insn.a);
+	const Variant *container = OPERAND(p_insn.b);
+	Variant *iterator = OPERAND(p_insn.c);
+
+	bool more;
+	if (!GDScriptFunction::_iterate_fast(container, 0, counter, iterator, more)) {
+
+		if (container->get_type() == Variant::OBJECT)
+			return DEOPT; // custom iterators are script calls
+
+		bool valid;
+		more = container->iter_init(*counter, valid);
+		if (!valid)
+			return DEOPT;
+		if (more) {
+			*iterator = container->iter_get(*counter, valid);
+			if (!valid)
+				return DEOPT; // iter_init doesn't depend on the counter, so this can run again
+		}
+	}
+	return more ? p_insn.next : p_insn.target;
+}
+
+static int _iterate(GDScriptJIT::Frame &p_frame, const GDScriptJIT::Insn &p_insn) {
+
+	Variant *counter = OPERAND(p_insn.a);
+	const Variant *container = OPERAND(p_insn.b);
+	Variant *iterator = OPERAND(p_insn.c);
+
+	bool more;
+	if (counter->get_type() != Variant::INT || !GDScriptFunction::_iterate_fast(container, counter->get_int_unchecked() + 1, counter, iterator, more)) {
+
+		if (container->get_type() == Variant::OBJECT)
+			return DEOPT;
+
+		// Built-in types never fail iter_get after a successful iter_next,
+		// which already moved the counter and can't be run again.
+		bool valid;
+		more = container->iter_next(*counter, valid);
+		if (!valid)
+			return DEOPT;
+		if (more) {
+			*iterator = container->iter_get(*counter, valid);
+		}
+	}
+	return more ? p_insn.next : p_insn.target;
+}
+
+static int _assert(GDScriptJIT::Frame &p_frame, const GDScriptJIT::Insn &p_insn) {
+
+	return _booleanize(OPERAND(p_insn.a)) ? p_insn.next : DEOPT;
+}
+
+static int _return(GDScriptJIT::Frame &p_frame, const GDScriptJIT::Insn &p_insn) {
+
+	*p_frame.retvalue = *OPERAND(p_insn.a);
+	return EXIT;
+}
+
+static int _end(GDScriptJIT::Frame &p_frame, const GDScriptJIT::Insn &p_insn) {
+
+	return EXIT;
+}
+
+GDScriptJIT::Handler GDScriptJIT::_get_operator_handler(Variant::Operator p_op) {
+
+	switch (p_op) {
+		case Variant::OP_ADD: return _operator<Variant::OP_ADD>;
+		case Variant::OP_SUBTRACT: return _operator<Variant::OP_SUBTRACT>;
+		case Variant::OP_MULTIPLY: return _operator<Variant::OP_MULTIPLY>;
+		case Variant::OP_DIVIDE: return _operator<Variant::OP_DIVIDE>;
+		case Variant::OP_MODULE: return _operator<Variant::OP_MODULE>;
+		case Variant::OP_EQUAL: return _operator<Variant::OP_EQUAL>;
+		case Variant::OP_NOT_EQUAL: return _operator<Variant::OP_NOT_EQUAL>;
+		case Variant::OP_LESS: return _operator<Variant::OP_LESS>;
+		case Variant::OP_LESS_EQUAL: return _operator<Variant::OP_LESS_EQUAL>;
+		case Variant::OP_GREATER: return _operator<Variant::OP_GREATER>;
+		case Variant::OP_GREATER_EQUAL: return _operator<Variant::OP_GREATER_EQUAL>;
+		default: {
+		}
+	}
+	return _operator_generic;
+}
+
+/* Translation */
+
+GDScriptJIT *GDScriptJIT::compile(const GDScriptFunction *p_function) {
+
+	const int *code = p_function->_code_ptr;
+	int code_size = p_function->_code_size;
+	if (!code || code_size == 0 || code[code_size - 1] != GDScriptFunction::OPCODE_END)
+		return NULL;
+
+	GDScriptJIT *jit = memnew(GDScriptJIT);
+
+	// Bytecode address to instruction, for jump targets. Addresses of dropped opcodes
+	// such as OPCODE_LINE map to the instruction following them.
+	Vector<int> insn_at;
+	insn_at.resize(code_size);
+	for (int i = 0; i < code_size; i++) {
+		insn_at.write[i] = -1;
+	}
+	Vector<int> jump_insns;
+
+	int line = p_function->_initial_line;
+	int ip = 0;
+	bool ok = true;
+
+#define CHECK_SPACE(m_space)               \
+	if ((ip + (m_space)) > code_size) {    \
+		ok = false;                        \
+		break;                             \
+	}
+
+	// Everything but class constants and autoloads in the editor, which are looked up by name.
+#define CHECK_ADDRESS(m_addr)                                                                             \
+	{                                                                                                     \
+		int type = (m_addr) >> GDScriptFunction::ADDR_BITS;                                               \
+		int index = (m_addr)&GDScriptFunction::ADDR_MASK;                                                 \
+		switch (type) {                                                                                   \
+			case GDScriptFunction::ADDR_TYPE_SELF:                                                        \
+			case GDScriptFunction::ADDR_TYPE_MEMBER: {                                                    \
+				ok = ok && !p_function->_static;                                                          \
+			} break;                                                                                      \
+			case GDScriptFunction::ADDR_TYPE_CLASS:                                                       \
+			case GDScriptFunction::ADDR_TYPE_NIL: {                                                       \
+				ok = ok && index == 0;                                                                    \
+			} break;                                                                                      \
+			case GDScriptFunction::ADDR_TYPE_LOCAL_CONSTANT: {                                            \
+				ok = ok && index < p_function->_constant_count;                                           \
+			} break;                                                                                      \
+			case GDScriptFunction::ADDR_TYPE_STACK:                                                       \
+			case GDScriptFunction::ADDR_TYPE_STACK_VARIABLE: {                                            \
+				ok = ok && index < p_function->_stack_size;                                               \
+			} break;                                                                                      \
+			case GDScriptFunction::ADDR_TYPE_GLOBAL: {                                                    \
+				ok = ok && index < GDScriptLanguage::get_singleton()->get_global_array_size();            \
+			} break;                                                                                      \
+			default: {                                                                                    \
+				ok = false;                                                                               \
+			}                                                                                             \
+		}                                                                                                 \
+	}
+
+	while (ok && ip < code_size) {
+
+		insn_at.write[ip] = jit->insns.size();
+
+		Insn insn;
+		insn.handler = NULL;
+		insn.next = jit->insns.size() + 1;
+		insn.target = -1;
+		insn.a = insn.b = insn.c = insn.d = -1;
+		insn.args = NULL;
+		insn.name = NULL;
+		insn.ip = ip;
+		insn.line = line;
+
+		switch (code[ip]) {
+
+			case GDScriptFunction::OPCODE_OPERATOR: {
+				CHECK_SPACE(5);
+				if (code[ip + 1] < 0 || code[ip + 1] >= Variant::OP_MAX) {
+					ok = false;
+					break;
+				}
+				insn.handler = _get_operator_handler((Variant::Operator)code[ip + 1]);
+				insn.d = code[ip + 1];
+				insn.a = code[ip + 2];
+				insn.b = code[ip + 3];
+				insn.c = code[ip + 4];
+				ip += 5;
+			} break;
+			case GDScriptFunction::OPCODE_OPERATOR_TYPED: {
+				CHECK_SPACE(6);
+				if (code[ip + 1] < 0 || code[ip + 1] >= Variant::OP_MAX) {
+					ok = false;
+					break;
+				}
+				insn.handler = _get_operator_handler((Variant::Operator)code[ip + 1]);
+				insn.d = code[ip + 1];
+				insn.a = code[ip + 3];
+				insn.b = code[ip + 4];
+				insn.c = code[ip + 5];
+				ip += 6;
+			} break;
+			case GDScriptFunction::OPCODE_SET: {
+				CHECK_SPACE(4);
+				insn.handler = _set;
+				insn.a = code[ip + 1];
+				insn.b = code[ip + 2];
+				insn.c = code[ip + 3];
+				ip += 4;
+			} break;
+			case GDScriptFunction::OPCODE_GET: {
+				CHECK_SPACE(4);
+				insn.handler = _get;
+				insn.a = code[ip + 1];
+				insn.b = code[ip + 2];
+				insn.c = code[ip + 3];
+				ip += 4;
+			} break;
+			case GDScriptFunction::OPCODE_SET_NAMED: {
+				CHECK_SPACE(5);
+				insn.handler = _set_named;
+				insn.a = code[ip + 1];
+				insn.name = &p_function->_global_names_ptr[code[ip + 2]];
+				insn.b = code[ip + 3];
+				ok = code[ip + 2] >= 0 && code[ip + 2] < p_function->_global_names_count;
+				ip += 5;
+			} break;
+			case GDScriptFunction::OPCODE_GET_NAMED: {
+				CHECK_SPACE(5);
+				insn.handler = _get_named;
+				insn.a = code[ip + 1];
+				insn.name = &p_function->_global_names_ptr[code[ip + 2]];
+				insn.c = code[ip + 4];
+				ok = code[ip + 2] >= 0 && code[ip + 2] < p_function->_global_names_count;
+				ip += 5;
+			} break;
+			case GDScriptFunction::OPCODE_ASSIGN: {
+				CHECK_SPACE(3);
+				insn.handler = _assign;
+				insn.a = code[ip + 1];
+				insn.b = code[ip + 2];
+				ip += 3;
+			} break;
+			case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+			case GDScriptFunction::OPCODE_ASSIGN_FALSE: {
+				CHECK_SPACE(2);
+				insn.handler = code[ip] == GDScriptFunction::OPCODE_ASSIGN_TRUE ? _assign_true : _assign_false;
+				insn.a = code[ip + 1];
+				ip += 2;
+			} break;
+			case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN: {
+				CHECK_SPACE(4);
+				insn.handler = _assign_typed_builtin;
+				insn.d = code[ip + 1];
+				insn.a = code[ip + 2];
+				insn.b = code[ip + 3];
+				ip += 4;
+			} break;
+			case GDScriptFunction::OPCODE_CONSTRUCT: {
+				CHECK_SPACE(3);
+				int argc = code[ip + 2];
+				CHECK_SPACE(4 + argc);
+				insn.handler = _construct;
+				insn.d = code[ip + 1];
+				insn.c = argc;
+				insn.args = &code[ip + 3];
+				insn.a = code[ip + 3 + argc];
+				ok = insn.d >= 0 && insn.d < Variant::VARIANT_MAX && argc >= 0 && argc <= p_function->_call_size;
+				ip += 4 + argc;
+			} break;
+			case GDScriptFunction::OPCODE_CONSTRUCT_ARRAY: {
+				CHECK_SPACE(2);
+				int argc = code[ip + 1];
+				CHECK_SPACE(3 + argc);
+				insn.handler = _construct_array;
+				insn.c = argc;
+				insn.args = &code[ip + 2];
+				insn.a = code[ip + 2 + argc];
+				ok = argc >= 0;
+				ip += 3 + argc;
+			} break;
+			case GDScriptFunction::OPCODE_CALL:
+			case GDScriptFunction::OPCODE_CALL_RETURN: {
+				CHECK_SPACE(5);
+				int argc = code[ip + 1];
+				CHECK_SPACE(6 + argc);
+				insn.handler = _call;
+				insn.c = argc;
+				insn.a = code[ip + 2];
+				insn.name = &p_function->_global_names_ptr[code[ip + 3]];
+				insn.args = &code[ip + 5];
+				if (code[ip] == GDScriptFunction::OPCODE_CALL_RETURN) {
+					insn.b = code[ip + 5 + argc];
+				}
+				ok = argc >= 0 && argc <= p_function->_call_size && code[ip + 3] >= 0 && code[ip + 3] < p_function->_global_names_count;
+				ip += 6 + argc;
+			} break;
+			case GDScriptFunction::OPCODE_CALL_BUILT_IN: {
+				CHECK_SPACE(3);
+				int argc = code[ip + 2];
+				CHECK_SPACE(4 + argc);
+				insn.handler = _call_built_in;
+				insn.d = code[ip + 1];
+				insn.c = argc;
+				insn.args = &code[ip + 3];
+				insn.a = code[ip + 3 + argc];
+				ok = insn.d >= 0 && insn.d < GDScriptFunctions::FUNC_MAX && argc >= 0 && argc <= p_function->_call_size;
+				ip += 4 + argc;
+			} break;
+			case GDScriptFunction::OPCODE_JUMP: {
+				CHECK_SPACE(2);
+				insn.handler = _jump;
+				insn.target = code[ip + 1];
+				jump_insns.push_back(jit->insns.size());
+				ip += 2;
+			} break;
+			case GDScriptFunction::OPCODE_JUMP_IF:
+			case GDScriptFunction::OPCODE_JUMP_IF_NOT: {
+				CHECK_SPACE(3);
+				insn.handler = code[ip] == GDScriptFunction::OPCODE_JUMP_IF ? _jump_if : _jump_if_not;
+				insn.a = code[ip + 1];
+				insn.target = code[ip + 2];
+				jump_insns.push_back(jit->insns.size());
+				ip += 3;
+			} break;
+			case GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT: {
+				insn.handler = _jump_to_def_argument;
+				ip += 1;
+			} break;
+			case GDScriptFunction::OPCODE_RETURN: {
+				CHECK_SPACE(2);
+				insn.handler = _return;
+				insn.a = code[ip + 1];
+				ip += 2;
+			} break;
+			case GDScriptFunction::OPCODE_ITERATE_BEGIN:
+			case GDScriptFunction::OPCODE_ITERATE: {
+				CHECK_SPACE(5);
+				insn.handler = code[ip] == GDScriptFunction::OPCODE_ITERATE_BEGIN ? _iterate_begin : _iterate;
+				insn.a = code[ip + 1];
+				insn.b = code[ip + 2];
+				insn.target = code[ip + 3];
+				insn.c = code[ip + 4];
+				jump_insns.push_back(jit->insns.size());
+				ip += 5;
+			} break;
+			case GDScriptFunction::OPCODE_ASSERT: {
+				CHECK_SPACE(3);
+				insn.handler = _assert;
+				insn.a = code[ip + 1];
+				ip += 3;
+			} break;
+			case GDScriptFunction::OPCODE_BREAKPOINT: {
+				ip += 1; // only meaningful with the debugger, which turns this tier off
+			} break;
+			case GDScriptFunction::OPCODE_LINE: {
+				CHECK_SPACE(2);
+				line = code[ip + 1];
+				ip += 2;
+			} break;
+			case GDScriptFunction::OPCODE_END: {
+				insn.handler = _end;
+				ip += 1;
+			} break;
+			default: {
+				ok = false; // calls into scripts, yields, casts and the like stay in the interpreter
+			}
+		}
+
+		if (!ok || !insn.handler)
+			continue;
+
+		if (insn.a != -1)
+			CHECK_ADDRESS(insn.a);
+		if (insn.b != -1)
+			CHECK_ADDRESS(insn.b);
+		if (insn.c != -1 && insn.args == NULL)
+			CHECK_ADDRESS(insn.c);
+		if (insn.handler == _assign_typed_builtin)
+			ok = ok && insn.d >= 0 && insn.d < Variant::VARIANT_MAX;
+		if (insn.args) {
+			for (int i = 0; i < insn.c; i++) {
+				CHECK_ADDRESS(insn.args[i]);
+			}
+		}
+
+		jit->insns.push_back(insn);
+	}
+
+#undef CHECK_SPACE
+#undef CHECK_ADDRESS
+
+	if (!ok) {
+		memdelete(jit);
+		return NULL;
+	}
+
+	// Resolve jumps now that every instruction has an index.
+	for (int i = 0; i < code_size; i++) {
+		if (insn_at[i] == -1)
+			insn_at.write[i] = i > 0 ? insn_at[i - 1] : 0;
+	}
+
+	Insn *insns = jit->insns.ptrw();
+	for (int i = 0; i < jump_insns.size(); i++) {
+		Insn &insn = insns[jump_insns[i]];
+		if (insn.target < 0 || insn.target >= code_size) {
+			memdelete(jit);
+			return NULL;
+		}
+		insn.target = insn_at[insn.target];
+	}
+
+	for (int i = 0; i < p_function->default_arguments.size(); i++) {
+		int addr = p_function->default_arguments[i];
+		if (addr < 0 || addr >= code_size) {
+			memdelete(jit);
+			return NULL;
+		}
+		jit->default_arg_targets.push_back(insn_at[addr]);
+	}
+	for (int i = 0; i < jit->insns.size(); i++) {
+		if (insns[i].handler == _jump_to_def_argument)
+			insns[i].args = jit->default_arg_targets.ptr();
+	}
+
+	return jit;
+}
+
+bool GDScriptJIT::run(Frame &p_frame, int &r_ip, int &r_line) const {
+
+	const Insn *code = insns.ptr();
+	int pc = 0;
+
+	while (true) {
+
+		const Insn &insn = code[pc];
+		int next = insn.handler(p_frame, insn);
+		if (likely(next >= 0)) {
+			pc = next;
+			continue;
+		}
+
+		if (next == EXIT)
+			return true;
+
+		r_ip = insn.ip;
+		r_line = insn.line;
+		return false;
+	}
+}
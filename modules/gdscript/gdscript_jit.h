@@ -0,0 +1,95 @@
+/*************************************************************************/
+/*  gdscript_jit.h                                                       */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef GDSCRIPT_JIT_H
+#define GDSCRIPT_JIT_H
+
+#include "core/variant.h"
+#include "core/vector.h"
+#include "gdscript_function.h"
+
+// Second execution tier for hot, fully typed functions.
+// The bytecode is translated once into pre-decoded instructions with resolved
+// jump targets, each run by a handler specialized for its opcode and, for
+// arithmetic and comparisons, for the operator. Operands are read straight
+// from per-call base pointers instead of decoding addresses on every access.
+//
+// Handlers take int/float fast paths and guard everything else. A guard that
+// fails before the instruction had any effect deoptimizes: the interpreter
+// resumes at that same instruction on the same stack, and takes care of
+// conversions, calls into objects and error reporting as usual.
+class GDScriptJIT {
+public:
+	enum {
+		MAX_DEOPTS = 256, // the function goes back to the interpreter for good after this
+	};
+
+	struct Frame {
+		Variant *bases[GDScriptFunction::ADDR_TYPE_NIL + 1];
+		Variant **call_args;
+		Variant *retvalue;
+		int defarg;
+	};
+
+	struct Insn;
+	typedef int (*Handler)(Frame &p_frame, const Insn &p_insn);
+
+	struct Insn {
+		Handler handler;
+		int next;
+		int target;
+		int a;
+		int b;
+		int c;
+		int d;
+		const int *args; // variable argument addresses, in the function's code
+		const StringName *name;
+		int ip; // where the interpreter resumes on deoptimization
+		int line;
+	};
+
+private:
+	Vector<Insn> insns;
+	Vector<int> default_arg_targets;
+
+	static Handler _get_operator_handler(Variant::Operator p_op);
+
+	GDScriptJIT() {}
+
+public:
+	// NULL if the function uses anything the tier doesn't handle.
+	static GDScriptJIT *compile(const GDScriptFunction *p_function);
+
+	// Runs a call from the top. Returns true when it finished, otherwise
+	// r_ip and r_line tell where the interpreter must continue.
+	bool run(Frame &p_frame, int &r_ip, int &r_line) const;
+};
+
+#endif // GDSCRIPT_JIT_H
@@ -0,0 +1,925 @@
+/*************************************************************************/
+/*  gdscript_optimizer.cpp                                               */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "gdscript_optimizer.h"
+
+/* Decoding */
+
+int GDScriptOptimizer::_get_insn_size(const int *p_code, int p_ip, int p_code_size) {
+
+	int remaining = p_code_size - p_ip;
+	int size = 0;
+
+	switch (p_code[p_ip]) {
+		case GDScriptFunction::OPCODE_OPERATOR:
+		case GDScriptFunction::OPCODE_SET_NAMED:
+		case GDScriptFunction::OPCODE_GET_NAMED:
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN:
+		case GDScriptFunction::OPCODE_ITERATE: {
+			size = 5;
+		} break;
+		case GDScriptFunction::OPCODE_OPERATOR_TYPED: {
+			size = 6;
+		} break;
+		case GDScriptFunction::OPCODE_EXTENDS_TEST:
+		case GDScriptFunction::OPCODE_IS_BUILTIN:
+		case GDScriptFunction::OPCODE_SET:
+		case GDScriptFunction::OPCODE_GET:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_NATIVE:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_SCRIPT:
+		case GDScriptFunction::OPCODE_CAST_TO_BUILTIN:
+		case GDScriptFunction::OPCODE_CAST_TO_NATIVE:
+		case GDScriptFunction::OPCODE_CAST_TO_SCRIPT: {
+			size = 4;
+		} break;
+		case GDScriptFunction::OPCODE_SET_MEMBER:
+		case GDScriptFunction::OPCODE_GET_MEMBER:
+		case GDScriptFunction::OPCODE_ASSIGN:
+		case GDScriptFunction::OPCODE_YIELD_SIGNAL:
+		case GDScriptFunction::OPCODE_JUMP_IF:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT:
+		case GDScriptFunction::OPCODE_ASSERT: {
+			size = 3;
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+		case GDScriptFunction::OPCODE_ASSIGN_FALSE:
+		case GDScriptFunction::OPCODE_YIELD_RESUME:
+		case GDScriptFunction::OPCODE_JUMP:
+		case GDScriptFunction::OPCODE_RETURN:
+		case GDScriptFunction::OPCODE_LINE: {
+			size = 2;
+		} break;
+		case GDScriptFunction::OPCODE_YIELD:
+		case GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT:
+		case GDScriptFunction::OPCODE_BREAKPOINT:
+		case GDScriptFunction::OPCODE_END: {
+			size = 1;
+		} break;
+		case GDScriptFunction::OPCODE_CONSTRUCT:
+		case GDScriptFunction::OPCODE_CALL_BUILT_IN:
+		case GDScriptFunction::OPCODE_CALL_SELF_BASE: {
+			if (remaining < 3 || p_code[p_ip + 2] < 0)
+				return 0;
+			size = 4 + p_code[p_ip + 2];
+		} break;
+		case GDScriptFunction::OPCODE_CONSTRUCT_ARRAY: {
+			if (remaining < 2 || p_code[p_ip + 1] < 0)
+				return 0;
+			size = 3 + p_code[p_ip + 1];
+		} break;
+		case GDScriptFunction::OPCODE_CONSTRUCT_DICTIONARY: {
+			if (remaining < 2 || p_code[p_ip + 1] < 0)
+				return 0;
+			size = 3 + p_code[p_ip + 1] * 2;
+		} break;
+		case GDScriptFunction::OPCODE_CALL:
+		case GDScriptFunction::OPCODE_CALL_RETURN: {
+			if (remaining < 2 || p_code[p_ip + 1] < 0)
+				return 0;
+			size = 6 + p_code[p_ip + 1];
+		} break;
+		default: {
+			return 0;
+		}
+	}
+
+	return size <= remaining ? size : 0;
+}
+
+static int _get_target_word(int p_opcode) {
+
+	switch (p_opcode) {
+		case GDScriptFunction::OPCODE_JUMP:
+			return 1;
+		case GDScriptFunction::OPCODE_JUMP_IF:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT:
+			return 2;
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN:
+		case GDScriptFunction::OPCODE_ITERATE:
+			return 3;
+		default:
+			return 0;
+	}
+}
+
+bool GDScriptOptimizer::_is_jump(int p_opcode) {
+
+	return _get_target_word(p_opcode) != 0;
+}
+
+void GDScriptOptimizer::_get_operands(const Insn &p_insn, Vector<Operand> &r_operands) {
+
+	r_operands.clear();
+	const int *w = p_insn.words.ptr();
+
+#define ADD_OPERAND(m_word, m_role)  \
+	{                                \
+		Operand operand;             \
+		operand.word = m_word;       \
+		operand.role = m_role;       \
+		r_operands.push_back(operand); \
+	}
+
+	switch (w[0]) {
+		case GDScriptFunction::OPCODE_OPERATOR: {
+			ADD_OPERAND(2, ROLE_READ);
+			ADD_OPERAND(3, ROLE_READ);
+			ADD_OPERAND(4, ROLE_WRITE);
+		} break;
+		case GDScriptFunction::OPCODE_OPERATOR_TYPED: {
+			ADD_OPERAND(3, ROLE_READ);
+			ADD_OPERAND(4, ROLE_READ);
+			ADD_OPERAND(5, ROLE_WRITE);
+		} break;
+		case GDScriptFunction::OPCODE_EXTENDS_TEST:
+		case GDScriptFunction::OPCODE_GET:
+		case GDScriptFunction::OPCODE_CAST_TO_NATIVE:
+		case GDScriptFunction::OPCODE_CAST_TO_SCRIPT: {
+			ADD_OPERAND(1, ROLE_READ);
+			ADD_OPERAND(2, ROLE_READ);
+			ADD_OPERAND(3, ROLE_WRITE);
+		} break;
+		case GDScriptFunction::OPCODE_IS_BUILTIN: {
+			ADD_OPERAND(1, ROLE_READ);
+			ADD_OPERAND(3, ROLE_WRITE);
+		} break;
+		case GDScriptFunction::OPCODE_SET: {
+			ADD_OPERAND(1, ROLE_READ_WRITE);
+			ADD_OPERAND(2, ROLE_READ);
+			ADD_OPERAND(3, ROLE_READ);
+		} break;
+		case GDScriptFunction::OPCODE_SET_NAMED: {
+			ADD_OPERAND(1, ROLE_READ_WRITE);
+			ADD_OPERAND(3, ROLE_READ);
+		} break;
+		case GDScriptFunction::OPCODE_GET_NAMED: {
+			ADD_OPERAND(1, ROLE_READ);
+			ADD_OPERAND(4, ROLE_WRITE);
+		} break;
+		case GDScriptFunction::OPCODE_SET_MEMBER: {
+			ADD_OPERAND(2, ROLE_READ);
+		} break;
+		case GDScriptFunction::OPCODE_GET_MEMBER: {
+			ADD_OPERAND(2, ROLE_WRITE);
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN: {
+			ADD_OPERAND(1, ROLE_WRITE);
+			ADD_OPERAND(2, ROLE_READ);
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+		case GDScriptFunction::OPCODE_ASSIGN_FALSE:
+		case GDScriptFunction::OPCODE_YIELD_RESUME: {
+			ADD_OPERAND(1, ROLE_WRITE);
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN: {
+			ADD_OPERAND(2, ROLE_WRITE);
+			ADD_OPERAND(3, ROLE_READ);
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_NATIVE:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_SCRIPT: {
+			ADD_OPERAND(1, ROLE_READ);
+			ADD_OPERAND(2, ROLE_WRITE);
+			ADD_OPERAND(3, ROLE_READ);
+		} break;
+		case GDScriptFunction::OPCODE_CAST_TO_BUILTIN: {
+			ADD_OPERAND(2, ROLE_READ);
+			ADD_OPERAND(3, ROLE_WRITE);
+		} break;
+		case GDScriptFunction::OPCODE_CONSTRUCT:
+		case GDScriptFunction::OPCODE_CALL_BUILT_IN:
+		case GDScriptFunction::OPCODE_CALL_SELF_BASE: {
+			int argc = w[2];
+			for (int i = 0; i < argc; i++) {
+				ADD_OPERAND(3 + i, ROLE_READ);
+			}
+			ADD_OPERAND(3 + argc, ROLE_WRITE);
+		} break;
+		case GDScriptFunction::OPCODE_CONSTRUCT_ARRAY:
+		case GDScriptFunction::OPCODE_CONSTRUCT_DICTIONARY: {
+			int argc = w[0] == GDScriptFunction::OPCODE_CONSTRUCT_ARRAY ? w[1] : w[1] * 2;
+			for (int i = 0; i < argc; i++) {
+				ADD_OPERAND(2 + i, ROLE_READ);
+			}
+			ADD_OPERAND(2 + argc, ROLE_WRITE);
+		} break;
+		case GDScriptFunction::OPCODE_CALL:
+		case GDScriptFunction::OPCODE_CALL_RETURN: {
+			// Methods of built-in types may change the base in place.
+			int argc = w[1];
+			ADD_OPERAND(2, ROLE_READ_WRITE);
+			for (int i = 0; i < argc; i++) {
+				ADD_OPERAND(5 + i, ROLE_READ);
+			}
+			if (w[0] == GDScriptFunction::OPCODE_CALL_RETURN)
+				ADD_OPERAND(5 + argc, ROLE_WRITE);
+		} break;
+		case GDScriptFunction::OPCODE_YIELD_SIGNAL:
+		case GDScriptFunction::OPCODE_ASSERT: {
+			ADD_OPERAND(1, ROLE_READ);
+			ADD_OPERAND(2, ROLE_READ);
+		} break;
+		case GDScriptFunction::OPCODE_JUMP_IF:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT:
+		case GDScriptFunction::OPCODE_RETURN: {
+			ADD_OPERAND(1, ROLE_READ);
+		} break;
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN:
+		case GDScriptFunction::OPCODE_ITERATE: {
+			// The iterator is left alone when the loop ends, so it isn't a plain write.
+			ADD_OPERAND(1, ROLE_READ_WRITE);
+			ADD_OPERAND(2, ROLE_READ);
+			ADD_OPERAND(4, ROLE_READ_WRITE);
+		} break;
+		default: {
+		}
+	}
+
+#undef ADD_OPERAND
+}
+
+bool GDScriptOptimizer::_decode(const Vector<int> &p_code, const Vector<int> &p_default_args) {
+
+	const int *code = p_code.ptr();
+	int code_size = p_code.size();
+
+	Vector<int> insn_at;
+	insn_at.resize(code_size);
+	for (int i = 0; i < code_size; i++) {
+		insn_at.write[i] = -1;
+	}
+
+	int ip = 0;
+	while (ip < code_size) {
+
+		int size = _get_insn_size(code, ip, code_size);
+		if (size == 0)
+			return false;
+
+		insn_at.write[ip] = insns.size();
+
+		Insn insn;
+		insn.words.resize(size);
+		for (int i = 0; i < size; i++) {
+			insn.words.write[i] = code[ip + i];
+		}
+		insn.target = -1;
+		insn.removed = false;
+		insn.label = false;
+		insns.push_back(insn);
+
+		ip += size;
+	}
+
+	if (insns.empty() || insns[insns.size() - 1].words[0] != GDScriptFunction::OPCODE_END)
+		return false;
+
+	for (int i = 0; i < insns.size(); i++) {
+		int target_word = _get_target_word(insns[i].words[0]);
+		if (!target_word)
+			continue;
+		int addr = insns[i].words[target_word];
+		if (addr < 0 || addr >= code_size || insn_at[addr] == -1)
+			return false;
+		insns.write[i].target = insn_at[addr];
+	}
+
+	for (int i = 0; i < p_default_args.size(); i++) {
+		int addr = p_default_args[i];
+		if (addr < 0 || addr >= code_size || insn_at[addr] == -1)
+			return false;
+		default_args.push_back(insn_at[addr]);
+	}
+
+	return true;
+}
+
+void GDScriptOptimizer::_encode(Vector<int> &r_code, Vector<int> &r_default_args) const {
+
+	// Removed instructions take the address of the next one that is kept.
+	Vector<int> addr;
+	addr.resize(insns.size());
+	int size = 0;
+	for (int i = 0; i < insns.size(); i++) {
+		addr.write[i] = size;
+		if (!insns[i].removed)
+			size += insns[i].words.size();
+	}
+
+	r_code.resize(size);
+	int *code = r_code.ptrw();
+	for (int i = 0; i < insns.size(); i++) {
+		const Insn &insn = insns[i];
+		if (insn.removed)
+			continue;
+		int *w = &code[addr[i]];
+		for (int j = 0; j < insn.words.size(); j++) {
+			w[j] = insn.words[j];
+		}
+		if (insn.target != -1)
+			w[_get_target_word(insn.words[0])] = addr[insn.target];
+	}
+
+	for (int i = 0; i < default_args.size(); i++) {
+		r_default_args.write[i] = addr[default_args[i]];
+	}
+}
+
+/* Helpers */
+
+bool GDScriptOptimizer::_get_constant(int p_address, Variant &r_value) const {
+
+	int type = p_address >> GDScriptFunction::ADDR_BITS;
+	int index = p_address & GDScriptFunction::ADDR_MASK;
+
+	if (type == GDScriptFunction::ADDR_TYPE_NIL) {
+		r_value = Variant();
+		return true;
+	}
+	if (type == GDScriptFunction::ADDR_TYPE_LOCAL_CONSTANT && index < constants.size()) {
+		r_value = constants[index];
+		return true;
+	}
+	return false;
+}
+
+int GDScriptOptimizer::_get_constant_address(const Variant &p_value) {
+
+	int index;
+	if (constant_map.has(p_value)) {
+		index = constant_map[p_value];
+	} else {
+		index = constants.size();
+		constant_map[p_value] = index;
+		constants.push_back(p_value);
+	}
+	return (GDScriptFunction::ADDR_TYPE_LOCAL_CONSTANT << GDScriptFunction::ADDR_BITS) | index;
+}
+
+int GDScriptOptimizer::_next_live(int p_insn) const {
+
+	// The trailing OPCODE_END is never removed, so this always finds one.
+	while (insns[p_insn].removed) {
+		p_insn++;
+	}
+	return p_insn;
+}
+
+void GDScriptOptimizer::_get_successors(int p_insn, Vector<int> &r_successors) const {
+
+	r_successors.clear();
+	const Insn &insn = insns[p_insn];
+
+	switch (insn.words[0]) {
+		case GDScriptFunction::OPCODE_JUMP: {
+			r_successors.push_back(_next_live(insn.target));
+		} break;
+		case GDScriptFunction::OPCODE_JUMP_IF:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT:
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN:
+		case GDScriptFunction::OPCODE_ITERATE: {
+			r_successors.push_back(_next_live(insn.target));
+			r_successors.push_back(_next_live(p_insn + 1));
+		} break;
+		case GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT: {
+			for (int i = 0; i < default_args.size(); i++) {
+				r_successors.push_back(_next_live(default_args[i]));
+			}
+		} break;
+		case GDScriptFunction::OPCODE_RETURN:
+		case GDScriptFunction::OPCODE_END: {
+		} break;
+		default: {
+			// A yield resumes at the instruction that follows it.
+			r_successors.push_back(_next_live(p_insn + 1));
+		}
+	}
+}
+
+void GDScriptOptimizer::_remove(int p_insn) {
+
+	insns.write[p_insn].removed = true;
+}
+
+void GDScriptOptimizer::_update_labels() {
+
+	Insn *code = insns.ptrw();
+	for (int i = 0; i < insns.size(); i++) {
+		code[i].label = false;
+	}
+	for (int i = 0; i < insns.size(); i++) {
+		if (!code[i].removed && code[i].target != -1)
+			code[_next_live(code[i].target)].label = true;
+	}
+	for (int i = 0; i < default_args.size(); i++) {
+		code[_next_live(default_args[i])].label = true;
+	}
+}
+
+void GDScriptOptimizer::_compute_liveness() {
+
+	int count = insns.size();
+	live_words = MAX(1, (stack_size + 31) / 32);
+
+	Vector<uint32_t> use;
+	Vector<uint32_t> def;
+	Vector<uint32_t> live_in;
+	use.resize(count * live_words);
+	def.resize(count * live_words);
+	live_in.resize(count * live_words);
+	live_out.resize(count * live_words);
+	zeromem(use.ptrw(), use.size() * sizeof(uint32_t));
+	zeromem(def.ptrw(), def.size() * sizeof(uint32_t));
+	zeromem(live_in.ptrw(), live_in.size() * sizeof(uint32_t));
+	zeromem(live_out.ptrw(), live_out.size() * sizeof(uint32_t));
+
+	Vector<Operand> operands;
+	for (int i = 0; i < count; i++) {
+		if (insns[i].removed)
+			continue;
+		_get_operands(insns[i], operands);
+		for (int j = 0; j < operands.size(); j++) {
+			int slot = _get_stack_slot(insns[i].words[operands[j].word]);
+			if (slot == -1)
+				continue;
+			uint32_t bit = 1U << (slot & 31);
+			if (operands[j].role == ROLE_WRITE)
+				def.write[i * live_words + (slot >> 5)] |= bit;
+			else
+				use.write[i * live_words + (slot >> 5)] |= bit;
+		}
+	}
+
+	Vector<int> successors;
+	bool changed = true;
+	while (changed) {
+		changed = false;
+		for (int i = count - 1; i >= 0; i--) {
+			if (insns[i].removed)
+				continue;
+			_get_successors(i, successors);
+			for (int j = 0; j < live_words; j++) {
+				int k = i * live_words + j;
+				uint32_t out = 0;
+				for (int s = 0; s < successors.size(); s++) {
+					out |= live_in[successors[s] * live_words + j];
+				}
+				uint32_t in = use[k] | (out & ~def[k]);
+				if (out != live_out[k] || in != live_in[k]) {
+					live_out.write[k] = out;
+					live_in.write[k] = in;
+					changed = true;
+				}
+			}
+		}
+	}
+}
+
+/* Passes */
+
+bool GDScriptOptimizer::_fold_constants() {
+
+	bool changed = false;
+
+	for (int i = 0; i < insns.size(); i++) {
+		const Insn &insn = insns[i];
+		if (insn.removed)
+			continue;
+		int ofs;
+		if (insn.words[0] == GDScriptFunction::OPCODE_OPERATOR)
+			ofs = 2;
+		else if (insn.words[0] == GDScriptFunction::OPCODE_OPERATOR_TYPED)
+			ofs = 3;
+		else
+			continue;
+
+		// Objects and containers are shared, so only plain values are folded.
+		Variant a, b;
+		if (!_get_constant(insn.words[ofs], a) || !_get_constant(insn.words[ofs + 1], b))
+			continue;
+		if (a.get_type() >= Variant::OBJECT || b.get_type() >= Variant::OBJECT)
+			continue;
+
+		Variant ret;
+		bool valid;
+		Variant::evaluate((Variant::Operator)insn.words[1], a, b, ret, valid);
+		if (!valid || ret.get_type() >= Variant::OBJECT)
+			continue;
+
+		int dst = insn.words[ofs + 2];
+		Vector<int> words;
+		words.push_back(GDScriptFunction::OPCODE_ASSIGN);
+		words.push_back(dst);
+		words.push_back(_get_constant_address(ret));
+		insns.write[i].words = words;
+		changed = true;
+	}
+
+	return changed;
+}
+
+bool GDScriptOptimizer::_simplify_jumps() {
+
+	bool changed = false;
+	Insn *code = insns.ptrw();
+
+	for (int i = 0; i < insns.size(); i++) {
+		if (code[i].removed || !_is_jump(code[i].words[0]))
+			continue;
+
+		int op = code[i].words[0];
+
+		// Branches on a constant are either always or never taken.
+		Variant test;
+		if ((op == GDScriptFunction::OPCODE_JUMP_IF || op == GDScriptFunction::OPCODE_JUMP_IF_NOT) && _get_constant(code[i].words[1], test)) {
+			if (test.booleanize() == (op == GDScriptFunction::OPCODE_JUMP_IF)) {
+				code[i].words.resize(2);
+				code[i].words.write[0] = GDScriptFunction::OPCODE_JUMP;
+				op = GDScriptFunction::OPCODE_JUMP;
+			} else {
+				_remove(i);
+				changed = true;
+				continue;
+			}
+			changed = true;
+		}
+
+		// Jumps landing on an unconditional jump go straight to its destination.
+		int target = _next_live(code[i].target);
+		for (int hops = 0; hops < insns.size() && target != i && code[target].words[0] == GDScriptFunction::OPCODE_JUMP; hops++) {
+			target = _next_live(code[target].target);
+		}
+		if (target != _next_live(code[i].target)) {
+			code[i].target = target;
+			code[target].label = true;
+			changed = true;
+		}
+
+		if (op == GDScriptFunction::OPCODE_ITERATE_BEGIN || op == GDScriptFunction::OPCODE_ITERATE)
+			continue;
+
+		int next = _next_live(i + 1);
+		if (target == next) {
+			_remove(i);
+			changed = true;
+			continue;
+		}
+
+		// A conditional jump over an unconditional one becomes the inverse jump.
+		if (op != GDScriptFunction::OPCODE_JUMP && code[next].words[0] == GDScriptFunction::OPCODE_JUMP && !code[next].label && target == _next_live(next + 1)) {
+			code[i].words.write[0] = op == GDScriptFunction::OPCODE_JUMP_IF ? GDScriptFunction::OPCODE_JUMP_IF_NOT : GDScriptFunction::OPCODE_JUMP_IF;
+			code[i].target = code[next].target;
+			code[_next_live(code[i].target)].label = true;
+			_remove(next);
+			changed = true;
+		}
+	}
+
+	return changed;
+}
+
+bool GDScriptOptimizer::_remove_unreachable() {
+
+	Vector<bool> reached;
+	reached.resize(insns.size());
+	for (int i = 0; i < insns.size(); i++) {
+		reached.write[i] = false;
+	}
+
+	Vector<int> pending;
+	Vector<int> successors;
+	pending.push_back(_next_live(0));
+	reached.write[pending[0]] = true;
+
+	while (!pending.empty()) {
+		int i = pending[pending.size() - 1];
+		pending.resize(pending.size() - 1);
+		_get_successors(i, successors);
+		for (int j = 0; j < successors.size(); j++) {
+			if (!reached[successors[j]]) {
+				reached.write[successors[j]] = true;
+				pending.push_back(successors[j]);
+			}
+		}
+	}
+
+	bool changed = false;
+	for (int i = 0; i < insns.size() - 1; i++) {
+		if (!insns[i].removed && !reached[i]) {
+			_remove(i);
+			changed = true;
+		}
+	}
+
+	return changed;
+}
+
+bool GDScriptOptimizer::_propagate_constants() {
+
+	if (stack_size == 0)
+		return false;
+
+	// Writes per stack slot, where updates in place count as two so they never qualify.
+	Vector<int> writes;
+	Vector<int> writer;
+	writes.resize(stack_size);
+	writer.resize(stack_size);
+	for (int i = 0; i < stack_size; i++) {
+		writes.write[i] = 0;
+		writer.write[i] = -1;
+	}
+
+	// Code up to the first label or control transfer runs exactly once, before anything else.
+	int straight_end = -1;
+	Vector<Operand> operands;
+
+	for (int i = 0; i < insns.size(); i++) {
+		const Insn &insn = insns[i];
+		if (insn.removed)
+			continue;
+
+		if (straight_end == -1) {
+			int op = insn.words[0];
+			if ((insn.label && i > 0) || _is_jump(op) || op == GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT || op == GDScriptFunction::OPCODE_RETURN || op == GDScriptFunction::OPCODE_YIELD || op == GDScriptFunction::OPCODE_YIELD_SIGNAL || op == GDScriptFunction::OPCODE_END)
+				straight_end = i;
+		}
+
+		_get_operands(insn, operands);
+		for (int j = 0; j < operands.size(); j++) {
+			int slot = _get_stack_slot(insn.words[operands[j].word]);
+			if (slot == -1 || operands[j].role == ROLE_READ)
+				continue;
+			writes.write[slot] += operands[j].role == ROLE_WRITE ? 1 : 2;
+			writer.write[slot] = i;
+		}
+	}
+
+	bool changed = false;
+
+	for (int slot = argument_count; slot < stack_size; slot++) {
+		int w = writer[slot];
+		if (writes[slot] != 1 || w >= straight_end)
+			continue;
+
+		const Insn &insn = insns[w];
+		Variant value;
+		bool is_constant = false;
+		switch (insn.words[0]) {
+			case GDScriptFunction::OPCODE_ASSIGN: {
+				is_constant = _get_constant(insn.words[2], value);
+			} break;
+			case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN: {
+				is_constant = _get_constant(insn.words[3], value) && value.get_type() == insn.words[1];
+			} break;
+			case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+			case GDScriptFunction::OPCODE_ASSIGN_FALSE: {
+				value = insn.words[0] == GDScriptFunction::OPCODE_ASSIGN_TRUE;
+				is_constant = true;
+			} break;
+			default: {
+			}
+		}
+		if (!is_constant || value.get_type() >= Variant::OBJECT)
+			continue;
+
+		// Reading the slot before it is assigned sees what was there before.
+		bool read_before = false;
+		for (int i = 0; i < w && !read_before; i++) {
+			if (insns[i].removed)
+				continue;
+			_get_operands(insns[i], operands);
+			for (int j = 0; j < operands.size(); j++) {
+				if (_get_stack_slot(insns[i].words[operands[j].word]) == slot)
+					read_before = true;
+			}
+		}
+		if (read_before)
+			continue;
+
+		int constant = _get_constant_address(value);
+		for (int i = w + 1; i < insns.size(); i++) {
+			if (insns[i].removed)
+				continue;
+			_get_operands(insns[i], operands);
+			for (int j = 0; j < operands.size(); j++) {
+				if (operands[j].role == ROLE_READ && _get_stack_slot(insns[i].words[operands[j].word]) == slot) {
+					insns.write[i].words.write[operands[j].word] = constant;
+					changed = true;
+				}
+			}
+		}
+	}
+
+	return changed;
+}
+
+bool GDScriptOptimizer::_forward_temporaries() {
+
+	bool changed = false;
+	Vector<Operand> operands;
+
+	for (int i = 0; i < insns.size(); i++) {
+		if (insns[i].removed || i + 1 == insns.size())
+			continue;
+
+		int next = _next_live(i + 1);
+		if (insns[next].label)
+			continue;
+
+		const Insn &insn = insns[i];
+		int op = insn.words[0];
+		_get_operands(insn, operands);
+
+		// A constant put in a temporary is read straight from the constants by the next instruction.
+		if (op == GDScriptFunction::OPCODE_ASSIGN && (insn.words[2] >> GDScriptFunction::ADDR_BITS) == GDScriptFunction::ADDR_TYPE_LOCAL_CONSTANT) {
+			int slot = _get_stack_slot(insn.words[1]);
+			Variant value;
+			if (slot != -1 && _get_constant(insn.words[2], value) && value.get_type() < Variant::OBJECT) {
+				Vector<Operand> next_operands;
+				_get_operands(insns[next], next_operands);
+				bool only_read = true;
+				for (int j = 0; j < next_operands.size(); j++) {
+					if (next_operands[j].role != ROLE_READ && _get_stack_slot(insns[next].words[next_operands[j].word]) == slot)
+						only_read = false;
+				}
+				for (int j = 0; only_read && j < next_operands.size(); j++) {
+					if (_get_stack_slot(insns[next].words[next_operands[j].word]) == slot) {
+						insns.write[next].words.write[next_operands[j].word] = insn.words[2];
+						changed = true;
+					}
+				}
+			}
+		}
+
+		// A result copied out of a temporary is written to its destination directly.
+		const Insn &assign = insns[next];
+		if (assign.words[0] != GDScriptFunction::OPCODE_ASSIGN)
+			continue;
+
+		switch (op) {
+			case GDScriptFunction::OPCODE_OPERATOR:
+			case GDScriptFunction::OPCODE_OPERATOR_TYPED:
+			case GDScriptFunction::OPCODE_EXTENDS_TEST:
+			case GDScriptFunction::OPCODE_IS_BUILTIN:
+			case GDScriptFunction::OPCODE_GET:
+			case GDScriptFunction::OPCODE_GET_NAMED:
+			case GDScriptFunction::OPCODE_GET_MEMBER:
+			case GDScriptFunction::OPCODE_ASSIGN:
+			case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+			case GDScriptFunction::OPCODE_ASSIGN_FALSE:
+			case GDScriptFunction::OPCODE_CAST_TO_BUILTIN:
+			case GDScriptFunction::OPCODE_CONSTRUCT:
+			case GDScriptFunction::OPCODE_CONSTRUCT_ARRAY:
+			case GDScriptFunction::OPCODE_CONSTRUCT_DICTIONARY:
+			case GDScriptFunction::OPCODE_CALL_RETURN:
+			case GDScriptFunction::OPCODE_CALL_BUILT_IN:
+			case GDScriptFunction::OPCODE_YIELD_RESUME: {
+			} break;
+			default: {
+				continue;
+			}
+		}
+
+		int tmp = _get_stack_slot(assign.words[2]);
+		int dst = _get_stack_slot(assign.words[1]);
+		if (tmp == -1 || dst == -1 || tmp == dst || _is_live_out(next, tmp))
+			continue;
+
+		int result_word = -1;
+		bool dst_is_input = false;
+		for (int j = 0; j < operands.size(); j++) {
+			int slot = _get_stack_slot(insn.words[operands[j].word]);
+			if (operands[j].role == ROLE_WRITE && slot == tmp)
+				result_word = operands[j].word;
+			else if (slot == dst)
+				dst_is_input = true;
+		}
+
+		// Operators and copies read their inputs before writing the result; calls and
+		// constructors may not.
+		if (result_word == -1 || (dst_is_input && op != GDScriptFunction::OPCODE_OPERATOR && op != GDScriptFunction::OPCODE_OPERATOR_TYPED && op != GDScriptFunction::OPCODE_ASSIGN))
+			continue;
+
+		insns.write[i].words.write[result_word] = assign.words[1];
+		for (int j = 0; j < live_words; j++) {
+			live_out.write[i * live_words + j] = live_out[next * live_words + j];
+		}
+		_remove(next);
+		changed = true;
+	}
+
+	return changed;
+}
+
+bool GDScriptOptimizer::_remove_dead_stores() {
+
+	bool changed = false;
+
+	for (int i = 0; i < insns.size(); i++) {
+		const Insn &insn = insns[i];
+		if (insn.removed)
+			continue;
+
+		int dst;
+		Variant value;
+		switch (insn.words[0]) {
+			case GDScriptFunction::OPCODE_ASSIGN: {
+				if (!_get_constant(insn.words[2], value))
+					continue;
+				dst = insn.words[1];
+			} break;
+			case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN: {
+				// A conversion may fail, so only stores of the right type go.
+				if (!_get_constant(insn.words[3], value) || value.get_type() != insn.words[1])
+					continue;
+				dst = insn.words[2];
+			} break;
+			case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+			case GDScriptFunction::OPCODE_ASSIGN_FALSE: {
+				dst = insn.words[1];
+			} break;
+			default: {
+				continue;
+			}
+		}
+
+		int slot = _get_stack_slot(dst);
+		if (slot == -1 || _is_live_out(i, slot))
+			continue;
+		// The debugger shows named variables, keep them up to date.
+		if (debug && (dst >> GDScriptFunction::ADDR_BITS) != GDScriptFunction::ADDR_TYPE_STACK)
+			continue;
+
+		_remove(i);
+		changed = true;
+	}
+
+	return changed;
+}
+
+void GDScriptOptimizer::optimize(Vector<int> &r_code, Vector<int> &r_default_args) {
+
+	if (!_decode(r_code, r_default_args))
+		return;
+
+	constants.resize(constant_map.size());
+	const Variant *K = NULL;
+	while ((K = constant_map.next(K))) {
+		constants.write[constant_map[*K]] = *K;
+	}
+
+	for (int round = 0; round < MAX_ROUNDS; round++) {
+
+		bool changed = _fold_constants();
+		_update_labels();
+		changed = _simplify_jumps() || changed;
+		changed = _remove_unreachable() || changed;
+
+		_update_labels();
+		_compute_liveness();
+		changed = _propagate_constants() || changed;
+		changed = _forward_temporaries() || changed;
+		changed = _remove_dead_stores() || changed;
+
+		if (!changed)
+			break;
+	}
+
+	_encode(r_code, r_default_args);
+}
+
+GDScriptOptimizer::GDScriptOptimizer(ConstantMap &r_constant_map, int p_stack_size, int p_argument_count, bool p_debug) :
+		constant_map(r_constant_map) {
+
+	stack_size = p_stack_size;
+	argument_count = p_argument_count;
+	debug = p_debug;
+	live_words = 0;
+}
@@ -0,0 +1,131 @@
+/*************************************************************************/
+/*  gdscript_optimizer.h                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef GDSCRIPT_OPTIMIZER_H
+#define GDSCRIPT_OPTIMIZER_H
+
+#include "core/hash_map.h"
+#include "core/variant.h"
+#include "core/vector.h"
+#include "gdscript_function.h"
+
+// Bytecode pass run by the compiler on every function before it is stored.
+// It folds operators on constants, propagates constants into the reads of
+// locals assigned only once, writes results straight into their destination
+// instead of going through a temporary and an OPCODE_ASSIGN, threads jumps,
+// resolves branches on constants and drops unreachable code.
+//
+// Locals stay observable in debug code: stores to named variables are kept
+// and only temporaries are removed.
+class GDScriptOptimizer {
+public:
+	typedef HashMap<Variant, int, VariantHasher, VariantComparator> ConstantMap;
+
+private:
+	enum {
+		MAX_ROUNDS = 8,
+	};
+
+	enum OperandRole {
+		ROLE_READ,
+		ROLE_WRITE,
+		ROLE_READ_WRITE,
+	};
+
+	struct Operand {
+		int word;
+		OperandRole role;
+	};
+
+	struct Insn {
+		Vector<int> words; // opcode followed by its operands
+		int target; // jump destination as an instruction index, -1 if none
+		bool removed;
+		bool label;
+	};
+
+	Vector<Insn> insns;
+	Vector<int> default_args;
+
+	ConstantMap &constant_map;
+	Vector<Variant> constants;
+
+	int stack_size;
+	int argument_count;
+	bool debug;
+
+	// Stack slots live after each instruction, as bitsets of live_words words.
+	Vector<uint32_t> live_out;
+	int live_words;
+
+	static int _get_insn_size(const int *p_code, int p_ip, int p_code_size);
+	static void _get_operands(const Insn &p_insn, Vector<Operand> &r_operands);
+	static bool _is_jump(int p_opcode);
+
+	_FORCE_INLINE_ int _get_stack_slot(int p_address) const {
+		int type = p_address >> GDScriptFunction::ADDR_BITS;
+		if (type != GDScriptFunction::ADDR_TYPE_STACK && type != GDScriptFunction::ADDR_TYPE_STACK_VARIABLE)
+			return -1;
+		int slot = p_address & GDScriptFunction::ADDR_MASK;
+		return slot < stack_size ? slot : -1;
+	}
+	_FORCE_INLINE_ bool _is_live_out(int p_insn, int p_slot) const {
+		return live_out[p_insn * live_words + (p_slot >> 5)] & (1U << (p_slot & 31));
+	}
+
+	bool _get_constant(int p_address, Variant &r_value) const;
+	int _get_constant_address(const Variant &p_value);
+
+	int _next_live(int p_insn) const;
+	void _get_successors(int p_insn, Vector<int> &r_successors) const;
+	void _remove(int p_insn);
+
+	bool _decode(const Vector<int> &p_code, const Vector<int> &p_default_args);
+	void _update_labels();
+	void _compute_liveness();
+
+	bool _fold_constants();
+	bool _simplify_jumps();
+	bool _remove_unreachable();
+	bool _propagate_constants();
+	bool _forward_temporaries();
+	bool _remove_dead_stores();
+
+	void _encode(Vector<int> &r_code, Vector<int> &r_default_args) const;
+
+public:
+	// Rewrites the code and default argument addresses in place, adding folded
+	// values to the constants. Code it doesn't understand is left untouched.
+	void optimize(Vector<int> &r_code, Vector<int> &r_default_args);
+
+	GDScriptOptimizer(ConstantMap &r_constant_map, int p_stack_size, int p_argument_count, bool p_debug);
+};
+
+#endif // GDSCRIPT_OPTIMIZER_H
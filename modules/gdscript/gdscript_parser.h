@@ -542,6 +542,8 @@ private:
 	bool check_types;
 	bool dependencies_only;
 	List<String> dependencies;
+	bool cache_only;
+	bool uncached_dependency;
 #ifdef DEBUG_ENABLED
 	Set<int> *safe_lines;
 #endif // DEBUG_ENABLED
@@ -601,6 +603,7 @@ private:
 	MultiplayerAPI::RPCMode rpc_mode;
 
 	void _set_error(const String &p_error, int p_line = -1, int p_column = -1);
+	RES _load_dependency(const String &p_path);
 #ifdef DEBUG_ENABLED
 	void _add_warning(int p_code, int p_line = -1, const String &p_symbol1 = String(), const String &p_symbol2 = String(), const String &p_symbol3 = String(), const String &p_symbol4 = String());
 	void _add_warning(int p_code, int p_line, const Vector<String> &p_symbols);
@@ -686,6 +689,10 @@ public:
 
 	const List<String> &get_dependencies() const { return dependencies; }
 
+	// When set, referenced resources are only taken from the cache, so parsing can run on any thread.
+	void set_cache_only(bool p_enable) { cache_only = p_enable; }
+	bool has_uncached_dependency() const { return uncached_dependency; }
+
 	void clear();
 	GDScriptParser();
 	~GDScriptParser();
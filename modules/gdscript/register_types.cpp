@@ -35,6 +35,7 @@
 #include "core/os/dir_access.h"
 #include "core/os/file_access.h"
 #include "gdscript.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_tokenizer.h"
 
 GDScriptLanguage *script_language_gd = NULL;
@@ -57,7 +58,14 @@ class EditorExportGDScript : public EditorExportPlugin {
 
 	GDCLASS(EditorExportGDScript, EditorExportPlugin);
 
+	bool export_debug;
+
 public:
+	virtual void _export_begin(const Set<String> &p_features, bool p_debug, const String &p_path, int p_flags) {
+
+		export_debug = p_debug;
+	}
+
 	virtual void _export_file(const String &p_path, const String &p_type, const Set<String> &p_features) {
 
 		int script_mode = EditorExportPreset::MODE_SCRIPT_COMPILED;
@@ -83,6 +91,11 @@ public:
 
 		if (!file.empty()) {
 
+			Vector<uint8_t> compiled;
+			if (GDScriptBytecodeCache::make_buffer(p_path, file, export_debug, compiled) == OK) {
+				file = compiled;
+			}
+
 			if (script_mode == EditorExportPreset::MODE_SCRIPT_ENCRYPTED) {
 
 				String tmp_path = EditorSettings::get_singleton()->get_cache_dir().plus_file("script.gde");
@@ -132,6 +145,11 @@ public:
 			}
 		}
 	}
+
+	EditorExportGDScript() {
+
+		export_debug = false;
+	}
 };
 
 static void _editor_init() {
@@ -30,6 +30,7 @@
 
 #include "cpu_particles.h"
 
+#include "core/math/math_kernels.h"
 #include "scene/3d/camera.h"
 #include "scene/3d/particles.h"
 #include "scene/resources/particles_material.h"
@@ -1065,29 +1066,17 @@ void CPUParticles::_update_particle_data_buffer() {
 			}
 		}
 
+		Transform draw_xform;
+		if (!local_coords) {
+			draw_xform = inv_emission_transform;
+		}
+
 		for (int i = 0; i < pc; i++) {
 
 			int idx = order ? order[i] : i;
 
-			Transform t = r[idx].transform;
-
-			if (!local_coords) {
-				t = inv_emission_transform * t;
-			}
-
 			if (r[idx].active) {
-				ptr[0] = t.basis.elements[0][0];
-				ptr[1] = t.basis.elements[0][1];
-				ptr[2] = t.basis.elements[0][2];
-				ptr[3] = t.origin.x;
-				ptr[4] = t.basis.elements[1][0];
-				ptr[5] = t.basis.elements[1][1];
-				ptr[6] = t.basis.elements[1][2];
-				ptr[7] = t.origin.y;
-				ptr[8] = t.basis.elements[2][0];
-				ptr[9] = t.basis.elements[2][1];
-				ptr[10] = t.basis.elements[2][2];
-				ptr[11] = t.origin.z;
+				MathKernels::multiply_to_rows(draw_xform, r[idx].transform, ptr);
 			} else {
 				zeromem(ptr, sizeof(float) * 12);
 			}
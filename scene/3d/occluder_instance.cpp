@@ -0,0 +1,209 @@
+/*************************************************************************/
+/*  occluder_instance.cpp                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "occluder_instance.h"
+
+#include "core/core_string_names.h"
+
+void Occluder::_update() {
+
+	// Vertices and indices are set one after the other when loading, only send them once they match.
+	bool valid = indices.size() % 3 == 0;
+	{
+		PoolVector<int>::Read r = indices.read();
+		for (int i = 0; valid && i < indices.size(); i++) {
+			valid = r[i] >= 0 && r[i] < vertices.size();
+		}
+	}
+
+	aabb = AABB();
+	if (valid) {
+		PoolVector<Vector3>::Read r = vertices.read();
+		for (int i = 0; i < vertices.size(); i++) {
+			if (i == 0) {
+				aabb.position = r[i];
+			} else {
+				aabb.expand_to(r[i]);
+			}
+		}
+		VS::get_singleton()->occluder_set_mesh(occluder, vertices, indices);
+	} else {
+		VS::get_singleton()->occluder_set_mesh(occluder, PoolVector<Vector3>(), PoolVector<int>());
+	}
+
+	emit_changed();
+}
+
+void Occluder::set_vertices(const PoolVector<Vector3> &p_vertices) {
+
+	vertices = p_vertices;
+	_update();
+}
+
+PoolVector<Vector3> Occluder::get_vertices() const {
+
+	return vertices;
+}
+
+void Occluder::set_indices(const PoolVector<int> &p_indices) {
+
+	indices = p_indices;
+	_update();
+}
+
+PoolVector<int> Occluder::get_indices() const {
+
+	return indices;
+}
+
+void Occluder::create_from_mesh(const Ref<Mesh> &p_mesh) {
+
+	ERR_FAIL_COND(p_mesh.is_null());
+
+	PoolVector<Face3> faces = p_mesh->get_faces();
+	vertices.resize(faces.size() * 3);
+	indices.resize(faces.size() * 3);
+
+	{
+		PoolVector<Face3>::Read r = faces.read();
+		PoolVector<Vector3>::Write vw = vertices.write();
+		PoolVector<int>::Write iw = indices.write();
+
+		for (int i = 0; i < faces.size(); i++) {
+			for (int j = 0; j < 3; j++) {
+				vw[i * 3 + j] = r[i].vertex[j];
+				iw[i * 3 + j] = i * 3 + j;
+			}
+		}
+	}
+
+	_update();
+}
+
+AABB Occluder::get_aabb() const {
+
+	return aabb;
+}
+
+RID Occluder::get_rid() const {
+
+	return occluder;
+}
+
+void Occluder::_bind_methods() {
+
+	ClassDB::bind_method(D_METHOD("set_vertices", "vertices"), &Occluder::set_vertices);
+	ClassDB::bind_method(D_METHOD("get_vertices"), &Occluder::get_vertices);
+	ClassDB::bind_method(D_METHOD("set_indices", "indices"), &Occluder::set_indices);
+	ClassDB::bind_method(D_METHOD("get_indices"), &Occluder::get_indices);
+	ClassDB::bind_method(D_METHOD("create_from_mesh", "mesh"), &Occluder::create_from_mesh);
+	ClassDB::bind_method(D_METHOD("get_aabb"), &Occluder::get_aabb);
+
+	ADD_PROPERTY(PropertyInfo(Variant::POOL_VECTOR3_ARRAY, "vertices"), "set_vertices", "get_vertices");
+	ADD_PROPERTY(PropertyInfo(Variant::POOL_INT_ARRAY, "indices"), "set_indices", "get_indices");
+}
+
+Occluder::Occluder() {
+
+	occluder = VS::get_singleton()->occluder_create();
+}
+
+Occluder::~Occluder() {
+
+	VS::get_singleton()->free(occluder);
+}
+
+//////////////////////
+
+void OccluderInstance::_occluder_changed() {
+
+	update_gizmo();
+}
+
+void OccluderInstance::set_occluder(const Ref<Occluder> &p_occluder) {
+
+	if (occluder == p_occluder)
+		return;
+
+	if (occluder.is_valid()) {
+		occluder->disconnect(CoreStringNames::get_singleton()->changed, this, "_occluder_changed");
+	}
+
+	occluder = p_occluder;
+
+	if (occluder.is_valid()) {
+		occluder->connect(CoreStringNames::get_singleton()->changed, this, "_occluder_changed");
+		set_base(occluder->get_rid());
+	} else {
+		set_base(RID());
+	}
+
+	update_gizmo();
+	update_configuration_warning();
+}
+
+Ref<Occluder> OccluderInstance::get_occluder() const {
+
+	return occluder;
+}
+
+AABB OccluderInstance::get_aabb() const {
+
+	if (occluder.is_valid())
+		return occluder->get_aabb();
+
+	return AABB();
+}
+
+PoolVector<Face3> OccluderInstance::get_faces(uint32_t p_usage_flags) const {
+
+	return PoolVector<Face3>();
+}
+
+String OccluderInstance::get_configuration_warning() const {
+
+	if (occluder.is_null()) {
+		return TTR("An Occluder resource must be set or created for this node to hide what is behind it.");
+	}
+
+	return String();
+}
+
+void OccluderInstance::_bind_methods() {
+
+	ClassDB::bind_method(D_METHOD("set_occluder", "occluder"), &OccluderInstance::set_occluder);
+	ClassDB::bind_method(D_METHOD("get_occluder"), &OccluderInstance::get_occluder);
+	ClassDB::bind_method(D_METHOD("_occluder_changed"), &OccluderInstance::_occluder_changed);
+
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "occluder", PROPERTY_HINT_RESOURCE_TYPE, "Occluder"), "set_occluder", "get_occluder");
+}
+
+OccluderInstance::OccluderInstance() {
+}
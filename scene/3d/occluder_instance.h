@@ -0,0 +1,91 @@
+/*************************************************************************/
+/*  occluder_instance.h                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef OCCLUDER_INSTANCE_H
+#define OCCLUDER_INSTANCE_H
+
+#include "scene/3d/visual_instance.h"
+#include "scene/resources/mesh.h"
+
+class Occluder : public Resource {
+
+	GDCLASS(Occluder, Resource);
+
+	RID occluder;
+	PoolVector<Vector3> vertices;
+	PoolVector<int> indices;
+	AABB aabb;
+
+	void _update();
+
+protected:
+	static void _bind_methods();
+
+public:
+	void set_vertices(const PoolVector<Vector3> &p_vertices);
+	PoolVector<Vector3> get_vertices() const;
+
+	void set_indices(const PoolVector<int> &p_indices);
+	PoolVector<int> get_indices() const;
+
+	void create_from_mesh(const Ref<Mesh> &p_mesh);
+
+	AABB get_aabb() const;
+
+	virtual RID get_rid() const;
+
+	Occluder();
+	~Occluder();
+};
+
+class OccluderInstance : public VisualInstance {
+
+	GDCLASS(OccluderInstance, VisualInstance);
+
+	Ref<Occluder> occluder;
+
+	void _occluder_changed();
+
+protected:
+	static void _bind_methods();
+
+public:
+	void set_occluder(const Ref<Occluder> &p_occluder);
+	Ref<Occluder> get_occluder() const;
+
+	virtual AABB get_aabb() const;
+	virtual PoolVector<Face3> get_faces(uint32_t p_usage_flags) const;
+
+	String get_configuration_warning() const;
+
+	OccluderInstance();
+};
+
+#endif // OCCLUDER_INSTANCE_H
@@ -30,6 +30,7 @@
 
 #include "skeleton.h"
 
+#include "core/math/math_kernels.h"
 #include "core/message_queue.h"
 
 #include "core/project_settings.h"
@@ -137,7 +138,7 @@ bool Skeleton::_get(const StringName &p_path, Variant &r_ret) const {
 	else if (what == "bound_children") {
 		Array children;
 
-		for (const List<uint32_t>::Element *E = bones[which].nodes_bound.front(); E; E = E->next()) {
+		for (const List<ObjectID>::Element *E = bones[which].nodes_bound.front(); E; E = E->next()) {
 
 			Object *obj = ObjectDB::get_instance(E->get());
 			ERR_CONTINUE(!obj);
@@ -301,7 +302,7 @@ void Skeleton::_notification(int p_what) {
 					b.global_pose_override_amount = 0.0;
 				}
 
-				for (List<uint32_t>::Element *E = b.nodes_bound.front(); E; E = E->next()) {
+				for (List<ObjectID>::Element *E = b.nodes_bound.front(); E; E = E->next()) {
 
 					Object *obj = ObjectDB::get_instance(E->get());
 					ERR_CONTINUE(!obj);
@@ -323,10 +324,26 @@ void Skeleton::_notification(int p_what) {
 					E->get()->bind_count = bind_count;
 				}
 
+				if (skin_pose_buffer.size() < (int)bind_count * 2) {
+					skin_pose_buffer.resize(bind_count * 2);
+				}
+				Transform *poses = skin_pose_buffer.ptrw();
+				Transform *bind_poses = poses + bind_count;
+
 				for (uint32_t i = 0; i < bind_count; i++) {
 					uint32_t bone_index = skin->get_bind_bone(i);
 					ERR_CONTINUE(bone_index >= (uint32_t)len);
-					vs->skeleton_bone_set_transform(skeleton, i, bonesptr[bone_index].pose_global * skin->get_bind_pose(i));
+					poses[i] = bonesptr[bone_index].pose_global;
+					bind_poses[i] = skin->get_bind_pose(i);
+				}
+
+				MathKernels::multiply_transforms(poses, bind_poses, poses, bind_count);
+
+				for (uint32_t i = 0; i < bind_count; i++) {
+					if ((uint32_t)skin->get_bind_bone(i) >= (uint32_t)len) {
+						continue;
+					}
+					vs->skeleton_bone_set_transform(skeleton, i, poses[i]);
 				}
 			}
 
@@ -483,9 +500,9 @@ void Skeleton::bind_child_node_to_bone(int p_bone, Node *p_node) {
 	ERR_FAIL_NULL(p_node);
 	ERR_FAIL_INDEX(p_bone, bones.size());
 
-	uint32_t id = p_node->get_instance_id();
+	ObjectID id = p_node->get_instance_id();
 
-	for (const List<uint32_t>::Element *E = bones[p_bone].nodes_bound.front(); E; E = E->next()) {
+	for (const List<ObjectID>::Element *E = bones[p_bone].nodes_bound.front(); E; E = E->next()) {
 
 		if (E->get() == id)
 			return; // already here
@@ -498,14 +515,14 @@ void Skeleton::unbind_child_node_from_bone(int p_bone, Node *p_node) {
 	ERR_FAIL_NULL(p_node);
 	ERR_FAIL_INDEX(p_bone, bones.size());
 
-	uint32_t id = p_node->get_instance_id();
+	ObjectID id = p_node->get_instance_id();
 	bones.write[p_bone].nodes_bound.erase(id);
 }
 void Skeleton::get_bound_child_nodes_to_bone(int p_bone, List<Node *> *p_bound) const {
 
 	ERR_FAIL_INDEX(p_bone, bones.size());
 
-	for (const List<uint32_t>::Element *E = bones[p_bone].nodes_bound.front(); E; E = E->next()) {
+	for (const List<ObjectID>::Element *E = bones[p_bone].nodes_bound.front(); E; E = E->next()) {
 
 		Object *obj = ObjectDB::get_instance(E->get());
 		ERR_CONTINUE(!obj);
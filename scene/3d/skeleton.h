@@ -99,7 +99,7 @@ private:
 		PhysicalBone *cache_parent_physical_bone;
 #endif // _3D_DISABLED
 
-		List<uint32_t> nodes_bound;
+		List<ObjectID> nodes_bound;
 
 		Bone() {
 			parent = -1;
@@ -119,6 +119,8 @@ private:
 	Vector<int> process_order;
 	bool process_order_dirty;
 
+	Vector<Transform> skin_pose_buffer; // scratch space for skin bind transforms
+
 	void _make_dirty();
 	bool dirty;
 
@@ -63,24 +63,53 @@ void SceneTreeTimer::_bind_methods() {
 }
 
 void SceneTreeTimer::set_time_left(float p_time) {
-	time_left = p_time;
+
+	if (tree) {
+		Ref<SceneTreeTimer> keep_alive(this); // the wheel may hold the last reference
+		SceneTree *scheduled_on = tree;
+		scheduled_on->_unschedule_timer(this);
+		scheduled_on->_schedule_timer(this, p_time);
+	} else {
+		time_left = p_time;
+	}
 }
 
 float SceneTreeTimer::get_time_left() const {
+
+	if (tree) {
+		return expiry - tree->_get_timer_wheel(this).clock;
+	}
 	return time_left;
 }
 
 void SceneTreeTimer::set_pause_mode_process(bool p_pause_mode_process) {
 
-	process_pause = p_pause_mode_process;
+	if (tree && process_pause != p_pause_mode_process) {
+		// Move to the other clock, keeping the remaining time.
+		Ref<SceneTreeTimer> keep_alive(this);
+		SceneTree *scheduled_on = tree;
+		float remaining = get_time_left();
+		scheduled_on->_unschedule_timer(this);
+		process_pause = p_pause_mode_process;
+		scheduled_on->_schedule_timer(this, remaining);
+	} else {
+		process_pause = p_pause_mode_process;
+	}
 }
 
 bool SceneTreeTimer::is_pause_mode_process() {
 	return process_pause;
 }
 
+void SceneTreeTimer::add_resume_state(const Ref<Reference> &p_state) {
+
+	resume_states.push_back(p_state);
+}
+
 void SceneTreeTimer::release_connections() {
 
+	resume_states.clear();
+
 	List<Connection> connections;
 	get_all_signal_connections(&connections);
 
@@ -93,6 +122,8 @@ void SceneTreeTimer::release_connections() {
 SceneTreeTimer::SceneTreeTimer() {
 	time_left = 0;
 	process_pause = true;
+	tree = NULL;
+	expiry = 0;
 }
 
 void SceneTree::tree_changed() {
@@ -542,32 +573,23 @@ bool SceneTree::idle(float p_time) {
 
 	_flush_delete_queue();
 
-	//go through timers
-
-	List<Ref<SceneTreeTimer> >::Element *L = timers.back(); //last element
+	//go through timers, those added while emitting wait for the next frame
 
-	for (List<Ref<SceneTreeTimer> >::Element *E = timers.front(); E;) {
+	Vector<Ref<SceneTreeTimer> > timeouts;
+	_process_timers(timer_wheels[1], p_time, timeouts);
+	if (!pause) {
+		_process_timers(timer_wheels[0], p_time, timeouts);
+	}
 
-		List<Ref<SceneTreeTimer> >::Element *N = E->next();
-		if (pause && !E->get()->is_pause_mode_process()) {
-			if (E == L) {
-				break; //break on last, so if new timers were added during list traversal, ignore them.
-			}
-			E = N;
-			continue;
-		}
-		float time_left = E->get()->get_time_left();
-		time_left -= p_time;
-		E->get()->set_time_left(time_left);
+	for (int i = 0; i < timeouts.size(); i++) {
+		Ref<SceneTreeTimer> timer = timeouts[i];
+		timer->emit_signal("timeout");
 
-		if (time_left < 0) {
-			E->get()->emit_signal("timeout");
-			timers.erase(E);
-		}
-		if (E == L) {
-			break; //break on last, so if new timers were added during list traversal, ignore them.
+		Vector<Ref<Reference> > states = timer->resume_states;
+		timer->resume_states.clear();
+		for (int j = 0; j < states.size(); j++) {
+			states.write[j]->call("resume");
 		}
-		E = N;
 	}
 
 	flush_transform_notifications(); //additional transforms after timers update
@@ -623,10 +645,19 @@ void SceneTree::finish() {
 	}
 
 	// cleanup timers
-	for (List<Ref<SceneTreeTimer> >::Element *E = timers.front(); E; E = E->next()) {
-		E->get()->release_connections();
+	for (int i = 0; i < 2; i++) {
+		TimerWheel &wheel = timer_wheels[i];
+		for (int j = 0; j < TIMER_WHEEL_SLOTS; j++) {
+			for (int k = 0; k < wheel.slots[j].size(); k++) {
+				SceneTreeTimer *timer = wheel.slots[j].write[k].ptr();
+				timer->time_left = timer->get_time_left();
+				timer->tree = NULL;
+				timer->release_connections();
+			}
+			wheel.slots[j].clear();
+		}
+		wheel.count = 0;
 	}
-	timers.clear();
 }
 
 void SceneTree::quit(int p_exit_code) {
@@ -1718,11 +1749,77 @@ Ref<SceneTreeTimer> SceneTree::create_timer(float p_delay_sec, bool p_process_pa
 	Ref<SceneTreeTimer> stt;
 	stt.instance();
 	stt->set_pause_mode_process(p_process_pause);
-	stt->set_time_left(p_delay_sec);
-	timers.push_back(stt);
+	_schedule_timer(stt.ptr(), p_delay_sec);
 	return stt;
 }
 
+void SceneTree::_schedule_timer(SceneTreeTimer *p_timer, float p_time_left) {
+
+	TimerWheel &wheel = _get_timer_wheel(p_timer);
+	p_timer->tree = this;
+	p_timer->expiry = wheel.clock + p_time_left;
+
+	// Already due timers go in the current slot, which is visited again next frame.
+	int64_t tick = MAX((int64_t)Math::floor(p_timer->expiry * TIMER_WHEEL_TICKS_PER_SEC), wheel.tick);
+	wheel.slots[tick & (TIMER_WHEEL_SLOTS - 1)].push_back(Ref<SceneTreeTimer>(p_timer));
+	wheel.count++;
+}
+
+void SceneTree::_unschedule_timer(SceneTreeTimer *p_timer) {
+
+	ERR_FAIL_COND(p_timer->tree != this);
+
+	TimerWheel &wheel = _get_timer_wheel(p_timer);
+	int64_t tick = MAX((int64_t)Math::floor(p_timer->expiry * TIMER_WHEEL_TICKS_PER_SEC), wheel.tick);
+
+	p_timer->time_left = p_timer->get_time_left();
+	p_timer->tree = NULL;
+
+	// The slot is normally the one it was put in, otherwise it was already due and left behind.
+	for (int i = 0; i < TIMER_WHEEL_SLOTS; i++) {
+		Vector<Ref<SceneTreeTimer> > &slot = wheel.slots[(tick + i) & (TIMER_WHEEL_SLOTS - 1)];
+		for (int j = 0; j < slot.size(); j++) {
+			if (slot[j].ptr() == p_timer) {
+				slot.remove(j);
+				wheel.count--;
+				return;
+			}
+		}
+	}
+}
+
+void SceneTree::_process_timers(TimerWheel &p_wheel, float p_time, Vector<Ref<SceneTreeTimer> > &r_timeouts) {
+
+	p_wheel.clock += p_time;
+	if (p_wheel.count == 0) {
+		p_wheel.tick = (int64_t)Math::floor(p_wheel.clock * TIMER_WHEEL_TICKS_PER_SEC);
+		return;
+	}
+
+	int64_t to_tick = (int64_t)Math::floor(p_wheel.clock * TIMER_WHEEL_TICKS_PER_SEC);
+	int64_t from_tick = MAX(p_wheel.tick, to_tick - TIMER_WHEEL_SLOTS + 1);
+
+	for (int64_t tick = from_tick; tick <= to_tick; tick++) {
+
+		Vector<Ref<SceneTreeTimer> > &slot = p_wheel.slots[tick & (TIMER_WHEEL_SLOTS - 1)];
+		for (int i = 0; i < slot.size();) {
+
+			SceneTreeTimer *timer = slot.write[i].ptr();
+			if (timer->expiry - p_wheel.clock < 0) {
+				timer->time_left = timer->expiry - p_wheel.clock;
+				timer->tree = NULL;
+				r_timeouts.push_back(slot[i]);
+				slot.remove(i);
+				p_wheel.count--;
+			} else {
+				i++; // later turn of the wheel
+			}
+		}
+	}
+
+	p_wheel.tick = to_tick;
+}
+
 void SceneTree::_network_peer_connected(int p_id) {
 
 	emit_signal("network_peer_connected", p_id);
@@ -2038,6 +2135,12 @@ SceneTree::SceneTree() {
 
 	tree_version = 1;
 	physics_process_time = 1;
+
+	for (int i = 0; i < 2; i++) {
+		timer_wheels[i].clock = 0;
+		timer_wheels[i].tick = 0;
+		timer_wheels[i].count = 0;
+	}
 	idle_process_time = 1;
 
 	root = NULL;
@@ -45,12 +45,22 @@ class Viewport;
 class Material;
 class Mesh;
 
+class SceneTree;
+
 class SceneTreeTimer : public Reference {
 	GDCLASS(SceneTreeTimer, Reference);
 
+	friend class SceneTree;
+
 	float time_left;
 	bool process_pause;
 
+	// Set while the timer is pending on a tree's timer wheel, time_left is then derived from expiry.
+	SceneTree *tree;
+	double expiry;
+
+	Vector<Ref<Reference> > resume_states;
+
 protected:
 	static void _bind_methods();
 
@@ -61,6 +71,9 @@ public:
 	void set_pause_mode_process(bool p_pause_mode_process);
 	bool is_pause_mode_process();
 
+	// Script coroutines yielding on "timeout" are resumed directly instead of through a connection.
+	void add_resume_state(const Ref<Reference> &p_state);
+
 	void release_connections();
 
 	SceneTreeTimer();
@@ -180,7 +193,27 @@ private:
 	void _change_scene(Node *p_to);
 	//void _call_group(uint32_t p_call_flags,const StringName& p_group,const StringName& p_function,const Variant& p_arg1,const Variant& p_arg2);
 
-	List<Ref<SceneTreeTimer> > timers;
+	enum {
+		TIMER_WHEEL_SLOTS = 256,
+		TIMER_WHEEL_TICKS_PER_SEC = 60,
+	};
+
+	// Pending timers bucketed by the tick they expire on, so each frame only looks at the
+	// slots of the ticks that passed. Timers that process while paused use their own wheel.
+	struct TimerWheel {
+		Vector<Ref<SceneTreeTimer> > slots[TIMER_WHEEL_SLOTS];
+		double clock;
+		int64_t tick;
+		int count;
+	};
+
+	TimerWheel timer_wheels[2];
+
+	_FORCE_INLINE_ TimerWheel &_get_timer_wheel(const SceneTreeTimer *p_timer) { return timer_wheels[p_timer->process_pause ? 1 : 0]; }
+	void _schedule_timer(SceneTreeTimer *p_timer, float p_time_left);
+	void _unschedule_timer(SceneTreeTimer *p_timer);
+	void _process_timers(TimerWheel &p_wheel, float p_time, Vector<Ref<SceneTreeTimer> > &r_timeouts);
+	friend class SceneTreeTimer;
 
 	///network///
 
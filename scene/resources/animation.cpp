@@ -230,7 +230,7 @@ bool Animation::_set(const StringName &p_name, const Variant &p_value) {
 					int valcount = times.size();
 
 					PoolVector<float>::Read rt = times.read();
-					PoolVector<float>::Read rv = values.read();
+					PoolRealArray::Read rv = values.read();
 
 					bt->values.resize(valcount);
 
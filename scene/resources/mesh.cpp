@@ -30,6 +30,8 @@
 
 #include "mesh.h"
 
+#include "core/math/math_kernels.h"
+#include "core/math/mesh_simplifier.h"
 #include "core/pair.h"
 #include "scene/resources/concave_polygon_shape.h"
 #include "scene/resources/convex_polygon_shape.h"
@@ -695,6 +697,15 @@ bool ArrayMesh::_set(const StringName &p_name, const Variant &p_value) {
 			ERR_FAIL_V(false);
 		}
 
+		if (d.has("lod_data")) {
+			Array lod_data = d["lod_data"];
+			Vector<PoolVector<uint8_t> > lods;
+			for (int i = 0; i < lod_data.size(); i++) {
+				lods.push_back(lod_data[i]);
+			}
+			VS::get_singleton()->mesh_surface_set_lods(mesh, idx, lods);
+		}
+
 		if (d.has("material")) {
 
 			surface_set_material(idx, d["material"]);
@@ -772,6 +783,15 @@ bool ArrayMesh::_get(const StringName &p_name, Variant &r_ret) const {
 
 	d["blend_shape_data"] = md;
 
+	Vector<PoolVector<uint8_t> > lods = VS::get_singleton()->mesh_surface_get_lods(mesh, idx);
+	if (lods.size()) {
+		Array lod_data;
+		for (int i = 0; i < lods.size(); i++) {
+			lod_data.push_back(lods[i]);
+		}
+		d["lod_data"] = lod_data;
+	}
+
 	Ref<Material> m = surface_get_material(idx);
 	if (m.is_valid())
 		d["material"] = m;
@@ -849,16 +869,7 @@ void ArrayMesh::add_surface_from_arrays(PrimitiveType p_primitive, const Array &
 		const Vector3 *vtx = r.ptr();
 
 		// check AABB
-		AABB aabb;
-		for (int i = 0; i < len; i++) {
-
-			if (i == 0)
-				aabb.position = vtx[i];
-			else
-				aabb.expand_to(vtx[i]);
-		}
-
-		s.aabb = aabb;
+		s.aabb = MathKernels::compute_aabb(vtx, len);
 		s.is_2d = arr.get_type() == Variant::POOL_VECTOR2_ARRAY;
 		surfaces.push_back(s);
 
@@ -1094,6 +1105,147 @@ void ArrayMesh::regen_normalmaps() {
 	}
 }
 
+void ArrayMesh::surface_set_lods(int p_idx, const Array &p_lods) {
+
+	ERR_FAIL_INDEX(p_idx, surfaces.size());
+
+	bool wide = surface_get_array_len(p_idx) >= (1 << 16);
+	int index_size = wide ? 4 : 2;
+
+	Vector<PoolVector<uint8_t> > lods;
+	for (int i = 0; i < p_lods.size(); i++) {
+
+		PoolVector<int> indices = p_lods[i];
+		ERR_FAIL_COND_MSG(indices.size() % 3 != 0, "LOD index arrays must hold whole triangles.");
+
+		PoolVector<uint8_t> data;
+		data.resize(indices.size() * index_size);
+		{
+			PoolVector<int>::Read r = indices.read();
+			PoolVector<uint8_t>::Write w = data.write();
+			for (int j = 0; j < indices.size(); j++) {
+				if (wide) {
+					((uint32_t *)w.ptr())[j] = r[j];
+				} else {
+					((uint16_t *)w.ptr())[j] = r[j];
+				}
+			}
+		}
+		lods.push_back(data);
+	}
+
+	VisualServer::get_singleton()->mesh_surface_set_lods(mesh, p_idx, lods);
+}
+
+Array ArrayMesh::surface_get_lods(int p_idx) const {
+
+	ERR_FAIL_INDEX_V(p_idx, surfaces.size(), Array());
+
+	bool wide = surface_get_array_len(p_idx) >= (1 << 16);
+	int index_size = wide ? 4 : 2;
+
+	Vector<PoolVector<uint8_t> > lods = VisualServer::get_singleton()->mesh_surface_get_lods(mesh, p_idx);
+
+	Array ret;
+	for (int i = 0; i < lods.size(); i++) {
+
+		PoolVector<int> indices;
+		indices.resize(lods[i].size() / index_size);
+		{
+			PoolVector<uint8_t>::Read r = lods[i].read();
+			PoolVector<int>::Write w = indices.write();
+			for (int j = 0; j < indices.size(); j++) {
+				w[j] = wide ? ((const uint32_t *)r.ptr())[j] : ((const uint16_t *)r.ptr())[j];
+			}
+		}
+		ret.push_back(indices);
+	}
+
+	return ret;
+}
+
+void ArrayMesh::set_lod_errors(const PoolVector<float> &p_errors) {
+
+	Vector<float> errors;
+	errors.resize(p_errors.size());
+	for (int i = 0; i < p_errors.size(); i++) {
+		errors.write[i] = p_errors[i];
+	}
+	VisualServer::get_singleton()->mesh_set_lod_errors(mesh, errors);
+}
+
+PoolVector<float> ArrayMesh::get_lod_errors() const {
+
+	Vector<float> errors = VisualServer::get_singleton()->mesh_get_lod_errors(mesh);
+
+	PoolVector<float> ret;
+	ret.resize(errors.size());
+	{
+		PoolVector<float>::Write w = ret.write();
+		for (int i = 0; i < errors.size(); i++) {
+			w[i] = errors[i];
+		}
+	}
+	return ret;
+}
+
+Error ArrayMesh::generate_lods(int p_lod_count, float p_reduction, float p_max_error) {
+
+	ERR_FAIL_COND_V(p_lod_count < 1, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(p_reduction <= 0 || p_reduction >= 1, ERR_INVALID_PARAMETER);
+
+	// Degenerate meshes are common in imported scenes, they just get no levels.
+	real_t mesh_size = aabb.size.length();
+	bool degenerate = mesh_size <= CMP_EPSILON;
+
+	// Errors are stored relative to the size of the whole mesh, per level, taking
+	// the worst surface so a level is only used where all of them look right.
+	PoolVector<float> errors;
+	errors.resize(p_lod_count);
+	for (int i = 0; i < p_lod_count; i++) {
+		errors.set(i, 0);
+	}
+	int level_count = 0;
+
+	for (int i = 0; i < surfaces.size(); i++) {
+
+		Array lods;
+
+		if (!degenerate && surface_get_primitive_type(i) == PRIMITIVE_TRIANGLES && (surface_get_format(i) & ARRAY_FORMAT_INDEX)) {
+
+			Array arrays = surface_get_arrays(i);
+			PoolVector<Vector3> vertices = arrays[ARRAY_VERTEX];
+			PoolVector<int> indices = arrays[ARRAY_INDEX];
+			real_t surface_size = surfaces[i].aabb.size.length();
+
+			for (int l = 0; l < p_lod_count; l++) {
+
+				int target = int(indices.size() * p_reduction) / 3 * 3;
+				float error = 0;
+				PoolVector<int> simplified = MeshSimplifier::simplify(vertices, indices, target, p_max_error, &error);
+
+				if (simplified.size() == 0 || simplified.size() > indices.size() * 0.9)
+					break; // not worth another level
+
+				errors.set(l, MAX(errors[l], error * surface_size / mesh_size));
+				lods.push_back(simplified);
+				indices = simplified;
+			}
+		}
+
+		surface_set_lods(i, lods);
+		level_count = MAX(level_count, lods.size());
+	}
+
+	errors.resize(level_count);
+	for (int i = 1; i < level_count; i++) {
+		errors.set(i, MAX(errors[i], errors[i - 1]));
+	}
+	set_lod_errors(errors);
+
+	return OK;
+}
+
 //dirty hack
 bool (*array_mesh_lightmap_unwrap_callback)(float p_texel_size, const float *p_vertices, const float *p_normals, int p_vertex_count, const int *p_indices, const int *p_face_materials, int p_index_count, float **r_uv, int **r_vertex, int *r_vertex_count, int **r_index, int *r_index_count, int *r_size_hint_x, int *r_size_hint_y) = NULL;
 
@@ -1308,6 +1460,12 @@ void ArrayMesh::_bind_methods() {
 	ClassDB::set_method_flags(get_class_static(), _scs_create("regen_normalmaps"), METHOD_FLAGS_DEFAULT | METHOD_FLAG_EDITOR);
 	ClassDB::bind_method(D_METHOD("lightmap_unwrap", "transform", "texel_size"), &ArrayMesh::lightmap_unwrap);
 	ClassDB::set_method_flags(get_class_static(), _scs_create("lightmap_unwrap"), METHOD_FLAGS_DEFAULT | METHOD_FLAG_EDITOR);
+	ClassDB::bind_method(D_METHOD("surface_set_lods", "surf_idx", "lods"), &ArrayMesh::surface_set_lods);
+	ClassDB::bind_method(D_METHOD("surface_get_lods", "surf_idx"), &ArrayMesh::surface_get_lods);
+	ClassDB::bind_method(D_METHOD("set_lod_errors", "errors"), &ArrayMesh::set_lod_errors);
+	ClassDB::bind_method(D_METHOD("get_lod_errors"), &ArrayMesh::get_lod_errors);
+	ClassDB::bind_method(D_METHOD("generate_lods", "lod_count", "reduction", "max_error"), &ArrayMesh::generate_lods, DEFVAL(3), DEFVAL(0.5), DEFVAL(0.05));
+	ClassDB::set_method_flags(get_class_static(), _scs_create("generate_lods"), METHOD_FLAGS_DEFAULT | METHOD_FLAG_EDITOR);
 	ClassDB::bind_method(D_METHOD("get_faces"), &ArrayMesh::get_faces);
 	ClassDB::bind_method(D_METHOD("generate_triangle_mesh"), &ArrayMesh::generate_triangle_mesh);
 
@@ -1316,6 +1474,7 @@ void ArrayMesh::_bind_methods() {
 
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "blend_shape_mode", PROPERTY_HINT_ENUM, "Normalized,Relative", PROPERTY_USAGE_NOEDITOR), "set_blend_shape_mode", "get_blend_shape_mode");
 	ADD_PROPERTY(PropertyInfo(Variant::AABB, "custom_aabb", PROPERTY_HINT_NONE, ""), "set_custom_aabb", "get_custom_aabb");
+	ADD_PROPERTY(PropertyInfo(Variant::POOL_REAL_ARRAY, "lod_errors"), "set_lod_errors", "get_lod_errors");
 
 	BIND_CONSTANT(NO_INDEX_ARRAY);
 	BIND_CONSTANT(ARRAY_WEIGHTS_SIZE);
@@ -1346,6 +1505,7 @@ void ArrayMesh::reload_from_file() {
 	VisualServer::get_singleton()->mesh_clear(mesh);
 	surfaces.clear();
 	clear_blend_shapes();
+	set_lod_errors(PoolVector<float>());
 	clear_cache();
 
 	Resource::reload_from_file();
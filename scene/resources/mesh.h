@@ -232,6 +232,14 @@ public:
 
 	Error lightmap_unwrap(const Transform &p_base_transform = Transform(), float p_texel_size = 0.05);
 
+	void surface_set_lods(int p_idx, const Array &p_lods);
+	Array surface_get_lods(int p_idx) const;
+
+	void set_lod_errors(const PoolVector<float> &p_errors);
+	PoolVector<float> get_lod_errors() const;
+
+	Error generate_lods(int p_lod_count = 3, float p_reduction = 0.5, float p_max_error = 0.05);
+
 	virtual void reload_from_file();
 
 	ArrayMesh();
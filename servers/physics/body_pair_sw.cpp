@@ -32,6 +32,7 @@
 
 #include "collision_solver_sw.h"
 #include "core/os/os.h"
+#include "gjk_epa.h"
 #include "space_sw.h"
 
 /*
@@ -48,6 +49,7 @@
 #define RELAXATION_TIMESTEPS 3
 #define MIN_VELOCITY 0.0001
 #define MAX_BIAS_ROTATION (Math_PI / 8)
+#define CCD_MAX_ITERATIONS 16
 
 void BodyPairSW::_contact_added_callback(const Vector3 &p_point_A, const Vector3 &p_point_B, void *p_userdata) {
 
@@ -169,7 +171,7 @@ void BodyPairSW::validate_contacts() {
 	}
 }
 
-bool BodyPairSW::_test_ccd(real_t p_step, BodySW *p_A, int p_shape_A, const Transform &p_xform_A, BodySW *p_B, int p_shape_B, const Transform &p_xform_B) {
+bool BodyPairSW::_test_ccd_ray(real_t p_step, BodySW *p_A, int p_shape_A, const Transform &p_xform_A, BodySW *p_B, int p_shape_B, const Transform &p_xform_B) {
 
 	Vector3 motion = p_A->get_linear_velocity() * p_step;
 	real_t mlen = motion.length();
@@ -211,6 +213,163 @@ bool BodyPairSW::_test_ccd(real_t p_step, BodySW *p_A, int p_shape_A, const Tran
 	return true;
 }
 
+struct _CCDSweepSW {
+
+	const ShapeSW *shape_A;
+	Transform xform_A;
+	Vector3 motion;
+	Vector3 pivot; // center of mass, rotations happen around it
+	Vector3 rotation_axis;
+	real_t rotation; // angle rotated over the whole step
+	real_t radius; // farthest point of shape A from the pivot
+	real_t tolerance;
+
+	Transform xform_B;
+	real_t toi;
+	bool hit;
+
+	_FORCE_INLINE_ Transform get_xform_A(real_t p_t) const {
+
+		Transform xform = xform_A;
+		if (rotation > 0) {
+			Basis rot(rotation_axis, rotation * p_t);
+			xform.basis = rot * xform.basis;
+			xform.origin = pivot + rot.xform(xform.origin - pivot);
+		}
+		xform.origin += motion * p_t;
+		return xform;
+	}
+
+	_FORCE_INLINE_ Vector3 get_point_velocity(const Vector3 &p_point, real_t p_t) const {
+
+		return motion + (rotation_axis * rotation).cross(p_point - (pivot + motion * p_t));
+	}
+};
+
+// Conservative advancement: step the sweep forward by the current distance divided by an
+// upper bound of the closing speed, so it can never step past the first time of impact.
+static bool _ccd_advance(const _CCDSweepSW &p_sweep, const ShapeSW *p_shape_B, real_t &r_toi) {
+
+	real_t t = 0;
+
+	for (int i = 0; i < CCD_MAX_ITERATIONS; i++) {
+
+		Vector3 point_A, point_B;
+		if (!gjk_epa_calculate_distance(p_sweep.shape_A, p_sweep.get_xform_A(t), p_shape_B, p_sweep.xform_B, point_A, point_B)) {
+			if (t == 0) {
+				return false; // already overlapping, regular contacts handle it
+			}
+			break;
+		}
+
+		Vector3 dir = point_B - point_A;
+		real_t dist = dir.length();
+		if (dist < p_sweep.tolerance) {
+			// Touching, only a hit if the shapes are still approaching, so resting,
+			// sliding and separating bodies keep their velocity.
+			if (dist > CMP_EPSILON) {
+				if (p_sweep.get_point_velocity(point_A, t).dot(dir / dist) <= CMP_EPSILON) {
+					return false;
+				}
+			} else if (t == 0) {
+				return false;
+			}
+			break;
+		}
+
+		real_t closing = p_sweep.motion.dot(dir / dist) + p_sweep.rotation * p_sweep.radius;
+		if (closing <= CMP_EPSILON) {
+			return false; // moving apart
+		}
+
+		t += dist / closing;
+		if (t >= 1.0) {
+			return false;
+		}
+	}
+
+	r_toi = t;
+	return true;
+}
+
+static void _ccd_cull_callback(void *p_userdata, ShapeSW *p_convex) {
+
+	_CCDSweepSW &sweep = *(_CCDSweepSW *)p_userdata;
+
+	real_t toi;
+	if (_ccd_advance(sweep, p_convex, toi) && toi < sweep.toi) {
+		sweep.toi = toi;
+		sweep.hit = true;
+	}
+}
+
+bool BodyPairSW::_test_ccd(real_t p_step, BodySW *p_A, int p_shape_A, const Transform &p_xform_A, const Vector3 &p_offset_A, BodySW *p_B, int p_shape_B, const Transform &p_xform_B) {
+
+	const ShapeSW *shape_A_ptr = p_A->get_shape(p_shape_A);
+	const ShapeSW *shape_B_ptr = p_B->get_shape(p_shape_B);
+
+	if (shape_A_ptr->is_concave() || shape_A_ptr->get_type() == PhysicsServer::SHAPE_RAY) {
+		return false;
+	}
+
+	if (shape_B_ptr->get_type() == PhysicsServer::SHAPE_PLANE || shape_B_ptr->get_type() == PhysicsServer::SHAPE_RAY) {
+		// not usable with distance queries
+		return _test_ccd_ray(p_step, p_A, p_shape_A, p_xform_A, p_B, p_shape_B, p_xform_B);
+	}
+
+	_CCDSweepSW sweep;
+	sweep.shape_A = shape_A_ptr;
+	sweep.xform_A = p_xform_A;
+	sweep.xform_B = p_xform_B;
+	sweep.motion = p_A->get_linear_velocity() * p_step;
+	sweep.pivot = p_A->get_center_of_mass() + p_offset_A; // transforms are relative to the pair's origin
+
+	Vector3 angular_velocity = p_A->get_angular_velocity();
+	real_t angular_speed = angular_velocity.length();
+	sweep.rotation = angular_speed * p_step;
+	sweep.rotation_axis = angular_speed > CMP_EPSILON ? angular_velocity / angular_speed : Vector3(0, 1, 0);
+
+	AABB aabb = p_xform_A.xform(shape_A_ptr->get_aabb());
+	sweep.radius = 0;
+	for (int i = 0; i < 8; i++) {
+		sweep.radius = MAX(sweep.radius, aabb.get_endpoint(i).distance_to(sweep.pivot));
+	}
+
+	// Only bodies that sweep a good part of their own size in a step pay for the sweep.
+	real_t sweep_length = sweep.motion.length() + MIN(sweep.rotation, (real_t)2.0) * sweep.radius;
+	if (sweep_length < aabb.get_shortest_axis_size() * 0.3) {
+		return false;
+	}
+
+	sweep.tolerance = MAX(space->get_contact_max_allowed_penetration(), (real_t)CMP_EPSILON);
+	sweep.toi = 1.0;
+	sweep.hit = false;
+
+	if (shape_B_ptr->is_concave()) {
+
+		AABB swept_aabb = aabb;
+		swept_aabb.merge_with(AABB(aabb.position + sweep.motion, aabb.size));
+		swept_aabb.grow_by(MIN(sweep.rotation, (real_t)2.0) * sweep.radius);
+
+		const ConcaveShapeSW *concave = static_cast<const ConcaveShapeSW *>(shape_B_ptr);
+		concave->cull(p_xform_B.affine_inverse().xform(swept_aabb), _ccd_cull_callback, &sweep);
+
+	} else {
+
+		sweep.hit = _ccd_advance(sweep, shape_B_ptr, sweep.toi);
+	}
+
+	if (!sweep.hit) {
+		return false;
+	}
+
+	// Only move up to the time of impact this step, next step will collide softly.
+	p_A->set_linear_velocity(p_A->get_linear_velocity() * sweep.toi);
+	p_A->set_angular_velocity(angular_velocity * sweep.toi);
+
+	return true;
+}
+
 real_t combine_bounce(BodySW *A, BodySW *B) {
 	return CLAMP(A->get_bounce() + B->get_bounce(), 0, 1);
 }
@@ -219,23 +378,48 @@ real_t combine_friction(BodySW *A, BodySW *B) {
 	return ABS(MIN(A->get_friction(), B->get_friction()));
 }
 
-bool BodyPairSW::setup(real_t p_step) {
+bool BodyPairSW::_can_collide() const {
 
-	//cannot collide
 	if (!A->test_collision_mask(B) || A->has_exception(B->get_self()) || B->has_exception(A->get_self()) || (A->get_mode() <= PhysicsServer::BODY_MODE_KINEMATIC && B->get_mode() <= PhysicsServer::BODY_MODE_KINEMATIC && A->get_max_contacts_reported() == 0 && B->get_max_contacts_reported() == 0)) {
-		collided = false;
 		return false;
 	}
 
 	if (A->is_shape_set_as_disabled(shape_A) || B->is_shape_set_as_disabled(shape_B)) {
-		collided = false;
 		return false;
 	}
 
+	return true;
+}
+
+void BodyPairSW::collide(real_t p_step) {
+
+	if (!_can_collide()) {
+		collided = false;
+		return;
+	}
+
 	offset_B = B->get_transform().get_origin() - A->get_transform().get_origin();
 
 	validate_contacts();
 
+	Transform xform_Au = Transform(A->get_transform().basis, Vector3());
+	Transform xform_A = xform_Au * A->get_shape_transform(shape_A);
+
+	Transform xform_Bu = B->get_transform();
+	xform_Bu.origin -= A->get_transform().get_origin();
+	Transform xform_B = xform_Bu * B->get_shape_transform(shape_B);
+
+	collided = CollisionSolverSW::solve_static(A->get_shape(shape_A), xform_A, B->get_shape(shape_B), xform_B, _contact_added_callback, this, &sep_axis);
+}
+
+bool BodyPairSW::setup(real_t p_step) {
+
+	//cannot collide
+	if (!_can_collide()) {
+		collided = false;
+		return false;
+	}
+
 	Vector3 offset_A = A->get_transform().get_origin();
 	Transform xform_Au = Transform(A->get_transform().basis, Vector3());
 	Transform xform_A = xform_Au * A->get_shape_transform(shape_A);
@@ -247,19 +431,23 @@ bool BodyPairSW::setup(real_t p_step) {
 	ShapeSW *shape_A_ptr = A->get_shape(shape_A);
 	ShapeSW *shape_B_ptr = B->get_shape(shape_B);
 
-	bool collided = CollisionSolverSW::solve_static(shape_A_ptr, xform_A, shape_B_ptr, xform_B, _contact_added_callback, this, &sep_axis);
-	this->collided = collided;
-
-	if (!collided) {
+	if (collided) {
+		// new contacts against a sleeping island wake it up
+		if (A->is_active() && !B->is_active()) {
+			B->wakeup();
+		} else if (B->is_active() && !A->is_active()) {
+			A->wakeup();
+		}
+	} else {
 
-		//test ccd (currently just a raycast)
+		//test ccd
 
 		if (A->is_continuous_collision_detection_enabled() && A->get_mode() > PhysicsServer::BODY_MODE_KINEMATIC && B->get_mode() <= PhysicsServer::BODY_MODE_KINEMATIC) {
-			_test_ccd(p_step, A, shape_A, xform_A, B, shape_B, xform_B);
+			_test_ccd(p_step, A, shape_A, xform_A, Vector3(), B, shape_B, xform_B);
 		}
 
 		if (B->is_continuous_collision_detection_enabled() && B->get_mode() > PhysicsServer::BODY_MODE_KINEMATIC && A->get_mode() <= PhysicsServer::BODY_MODE_KINEMATIC) {
-			_test_ccd(p_step, B, shape_B, xform_B, A, shape_A, xform_A);
+			_test_ccd(p_step, B, shape_B, xform_B, xform_Bu.origin, A, shape_A, xform_A);
 		}
 
 		return false;
@@ -281,6 +469,8 @@ bool BodyPairSW::setup(real_t p_step) {
 
 	real_t inv_dt = 1.0 / p_step;
 
+	friction = combine_friction(A, B);
+
 	for (int i = 0; i < contact_count; i++) {
 
 		Contact &c = contacts[i];
@@ -324,10 +514,10 @@ bool BodyPairSW::setup(real_t p_step) {
 		c.active = true;
 
 		// Precompute normal mass, tangent mass, and bias.
-		Vector3 inertia_A = A->get_inv_inertia_tensor().xform(c.rA.cross(c.normal));
-		Vector3 inertia_B = B->get_inv_inertia_tensor().xform(c.rB.cross(c.normal));
+		c.normal_inertia_A = A->get_inv_inertia_tensor().xform(c.rA.cross(c.normal));
+		c.normal_inertia_B = B->get_inv_inertia_tensor().xform(c.rB.cross(c.normal));
 		real_t kNormal = A->get_inv_mass() + B->get_inv_mass();
-		kNormal += c.normal.dot(inertia_A.cross(c.rA)) + c.normal.dot(inertia_B.cross(c.rB));
+		kNormal += c.normal.dot(c.normal_inertia_A.cross(c.rA)) + c.normal.dot(c.normal_inertia_B.cross(c.rB));
 		c.mass_normal = 1.0f / kNormal;
 
 		c.bias = -bias * inv_dt * MIN(0.0f, -depth + max_penetration);
@@ -353,11 +543,40 @@ bool BodyPairSW::setup(real_t p_step) {
 	return true;
 }
 
+static _FORCE_INLINE_ Vector3 _limit_bias_rotation(const Vector3 &p_delta_av, real_t p_max_delta_av) {
+
+	real_t len = p_delta_av.length();
+	if (len > p_max_delta_av) {
+		return p_delta_av * (p_max_delta_av / len);
+	}
+	return p_delta_av;
+}
+
 void BodyPairSW::solve(real_t p_step) {
 
 	if (!collided)
 		return;
 
+	// Work on local copies of the body state and write it back once at the end,
+	// so the contact loop does not go through the bodies on every impulse.
+
+	Vector3 lv_A = A->get_linear_velocity();
+	Vector3 av_A = A->get_angular_velocity();
+	Vector3 blv_A = A->get_biased_linear_velocity();
+	Vector3 bav_A = A->get_biased_angular_velocity();
+	const Basis &inv_inertia_A = A->get_inv_inertia_tensor();
+	real_t inv_mass_A = A->get_inv_mass();
+
+	Vector3 lv_B = B->get_linear_velocity();
+	Vector3 av_B = B->get_angular_velocity();
+	Vector3 blv_B = B->get_biased_linear_velocity();
+	Vector3 bav_B = B->get_biased_angular_velocity();
+	const Basis &inv_inertia_B = B->get_inv_inertia_tensor();
+	real_t inv_mass_B = B->get_inv_mass();
+
+	real_t inv_mass_sum = inv_mass_A + inv_mass_B;
+	real_t max_bias_rotation = MAX_BIAS_ROTATION / p_step;
+
 	for (int i = 0; i < contact_count; i++) {
 
 		Contact &c = contacts[i];
@@ -368,9 +587,7 @@ void BodyPairSW::solve(real_t p_step) {
 
 		//bias impulse
 
-		Vector3 crbA = A->get_biased_angular_velocity().cross(c.rA);
-		Vector3 crbB = B->get_biased_angular_velocity().cross(c.rB);
-		Vector3 dbv = B->get_biased_linear_velocity() + crbB - A->get_biased_linear_velocity() - crbA;
+		Vector3 dbv = blv_B + bav_B.cross(c.rB) - blv_A - bav_A.cross(c.rA);
 
 		real_t vbn = dbv.dot(c.normal);
 
@@ -380,35 +597,34 @@ void BodyPairSW::solve(real_t p_step) {
 			real_t jbnOld = c.acc_bias_impulse;
 			c.acc_bias_impulse = MAX(jbnOld + jbn, 0.0f);
 
-			Vector3 jb = c.normal * (c.acc_bias_impulse - jbnOld);
+			real_t jbn_delta = c.acc_bias_impulse - jbnOld;
+			Vector3 jb = c.normal * jbn_delta;
 
-			A->apply_bias_impulse(c.rA + A->get_center_of_mass(), -jb, MAX_BIAS_ROTATION / p_step);
-			B->apply_bias_impulse(c.rB + B->get_center_of_mass(), jb, MAX_BIAS_ROTATION / p_step);
+			blv_A -= jb * inv_mass_A;
+			bav_A += _limit_bias_rotation(c.normal_inertia_A * -jbn_delta, max_bias_rotation);
+			blv_B += jb * inv_mass_B;
+			bav_B += _limit_bias_rotation(c.normal_inertia_B * jbn_delta, max_bias_rotation);
 
-			crbA = A->get_biased_angular_velocity().cross(c.rA);
-			crbB = B->get_biased_angular_velocity().cross(c.rB);
-			dbv = B->get_biased_linear_velocity() + crbB - A->get_biased_linear_velocity() - crbA;
+			dbv = blv_B + bav_B.cross(c.rB) - blv_A - bav_A.cross(c.rA);
 
 			vbn = dbv.dot(c.normal);
 
 			if (Math::abs(-vbn + c.bias) > MIN_VELOCITY) {
 
-				real_t jbn_com = (-vbn + c.bias) / (A->get_inv_mass() + B->get_inv_mass());
+				real_t jbn_com = (-vbn + c.bias) / inv_mass_sum;
 				real_t jbnOld_com = c.acc_bias_impulse_center_of_mass;
 				c.acc_bias_impulse_center_of_mass = MAX(jbnOld_com + jbn_com, 0.0f);
 
 				Vector3 jb_com = c.normal * (c.acc_bias_impulse_center_of_mass - jbnOld_com);
 
-				A->apply_bias_impulse(A->get_center_of_mass(), -jb_com, 0.0f);
-				B->apply_bias_impulse(B->get_center_of_mass(), jb_com, 0.0f);
+				blv_A -= jb_com * inv_mass_A;
+				blv_B += jb_com * inv_mass_B;
 			}
 
 			c.active = true;
 		}
 
-		Vector3 crA = A->get_angular_velocity().cross(c.rA);
-		Vector3 crB = B->get_angular_velocity().cross(c.rB);
-		Vector3 dv = B->get_linear_velocity() + crB - A->get_linear_velocity() - crA;
+		Vector3 dv = lv_B + av_B.cross(c.rB) - lv_A - av_A.cross(c.rA);
 
 		//normal impulse
 		real_t vn = dv.dot(c.normal);
@@ -419,22 +635,20 @@ void BodyPairSW::solve(real_t p_step) {
 			real_t jnOld = c.acc_normal_impulse;
 			c.acc_normal_impulse = MAX(jnOld + jn, 0.0f);
 
-			Vector3 j = c.normal * (c.acc_normal_impulse - jnOld);
+			real_t jn_delta = c.acc_normal_impulse - jnOld;
+			Vector3 j = c.normal * jn_delta;
 
-			A->apply_impulse(c.rA + A->get_center_of_mass(), -j);
-			B->apply_impulse(c.rB + B->get_center_of_mass(), j);
+			lv_A -= j * inv_mass_A;
+			av_A -= c.normal_inertia_A * jn_delta;
+			lv_B += j * inv_mass_B;
+			av_B += c.normal_inertia_B * jn_delta;
 
 			c.active = true;
 		}
 
 		//friction impulse
 
-		real_t friction = combine_friction(A, B);
-
-		Vector3 lvA = A->get_linear_velocity() + A->get_angular_velocity().cross(c.rA);
-		Vector3 lvB = B->get_linear_velocity() + B->get_angular_velocity().cross(c.rB);
-
-		Vector3 dtv = lvB - lvA;
+		Vector3 dtv = lv_B + av_B.cross(c.rB) - lv_A - av_A.cross(c.rA);
 		real_t tn = c.normal.dot(dtv);
 
 		// tangential velocity
@@ -445,11 +659,11 @@ void BodyPairSW::solve(real_t p_step) {
 
 			tv /= tvl;
 
-			Vector3 temp1 = A->get_inv_inertia_tensor().xform(c.rA.cross(tv));
-			Vector3 temp2 = B->get_inv_inertia_tensor().xform(c.rB.cross(tv));
+			Vector3 temp1 = inv_inertia_A.xform(c.rA.cross(tv));
+			Vector3 temp2 = inv_inertia_B.xform(c.rB.cross(tv));
 
 			real_t t = -tvl /
-					   (A->get_inv_mass() + B->get_inv_mass() + tv.dot(temp1.cross(c.rA) + temp2.cross(c.rB)));
+					   (inv_mass_sum + tv.dot(temp1.cross(c.rA) + temp2.cross(c.rB)));
 
 			Vector3 jt = t * tv;
 
@@ -466,12 +680,24 @@ void BodyPairSW::solve(real_t p_step) {
 
 			jt = c.acc_tangent_impulse - jtOld;
 
-			A->apply_impulse(c.rA + A->get_center_of_mass(), -jt);
-			B->apply_impulse(c.rB + B->get_center_of_mass(), jt);
+			lv_A -= jt * inv_mass_A;
+			av_A -= inv_inertia_A.xform(c.rA.cross(jt));
+			lv_B += jt * inv_mass_B;
+			av_B += inv_inertia_B.xform(c.rB.cross(jt));
 
 			c.active = true;
 		}
 	}
+
+	A->set_linear_velocity(lv_A);
+	A->set_angular_velocity(av_A);
+	A->set_biased_linear_velocity(blv_A);
+	A->set_biased_angular_velocity(bav_A);
+
+	B->set_linear_velocity(lv_B);
+	B->set_angular_velocity(av_B);
+	B->set_biased_linear_velocity(blv_B);
+	B->set_biased_angular_velocity(bav_B);
 }
 
 BodyPairSW::BodyPairSW(BodySW *p_A, int p_shape_A, BodySW *p_B, int p_shape_B) :
@@ -486,6 +712,7 @@ BodyPairSW::BodyPairSW(BodySW *p_A, int p_shape_A, BodySW *p_B, int p_shape_B) :
 	B->add_constraint(this, 1);
 	contact_count = 0;
 	collided = false;
+	friction = 0;
 }
 
 BodyPairSW::~BodyPairSW() {
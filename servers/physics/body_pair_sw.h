@@ -68,6 +68,7 @@ class BodyPairSW : public ConstraintSW {
 		real_t depth;
 		bool active;
 		Vector3 rA, rB; // Offset in world orientation with respect to center of mass
+		Vector3 normal_inertia_A, normal_inertia_B; // inverse inertia tensor * (r x normal), constant during solve
 	};
 
 	Vector3 offset_B; //use local A coordinates to avoid numerical issues on collision detection
@@ -76,17 +77,22 @@ class BodyPairSW : public ConstraintSW {
 	Contact contacts[MAX_CONTACTS];
 	int contact_count;
 	bool collided;
+	real_t friction;
 
 	static void _contact_added_callback(const Vector3 &p_point_A, const Vector3 &p_point_B, void *p_userdata);
 
 	void contact_added_callback(const Vector3 &p_point_A, const Vector3 &p_point_B);
 
 	void validate_contacts();
-	bool _test_ccd(real_t p_step, BodySW *p_A, int p_shape_A, const Transform &p_xform_A, BodySW *p_B, int p_shape_B, const Transform &p_xform_B);
+	bool _can_collide() const;
+	bool _test_ccd_ray(real_t p_step, BodySW *p_A, int p_shape_A, const Transform &p_xform_A, BodySW *p_B, int p_shape_B, const Transform &p_xform_B);
+	bool _test_ccd(real_t p_step, BodySW *p_A, int p_shape_A, const Transform &p_xform_A, const Vector3 &p_offset_A, BodySW *p_B, int p_shape_B, const Transform &p_xform_B);
 
 	SpaceSW *space;
 
 public:
+	void collide(real_t p_step);
+	virtual bool links_bodies() const { return collided; }
 	bool setup(real_t p_step);
 	void solve(real_t p_step);
 
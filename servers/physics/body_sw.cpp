@@ -138,6 +138,16 @@ void BodySW::update_inertias() {
 	_update_transform_dependant();
 }
 
+void BodySW::_update_sleeping_count() {
+
+	bool sleeping = get_space() && !active && mode >= PhysicsServer::BODY_MODE_RIGID;
+	if (sleeping == counted_as_sleeping)
+		return;
+
+	get_space()->add_sleeping_objects(sleeping ? 1 : -1);
+	counted_as_sleeping = sleeping;
+}
+
 void BodySW::set_active(bool p_active) {
 
 	if (active == p_active)
@@ -155,6 +165,8 @@ void BodySW::set_active(bool p_active) {
 
 		//still_time=0;
 	}
+
+	_update_sleeping_count();
 	/*
 	if (!space)
 		return;
@@ -273,6 +285,7 @@ void BodySW::set_mode(PhysicsServer::BodyMode p_mode) {
 	}
 
 	_update_inertia();
+	_update_sleeping_count();
 	/*
 	if (get_space())
 		_update_queries();
@@ -393,6 +406,10 @@ void BodySW::set_space(SpaceSW *p_space) {
 			get_space()->body_remove_from_active_list(&active_list);
 		if (direct_state_query_list.in_list())
 			get_space()->body_remove_from_state_query_list(&direct_state_query_list);
+		if (counted_as_sleeping) {
+			get_space()->add_sleeping_objects(-1);
+			counted_as_sleeping = false;
+		}
 	}
 
 	_set_space(p_space);
@@ -402,6 +419,7 @@ void BodySW::set_space(SpaceSW *p_space) {
 		_update_inertia();
 		if (active)
 			get_space()->body_add_to_active_list(&active_list);
+		_update_sleeping_count();
 		/*
 		_update_queries();
 		if (is_active()) {
@@ -771,6 +789,7 @@ BodySW::BodySW() :
 
 	mode = PhysicsServer::BODY_MODE_RIGID;
 	active = true;
+	counted_as_sleeping = false;
 
 	mass = 1;
 	kinematic_safe_margin = 0.01;
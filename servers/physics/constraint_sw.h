@@ -76,6 +76,11 @@ public:
 	_FORCE_INLINE_ void disable_collisions_between_bodies(const bool p_disabled) { disabled_collisions_between_bodies = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled_collisions_between_bodies() const { return disabled_collisions_between_bodies; }
 
+	// Narrow phase. Runs in parallel for all the constraints of a step before setup(),
+	// so it must not write to anything but the constraint itself.
+	virtual void collide(real_t p_step) {}
+	// If false, sleeping bodies are not pulled into the island (and woken up) through this constraint.
+	virtual bool links_bodies() const { return true; }
 	virtual bool setup(real_t p_step) = 0;
 	virtual void solve(real_t p_step) = 0;
 
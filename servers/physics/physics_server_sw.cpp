@@ -963,7 +963,49 @@ bool PhysicsServerSW::body_test_motion(RID p_body, const Transform &p_from, cons
 	return body->get_space()->test_body_motion(body, p_from, p_motion, p_infinite_inertia, body->get_kinematic_margin(), r_result, p_exclude_raycast_shapes);
 }
 
-int PhysicsServerSW::body_test_ray_separation(RID p_body, const Transform &p_transform, bool p_infinite_inertia, Vector3 &r_recover_motion, SeparationResult *r_results, int p_result_max, float p_margin) {
+int PhysicsServerSW::body_test_motion_batch(const MotionQuery *p_queries, int p_query_count, MotionResult *r_results, bool *r_collided) {
+
+	Vector<SpaceSW::BodyMotion> motions;
+	motions.resize(p_query_count);
+
+	// All the queries are checked first, so an invalid one doesn't leave partial results.
+	for (int i = 0; i < p_query_count; i++) {
+
+		BodySW *body = body_owner.get(p_queries[i].body);
+		ERR_FAIL_COND_V(!body, 0);
+		ERR_FAIL_COND_V(!body->get_space(), 0);
+		ERR_FAIL_COND_V(body->get_space()->is_locked(), 0);
+
+		SpaceSW::BodyMotion &m = motions.write[i];
+		m.body = body;
+		m.from = p_queries[i].from;
+		m.motion = p_queries[i].motion;
+		m.infinite_inertia = p_queries[i].infinite_inertia;
+		m.margin = body->get_kinematic_margin();
+		m.exclude_raycast_shapes = p_queries[i].exclude_raycast_shapes;
+	}
+
+	_update_shapes();
+
+	int collided_count = 0;
+	int begin = 0;
+
+	// Consecutive queries in the same space are tested together.
+	for (int i = 1; i <= p_query_count; i++) {
+
+		SpaceSW *space = motions[begin].body->get_space();
+		if (i < p_query_count && motions[i].body->get_space() == space) {
+			continue;
+		}
+
+		collided_count += space->test_body_motion_batch(&motions[begin], i - begin, &r_results[begin], &r_collided[begin]);
+		begin = i;
+	}
+
+	return collided_count;
+}
+
+int PhysicsServerSW::body_test_ray_separation(RID p_body, const Transform &p_transform, bool p_infinite_inertia, Vector3 &r_recover_motion, SeparationResult *r_results, int p_result_max, real_t p_margin) {
 
 	BodySW *body = body_owner.get(p_body);
 	ERR_FAIL_COND_V(!body, false);
@@ -1413,6 +1455,7 @@ void PhysicsServerSW::init() {
 	iterations = 8; // 8?
 	stepper = memnew(StepSW);
 	direct_state = memnew(PhysicsDirectBodyStateSW);
+	thread_pool.init();
 };
 
 void PhysicsServerSW::step(real_t p_step) {
@@ -1431,12 +1474,14 @@ void PhysicsServerSW::step(real_t p_step) {
 
 	island_count = 0;
 	active_objects = 0;
+	sleeping_objects = 0;
 	collision_pairs = 0;
 	for (Set<const SpaceSW *>::Element *E = active_spaces.front(); E; E = E->next()) {
 
 		stepper->step((SpaceSW *)E->get(), p_step, iterations);
 		island_count += E->get()->get_island_count();
 		active_objects += E->get()->get_active_objects();
+		sleeping_objects += E->get()->get_sleeping_objects();
 		collision_pairs += E->get()->get_collision_pairs();
 	}
 #endif
@@ -1473,6 +1518,7 @@ void PhysicsServerSW::flush_queries() {
 		static const char *time_name[SpaceSW::ELAPSED_TIME_MAX] = {
 			"integrate_forces",
 			"generate_islands",
+			"narrow_phase",
 			"setup_constraints",
 			"solve_constraints",
 			"integrate_velocities"
@@ -1505,6 +1551,7 @@ void PhysicsServerSW::flush_queries() {
 
 void PhysicsServerSW::finish() {
 
+	thread_pool.finish();
 	memdelete(stepper);
 	memdelete(direct_state);
 };
@@ -1524,6 +1571,10 @@ int PhysicsServerSW::get_process_info(ProcessInfo p_info) {
 
 			return island_count;
 		} break;
+		case INFO_SLEEPING_OBJECTS: {
+
+			return sleeping_objects;
+		} break;
 	}
 
 	return 0;
@@ -1577,6 +1628,7 @@ PhysicsServerSW::PhysicsServerSW() {
 	BroadPhaseSW::create_func = BroadPhaseOctree::_create;
 	island_count = 0;
 	active_objects = 0;
+	sleeping_objects = 0;
 	collision_pairs = 0;
 
 	active = true;
@@ -31,6 +31,7 @@
 #ifndef PHYSICS_SERVER_SW
 #define PHYSICS_SERVER_SW
 
+#include "core/os/thread_work_pool.h"
 #include "joints_sw.h"
 #include "servers/physics_server.h"
 #include "shape_sw.h"
@@ -42,6 +43,8 @@ class PhysicsServerSW : public PhysicsServer {
 	GDCLASS(PhysicsServerSW, PhysicsServer);
 
 	friend class PhysicsDirectSpaceStateSW;
+	friend class StepSW;
+	friend class SpaceSW;
 	bool active;
 	int iterations;
 	bool doing_sync;
@@ -49,6 +52,7 @@ class PhysicsServerSW : public PhysicsServer {
 
 	int island_count;
 	int active_objects;
+	int sleeping_objects;
 	int collision_pairs;
 
 	bool flushing_queries;
@@ -58,6 +62,8 @@ class PhysicsServerSW : public PhysicsServer {
 
 	PhysicsDirectBodyStateSW *direct_state;
 
+	ThreadWorkPool thread_pool;
+
 	mutable RID_Owner<ShapeSW> shape_owner;
 	mutable RID_Owner<SpaceSW> space_owner;
 	mutable RID_Owner<AreaSW> area_owner;
@@ -237,7 +243,8 @@ public:
 	virtual bool body_is_ray_pickable(RID p_body) const;
 
 	virtual bool body_test_motion(RID p_body, const Transform &p_from, const Vector3 &p_motion, bool p_infinite_inertia, MotionResult *r_result = NULL, bool p_exclude_raycast_shapes = true);
-	virtual int body_test_ray_separation(RID p_body, const Transform &p_transform, bool p_infinite_inertia, Vector3 &r_recover_motion, SeparationResult *r_results, int p_result_max, float p_margin = 0.001);
+	virtual int body_test_motion_batch(const MotionQuery *p_queries, int p_query_count, MotionResult *r_results, bool *r_collided);
+	virtual int body_test_ray_separation(RID p_body, const Transform &p_transform, bool p_infinite_inertia, Vector3 &r_recover_motion, SeparationResult *r_results, int p_result_max, real_t p_margin = 0.001);
 
 	// this function only works on physics process, errors and returns null otherwise
 	virtual PhysicsDirectBodyState *body_get_direct_state(RID p_body);
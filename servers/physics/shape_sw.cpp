@@ -1575,11 +1575,156 @@ Vector3 HeightMapShapeSW::get_support(const Vector3 &p_normal) const {
 	return get_aabb().get_support(p_normal);
 }
 
-bool HeightMapShapeSW::intersect_segment(const Vector3 &p_begin, const Vector3 &p_end, Vector3 &r_point, Vector3 &r_normal) const {
+void HeightMapShapeSW::_get_cell_faces(const real_t *p_heights, int p_x, int p_z, Face3 &r_face0, Face3 &r_face1) const {
+
+	Vector3 p00 = _get_point(p_heights, p_x, p_z);
+	Vector3 p10 = _get_point(p_heights, p_x + 1, p_z);
+	Vector3 p01 = _get_point(p_heights, p_x, p_z + 1);
+	Vector3 p11 = _get_point(p_heights, p_x + 1, p_z + 1);
+
+	// Wound so normals point up.
+	r_face0 = Face3(p00, p10, p01);
+	r_face1 = Face3(p10, p11, p01);
+}
+
+bool HeightMapShapeSW::_intersect_cells(const real_t *p_heights, const Vector3 &p_begin, const Vector3 &p_dir, real_t p_t_begin, real_t p_t_end, int p_cell_size, Vector3 &r_point, Vector3 &r_normal) const {
+
+	// Walks the cells (or bounds chunks) crossed by the segment in the XZ plane
+	// in order, so the first cell with a hit contains the closest one.
+	// p_begin and p_dir are in grid units, where cells have a size of one.
+
+	int max_x = p_cell_size == 1 ? width - 2 : bounds_grid_width - 1;
+	int max_z = p_cell_size == 1 ? depth - 2 : bounds_grid_depth - 1;
+
+	Vector3 start = p_begin + p_dir * p_t_begin;
+	int x = CLAMP((int)Math::floor(start.x / p_cell_size), 0, max_x);
+	int z = CLAMP((int)Math::floor(start.z / p_cell_size), 0, max_z);
+
+	int step_x = p_dir.x > 0 ? 1 : -1;
+	int step_z = p_dir.z > 0 ? 1 : -1;
+	real_t t_delta_x = p_dir.x != 0 ? p_cell_size / Math::abs(p_dir.x) : 1e20;
+	real_t t_delta_z = p_dir.z != 0 ? p_cell_size / Math::abs(p_dir.z) : 1e20;
+	real_t t_max_x = p_dir.x != 0 ? ((x + (step_x > 0 ? 1 : 0)) * p_cell_size - p_begin.x) / p_dir.x : 1e20;
+	real_t t_max_z = p_dir.z != 0 ? ((z + (step_z > 0 ? 1 : 0)) * p_cell_size - p_begin.z) / p_dir.z : 1e20;
+
+	Vector3 local_begin = Vector3(p_begin.x * cell_size, p_begin.y, p_begin.z * cell_size) - local_origin;
+	Vector3 local_end = local_begin + Vector3(p_dir.x * cell_size, p_dir.y, p_dir.z * cell_size);
+
+	real_t t = p_t_begin;
+	while (true) {
+
+		real_t t_next = MIN(MIN(t_max_x, t_max_z), p_t_end);
+
+		if (p_cell_size == 1) {
+
+			Face3 faces[2];
+			_get_cell_faces(p_heights, x, z, faces[0], faces[1]);
+
+			bool collided = false;
+			real_t min_d = 1e20;
+			for (int i = 0; i < 2; i++) {
+
+				Vector3 res;
+				if (Geometry::segment_intersects_triangle(local_begin, local_end, faces[i].vertex[0], faces[i].vertex[1], faces[i].vertex[2], &res)) {
+
+					real_t d = local_begin.distance_squared_to(res);
+					if (d < min_d) {
+						min_d = d;
+						r_point = res;
+						r_normal = faces[i].get_plane().normal;
+						collided = true;
+					}
+				}
+			}
+
+			if (collided) {
+				return true;
+			}
+
+		} else {
+
+			// Only descend into chunks whose height range overlaps the segment.
+			const Range &range = bounds[z * bounds_grid_width + x];
+			real_t y_begin = p_begin.y + p_dir.y * t;
+			real_t y_end = p_begin.y + p_dir.y * t_next;
+
+			if (MAX(y_begin, y_end) >= range.min && MIN(y_begin, y_end) <= range.max) {
+				if (_intersect_cells(p_heights, p_begin, p_dir, t, t_next, 1, r_point, r_normal)) {
+					return true;
+				}
+			}
+		}
+
+		if (t_next >= p_t_end) {
+			break;
+		}
+
+		if (t_max_x < t_max_z) {
+			x += step_x;
+			t = t_max_x;
+			t_max_x += t_delta_x;
+		} else {
+			z += step_z;
+			t = t_max_z;
+			t_max_z += t_delta_z;
+		}
+
+		if (x < 0 || x > max_x || z < 0 || z > max_z) {
+			break;
+		}
+	}
 
 	return false;
 }
 
+bool HeightMapShapeSW::intersect_segment(const Vector3 &p_begin, const Vector3 &p_end, Vector3 &r_point, Vector3 &r_normal) const {
+
+	if (width < 2 || depth < 2) {
+		return false;
+	}
+
+	// Move to grid units, where the map spans from zero to (width - 1, depth - 1).
+	Vector3 begin = p_begin + local_origin;
+	begin.x /= cell_size;
+	begin.z /= cell_size;
+	Vector3 end = p_end + local_origin;
+	end.x /= cell_size;
+	end.z /= cell_size;
+	Vector3 dir = end - begin;
+
+	// Clip the segment to the bounds of the map.
+	const AABB &aabb = get_aabb();
+	Vector3 bounds_begin(0, aabb.position.y - CMP_EPSILON, 0);
+	Vector3 bounds_end(width - 1, aabb.position.y + aabb.size.y + CMP_EPSILON, depth - 1);
+
+	real_t t_begin = 0;
+	real_t t_end = 1;
+	for (int i = 0; i < 3; i++) {
+
+		if (dir[i] == 0) {
+			if (begin[i] < bounds_begin[i] || begin[i] > bounds_end[i]) {
+				return false;
+			}
+			continue;
+		}
+
+		real_t t0 = (bounds_begin[i] - begin[i]) / dir[i];
+		real_t t1 = (bounds_end[i] - begin[i]) / dir[i];
+		if (t0 > t1) {
+			SWAP(t0, t1);
+		}
+		t_begin = MAX(t_begin, t0);
+		t_end = MIN(t_end, t1);
+	}
+
+	if (t_begin > t_end) {
+		return false;
+	}
+
+	PoolVector<real_t>::Read r = heights.read();
+	return _intersect_cells(r.ptr(), begin, dir, t_begin, t_end, BOUNDS_CHUNK_SIZE, r_point, r_normal);
+}
+
 bool HeightMapShapeSW::intersect_point(const Vector3 &p_point) const {
 	return false;
 }
@@ -1590,6 +1735,65 @@ Vector3 HeightMapShapeSW::get_closest_point_to(const Vector3 &p_point) const {
 }
 
 void HeightMapShapeSW::cull(const AABB &p_local_aabb, Callback p_callback, void *p_userdata) const {
+
+	if (width < 2 || depth < 2) {
+		return;
+	}
+
+	if (!p_local_aabb.intersects(get_aabb())) {
+		return;
+	}
+
+	// Range of cells touched by the AABB, triangles are generated on the fly.
+	Vector3 grid_begin = p_local_aabb.position + local_origin;
+	Vector3 grid_end = grid_begin + p_local_aabb.size;
+
+	int start_x = MAX(0, (int)Math::floor(grid_begin.x / cell_size));
+	int start_z = MAX(0, (int)Math::floor(grid_begin.z / cell_size));
+	int end_x = MIN(width - 2, (int)Math::floor(grid_end.x / cell_size));
+	int end_z = MIN(depth - 2, (int)Math::floor(grid_end.z / cell_size));
+
+	real_t min_y = p_local_aabb.position.y;
+	real_t max_y = min_y + p_local_aabb.size.y;
+
+	PoolVector<real_t>::Read r = heights.read();
+	const real_t *heights_ptr = r.ptr();
+
+	FaceShapeSW face; // use this to send in the callback
+
+	for (int chunk_z = start_z / BOUNDS_CHUNK_SIZE; chunk_z <= end_z / BOUNDS_CHUNK_SIZE; chunk_z++) {
+		for (int chunk_x = start_x / BOUNDS_CHUNK_SIZE; chunk_x <= end_x / BOUNDS_CHUNK_SIZE; chunk_x++) {
+
+			const Range &range = bounds[chunk_z * bounds_grid_width + chunk_x];
+			if (range.max < min_y || range.min > max_y) {
+				continue;
+			}
+
+			int chunk_end_z = MIN(end_z, (chunk_z + 1) * BOUNDS_CHUNK_SIZE - 1);
+			int chunk_end_x = MIN(end_x, (chunk_x + 1) * BOUNDS_CHUNK_SIZE - 1);
+
+			for (int z = MAX(start_z, chunk_z * BOUNDS_CHUNK_SIZE); z <= chunk_end_z; z++) {
+				for (int x = MAX(start_x, chunk_x * BOUNDS_CHUNK_SIZE); x <= chunk_end_x; x++) {
+
+					Face3 faces[2];
+					_get_cell_faces(heights_ptr, x, z, faces[0], faces[1]);
+
+					for (int i = 0; i < 2; i++) {
+
+						if (!p_local_aabb.intersects(faces[i].get_aabb())) {
+							continue;
+						}
+
+						face.normal = faces[i].get_plane().normal;
+						face.vertex[0] = faces[i].vertex[0];
+						face.vertex[1] = faces[i].vertex[1];
+						face.vertex[2] = faces[i].vertex[2];
+						p_callback(p_userdata, &face);
+					}
+				}
+			}
+		}
+	}
 }
 
 Vector3 HeightMapShapeSW::get_moment_of_inertia(real_t p_mass) const {
@@ -1609,25 +1813,45 @@ void HeightMapShapeSW::_setup(PoolVector<real_t> p_heights, int p_width, int p_d
 	width = p_width;
 	depth = p_depth;
 	cell_size = p_cell_size;
+	local_origin = Vector3((width - 1) * cell_size * 0.5, 0, (depth - 1) * cell_size * 0.5);
 
 	PoolVector<real_t>::Read r = heights.read();
 
-	AABB aabb;
+	bounds_grid_width = MAX(1, (width - 1 + BOUNDS_CHUNK_SIZE - 1) / BOUNDS_CHUNK_SIZE);
+	bounds_grid_depth = MAX(1, (depth - 1 + BOUNDS_CHUNK_SIZE - 1) / BOUNDS_CHUNK_SIZE);
+	bounds.resize(bounds_grid_width * bounds_grid_depth);
 
-	for (int i = 0; i < depth; i++) {
+	real_t min_height = r[0];
+	real_t max_height = r[0];
 
-		for (int j = 0; j < width; j++) {
+	for (int chunk_z = 0; chunk_z < bounds_grid_depth; chunk_z++) {
+		for (int chunk_x = 0; chunk_x < bounds_grid_width; chunk_x++) {
 
-			real_t h = r[i * width + j];
+			// Chunks include the vertices shared with the next one.
+			int end_z = MIN(depth - 1, (chunk_z + 1) * BOUNDS_CHUNK_SIZE);
+			int end_x = MIN(width - 1, (chunk_x + 1) * BOUNDS_CHUNK_SIZE);
 
-			Vector3 pos(j * cell_size, h, i * cell_size);
-			if (i == 0 || j == 0)
-				aabb.position = pos;
-			else
-				aabb.expand_to(pos);
+			Range range;
+			range.min = range.max = r[chunk_z * BOUNDS_CHUNK_SIZE * width + chunk_x * BOUNDS_CHUNK_SIZE];
+
+			for (int z = chunk_z * BOUNDS_CHUNK_SIZE; z <= end_z; z++) {
+				for (int x = chunk_x * BOUNDS_CHUNK_SIZE; x <= end_x; x++) {
+					real_t h = r[z * width + x];
+					range.min = MIN(range.min, h);
+					range.max = MAX(range.max, h);
+				}
+			}
+
+			bounds.write[chunk_z * bounds_grid_width + chunk_x] = range;
+			min_height = MIN(min_height, range.min);
+			max_height = MAX(max_height, range.max);
 		}
 	}
 
+	AABB aabb;
+	aabb.position = Vector3(-local_origin.x, min_height, -local_origin.z);
+	aabb.size = Vector3((width - 1) * cell_size, max_height - min_height, (depth - 1) * cell_size);
+
 	configure(aabb);
 }
 
@@ -1637,12 +1861,12 @@ void HeightMapShapeSW::set_data(const Variant &p_data) {
 	Dictionary d = p_data;
 	ERR_FAIL_COND(!d.has("width"));
 	ERR_FAIL_COND(!d.has("depth"));
-	ERR_FAIL_COND(!d.has("cell_size"));
 	ERR_FAIL_COND(!d.has("heights"));
 
 	int width = d["width"];
 	int depth = d["depth"];
-	real_t cell_size = d["cell_size"];
+	// HeightMapShape does not send a cell size, cells are scaled through the transform instead.
+	real_t cell_size = d.has("cell_size") ? real_t(d["cell_size"]) : real_t(1.0);
 	PoolVector<real_t> heights = d["heights"];
 
 	ERR_FAIL_COND(width <= 0);
@@ -1654,7 +1878,14 @@ void HeightMapShapeSW::set_data(const Variant &p_data) {
 
 Variant HeightMapShapeSW::get_data() const {
 
-	ERR_FAIL_V(Variant());
+	Dictionary d;
+	d["width"] = width;
+	d["depth"] = depth;
+	d["cell_size"] = cell_size;
+	d["heights"] = heights;
+	d["min_height"] = get_aabb().position.y;
+	d["max_height"] = get_aabb().position.y + get_aabb().size.y;
+	return d;
 }
 
 HeightMapShapeSW::HeightMapShapeSW() {
@@ -1662,4 +1893,6 @@ HeightMapShapeSW::HeightMapShapeSW() {
 	width = 0;
 	depth = 0;
 	cell_size = 0;
+	bounds_grid_width = 0;
+	bounds_grid_depth = 0;
 }
@@ -368,13 +368,34 @@ public:
 
 struct HeightMapShapeSW : public ConcaveShapeSW {
 
+	// The map is centered around the origin in the XZ plane. Minimum and
+	// maximum heights are kept for square chunks of cells, so culling and
+	// ray traversal can reject whole chunks without looking at the heights.
+	enum {
+		BOUNDS_CHUNK_SIZE = 16
+	};
+
+	struct Range {
+		real_t min;
+		real_t max;
+	};
+
 	PoolVector<real_t> heights;
 	int width;
 	int depth;
 	real_t cell_size;
+	Vector3 local_origin;
+
+	Vector<Range> bounds;
+	int bounds_grid_width;
+	int bounds_grid_depth;
+
+	_FORCE_INLINE_ Vector3 _get_point(const real_t *p_heights, int p_x, int p_z) const {
+		return Vector3(p_x * cell_size, p_heights[p_z * width + p_x], p_z * cell_size) - local_origin;
+	}
 
-	//void _cull_segment(int p_idx,_SegmentCullParams *p_params) const;
-	//void _cull(int p_idx,_CullParams *p_params) const;
+	_FORCE_INLINE_ void _get_cell_faces(const real_t *p_heights, int p_x, int p_z, Face3 &r_face0, Face3 &r_face1) const;
+	bool _intersect_cells(const real_t *p_heights, const Vector3 &p_begin, const Vector3 &p_dir, real_t p_t_begin, real_t p_t_end, int p_cell_size, Vector3 &r_point, Vector3 &r_normal) const;
 
 	void _setup(PoolVector<real_t> p_heights, int p_width, int p_depth, real_t p_cell_size);
 
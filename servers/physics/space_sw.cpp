@@ -32,6 +32,7 @@
 
 #include "collision_solver_sw.h"
 #include "core/project_settings.h"
+#include "core/sort_array.h"
 #include "physics_server_sw.h"
 
 _FORCE_INLINE_ static bool _can_collide_with(CollisionObjectSW *p_object, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
@@ -49,6 +50,38 @@ _FORCE_INLINE_ static bool _can_collide_with(CollisionObjectSW *p_object, uint32
 	return true;
 }
 
+// Intersects a segment with a shape of an object, updating the closest result
+// if the hit is closer along p_normal than r_min_d.
+_FORCE_INLINE_ static bool _intersect_ray_shape(const CollisionObjectSW *p_object, int p_shape_idx, const Vector3 &p_begin, const Vector3 &p_end, const Vector3 &p_normal, real_t &r_min_d, Vector3 &r_point, Vector3 &r_normal) {
+
+	Transform inv_xform = p_object->get_shape_inv_transform(p_shape_idx) * p_object->get_inv_transform();
+
+	Vector3 local_from = inv_xform.xform(p_begin);
+	Vector3 local_to = inv_xform.xform(p_end);
+
+	const ShapeSW *shape = p_object->get_shape(p_shape_idx);
+
+	Vector3 shape_point, shape_normal;
+
+	if (!shape->intersect_segment(local_from, local_to, shape_point, shape_normal)) {
+		return false;
+	}
+
+	Transform xform = p_object->get_transform() * p_object->get_shape_transform(p_shape_idx);
+	shape_point = xform.xform(shape_point);
+
+	real_t ld = p_normal.dot(shape_point);
+
+	if (ld >= r_min_d) {
+		return false;
+	}
+
+	r_min_d = ld;
+	r_point = shape_point;
+	r_normal = inv_xform.basis.xform_inv(shape_normal).normalized();
+	return true;
+}
+
 int PhysicsDirectSpaceStateSW::intersect_point(const Vector3 &p_point, ShapeResult *r_results, int p_result_max, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
 
 	ERR_FAIL_COND_V(space->locked, false);
@@ -125,39 +158,70 @@ bool PhysicsDirectSpaceStateSW::intersect_ray(const Vector3 &p_from, const Vecto
 			continue;
 
 		const CollisionObjectSW *col_obj = space->intersection_query_results[i];
-
 		int shape_idx = space->intersection_query_subindex_results[i];
-		Transform inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
-		Vector3 local_from = inv_xform.xform(begin);
-		Vector3 local_to = inv_xform.xform(end);
+		if (_intersect_ray_shape(col_obj, shape_idx, begin, end, normal, min_d, res_point, res_normal)) {
 
-		const ShapeSW *shape = col_obj->get_shape(shape_idx);
+			res_shape = shape_idx;
+			res_obj = col_obj;
+			collided = true;
+		}
+	}
 
-		Vector3 shape_point, shape_normal;
+	if (!collided)
+		return false;
 
-		if (shape->intersect_segment(local_from, local_to, shape_point, shape_normal)) {
+	r_result.collider_id = res_obj->get_instance_id();
+	if (r_result.collider_id != 0)
+		r_result.collider = ObjectDB::get_instance(r_result.collider_id);
+	else
+		r_result.collider = NULL;
+	r_result.normal = res_normal;
+	r_result.position = res_point;
+	r_result.rid = res_obj->get_self();
+	r_result.shape = res_shape;
 
-			Transform xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
-			shape_point = xform.xform(shape_point);
+	return true;
+}
 
-			real_t ld = normal.dot(shape_point);
+void PhysicsDirectSpaceStateSW::_intersect_ray_batch_process(uint32_t p_index, RayBatch *p_batch) {
 
-			if (ld < min_d) {
+	const RayQuery &query = p_batch->queries[p_index];
+	Vector3 normal = (query.to - query.from).normalized();
 
-				min_d = ld;
-				res_point = shape_point;
-				res_normal = inv_xform.basis.xform_inv(shape_normal).normalized();
-				res_shape = shape_idx;
-				res_obj = col_obj;
-				collided = true;
-			}
+	BatchCandidate *candidates = &p_batch->candidates[p_batch->candidate_offsets[p_index]];
+	int candidate_count = p_batch->candidate_offsets[p_index + 1] - p_batch->candidate_offsets[p_index];
+
+	// Visit candidates from the nearest AABB, so farther ones can be skipped once something was hit.
+	SortArray<BatchCandidate> sorter;
+	sorter.sort(candidates, candidate_count);
+
+	bool collided = false;
+	Vector3 res_point, res_normal;
+	int res_shape = 0;
+	const CollisionObjectSW *res_obj = NULL;
+	real_t min_d = 1e10;
+
+	for (int i = 0; i < candidate_count; i++) {
+
+		if (candidates[i].entry >= min_d) {
+			break;
+		}
+
+		if (_intersect_ray_shape(candidates[i].object, candidates[i].shape, query.from, query.to, normal, min_d, res_point, res_normal)) {
+
+			res_shape = candidates[i].shape;
+			res_obj = candidates[i].object;
+			collided = true;
 		}
 	}
 
-	if (!collided)
-		return false;
+	p_batch->hits[p_index] = collided;
+	if (!collided) {
+		return;
+	}
 
+	RayResult &r_result = p_batch->results[p_index];
 	r_result.collider_id = res_obj->get_instance_id();
 	if (r_result.collider_id != 0)
 		r_result.collider = ObjectDB::get_instance(r_result.collider_id);
@@ -167,8 +231,85 @@ bool PhysicsDirectSpaceStateSW::intersect_ray(const Vector3 &p_from, const Vecto
 	r_result.position = res_point;
 	r_result.rid = res_obj->get_self();
 	r_result.shape = res_shape;
+}
 
-	return true;
+int PhysicsDirectSpaceStateSW::intersect_rays_batch(const RayQuery *p_queries, int p_query_count, RayResult *r_results, bool *r_hits, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
+
+	ERR_FAIL_COND_V(space->locked, 0);
+
+	// The broadphase keeps internal state while culling, so the candidates of
+	// every ray are gathered here first. The narrow phase only reads shapes and
+	// transforms, so it can then run in parallel over this snapshot.
+	Vector<BatchCandidate> candidates;
+	Vector<int> candidate_offsets;
+	candidate_offsets.resize(p_query_count + 1);
+
+	for (int i = 0; i < p_query_count; i++) {
+
+		candidate_offsets.write[i] = candidates.size();
+
+		const Vector3 &begin = p_queries[i].from;
+		const Vector3 &end = p_queries[i].to;
+		Vector3 dir = end - begin;
+		real_t begin_d = dir.normalized().dot(begin);
+		real_t length = dir.length();
+
+		int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, SpaceSW::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+
+		for (int j = 0; j < amount; j++) {
+
+			const CollisionObjectSW *col_obj = space->intersection_query_results[j];
+
+			if (!_can_collide_with(space->intersection_query_results[j], p_collision_mask, p_collide_with_bodies, p_collide_with_areas))
+				continue;
+
+			if (p_exclude.has(col_obj->get_self()))
+				continue;
+
+			BatchCandidate candidate;
+			candidate.object = col_obj;
+			candidate.shape = space->intersection_query_subindex_results[j];
+
+			// Slab test for the point where the ray enters the shape AABB.
+			const AABB &aabb = col_obj->get_shape_aabb(candidate.shape);
+			real_t t_enter = 0;
+			for (int k = 0; k < 3; k++) {
+				if (dir[k] != 0) {
+					real_t t0 = (aabb.position[k] - begin[k]) / dir[k];
+					real_t t1 = (aabb.position[k] + aabb.size[k] - begin[k]) / dir[k];
+					t_enter = MAX(t_enter, MIN(t0, t1));
+				}
+			}
+			candidate.entry = begin_d + MIN(t_enter, (real_t)1.0) * length;
+
+			candidates.push_back(candidate);
+		}
+	}
+	candidate_offsets.write[p_query_count] = candidates.size();
+
+	RayBatch batch;
+	batch.queries = p_queries;
+	batch.results = r_results;
+	batch.hits = r_hits;
+	batch.candidates = candidates.ptrw();
+	batch.candidate_offsets = candidate_offsets.ptr();
+
+	if (p_query_count >= BATCH_PARALLEL_MIN_QUERIES) {
+		PhysicsServerSW::singleton->thread_pool.do_work(p_query_count, this, &PhysicsDirectSpaceStateSW::_intersect_ray_batch_process, &batch);
+	} else {
+		for (int i = 0; i < p_query_count; i++) {
+			_intersect_ray_batch_process(i, &batch);
+		}
+	}
+
+	int hit_count = 0;
+	for (int i = 0; i < p_query_count; i++) {
+		if (r_hits[i]) {
+			hit_count++;
+		}
+	}
+
+	return hit_count;
 }
 
 int PhysicsDirectSpaceStateSW::intersect_shape(const RID &p_shape, const Transform &p_xform, real_t p_margin, ShapeResult *r_results, int p_result_max, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
@@ -222,6 +363,108 @@ int PhysicsDirectSpaceStateSW::intersect_shape(const RID &p_shape, const Transfo
 	return cc;
 }
 
+void PhysicsDirectSpaceStateSW::_intersect_shape_batch_process(uint32_t p_index, ShapeBatch *p_batch) {
+
+	const ShapeQuery &query = p_batch->queries[p_index];
+	const ShapeSW *shape = p_batch->shapes[p_index];
+	ShapeResult *results = &p_batch->results[p_index * p_batch->result_max];
+
+	int cc = 0;
+
+	for (int i = p_batch->candidate_offsets[p_index]; i < p_batch->candidate_offsets[p_index + 1]; i++) {
+
+		if (cc >= p_batch->result_max)
+			break;
+
+		const CollisionObjectSW *col_obj = p_batch->candidates[i].object;
+		int shape_idx = p_batch->candidates[i].shape;
+
+		if (!CollisionSolverSW::solve_static(shape, query.xform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), NULL, NULL, NULL, p_batch->margin, 0))
+			continue;
+
+		results[cc].collider_id = col_obj->get_instance_id();
+		if (results[cc].collider_id != 0)
+			results[cc].collider = ObjectDB::get_instance(results[cc].collider_id);
+		else
+			results[cc].collider = NULL;
+		results[cc].rid = col_obj->get_self();
+		results[cc].shape = shape_idx;
+
+		cc++;
+	}
+
+	p_batch->result_counts[p_index] = cc;
+}
+
+int PhysicsDirectSpaceStateSW::intersect_shapes_batch(const ShapeQuery *p_queries, int p_query_count, real_t p_margin, ShapeResult *r_results, int p_result_max, int *r_result_counts, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
+
+	ERR_FAIL_COND_V(space->locked, 0);
+
+	// Gather candidates serially, as in intersect_rays_batch().
+	Vector<const ShapeSW *> shapes;
+	shapes.resize(p_query_count);
+	Vector<BatchCandidate> candidates;
+	Vector<int> candidate_offsets;
+	candidate_offsets.resize(p_query_count + 1);
+
+	for (int i = 0; i < p_query_count; i++) {
+
+		candidate_offsets.write[i] = candidates.size();
+
+		const ShapeSW *shape = PhysicsServerSW::singleton->shape_owner.get(p_queries[i].shape);
+		shapes.write[i] = shape;
+		if (!shape || p_result_max <= 0) {
+			ERR_CONTINUE(!shape);
+			continue;
+		}
+
+		AABB aabb = p_queries[i].xform.xform(shape->get_aabb());
+
+		int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, SpaceSW::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+
+		for (int j = 0; j < amount; j++) {
+
+			if (!_can_collide_with(space->intersection_query_results[j], p_collision_mask, p_collide_with_bodies, p_collide_with_areas))
+				continue;
+
+			if (p_exclude.has(space->intersection_query_results[j]->get_self()))
+				continue;
+
+			BatchCandidate candidate;
+			candidate.object = space->intersection_query_results[j];
+			candidate.shape = space->intersection_query_subindex_results[j];
+			candidate.entry = 0;
+			candidates.push_back(candidate);
+		}
+	}
+	candidate_offsets.write[p_query_count] = candidates.size();
+
+	ShapeBatch batch;
+	batch.queries = p_queries;
+	batch.shapes = shapes.ptr();
+	batch.margin = p_margin;
+	batch.results = r_results;
+	batch.result_max = p_result_max;
+	batch.result_counts = r_result_counts;
+	batch.candidates = candidates.ptr();
+	batch.candidate_offsets = candidate_offsets.ptr();
+
+	if (p_query_count >= BATCH_PARALLEL_MIN_QUERIES) {
+		PhysicsServerSW::singleton->thread_pool.do_work(p_query_count, this, &PhysicsDirectSpaceStateSW::_intersect_shape_batch_process, &batch);
+	} else {
+		for (int i = 0; i < p_query_count; i++) {
+			_intersect_shape_batch_process(i, &batch);
+		}
+	}
+
+	int total = 0;
+	for (int i = 0; i < p_query_count; i++) {
+		total += r_result_counts[i];
+	}
+
+	return total;
+}
+
 bool PhysicsDirectSpaceStateSW::cast_motion(const RID &p_shape, const Transform &p_xform, const Vector3 &p_motion, real_t p_margin, real_t &p_closest_safe, real_t &p_closest_unsafe, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas, ShapeRestInfo *r_info) {
 
 	ShapeSW *shape = static_cast<PhysicsServerSW *>(PhysicsServer::get_singleton())->shape_owner.get(p_shape);
@@ -506,10 +749,14 @@ PhysicsDirectSpaceStateSW::PhysicsDirectSpaceStateSW() {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-int SpaceSW::_cull_aabb_for_body(BodySW *p_body, const AABB &p_aabb) {
+int SpaceSW::_cull_aabb_for_body(BodySW *p_body, const AABB &p_aabb, bool *r_full) {
 
 	int amount = broadphase->cull_aabb(p_aabb, intersection_query_results, INTERSECTION_QUERY_MAX, intersection_query_subindex_results);
 
+	if (r_full) {
+		*r_full = amount == INTERSECTION_QUERY_MAX;
+	}
+
 	for (int i = 0; i < amount; i++) {
 
 		bool keep = true;
@@ -695,19 +942,8 @@ int SpaceSW::test_body_ray_separation(BodySW *p_body, const Transform &p_transfo
 	return rays_found;
 }
 
-bool SpaceSW::test_body_motion(BodySW *p_body, const Transform &p_from, const Vector3 &p_motion, bool p_infinite_inertia, real_t p_margin, PhysicsServer::MotionResult *r_result, bool p_exclude_raycast_shapes) {
-
-	//give me back regular physics engine logic
-	//this is madness
-	//and most people using this function will think
-	//what it does is simpler than using physics
-	//this took about a week to get right..
-	//but is it right? who knows at this point..
+bool SpaceSW::_get_body_motion_aabb(BodySW *p_body, const Transform &p_from, real_t p_margin, AABB &r_aabb) const {
 
-	if (r_result) {
-		r_result->collider_id = 0;
-		r_result->collider_shape = 0;
-	}
 	AABB body_aabb;
 	bool shapes_found = false;
 
@@ -725,18 +961,58 @@ bool SpaceSW::test_body_motion(BodySW *p_body, const Transform &p_from, const Ve
 	}
 
 	if (!shapes_found) {
-		if (r_result) {
-			*r_result = PhysicsServer::MotionResult();
-			r_result->motion = p_motion;
-		}
-
 		return false;
 	}
 
 	// Undo the currently transform the physics server is aware of and apply the provided one
-	body_aabb = p_from.xform(p_body->get_inv_transform().xform(body_aabb));
-	body_aabb = body_aabb.grow(p_margin);
+	r_aabb = p_from.xform(p_body->get_inv_transform().xform(body_aabb));
+	r_aabb = r_aabb.grow(p_margin);
+	return true;
+}
+
+AABB SpaceSW::_get_motion_query_aabb(const AABB &p_body_aabb, const Vector3 &p_motion) const {
+
+	// Covers the whole motion, plus some room for the body to be pushed out when stuck.
+	AABB query_aabb = p_body_aabb;
+	query_aabb.position += p_motion;
+	query_aabb = query_aabb.merge(p_body_aabb);
+	return query_aabb.grow(p_body_aabb.get_longest_axis_size() * 0.25);
+}
 
+int SpaceSW::_cull_motion_candidates(BodySW *p_body, const AABB &p_aabb, Vector<MotionCandidate> &r_candidates, bool &r_full) {
+
+	int amount = _cull_aabb_for_body(p_body, p_aabb, &r_full);
+
+	int from = r_candidates.size();
+	r_candidates.resize(from + amount);
+	MotionCandidate *candidates = r_candidates.ptrw() + from;
+
+	for (int i = 0; i < amount; i++) {
+
+		const CollisionObjectSW *col_obj = intersection_query_results[i];
+		int shape_idx = intersection_query_subindex_results[i];
+
+		candidates[i].object = col_obj;
+		candidates[i].shape = shape_idx;
+		candidates[i].aabb = col_obj->get_shape_aabb(shape_idx);
+		candidates[i].xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
+	}
+
+	return amount;
+}
+
+SpaceSW::MotionTestResult SpaceSW::_test_body_motion_candidates(BodySW *p_body, const Transform &p_from, const Vector3 &p_motion, real_t p_margin, PhysicsServer::MotionResult *r_result, bool p_exclude_raycast_shapes, const AABB &p_body_aabb, const MotionCandidate *p_candidates, int p_candidate_count, const AABB &p_candidates_aabb, AABB &r_required_aabb) const {
+
+	//give me back regular physics engine logic
+	//this is madness
+	//and most people using this function will think
+	//what it does is simpler than using physics
+	//this took about a week to get right..
+	//but is it right? who knows at this point..
+
+	// Only touches the candidates it is given, so it is safe to run in parallel.
+
+	AABB body_aabb = p_body_aabb;
 	Transform body_transform = p_from;
 
 	{
@@ -748,6 +1024,11 @@ bool SpaceSW::test_body_motion(BodySW *p_body, const Transform &p_from, const Ve
 
 		do {
 
+			if (!p_candidates_aabb.encloses(body_aabb)) {
+				r_required_aabb = body_aabb;
+				return MOTION_TEST_OUT_OF_BOUNDS;
+			}
+
 			PhysicsServerSW::CollCbkData cbk;
 			cbk.max = max_results;
 			cbk.amount = 0;
@@ -758,8 +1039,6 @@ bool SpaceSW::test_body_motion(BodySW *p_body, const Transform &p_from, const Ve
 
 			bool collided = false;
 
-			int amount = _cull_aabb_for_body(p_body, body_aabb);
-
 			for (int j = 0; j < p_body->get_shape_count(); j++) {
 				if (p_body->is_shape_set_as_disabled(j))
 					continue;
@@ -770,12 +1049,13 @@ bool SpaceSW::test_body_motion(BodySW *p_body, const Transform &p_from, const Ve
 					continue;
 				}
 
-				for (int i = 0; i < amount; i++) {
+				for (int i = 0; i < p_candidate_count; i++) {
 
-					const CollisionObjectSW *col_obj = intersection_query_results[i];
-					int shape_idx = intersection_query_subindex_results[i];
+					const MotionCandidate &candidate = p_candidates[i];
+					if (!candidate.aabb.intersects(body_aabb))
+						continue;
 
-					if (CollisionSolverSW::solve_static(body_shape, body_shape_xform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), cbkres, cbkptr, NULL, p_margin)) {
+					if (CollisionSolverSW::solve_static(body_shape, body_shape_xform, candidate.object->get_shape(candidate.shape), candidate.xform, cbkres, cbkptr, NULL, p_margin)) {
 						collided = cbk.amount > 0;
 					}
 				}
@@ -811,14 +1091,17 @@ bool SpaceSW::test_body_motion(BodySW *p_body, const Transform &p_from, const Ve
 	real_t unsafe = 1.0;
 	int best_shape = -1;
 
-	{
-		// STEP 2 ATTEMPT MOTION
+	AABB motion_aabb = body_aabb;
+	motion_aabb.position += p_motion;
+	motion_aabb = motion_aabb.merge(body_aabb);
 
-		AABB motion_aabb = body_aabb;
-		motion_aabb.position += p_motion;
-		motion_aabb = motion_aabb.merge(body_aabb);
+	if (!p_candidates_aabb.encloses(motion_aabb)) {
+		r_required_aabb = motion_aabb;
+		return MOTION_TEST_OUT_OF_BOUNDS;
+	}
 
-		int amount = _cull_aabb_for_body(p_body, motion_aabb);
+	{
+		// STEP 2 ATTEMPT MOTION
 
 		for (int j = 0; j < p_body->get_shape_count(); j++) {
 
@@ -842,23 +1125,26 @@ bool SpaceSW::test_body_motion(BodySW *p_body, const Transform &p_from, const Ve
 			real_t best_safe = 1;
 			real_t best_unsafe = 1;
 
-			for (int i = 0; i < amount; i++) {
+			for (int i = 0; i < p_candidate_count; i++) {
+
+				const MotionCandidate &candidate = p_candidates[i];
+				if (!candidate.aabb.intersects(motion_aabb))
+					continue;
 
-				const CollisionObjectSW *col_obj = intersection_query_results[i];
-				int shape_idx = intersection_query_subindex_results[i];
+				const ShapeSW *col_shape = candidate.object->get_shape(candidate.shape);
+				const Transform &col_obj_xform = candidate.xform;
 
 				//test initial overlap, does it collide if going all the way?
 				Vector3 point_A, point_B;
 				Vector3 sep_axis = p_motion.normalized();
 
-				Transform col_obj_xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
 				//test initial overlap, does it collide if going all the way?
-				if (CollisionSolverSW::solve_distance(&mshape, body_shape_xform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, motion_aabb, &sep_axis)) {
+				if (CollisionSolverSW::solve_distance(&mshape, body_shape_xform, col_shape, col_obj_xform, point_A, point_B, motion_aabb, &sep_axis)) {
 					continue;
 				}
 				sep_axis = p_motion.normalized();
 
-				if (!CollisionSolverSW::solve_distance(body_shape, body_shape_xform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, motion_aabb, &sep_axis)) {
+				if (!CollisionSolverSW::solve_distance(body_shape, body_shape_xform, col_shape, col_obj_xform, point_A, point_B, motion_aabb, &sep_axis)) {
 					stuck = true;
 					break;
 				}
@@ -878,7 +1164,7 @@ bool SpaceSW::test_body_motion(BodySW *p_body, const Transform &p_from, const Ve
 
 					Vector3 lA, lB;
 
-					bool collided = !CollisionSolverSW::solve_distance(&mshape, body_shape_xform, col_obj->get_shape(shape_idx), col_obj_xform, lA, lB, motion_aabb, &sep);
+					bool collided = !CollisionSolverSW::solve_distance(&mshape, body_shape_xform, col_shape, col_obj_xform, lA, lB, motion_aabb, &sep);
 
 					if (collided) {
 
@@ -944,16 +1230,15 @@ bool SpaceSW::test_body_motion(BodySW *p_body, const Transform &p_from, const Ve
 
 		body_aabb.position += p_motion * unsafe;
 
-		int amount = _cull_aabb_for_body(p_body, body_aabb);
+		for (int i = 0; i < p_candidate_count; i++) {
 
-		for (int i = 0; i < amount; i++) {
-
-			const CollisionObjectSW *col_obj = intersection_query_results[i];
-			int shape_idx = intersection_query_subindex_results[i];
+			const MotionCandidate &candidate = p_candidates[i];
+			if (!candidate.aabb.intersects(body_aabb))
+				continue;
 
-			rcd.object = col_obj;
-			rcd.shape = shape_idx;
-			bool sc = CollisionSolverSW::solve_static(body_shape, body_shape_xform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), _rest_cbk_result, &rcd, NULL, p_margin);
+			rcd.object = candidate.object;
+			rcd.shape = candidate.shape;
+			bool sc = CollisionSolverSW::solve_static(body_shape, body_shape_xform, candidate.object->get_shape(candidate.shape), candidate.xform, _rest_cbk_result, &rcd, NULL, p_margin);
 			if (!sc)
 				continue;
 		}
@@ -992,7 +1277,148 @@ bool SpaceSW::test_body_motion(BodySW *p_body, const Transform &p_from, const Ve
 		}
 	}
 
-	return collided;
+	return collided ? MOTION_TEST_COLLIDED : MOTION_TEST_FREE;
+}
+
+bool SpaceSW::test_body_motion(BodySW *p_body, const Transform &p_from, const Vector3 &p_motion, bool p_infinite_inertia, real_t p_margin, PhysicsServer::MotionResult *r_result, bool p_exclude_raycast_shapes) {
+
+	if (r_result) {
+		r_result->collider_id = 0;
+		r_result->collider_shape = 0;
+	}
+
+	AABB body_aabb;
+	if (!_get_body_motion_aabb(p_body, p_from, p_margin, body_aabb)) {
+		if (r_result) {
+			*r_result = PhysicsServer::MotionResult();
+			r_result->motion = p_motion;
+		}
+
+		return false;
+	}
+
+	// The broadphase is culled once for all the steps of the test, instead of once per step.
+	AABB query_aabb = _get_motion_query_aabb(body_aabb, p_motion);
+	bool tight_query = false;
+
+	while (true) {
+
+		motion_candidates.clear();
+		bool full = false;
+		int amount = _cull_motion_candidates(p_body, query_aabb, motion_candidates, full);
+
+		if (full && !tight_query) {
+			// Too many shapes around to fit the extra room, cull only what the motion sweeps.
+			// Recovery falls back to culling again if it leaves that area.
+			query_aabb = body_aabb.merge(AABB(body_aabb.position + p_motion, body_aabb.size));
+			tight_query = true;
+			continue;
+		}
+
+		AABB required_aabb;
+		MotionTestResult result = _test_body_motion_candidates(p_body, p_from, p_motion, p_margin, r_result, p_exclude_raycast_shapes, body_aabb, motion_candidates.ptr(), amount, query_aabb, required_aabb);
+
+		if (result != MOTION_TEST_OUT_OF_BOUNDS) {
+			return result == MOTION_TEST_COLLIDED;
+		}
+
+		// Pushed far away while recovering, start again with an area that covers it.
+		query_aabb = query_aabb.merge(_get_motion_query_aabb(required_aabb, p_motion));
+	}
+}
+
+void SpaceSW::_test_body_motion_batch_process(uint32_t p_index, BodyMotionBatch *p_batch) {
+
+	if (!p_batch->has_shapes[p_index] || p_batch->status[p_index] == MOTION_TEST_OUT_OF_BOUNDS) {
+		return;
+	}
+
+	const BodyMotion &m = p_batch->motions[p_index];
+	int from = p_batch->candidate_offsets[p_index];
+	int to = p_batch->candidate_offsets[p_index + 1];
+	AABB required_aabb;
+
+	p_batch->status[p_index] = _test_body_motion_candidates(m.body, m.from, m.motion, m.margin, &p_batch->results[p_index], m.exclude_raycast_shapes, p_batch->body_aabbs[p_index], p_batch->candidates + from, to - from, p_batch->query_aabbs[p_index], required_aabb);
+}
+
+int SpaceSW::test_body_motion_batch(const BodyMotion *p_motions, int p_count, PhysicsServer::MotionResult *r_results, bool *r_collided) {
+
+	// The broadphase can't be queried from several threads, so the candidates for
+	// all the bodies are culled first, then the motions are tested in parallel.
+
+	Vector<MotionCandidate> candidates;
+	Vector<int> candidate_offsets;
+	Vector<AABB> body_aabbs;
+	Vector<AABB> query_aabbs;
+	Vector<MotionTestResult> status;
+	Vector<bool> has_shapes;
+	candidate_offsets.resize(p_count + 1);
+	body_aabbs.resize(p_count);
+	query_aabbs.resize(p_count);
+	status.resize(p_count);
+	has_shapes.resize(p_count);
+
+	for (int i = 0; i < p_count; i++) {
+
+		const BodyMotion &m = p_motions[i];
+		candidate_offsets.write[i] = candidates.size();
+		status.write[i] = MOTION_TEST_FREE;
+
+		r_results[i] = PhysicsServer::MotionResult();
+
+		has_shapes.write[i] = _get_body_motion_aabb(m.body, m.from, m.margin, body_aabbs.write[i]);
+		if (!has_shapes[i]) {
+			r_results[i].motion = m.motion;
+			continue;
+		}
+
+		query_aabbs.write[i] = _get_motion_query_aabb(body_aabbs[i], m.motion);
+
+		bool full = false;
+		_cull_motion_candidates(m.body, query_aabbs[i], candidates, full);
+		if (full) {
+			// Some candidates may be missing, test this motion on its own afterwards.
+			candidates.resize(candidate_offsets[i]);
+			status.write[i] = MOTION_TEST_OUT_OF_BOUNDS;
+		}
+	}
+	candidate_offsets.write[p_count] = candidates.size();
+
+	BodyMotionBatch batch;
+	batch.motions = p_motions;
+	batch.results = r_results;
+	batch.status = status.ptrw();
+	batch.has_shapes = has_shapes.ptr();
+	batch.body_aabbs = body_aabbs.ptr();
+	batch.query_aabbs = query_aabbs.ptr();
+	batch.candidates = candidates.ptr();
+	batch.candidate_offsets = candidate_offsets.ptr();
+
+	if (p_count >= MOTION_BATCH_PARALLEL_MIN_QUERIES) {
+		PhysicsServerSW::singleton->thread_pool.do_work(p_count, this, &SpaceSW::_test_body_motion_batch_process, &batch);
+	} else {
+		for (int i = 0; i < p_count; i++) {
+			_test_body_motion_batch_process(i, &batch);
+		}
+	}
+
+	int collided_count = 0;
+
+	for (int i = 0; i < p_count; i++) {
+
+		if (status[i] == MOTION_TEST_OUT_OF_BOUNDS) {
+			const BodyMotion &m = p_motions[i];
+			r_collided[i] = test_body_motion(m.body, m.from, m.motion, m.infinite_inertia, m.margin, &r_results[i], m.exclude_raycast_shapes);
+		} else {
+			r_collided[i] = status[i] == MOTION_TEST_COLLIDED;
+		}
+
+		if (r_collided[i]) {
+			collided_count++;
+		}
+	}
+
+	return collided_count;
 }
 
 void *SpaceSW::_broadphase_pair(CollisionObjectSW *A, int p_subindex_A, CollisionObjectSW *B, int p_subindex_B, void *p_self) {
@@ -1207,6 +1633,7 @@ SpaceSW::SpaceSW() {
 
 	collision_pairs = 0;
 	active_objects = 0;
+	sleeping_objects = 0;
 	island_count = 0;
 	contact_debug_count = 0;
 
@@ -45,12 +45,51 @@ class PhysicsDirectSpaceStateSW : public PhysicsDirectSpaceState {
 
 	GDCLASS(PhysicsDirectSpaceStateSW, PhysicsDirectSpaceState);
 
+	enum {
+		BATCH_PARALLEL_MIN_QUERIES = 64
+	};
+
+	struct BatchCandidate {
+
+		const CollisionObjectSW *object;
+		int shape;
+		real_t entry; // Projection along the ray where its AABB is entered, used to stop early.
+
+		bool operator<(const BatchCandidate &p_other) const { return entry < p_other.entry; }
+	};
+
+	struct RayBatch {
+
+		const RayQuery *queries;
+		RayResult *results;
+		bool *hits;
+		BatchCandidate *candidates;
+		const int *candidate_offsets;
+	};
+
+	struct ShapeBatch {
+
+		const ShapeQuery *queries;
+		const ShapeSW *const *shapes;
+		real_t margin;
+		ShapeResult *results;
+		int result_max;
+		int *result_counts;
+		const BatchCandidate *candidates;
+		const int *candidate_offsets;
+	};
+
+	void _intersect_ray_batch_process(uint32_t p_index, RayBatch *p_batch);
+	void _intersect_shape_batch_process(uint32_t p_index, ShapeBatch *p_batch);
+
 public:
 	SpaceSW *space;
 
 	virtual int intersect_point(const Vector3 &p_point, ShapeResult *r_results, int p_result_max, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
 	virtual bool intersect_ray(const Vector3 &p_from, const Vector3 &p_to, RayResult &r_result, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false, bool p_pick_ray = false);
+	virtual int intersect_rays_batch(const RayQuery *p_queries, int p_query_count, RayResult *r_results, bool *r_hits, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
 	virtual int intersect_shape(const RID &p_shape, const Transform &p_xform, real_t p_margin, ShapeResult *r_results, int p_result_max, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
+	virtual int intersect_shapes_batch(const ShapeQuery *p_queries, int p_query_count, real_t p_margin, ShapeResult *r_results, int p_result_max, int *r_result_counts, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
 	virtual bool cast_motion(const RID &p_shape, const Transform &p_xform, const Vector3 &p_motion, real_t p_margin, real_t &p_closest_safe, real_t &p_closest_unsafe, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false, ShapeRestInfo *r_info = NULL);
 	virtual bool collide_shape(RID p_shape, const Transform &p_shape_xform, real_t p_margin, Vector3 *r_results, int p_result_max, int &r_result_count, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
 	virtual bool rest_info(RID p_shape, const Transform &p_shape_xform, real_t p_margin, ShapeRestInfo *r_info, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
@@ -65,6 +104,7 @@ public:
 	enum ElapsedTime {
 		ELAPSED_TIME_INTEGRATE_FORCES,
 		ELAPSED_TIME_GENERATE_ISLANDS,
+		ELAPSED_TIME_NARROW_PHASE,
 		ELAPSED_TIME_SETUP_CONSTRAINTS,
 		ELAPSED_TIME_SOLVE_CONSTRAINTS,
 		ELAPSED_TIME_INTEGRATE_VELOCITIES,
@@ -115,6 +155,7 @@ private:
 
 	int island_count;
 	int active_objects;
+	int sleeping_objects;
 	int collision_pairs;
 
 	RID static_global_body;
@@ -124,7 +165,58 @@ private:
 
 	friend class PhysicsDirectSpaceStateSW;
 
-	int _cull_aabb_for_body(BodySW *p_body, const AABB &p_aabb);
+	int _cull_aabb_for_body(BodySW *p_body, const AABB &p_aabb, bool *r_full = NULL);
+
+	enum {
+		MOTION_BATCH_PARALLEL_MIN_QUERIES = 8
+	};
+
+	// Shapes near a body, culled once for all the stages of a motion test.
+	struct MotionCandidate {
+
+		const CollisionObjectSW *object;
+		int shape;
+		AABB aabb;
+		Transform xform;
+	};
+
+	enum MotionTestResult {
+		MOTION_TEST_FREE,
+		MOTION_TEST_COLLIDED,
+		MOTION_TEST_OUT_OF_BOUNDS, // recovery moved the body outside the culled area
+	};
+
+public:
+	struct BodyMotion {
+
+		BodySW *body;
+		Transform from;
+		Vector3 motion;
+		bool infinite_inertia;
+		real_t margin;
+		bool exclude_raycast_shapes;
+	};
+
+private:
+	struct BodyMotionBatch {
+
+		const BodyMotion *motions;
+		PhysicsServer::MotionResult *results;
+		MotionTestResult *status;
+		const bool *has_shapes;
+		const AABB *body_aabbs;
+		const AABB *query_aabbs;
+		const MotionCandidate *candidates;
+		const int *candidate_offsets;
+	};
+
+	Vector<MotionCandidate> motion_candidates;
+
+	bool _get_body_motion_aabb(BodySW *p_body, const Transform &p_from, real_t p_margin, AABB &r_aabb) const;
+	AABB _get_motion_query_aabb(const AABB &p_body_aabb, const Vector3 &p_motion) const;
+	int _cull_motion_candidates(BodySW *p_body, const AABB &p_aabb, Vector<MotionCandidate> &r_candidates, bool &r_full);
+	MotionTestResult _test_body_motion_candidates(BodySW *p_body, const Transform &p_from, const Vector3 &p_motion, real_t p_margin, PhysicsServer::MotionResult *r_result, bool p_exclude_raycast_shapes, const AABB &p_body_aabb, const MotionCandidate *p_candidates, int p_candidate_count, const AABB &p_candidates_aabb, AABB &r_required_aabb) const;
+	void _test_body_motion_batch_process(uint32_t p_index, BodyMotionBatch *p_batch);
 
 public:
 	_FORCE_INLINE_ void set_self(const RID &p_self) { self = p_self; }
@@ -180,6 +272,9 @@ public:
 	void set_active_objects(int p_active_objects) { active_objects = p_active_objects; }
 	int get_active_objects() const { return active_objects; }
 
+	void add_sleeping_objects(int p_amount) { sleeping_objects += p_amount; }
+	int get_sleeping_objects() const { return sleeping_objects; }
+
 	int get_collision_pairs() const { return collision_pairs; }
 
 	PhysicsDirectSpaceStateSW *get_direct_state();
@@ -200,6 +295,7 @@ public:
 
 	int test_body_ray_separation(BodySW *p_body, const Transform &p_transform, bool p_infinite_inertia, Vector3 &r_recover_motion, PhysicsServer::SeparationResult *r_results, int p_result_max, real_t p_margin);
 	bool test_body_motion(BodySW *p_body, const Transform &p_from, const Vector3 &p_motion, bool p_infinite_inertia, real_t p_margin, PhysicsServer::MotionResult *r_result, bool p_exclude_raycast_shapes);
+	int test_body_motion_batch(const BodyMotion *p_motions, int p_count, PhysicsServer::MotionResult *r_results, bool *r_collided);
 
 	SpaceSW();
 	~SpaceSW();
@@ -30,6 +30,7 @@
 
 #include "step_sw.h"
 #include "joints_sw.h"
+#include "physics_server_sw.h"
 
 #include "core/os/os.h"
 
@@ -54,11 +55,18 @@ void StepSW::_populate_island(BodySW *p_body, BodySW **p_island, ConstraintSW **
 			BodySW *b = c->get_body_ptr()[i];
 			if (b->get_island_step() == _step || b->get_mode() == PhysicsServer::BODY_MODE_STATIC || b->get_mode() == PhysicsServer::BODY_MODE_KINEMATIC)
 				continue; //no go
+			if (!b->is_active() && !c->links_bodies())
+				continue; //sleeping and not touched, leave its island asleep
 			_populate_island(c->get_body_ptr()[i], p_island, p_constraint_island);
 		}
 	}
 }
 
+void StepSW::_collide_constraint(uint32_t p_index, real_t p_delta) {
+
+	all_constraints[p_index]->collide(p_delta);
+}
+
 void StepSW::_setup_island(ConstraintSW *p_island, real_t p_delta) {
 
 	ConstraintSW *ci = p_island;
@@ -228,6 +236,33 @@ void StepSW::step(SpaceSW *p_space, real_t p_delta, int p_iterations) {
 		profile_begtime = profile_endtime;
 	}
 
+	/* NARROW PHASE */
+
+	{
+		// Flatten the islands so the collision tests can be split between threads.
+		int constraint_count = 0;
+		ConstraintSW *ci = constraint_island_list;
+		while (ci) {
+			ConstraintSW *c = ci;
+			while (c) {
+				if (constraint_count >= all_constraints.size()) {
+					all_constraints.resize(MAX(constraint_count * 2, 64));
+				}
+				all_constraints.write[constraint_count++] = c;
+				c = c->get_island_next();
+			}
+			ci = ci->get_island_list_next();
+		}
+
+		PhysicsServerSW::singleton->thread_pool.do_work(constraint_count, this, &StepSW::_collide_constraint, p_delta);
+	}
+
+	{ //profile
+		profile_endtime = OS::get_singleton()->get_ticks_usec();
+		p_space->set_elapsed_time(SpaceSW::ELAPSED_TIME_NARROW_PHASE, profile_endtime - profile_begtime);
+		profile_begtime = profile_endtime;
+	}
+
 	/* SETUP CONSTRAINT ISLANDS */
 
 	{
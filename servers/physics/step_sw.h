@@ -37,6 +37,9 @@ class StepSW {
 
 	uint64_t _step;
 
+	Vector<ConstraintSW *> all_constraints;
+
+	void _collide_constraint(uint32_t p_index, real_t p_delta);
 	void _populate_island(BodySW *p_body, BodySW **p_island, ConstraintSW **p_constraint_island);
 	void _setup_island(ConstraintSW *p_island, real_t p_delta);
 	void _solve_island(ConstraintSW *p_island, int p_iterations, real_t p_delta);
@@ -64,25 +64,36 @@ void BodyPair2DSW::_contact_added_callback(const Vector2 &p_point_A, const Vecto
 	contact.normal = (p_point_A - p_point_B).normalized();
 	contact.mass_normal = 0; // will be computed in setup()
 
-	// attempt to determine if the contact will be reused
+	// attempt to determine if the contact will be reused, pick the closest match
 
 	real_t recycle_radius_2 = space->get_contact_recycle_radius() * space->get_contact_recycle_radius();
+	real_t min_distance = 1e20;
 
 	for (int i = 0; i < contact_count; i++) {
 
 		Contact &c = contacts[i];
-		if (
-				c.local_A.distance_squared_to(local_A) < (recycle_radius_2) &&
-				c.local_B.distance_squared_to(local_B) < (recycle_radius_2)) {
+		real_t distance_A = c.local_A.distance_squared_to(local_A);
+		real_t distance_B = c.local_B.distance_squared_to(local_B);
 
-			contact.acc_normal_impulse = c.acc_normal_impulse;
-			contact.acc_tangent_impulse = c.acc_tangent_impulse;
-			contact.acc_bias_impulse = c.acc_bias_impulse;
+		if (distance_A < recycle_radius_2 && distance_B < recycle_radius_2 && distance_A + distance_B < min_distance) {
+
+			min_distance = distance_A + distance_B;
 			new_index = i;
-			break;
 		}
 	}
 
+	if (new_index < contact_count) {
+
+		// Warm start with the previous impulse, re-projected on the new contact frame
+		// in case the normal rotated since the last step.
+		const Contact &c = contacts[new_index];
+		Vector2 impulse = c.normal * c.acc_normal_impulse + c.normal.tangent() * c.acc_tangent_impulse;
+
+		contact.acc_normal_impulse = MAX(impulse.dot(contact.normal), 0.0f);
+		contact.acc_tangent_impulse = impulse.dot(contact.normal.tangent());
+		contact.acc_bias_impulse = c.acc_bias_impulse;
+	}
+
 	// figure out if the contact amount must be reduced to fit the new contact
 
 	if (new_index == MAX_CONTACTS) {
@@ -168,6 +179,62 @@ void BodyPair2DSW::_validate_contacts() {
 	}
 }
 
+static _FORCE_INLINE_ real_t _get_max_displacement(const Shape2DSW *p_shape, const Transform2D &p_from, const Transform2D &p_to) {
+
+	// Upper bound of how far any point of the shape moved between both transforms.
+	Rect2 aabb = p_shape->get_aabb();
+	Vector2 extents(MAX(Math::abs(aabb.position.x), Math::abs(aabb.position.x + aabb.size.x)), MAX(Math::abs(aabb.position.y), Math::abs(aabb.position.y + aabb.size.y)));
+
+	real_t basis_delta = Math::sqrt((p_to.elements[0] - p_from.elements[0]).length_squared() + (p_to.elements[1] - p_from.elements[1]).length_squared());
+	return (p_to.elements[2] - p_from.elements[2]).length() + basis_delta * extents.length();
+}
+
+bool BodyPair2DSW::_test_separation_cache(const Shape2DSW *p_shape_A, const Transform2D &p_xform_A, const Shape2DSW *p_shape_B, const Transform2D &p_xform_B) const {
+
+	const SeparationCache &sc = separation_cache;
+
+	if (!sc.valid || sc.shape_A != p_shape_A || sc.shape_B != p_shape_B || sc.version_A != p_shape_A->get_version() || sc.version_B != p_shape_B->get_version()) {
+		return false;
+	}
+
+	return _get_max_displacement(p_shape_A, sc.xform_A, p_xform_A) + _get_max_displacement(p_shape_B, sc.xform_B, p_xform_B) < sc.gap;
+}
+
+void BodyPair2DSW::_update_separation_cache(const Shape2DSW *p_shape_A, const Transform2D &p_xform_A, const Shape2DSW *p_shape_B, const Transform2D &p_xform_B) {
+
+	separation_cache.valid = false;
+
+	// Only convex shapes report a separating axis valid for the whole pair.
+	if (p_shape_A->is_concave() || p_shape_B->is_concave() || sep_axis == Vector2()) {
+		return;
+	}
+
+	Physics2DServer::ShapeType type_A = p_shape_A->get_type();
+	Physics2DServer::ShapeType type_B = p_shape_B->get_type();
+	if (type_A == Physics2DServer::SHAPE_LINE || type_A == Physics2DServer::SHAPE_RAY || type_B == Physics2DServer::SHAPE_LINE || type_B == Physics2DServer::SHAPE_RAY) {
+		return;
+	}
+
+	Vector2 axis = sep_axis.normalized();
+	real_t min_A, max_A, min_B, max_B;
+	p_shape_A->project_rangev(axis, p_xform_A, min_A, max_A);
+	p_shape_B->project_rangev(axis, p_xform_B, min_B, max_B);
+
+	real_t gap = MAX(min_B - max_A, min_A - max_B);
+	if (gap <= CMP_EPSILON) {
+		return;
+	}
+
+	separation_cache.valid = true;
+	separation_cache.shape_A = p_shape_A;
+	separation_cache.shape_B = p_shape_B;
+	separation_cache.version_A = p_shape_A->get_version();
+	separation_cache.version_B = p_shape_B->get_version();
+	separation_cache.xform_A = p_xform_A;
+	separation_cache.xform_B = p_xform_B;
+	separation_cache.gap = gap;
+}
+
 bool BodyPair2DSW::_test_ccd(real_t p_step, Body2DSW *p_A, int p_shape_A, const Transform2D &p_xform_A, Body2DSW *p_B, int p_shape_B, const Transform2D &p_xform_B, bool p_swap_result) {
 
 	Vector2 motion = p_A->get_linear_velocity() * p_step;
@@ -268,7 +335,23 @@ bool BodyPair2DSW::setup(real_t p_step) {
 
 	//bool prev_collided=collided;
 
+	bool use_ccd = A->get_continuous_collision_detection_mode() != Physics2DServer::CCD_MODE_DISABLED || B->get_continuous_collision_detection_mode() != Physics2DServer::CCD_MODE_DISABLED;
+
+	if (!use_ccd && _test_separation_cache(shape_A_ptr, xform_A, shape_B_ptr, xform_B)) {
+		// still apart, skip the narrow phase
+		collided = false;
+		oneway_disabled = false;
+		return false;
+	}
+
 	collided = CollisionSolver2DSW::solve(shape_A_ptr, xform_A, motion_A, shape_B_ptr, xform_B, motion_B, _add_contact, this, &sep_axis);
+
+	if (!collided && !use_ccd) {
+		_update_separation_cache(shape_A_ptr, xform_A, shape_B_ptr, xform_B);
+	} else {
+		separation_cache.valid = false;
+	}
+
 	if (!collided) {
 
 		//test ccd (currently just a raycast)
@@ -523,6 +606,7 @@ BodyPair2DSW::BodyPair2DSW(Body2DSW *p_A, int p_shape_A, Body2DSW *p_B, int p_sh
 	contact_count = 0;
 	collided = false;
 	oneway_disabled = false;
+	separation_cache.valid = false;
 }
 
 BodyPair2DSW::~BodyPair2DSW() {
@@ -74,6 +74,23 @@ class BodyPair2DSW : public Constraint2DSW {
 	Vector2 offset_B; //use local A coordinates to avoid numerical issues on collision detection
 
 	Vector2 sep_axis;
+
+	// Gap along sep_axis the last time the narrow phase found the shapes apart,
+	// used to skip it while they have not moved enough to close that gap.
+	struct SeparationCache {
+
+		bool valid;
+		const Shape2DSW *shape_A;
+		const Shape2DSW *shape_B;
+		uint32_t version_A;
+		uint32_t version_B;
+		Transform2D xform_A;
+		Transform2D xform_B;
+		real_t gap;
+	};
+
+	SeparationCache separation_cache;
+
 	Contact contacts[MAX_CONTACTS];
 	int contact_count;
 	bool collided;
@@ -82,6 +99,8 @@ class BodyPair2DSW : public Constraint2DSW {
 
 	bool _test_ccd(real_t p_step, Body2DSW *p_A, int p_shape_A, const Transform2D &p_xform_A, Body2DSW *p_B, int p_shape_B, const Transform2D &p_xform_B, bool p_swap_result = false);
 	void _validate_contacts();
+	bool _test_separation_cache(const Shape2DSW *p_shape_A, const Transform2D &p_xform_A, const Shape2DSW *p_shape_B, const Transform2D &p_xform_B) const;
+	void _update_separation_cache(const Shape2DSW *p_shape_A, const Transform2D &p_xform_A, const Shape2DSW *p_shape_B, const Transform2D &p_xform_B);
 	static void _add_contact(const Vector2 &p_point_A, const Vector2 &p_point_B, void *p_self);
 	_FORCE_INLINE_ void _contact_added_callback(const Vector2 &p_point_A, const Vector2 &p_point_B);
 
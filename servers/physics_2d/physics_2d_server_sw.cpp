@@ -731,7 +731,7 @@ void Physics2DServerSW::body_set_shape_disabled(RID p_body, int p_shape_idx, boo
 
 	body->set_shape_as_disabled(p_shape_idx, p_disabled);
 }
-void Physics2DServerSW::body_set_shape_as_one_way_collision(RID p_body, int p_shape_idx, bool p_enable, float p_margin) {
+void Physics2DServerSW::body_set_shape_as_one_way_collision(RID p_body, int p_shape_idx, bool p_enable, real_t p_margin) {
 
 	Body2DSW *body = body_owner.get(p_body);
 	ERR_FAIL_COND(!body);
@@ -1056,7 +1056,49 @@ bool Physics2DServerSW::body_test_motion(RID p_body, const Transform2D &p_from,
 	return body->get_space()->test_body_motion(body, p_from, p_motion, p_infinite_inertia, p_margin, r_result, p_exclude_raycast_shapes);
 }
 
-int Physics2DServerSW::body_test_ray_separation(RID p_body, const Transform2D &p_transform, bool p_infinite_inertia, Vector2 &r_recover_motion, SeparationResult *r_results, int p_result_max, float p_margin) {
+int Physics2DServerSW::body_test_motion_batch(const MotionQuery *p_queries, int p_query_count, MotionResult *r_results, bool *r_collided) {
+
+	Vector<Space2DSW::BodyMotion> motions;
+	motions.resize(p_query_count);
+
+	// All the queries are checked first, so an invalid one doesn't leave partial results.
+	for (int i = 0; i < p_query_count; i++) {
+
+		Body2DSW *body = body_owner.get(p_queries[i].body);
+		ERR_FAIL_COND_V(!body, 0);
+		ERR_FAIL_COND_V(!body->get_space(), 0);
+		ERR_FAIL_COND_V(body->get_space()->is_locked(), 0);
+
+		Space2DSW::BodyMotion &m = motions.write[i];
+		m.body = body;
+		m.from = p_queries[i].from;
+		m.motion = p_queries[i].motion;
+		m.infinite_inertia = p_queries[i].infinite_inertia;
+		m.margin = p_queries[i].margin;
+		m.exclude_raycast_shapes = p_queries[i].exclude_raycast_shapes;
+	}
+
+	_update_shapes();
+
+	int collided_count = 0;
+	int begin = 0;
+
+	// Consecutive queries in the same space are tested together.
+	for (int i = 1; i <= p_query_count; i++) {
+
+		Space2DSW *space = motions[begin].body->get_space();
+		if (i < p_query_count && motions[i].body->get_space() == space) {
+			continue;
+		}
+
+		collided_count += space->test_body_motion_batch(&motions[begin], i - begin, &r_results[begin], &r_collided[begin]);
+		begin = i;
+	}
+
+	return collided_count;
+}
+
+int Physics2DServerSW::body_test_ray_separation(RID p_body, const Transform2D &p_transform, bool p_infinite_inertia, Vector2 &r_recover_motion, SeparationResult *r_results, int p_result_max, real_t p_margin) {
 
 	Body2DSW *body = body_owner.get(p_body);
 	ERR_FAIL_COND_V(!body, false);
@@ -1322,6 +1364,7 @@ void Physics2DServerSW::init() {
 	iterations = 8; // 8?
 	stepper = memnew(Step2DSW);
 	direct_state = memnew(Physics2DDirectBodyStateSW);
+	thread_pool.init();
 };
 
 void Physics2DServerSW::step(real_t p_step) {
@@ -1410,6 +1453,7 @@ void Physics2DServerSW::end_sync() {
 
 void Physics2DServerSW::finish() {
 
+	thread_pool.finish();
 	memdelete(stepper);
 	memdelete(direct_state);
 };
@@ -36,6 +36,7 @@
 void Shape2DSW::configure(const Rect2 &p_aabb) {
 	aabb = p_aabb;
 	configured = true;
+	version++;
 	for (Map<ShapeOwner2DSW *, int>::Element *E = owners.front(); E; E = E->next()) {
 		ShapeOwner2DSW *co = (ShapeOwner2DSW *)E->key();
 		co->_shape_changed();
@@ -83,6 +84,7 @@ Shape2DSW::Shape2DSW() {
 
 	custom_bias = 0;
 	configured = false;
+	version = 0;
 }
 
 Shape2DSW::~Shape2DSW() {
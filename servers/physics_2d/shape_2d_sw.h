@@ -62,6 +62,7 @@ class Shape2DSW : public RID_Data {
 	Rect2 aabb;
 	bool configured;
 	real_t custom_bias;
+	uint32_t version;
 
 	Map<ShapeOwner2DSW *, int> owners;
 
@@ -76,6 +77,7 @@ public:
 
 	_FORCE_INLINE_ Rect2 get_aabb() const { return aabb; }
 	_FORCE_INLINE_ bool is_configured() const { return configured; }
+	_FORCE_INLINE_ uint32_t get_version() const { return version; } // changes every time the shape data is set
 
 	virtual bool is_concave() const { return false; }
 
@@ -33,6 +33,7 @@
 #include "collision_solver_2d_sw.h"
 #include "core/os/os.h"
 #include "core/pair.h"
+#include "core/sort_array.h"
 #include "physics_2d_server_sw.h"
 _FORCE_INLINE_ static bool _can_collide_with(CollisionObject2DSW *p_object, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
 
@@ -49,6 +50,38 @@ _FORCE_INLINE_ static bool _can_collide_with(CollisionObject2DSW *p_object, uint
 	return true;
 }
 
+// Intersects a segment with a shape of an object, updating the closest result
+// if the hit is closer along p_normal than r_min_d.
+_FORCE_INLINE_ static bool _intersect_ray_shape(const CollisionObject2DSW *p_object, int p_shape_idx, const Vector2 &p_begin, const Vector2 &p_end, const Vector2 &p_normal, real_t &r_min_d, Vector2 &r_point, Vector2 &r_normal) {
+
+	Transform2D inv_xform = p_object->get_shape_inv_transform(p_shape_idx) * p_object->get_inv_transform();
+
+	Vector2 local_from = inv_xform.xform(p_begin);
+	Vector2 local_to = inv_xform.xform(p_end);
+
+	const Shape2DSW *shape = p_object->get_shape(p_shape_idx);
+
+	Vector2 shape_point, shape_normal;
+
+	if (!shape->intersect_segment(local_from, local_to, shape_point, shape_normal)) {
+		return false;
+	}
+
+	Transform2D xform = p_object->get_transform() * p_object->get_shape_transform(p_shape_idx);
+	shape_point = xform.xform(shape_point);
+
+	real_t ld = p_normal.dot(shape_point);
+
+	if (ld >= r_min_d) {
+		return false;
+	}
+
+	r_min_d = ld;
+	r_point = shape_point;
+	r_normal = inv_xform.basis_xform_inv(shape_normal).normalized();
+	return true;
+}
+
 int Physics2DDirectSpaceStateSW::_intersect_point_impl(const Vector2 &p_point, ShapeResult *r_results, int p_result_max, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas, bool p_pick_point, bool p_filter_by_canvas, ObjectID p_canvas_instance_id) {
 
 	if (p_result_max <= 0)
@@ -142,45 +175,69 @@ bool Physics2DDirectSpaceStateSW::intersect_ray(const Vector2 &p_from, const Vec
 			continue;
 
 		const CollisionObject2DSW *col_obj = space->intersection_query_results[i];
-
 		int shape_idx = space->intersection_query_subindex_results[i];
-		Transform2D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
-		Vector2 local_from = inv_xform.xform(begin);
-		Vector2 local_to = inv_xform.xform(end);
+		if (_intersect_ray_shape(col_obj, shape_idx, begin, end, normal, min_d, res_point, res_normal)) {
+
+			res_shape = shape_idx;
+			res_obj = col_obj;
+			collided = true;
+		}
+	}
+
+	if (!collided)
+		return false;
+
+	r_result.collider_id = res_obj->get_instance_id();
+	if (r_result.collider_id != 0)
+		r_result.collider = ObjectDB::get_instance(r_result.collider_id);
+	r_result.normal = res_normal;
+	r_result.metadata = res_obj->get_shape_metadata(res_shape);
+	r_result.position = res_point;
+	r_result.rid = res_obj->get_self();
+	r_result.shape = res_shape;
+
+	return true;
+}
 
-		/*local_from = col_obj->get_inv_transform().xform(begin);
-		local_from = col_obj->get_shape_inv_transform(shape_idx).xform(local_from);
+void Physics2DDirectSpaceStateSW::_intersect_ray_batch_process(uint32_t p_index, RayBatch *p_batch) {
 
-		local_to = col_obj->get_inv_transform().xform(end);
-		local_to = col_obj->get_shape_inv_transform(shape_idx).xform(local_to);*/
+	const RayQuery &query = p_batch->queries[p_index];
+	Vector2 normal = (query.to - query.from).normalized();
 
-		const Shape2DSW *shape = col_obj->get_shape(shape_idx);
+	BatchCandidate *candidates = &p_batch->candidates[p_batch->candidate_offsets[p_index]];
+	int candidate_count = p_batch->candidate_offsets[p_index + 1] - p_batch->candidate_offsets[p_index];
 
-		Vector2 shape_point, shape_normal;
+	// Visit candidates from the nearest AABB, so farther ones can be skipped once something was hit.
+	SortArray<BatchCandidate> sorter;
+	sorter.sort(candidates, candidate_count);
 
-		if (shape->intersect_segment(local_from, local_to, shape_point, shape_normal)) {
+	bool collided = false;
+	Vector2 res_point, res_normal;
+	int res_shape = 0;
+	const CollisionObject2DSW *res_obj = NULL;
+	real_t min_d = 1e10;
 
-			Transform2D xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
-			shape_point = xform.xform(shape_point);
+	for (int i = 0; i < candidate_count; i++) {
 
-			real_t ld = normal.dot(shape_point);
+		if (candidates[i].entry >= min_d) {
+			break;
+		}
 
-			if (ld < min_d) {
+		if (_intersect_ray_shape(candidates[i].object, candidates[i].shape, query.from, query.to, normal, min_d, res_point, res_normal)) {
 
-				min_d = ld;
-				res_point = shape_point;
-				res_normal = inv_xform.basis_xform_inv(shape_normal).normalized();
-				res_shape = shape_idx;
-				res_obj = col_obj;
-				collided = true;
-			}
+			res_shape = candidates[i].shape;
+			res_obj = candidates[i].object;
+			collided = true;
 		}
 	}
 
-	if (!collided)
-		return false;
+	p_batch->hits[p_index] = collided;
+	if (!collided) {
+		return;
+	}
 
+	RayResult &r_result = p_batch->results[p_index];
 	r_result.collider_id = res_obj->get_instance_id();
 	if (r_result.collider_id != 0)
 		r_result.collider = ObjectDB::get_instance(r_result.collider_id);
@@ -189,8 +246,85 @@ bool Physics2DDirectSpaceStateSW::intersect_ray(const Vector2 &p_from, const Vec
 	r_result.position = res_point;
 	r_result.rid = res_obj->get_self();
 	r_result.shape = res_shape;
+}
 
-	return true;
+int Physics2DDirectSpaceStateSW::intersect_rays_batch(const RayQuery *p_queries, int p_query_count, RayResult *r_results, bool *r_hits, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
+
+	ERR_FAIL_COND_V(space->locked, 0);
+
+	// The broadphase keeps internal state while culling, so the candidates of
+	// every ray are gathered here first. The narrow phase only reads shapes and
+	// transforms, so it can then run in parallel over this snapshot.
+	Vector<BatchCandidate> candidates;
+	Vector<int> candidate_offsets;
+	candidate_offsets.resize(p_query_count + 1);
+
+	for (int i = 0; i < p_query_count; i++) {
+
+		candidate_offsets.write[i] = candidates.size();
+
+		const Vector2 &begin = p_queries[i].from;
+		const Vector2 &end = p_queries[i].to;
+		Vector2 dir = end - begin;
+		real_t begin_d = dir.normalized().dot(begin);
+		real_t length = dir.length();
+
+		int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, Space2DSW::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+
+		for (int j = 0; j < amount; j++) {
+
+			const CollisionObject2DSW *col_obj = space->intersection_query_results[j];
+
+			if (!_can_collide_with(space->intersection_query_results[j], p_collision_mask, p_collide_with_bodies, p_collide_with_areas))
+				continue;
+
+			if (p_exclude.has(col_obj->get_self()))
+				continue;
+
+			BatchCandidate candidate;
+			candidate.object = col_obj;
+			candidate.shape = space->intersection_query_subindex_results[j];
+
+			// Slab test for the point where the ray enters the shape AABB.
+			const Rect2 &aabb = col_obj->get_shape_aabb(candidate.shape);
+			real_t t_enter = 0;
+			for (int k = 0; k < 2; k++) {
+				if (dir[k] != 0) {
+					real_t t0 = (aabb.position[k] - begin[k]) / dir[k];
+					real_t t1 = (aabb.position[k] + aabb.size[k] - begin[k]) / dir[k];
+					t_enter = MAX(t_enter, MIN(t0, t1));
+				}
+			}
+			candidate.entry = begin_d + MIN(t_enter, (real_t)1.0) * length;
+
+			candidates.push_back(candidate);
+		}
+	}
+	candidate_offsets.write[p_query_count] = candidates.size();
+
+	RayBatch batch;
+	batch.queries = p_queries;
+	batch.results = r_results;
+	batch.hits = r_hits;
+	batch.candidates = candidates.ptrw();
+	batch.candidate_offsets = candidate_offsets.ptr();
+
+	if (p_query_count >= BATCH_PARALLEL_MIN_QUERIES) {
+		Physics2DServerSW::singletonsw->thread_pool.do_work(p_query_count, this, &Physics2DDirectSpaceStateSW::_intersect_ray_batch_process, &batch);
+	} else {
+		for (int i = 0; i < p_query_count; i++) {
+			_intersect_ray_batch_process(i, &batch);
+		}
+	}
+
+	int hit_count = 0;
+	for (int i = 0; i < p_query_count; i++) {
+		if (r_hits[i]) {
+			hit_count++;
+		}
+	}
+
+	return hit_count;
 }
 
 int Physics2DDirectSpaceStateSW::intersect_shape(const RID &p_shape, const Transform2D &p_xform, const Vector2 &p_motion, real_t p_margin, ShapeResult *r_results, int p_result_max, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
@@ -238,6 +372,108 @@ int Physics2DDirectSpaceStateSW::intersect_shape(const RID &p_shape, const Trans
 	return cc;
 }
 
+void Physics2DDirectSpaceStateSW::_intersect_shape_batch_process(uint32_t p_index, ShapeBatch *p_batch) {
+
+	const ShapeQuery &query = p_batch->queries[p_index];
+	const Shape2DSW *shape = p_batch->shapes[p_index];
+	ShapeResult *results = &p_batch->results[p_index * p_batch->result_max];
+
+	int cc = 0;
+
+	for (int i = p_batch->candidate_offsets[p_index]; i < p_batch->candidate_offsets[p_index + 1]; i++) {
+
+		if (cc >= p_batch->result_max)
+			break;
+
+		const CollisionObject2DSW *col_obj = p_batch->candidates[i].object;
+		int shape_idx = p_batch->candidates[i].shape;
+
+		if (!CollisionSolver2DSW::solve(shape, query.xform, query.motion, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), Vector2(), NULL, NULL, NULL, p_batch->margin))
+			continue;
+
+		results[cc].collider_id = col_obj->get_instance_id();
+		if (results[cc].collider_id != 0)
+			results[cc].collider = ObjectDB::get_instance(results[cc].collider_id);
+		results[cc].rid = col_obj->get_self();
+		results[cc].shape = shape_idx;
+		results[cc].metadata = col_obj->get_shape_metadata(shape_idx);
+
+		cc++;
+	}
+
+	p_batch->result_counts[p_index] = cc;
+}
+
+int Physics2DDirectSpaceStateSW::intersect_shapes_batch(const ShapeQuery *p_queries, int p_query_count, real_t p_margin, ShapeResult *r_results, int p_result_max, int *r_result_counts, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
+
+	ERR_FAIL_COND_V(space->locked, 0);
+
+	// Gather candidates serially, as in intersect_rays_batch().
+	Vector<const Shape2DSW *> shapes;
+	shapes.resize(p_query_count);
+	Vector<BatchCandidate> candidates;
+	Vector<int> candidate_offsets;
+	candidate_offsets.resize(p_query_count + 1);
+
+	for (int i = 0; i < p_query_count; i++) {
+
+		candidate_offsets.write[i] = candidates.size();
+
+		const Shape2DSW *shape = Physics2DServerSW::singletonsw->shape_owner.get(p_queries[i].shape);
+		shapes.write[i] = shape;
+		if (!shape || p_result_max <= 0) {
+			ERR_CONTINUE(!shape);
+			continue;
+		}
+
+		Rect2 aabb = p_queries[i].xform.xform(shape->get_aabb());
+		aabb = aabb.grow(p_margin);
+
+		int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, Space2DSW::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+
+		for (int j = 0; j < amount; j++) {
+
+			if (!_can_collide_with(space->intersection_query_results[j], p_collision_mask, p_collide_with_bodies, p_collide_with_areas))
+				continue;
+
+			if (p_exclude.has(space->intersection_query_results[j]->get_self()))
+				continue;
+
+			BatchCandidate candidate;
+			candidate.object = space->intersection_query_results[j];
+			candidate.shape = space->intersection_query_subindex_results[j];
+			candidate.entry = 0;
+			candidates.push_back(candidate);
+		}
+	}
+	candidate_offsets.write[p_query_count] = candidates.size();
+
+	ShapeBatch batch;
+	batch.queries = p_queries;
+	batch.shapes = shapes.ptr();
+	batch.margin = p_margin;
+	batch.results = r_results;
+	batch.result_max = p_result_max;
+	batch.result_counts = r_result_counts;
+	batch.candidates = candidates.ptr();
+	batch.candidate_offsets = candidate_offsets.ptr();
+
+	if (p_query_count >= BATCH_PARALLEL_MIN_QUERIES) {
+		Physics2DServerSW::singletonsw->thread_pool.do_work(p_query_count, this, &Physics2DDirectSpaceStateSW::_intersect_shape_batch_process, &batch);
+	} else {
+		for (int i = 0; i < p_query_count; i++) {
+			_intersect_shape_batch_process(i, &batch);
+		}
+	}
+
+	int total = 0;
+	for (int i = 0; i < p_query_count; i++) {
+		total += r_result_counts[i];
+	}
+
+	return total;
+}
+
 bool Physics2DDirectSpaceStateSW::cast_motion(const RID &p_shape, const Transform2D &p_xform, const Vector2 &p_motion, real_t p_margin, real_t &p_closest_safe, real_t &p_closest_unsafe, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
 
 	Shape2DSW *shape = Physics2DServerSW::singletonsw->shape_owner.get(p_shape);
@@ -469,10 +705,14 @@ Physics2DDirectSpaceStateSW::Physics2DDirectSpaceStateSW() {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-int Space2DSW::_cull_aabb_for_body(Body2DSW *p_body, const Rect2 &p_aabb) {
+int Space2DSW::_cull_aabb_for_body(Body2DSW *p_body, const Rect2 &p_aabb, bool *r_full) {
 
 	int amount = broadphase->cull_aabb(p_aabb, intersection_query_results, INTERSECTION_QUERY_MAX, intersection_query_subindex_results);
 
+	if (r_full) {
+		*r_full = amount == INTERSECTION_QUERY_MAX;
+	}
+
 	for (int i = 0; i < amount; i++) {
 
 		bool keep = true;
@@ -687,21 +927,9 @@ int Space2DSW::test_body_ray_separation(Body2DSW *p_body, const Transform2D &p_t
 	return rays_found;
 }
 
-bool Space2DSW::test_body_motion(Body2DSW *p_body, const Transform2D &p_from, const Vector2 &p_motion, bool p_infinite_inertia, real_t p_margin, Physics2DServer::MotionResult *r_result, bool p_exclude_raycast_shapes) {
+bool Space2DSW::_get_body_motion_aabb(Body2DSW *p_body, const Transform2D &p_from, real_t p_margin, bool p_exclude_raycast_shapes, Rect2 &r_aabb) const {
 
-	//give me back regular physics engine logic
-	//this is madness
-	//and most people using this function will think
-	//what it does is simpler than using physics
-	//this took about a week to get right..
-	//but is it right? who knows at this point..
-
-	if (r_result) {
-		r_result->collider_id = 0;
-		r_result->collider_shape = 0;
-	}
 	Rect2 body_aabb;
-
 	bool shapes_found = false;
 
 	for (int i = 0; i < p_body->get_shape_count(); i++) {
@@ -721,16 +949,58 @@ bool Space2DSW::test_body_motion(Body2DSW *p_body, const Transform2D &p_from, co
 	}
 
 	if (!shapes_found) {
-		if (r_result) {
-			*r_result = Physics2DServer::MotionResult();
-			r_result->motion = p_motion;
-		}
 		return false;
 	}
 
 	// Undo the currently transform the physics server is aware of and apply the provided one
-	body_aabb = p_from.xform(p_body->get_inv_transform().xform(body_aabb));
-	body_aabb = body_aabb.grow(p_margin);
+	r_aabb = p_from.xform(p_body->get_inv_transform().xform(body_aabb));
+	r_aabb = r_aabb.grow(p_margin);
+	return true;
+}
+
+Rect2 Space2DSW::_get_motion_query_aabb(const Rect2 &p_body_aabb, const Vector2 &p_motion) const {
+
+	// Covers the whole motion, plus some room for the body to be pushed out when stuck.
+	Rect2 query_aabb = p_body_aabb;
+	query_aabb.position += p_motion;
+	query_aabb = query_aabb.merge(p_body_aabb);
+	return query_aabb.grow(MAX(p_body_aabb.size.x, p_body_aabb.size.y) * 0.25);
+}
+
+int Space2DSW::_cull_motion_candidates(Body2DSW *p_body, const Rect2 &p_aabb, Vector<MotionCandidate> &r_candidates, bool &r_full) {
+
+	int amount = _cull_aabb_for_body(p_body, p_aabb, &r_full);
+
+	int from = r_candidates.size();
+	r_candidates.resize(from + amount);
+	MotionCandidate *candidates = r_candidates.ptrw() + from;
+
+	for (int i = 0; i < amount; i++) {
+
+		const CollisionObject2DSW *col_obj = intersection_query_results[i];
+		int shape_idx = intersection_query_subindex_results[i];
+
+		candidates[i].object = col_obj;
+		candidates[i].shape = shape_idx;
+		candidates[i].aabb = col_obj->get_shape_aabb(shape_idx);
+		candidates[i].xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
+	}
+
+	return amount;
+}
+
+Space2DSW::MotionTestResult Space2DSW::_test_body_motion_candidates(Body2DSW *p_body, const Transform2D &p_from, const Vector2 &p_motion, bool p_infinite_inertia, real_t p_margin, Physics2DServer::MotionResult *r_result, bool p_exclude_raycast_shapes, const Rect2 &p_body_aabb, const MotionCandidate *p_candidates, int p_candidate_count, const Rect2 &p_candidates_aabb, Rect2 &r_required_aabb) const {
+
+	//give me back regular physics engine logic
+	//this is madness
+	//and most people using this function will think
+	//what it does is simpler than using physics
+	//this took about a week to get right..
+	//but is it right? who knows at this point..
+
+	// Only touches the candidates it is given, so it is safe to run in parallel.
+
+	Rect2 body_aabb = p_body_aabb;
 
 	static const int max_excluded_shape_pairs = 32;
 	ExcludedShapeSW excluded_shape_pairs[max_excluded_shape_pairs];
@@ -749,6 +1019,11 @@ bool Space2DSW::test_body_motion(Body2DSW *p_body, const Transform2D &p_from, co
 
 		do {
 
+			if (!p_candidates_aabb.encloses(body_aabb)) {
+				r_required_aabb = body_aabb;
+				return MOTION_TEST_OUT_OF_BOUNDS;
+			}
+
 			Physics2DServerSW::CollCbkData cbk;
 			cbk.max = max_results;
 			cbk.amount = 0;
@@ -762,8 +1037,6 @@ bool Space2DSW::test_body_motion(Body2DSW *p_body, const Transform2D &p_from, co
 
 			bool collided = false;
 
-			int amount = _cull_aabb_for_body(p_body, body_aabb);
-
 			for (int j = 0; j < p_body->get_shape_count(); j++) {
 				if (p_body->is_shape_set_as_disabled(j))
 					continue;
@@ -774,10 +1047,14 @@ bool Space2DSW::test_body_motion(Body2DSW *p_body, const Transform2D &p_from, co
 				}
 
 				Transform2D body_shape_xform = body_transform * p_body->get_shape_transform(j);
-				for (int i = 0; i < amount; i++) {
+				for (int i = 0; i < p_candidate_count; i++) {
 
-					const CollisionObject2DSW *col_obj = intersection_query_results[i];
-					int shape_idx = intersection_query_subindex_results[i];
+					const MotionCandidate &candidate = p_candidates[i];
+					if (!candidate.aabb.intersects(body_aabb))
+						continue;
+
+					const CollisionObject2DSW *col_obj = candidate.object;
+					int shape_idx = candidate.shape;
 
 					if (CollisionObject2DSW::TYPE_BODY == col_obj->get_type()) {
 						const Body2DSW *b = static_cast<const Body2DSW *>(col_obj);
@@ -786,7 +1063,7 @@ bool Space2DSW::test_body_motion(Body2DSW *p_body, const Transform2D &p_from, co
 						}
 					}
 
-					Transform2D col_obj_shape_xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
+					const Transform2D &col_obj_shape_xform = candidate.xform;
 
 					if (col_obj->is_shape_set_as_one_way_collision(shape_idx)) {
 
@@ -869,14 +1146,17 @@ bool Space2DSW::test_body_motion(Body2DSW *p_body, const Transform2D &p_from, co
 	real_t unsafe = 1.0;
 	int best_shape = -1;
 
-	{
-		// STEP 2 ATTEMPT MOTION
+	Rect2 motion_aabb = body_aabb;
+	motion_aabb.position += p_motion;
+	motion_aabb = motion_aabb.merge(body_aabb);
 
-		Rect2 motion_aabb = body_aabb;
-		motion_aabb.position += p_motion;
-		motion_aabb = motion_aabb.merge(body_aabb);
+	if (!p_candidates_aabb.encloses(motion_aabb)) {
+		r_required_aabb = motion_aabb;
+		return MOTION_TEST_OUT_OF_BOUNDS;
+	}
 
-		int amount = _cull_aabb_for_body(p_body, motion_aabb);
+	{
+		// STEP 2 ATTEMPT MOTION
 
 		for (int body_shape_idx = 0; body_shape_idx < p_body->get_shape_count(); body_shape_idx++) {
 
@@ -895,10 +1175,14 @@ bool Space2DSW::test_body_motion(Body2DSW *p_body, const Transform2D &p_from, co
 			real_t best_safe = 1;
 			real_t best_unsafe = 1;
 
-			for (int i = 0; i < amount; i++) {
+			for (int i = 0; i < p_candidate_count; i++) {
+
+				const MotionCandidate &candidate = p_candidates[i];
+				if (!candidate.aabb.intersects(motion_aabb))
+					continue;
 
-				const CollisionObject2DSW *col_obj = intersection_query_results[i];
-				int col_shape_idx = intersection_query_subindex_results[i];
+				const CollisionObject2DSW *col_obj = candidate.object;
+				int col_shape_idx = candidate.shape;
 				Shape2DSW *against_shape = col_obj->get_shape(col_shape_idx);
 
 				if (CollisionObject2DSW::TYPE_BODY == col_obj->get_type()) {
@@ -923,7 +1207,7 @@ bool Space2DSW::test_body_motion(Body2DSW *p_body, const Transform2D &p_from, co
 					continue;
 				}
 
-				Transform2D col_obj_shape_xform = col_obj->get_transform() * col_obj->get_shape_transform(col_shape_idx);
+				const Transform2D &col_obj_shape_xform = candidate.xform;
 				//test initial overlap, does it collide if going all the way?
 				if (!CollisionSolver2DSW::solve(body_shape, body_shape_xform, p_motion, against_shape, col_obj_shape_xform, Vector2(), NULL, NULL, NULL, 0)) {
 					continue;
@@ -1026,6 +1310,9 @@ bool Space2DSW::test_body_motion(Body2DSW *p_body, const Transform2D &p_from, co
 		int from_shape = best_shape != -1 ? best_shape : 0;
 		int to_shape = best_shape != -1 ? best_shape + 1 : p_body->get_shape_count();
 
+		// The rest area is within the motion area checked above.
+		body_aabb.position += p_motion * unsafe;
+
 		for (int j = from_shape; j < to_shape; j++) {
 
 			if (p_body->is_shape_set_as_disabled(j))
@@ -1038,14 +1325,14 @@ bool Space2DSW::test_body_motion(Body2DSW *p_body, const Transform2D &p_from, co
 				continue;
 			}
 
-			body_aabb.position += p_motion * unsafe;
+			for (int i = 0; i < p_candidate_count; i++) {
 
-			int amount = _cull_aabb_for_body(p_body, body_aabb);
-
-			for (int i = 0; i < amount; i++) {
+				const MotionCandidate &candidate = p_candidates[i];
+				if (!candidate.aabb.intersects(body_aabb))
+					continue;
 
-				const CollisionObject2DSW *col_obj = intersection_query_results[i];
-				int shape_idx = intersection_query_subindex_results[i];
+				const CollisionObject2DSW *col_obj = candidate.object;
+				int shape_idx = candidate.shape;
 
 				if (CollisionObject2DSW::TYPE_BODY == col_obj->get_type()) {
 					const Body2DSW *b = static_cast<const Body2DSW *>(col_obj);
@@ -1067,7 +1354,7 @@ bool Space2DSW::test_body_motion(Body2DSW *p_body, const Transform2D &p_from, co
 				if (excluded)
 					continue;
 
-				Transform2D col_obj_shape_xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
+				const Transform2D &col_obj_shape_xform = candidate.xform;
 
 				if (col_obj->is_shape_set_as_one_way_collision(shape_idx)) {
 
@@ -1118,7 +1405,147 @@ bool Space2DSW::test_body_motion(Body2DSW *p_body, const Transform2D &p_from, co
 		r_result->motion += (body_transform.get_origin() - p_from.get_origin());
 	}
 
-	return collided;
+	return collided ? MOTION_TEST_COLLIDED : MOTION_TEST_FREE;
+}
+
+bool Space2DSW::test_body_motion(Body2DSW *p_body, const Transform2D &p_from, const Vector2 &p_motion, bool p_infinite_inertia, real_t p_margin, Physics2DServer::MotionResult *r_result, bool p_exclude_raycast_shapes) {
+
+	if (r_result) {
+		r_result->collider_id = 0;
+		r_result->collider_shape = 0;
+	}
+
+	Rect2 body_aabb;
+	if (!_get_body_motion_aabb(p_body, p_from, p_margin, p_exclude_raycast_shapes, body_aabb)) {
+		if (r_result) {
+			*r_result = Physics2DServer::MotionResult();
+			r_result->motion = p_motion;
+		}
+		return false;
+	}
+
+	// The broadphase is culled once for all the steps of the test, instead of once per step.
+	Rect2 query_aabb = _get_motion_query_aabb(body_aabb, p_motion);
+	bool tight_query = false;
+
+	while (true) {
+
+		motion_candidates.clear();
+		bool full = false;
+		int amount = _cull_motion_candidates(p_body, query_aabb, motion_candidates, full);
+
+		if (full && !tight_query) {
+			// Too many shapes around to fit the extra room, cull only what the motion sweeps.
+			// Recovery falls back to culling again if it leaves that area.
+			query_aabb = body_aabb.merge(Rect2(body_aabb.position + p_motion, body_aabb.size));
+			tight_query = true;
+			continue;
+		}
+
+		Rect2 required_aabb;
+		MotionTestResult result = _test_body_motion_candidates(p_body, p_from, p_motion, p_infinite_inertia, p_margin, r_result, p_exclude_raycast_shapes, body_aabb, motion_candidates.ptr(), amount, query_aabb, required_aabb);
+
+		if (result != MOTION_TEST_OUT_OF_BOUNDS) {
+			return result == MOTION_TEST_COLLIDED;
+		}
+
+		// Pushed far away while recovering, start again with an area that covers it.
+		query_aabb = query_aabb.merge(_get_motion_query_aabb(required_aabb, p_motion));
+	}
+}
+
+void Space2DSW::_test_body_motion_batch_process(uint32_t p_index, BodyMotionBatch *p_batch) {
+
+	if (!p_batch->has_shapes[p_index] || p_batch->status[p_index] == MOTION_TEST_OUT_OF_BOUNDS) {
+		return;
+	}
+
+	const BodyMotion &m = p_batch->motions[p_index];
+	int from = p_batch->candidate_offsets[p_index];
+	int to = p_batch->candidate_offsets[p_index + 1];
+	Rect2 required_aabb;
+
+	p_batch->status[p_index] = _test_body_motion_candidates(m.body, m.from, m.motion, m.infinite_inertia, m.margin, &p_batch->results[p_index], m.exclude_raycast_shapes, p_batch->body_aabbs[p_index], p_batch->candidates + from, to - from, p_batch->query_aabbs[p_index], required_aabb);
+}
+
+int Space2DSW::test_body_motion_batch(const BodyMotion *p_motions, int p_count, Physics2DServer::MotionResult *r_results, bool *r_collided) {
+
+	// The broadphase can't be queried from several threads, so the candidates for
+	// all the bodies are culled first, then the motions are tested in parallel.
+
+	Vector<MotionCandidate> candidates;
+	Vector<int> candidate_offsets;
+	Vector<Rect2> body_aabbs;
+	Vector<Rect2> query_aabbs;
+	Vector<MotionTestResult> status;
+	Vector<bool> has_shapes;
+	candidate_offsets.resize(p_count + 1);
+	body_aabbs.resize(p_count);
+	query_aabbs.resize(p_count);
+	status.resize(p_count);
+	has_shapes.resize(p_count);
+
+	for (int i = 0; i < p_count; i++) {
+
+		const BodyMotion &m = p_motions[i];
+		candidate_offsets.write[i] = candidates.size();
+		status.write[i] = MOTION_TEST_FREE;
+
+		r_results[i] = Physics2DServer::MotionResult();
+
+		has_shapes.write[i] = _get_body_motion_aabb(m.body, m.from, m.margin, m.exclude_raycast_shapes, body_aabbs.write[i]);
+		if (!has_shapes[i]) {
+			r_results[i].motion = m.motion;
+			continue;
+		}
+
+		query_aabbs.write[i] = _get_motion_query_aabb(body_aabbs[i], m.motion);
+
+		bool full = false;
+		_cull_motion_candidates(m.body, query_aabbs[i], candidates, full);
+		if (full) {
+			// Some candidates may be missing, test this motion on its own afterwards.
+			candidates.resize(candidate_offsets[i]);
+			status.write[i] = MOTION_TEST_OUT_OF_BOUNDS;
+		}
+	}
+	candidate_offsets.write[p_count] = candidates.size();
+
+	BodyMotionBatch batch;
+	batch.motions = p_motions;
+	batch.results = r_results;
+	batch.status = status.ptrw();
+	batch.has_shapes = has_shapes.ptr();
+	batch.body_aabbs = body_aabbs.ptr();
+	batch.query_aabbs = query_aabbs.ptr();
+	batch.candidates = candidates.ptr();
+	batch.candidate_offsets = candidate_offsets.ptr();
+
+	if (p_count >= MOTION_BATCH_PARALLEL_MIN_QUERIES) {
+		Physics2DServerSW::singletonsw->thread_pool.do_work(p_count, this, &Space2DSW::_test_body_motion_batch_process, &batch);
+	} else {
+		for (int i = 0; i < p_count; i++) {
+			_test_body_motion_batch_process(i, &batch);
+		}
+	}
+
+	int collided_count = 0;
+
+	for (int i = 0; i < p_count; i++) {
+
+		if (status[i] == MOTION_TEST_OUT_OF_BOUNDS) {
+			const BodyMotion &m = p_motions[i];
+			r_collided[i] = test_body_motion(m.body, m.from, m.motion, m.infinite_inertia, m.margin, &r_results[i], m.exclude_raycast_shapes);
+		} else {
+			r_collided[i] = status[i] == MOTION_TEST_COLLIDED;
+		}
+
+		if (r_collided[i]) {
+			collided_count++;
+		}
+	}
+
+	return collided_count;
 }
 
 void *Space2DSW::_broadphase_pair(CollisionObject2DSW *A, int p_subindex_A, CollisionObject2DSW *B, int p_subindex_B, void *p_self) {
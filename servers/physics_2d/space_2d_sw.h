@@ -45,6 +45,43 @@ class Physics2DDirectSpaceStateSW : public Physics2DDirectSpaceState {
 
 	GDCLASS(Physics2DDirectSpaceStateSW, Physics2DDirectSpaceState);
 
+	enum {
+		BATCH_PARALLEL_MIN_QUERIES = 64
+	};
+
+	struct BatchCandidate {
+
+		const CollisionObject2DSW *object;
+		int shape;
+		real_t entry; // Projection along the ray where its AABB is entered, used to stop early.
+
+		bool operator<(const BatchCandidate &p_other) const { return entry < p_other.entry; }
+	};
+
+	struct RayBatch {
+
+		const RayQuery *queries;
+		RayResult *results;
+		bool *hits;
+		BatchCandidate *candidates;
+		const int *candidate_offsets;
+	};
+
+	struct ShapeBatch {
+
+		const ShapeQuery *queries;
+		const Shape2DSW *const *shapes;
+		real_t margin;
+		ShapeResult *results;
+		int result_max;
+		int *result_counts;
+		const BatchCandidate *candidates;
+		const int *candidate_offsets;
+	};
+
+	void _intersect_ray_batch_process(uint32_t p_index, RayBatch *p_batch);
+	void _intersect_shape_batch_process(uint32_t p_index, ShapeBatch *p_batch);
+
 	int _intersect_point_impl(const Vector2 &p_point, ShapeResult *r_results, int p_result_max, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas, bool p_pick_point, bool p_filter_by_canvas = false, ObjectID p_canvas_instance_id = 0);
 
 public:
@@ -53,7 +90,9 @@ public:
 	virtual int intersect_point(const Vector2 &p_point, ShapeResult *r_results, int p_result_max, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false, bool p_pick_point = false);
 	virtual int intersect_point_on_canvas(const Vector2 &p_point, ObjectID p_canvas_instance_id, ShapeResult *r_results, int p_result_max, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false, bool p_pick_point = false);
 	virtual bool intersect_ray(const Vector2 &p_from, const Vector2 &p_to, RayResult &r_result, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
+	virtual int intersect_rays_batch(const RayQuery *p_queries, int p_query_count, RayResult *r_results, bool *r_hits, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
 	virtual int intersect_shape(const RID &p_shape, const Transform2D &p_xform, const Vector2 &p_motion, real_t p_margin, ShapeResult *r_results, int p_result_max, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
+	virtual int intersect_shapes_batch(const ShapeQuery *p_queries, int p_query_count, real_t p_margin, ShapeResult *r_results, int p_result_max, int *r_result_counts, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
 	virtual bool cast_motion(const RID &p_shape, const Transform2D &p_xform, const Vector2 &p_motion, real_t p_margin, real_t &p_closest_safe, real_t &p_closest_unsafe, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
 	virtual bool collide_shape(RID p_shape, const Transform2D &p_shape_xform, const Vector2 &p_motion, real_t p_margin, Vector2 *r_results, int p_result_max, int &r_result_count, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
 	virtual bool rest_info(RID p_shape, const Transform2D &p_shape_xform, const Vector2 &p_motion, real_t p_margin, ShapeRestInfo *r_info, const Set<RID> &p_exclude = Set<RID>(), uint32_t p_collision_mask = 0xFFFFFFFF, bool p_collide_with_bodies = true, bool p_collide_with_areas = false);
@@ -124,7 +163,58 @@ private:
 	int active_objects;
 	int collision_pairs;
 
-	int _cull_aabb_for_body(Body2DSW *p_body, const Rect2 &p_aabb);
+	int _cull_aabb_for_body(Body2DSW *p_body, const Rect2 &p_aabb, bool *r_full = NULL);
+
+	enum {
+		MOTION_BATCH_PARALLEL_MIN_QUERIES = 8
+	};
+
+	// Shapes near a body, culled once for all the stages of a motion test.
+	struct MotionCandidate {
+
+		const CollisionObject2DSW *object;
+		int shape;
+		Rect2 aabb;
+		Transform2D xform;
+	};
+
+	enum MotionTestResult {
+		MOTION_TEST_FREE,
+		MOTION_TEST_COLLIDED,
+		MOTION_TEST_OUT_OF_BOUNDS, // recovery moved the body outside the culled area
+	};
+
+public:
+	struct BodyMotion {
+
+		Body2DSW *body;
+		Transform2D from;
+		Vector2 motion;
+		bool infinite_inertia;
+		real_t margin;
+		bool exclude_raycast_shapes;
+	};
+
+private:
+	struct BodyMotionBatch {
+
+		const BodyMotion *motions;
+		Physics2DServer::MotionResult *results;
+		MotionTestResult *status;
+		const bool *has_shapes;
+		const Rect2 *body_aabbs;
+		const Rect2 *query_aabbs;
+		const MotionCandidate *candidates;
+		const int *candidate_offsets;
+	};
+
+	Vector<MotionCandidate> motion_candidates;
+
+	bool _get_body_motion_aabb(Body2DSW *p_body, const Transform2D &p_from, real_t p_margin, bool p_exclude_raycast_shapes, Rect2 &r_aabb) const;
+	Rect2 _get_motion_query_aabb(const Rect2 &p_body_aabb, const Vector2 &p_motion) const;
+	int _cull_motion_candidates(Body2DSW *p_body, const Rect2 &p_aabb, Vector<MotionCandidate> &r_candidates, bool &r_full);
+	MotionTestResult _test_body_motion_candidates(Body2DSW *p_body, const Transform2D &p_from, const Vector2 &p_motion, bool p_infinite_inertia, real_t p_margin, Physics2DServer::MotionResult *r_result, bool p_exclude_raycast_shapes, const Rect2 &p_body_aabb, const MotionCandidate *p_candidates, int p_candidate_count, const Rect2 &p_candidates_aabb, Rect2 &r_required_aabb) const;
+	void _test_body_motion_batch_process(uint32_t p_index, BodyMotionBatch *p_batch);
 
 	Vector<Vector2> contact_debug;
 	int contact_debug_count;
@@ -188,6 +278,7 @@ public:
 
 	bool test_body_motion(Body2DSW *p_body, const Transform2D &p_from, const Vector2 &p_motion, bool p_infinite_inertia, real_t p_margin, Physics2DServer::MotionResult *r_result, bool p_exclude_raycast_shapes = true);
 	int test_body_ray_separation(Body2DSW *p_body, const Transform2D &p_transform, bool p_infinite_inertia, Vector2 &r_recover_motion, Physics2DServer::SeparationResult *r_results, int p_result_max, real_t p_margin);
+	int test_body_motion_batch(const BodyMotion *p_motions, int p_count, Physics2DServer::MotionResult *r_results, bool *r_collided);
 
 	void set_debug_contacts(int p_amount) { contact_debug.resize(p_amount); }
 	_FORCE_INLINE_ bool is_debugging_contacts() const { return !contact_debug.empty(); }
@@ -290,6 +290,55 @@ Dictionary Physics2DDirectSpaceState::_intersect_ray(const Vector2 &p_from, cons
 	return d;
 }
 
+Array Physics2DDirectSpaceState::_intersect_rays_batch(const PoolVector2Array &p_from, const PoolVector2Array &p_to, const Vector<RID> &p_exclude, uint32_t p_layers, bool p_collide_with_bodies, bool p_collide_with_areas) {
+
+	ERR_FAIL_COND_V(p_from.size() != p_to.size(), Array());
+
+	Set<RID> exclude;
+	for (int i = 0; i < p_exclude.size(); i++)
+		exclude.insert(p_exclude[i]);
+
+	int count = p_from.size();
+	Vector<RayQuery> queries;
+	queries.resize(count);
+	{
+		PoolVector2Array::Read from = p_from.read();
+		PoolVector2Array::Read to = p_to.read();
+		RayQuery *queries_ptr = queries.ptrw();
+		for (int i = 0; i < count; i++) {
+			queries_ptr[i].from = from[i];
+			queries_ptr[i].to = to[i];
+		}
+	}
+
+	Vector<RayResult> results;
+	results.resize(count);
+	Vector<bool> hits;
+	hits.resize(count);
+
+	intersect_rays_batch(queries.ptr(), count, results.ptrw(), hits.ptrw(), exclude, p_layers, p_collide_with_bodies, p_collide_with_areas);
+
+	Array ret;
+	ret.resize(count);
+	for (int i = 0; i < count; i++) {
+
+		Dictionary d;
+		if (hits[i]) {
+			const RayResult &inters = results[i];
+			d["position"] = inters.position;
+			d["normal"] = inters.normal;
+			d["collider_id"] = inters.collider_id;
+			d["collider"] = inters.collider;
+			d["shape"] = inters.shape;
+			d["rid"] = inters.rid;
+			d["metadata"] = inters.metadata;
+		}
+		ret[i] = d;
+	}
+
+	return ret;
+}
+
 Array Physics2DDirectSpaceState::_intersect_shape(const Ref<Physics2DShapeQueryParameters> &p_shape_query, int p_max_results) {
 
 	ERR_FAIL_COND_V(!p_shape_query.is_valid(), Array());
@@ -313,11 +362,55 @@ Array Physics2DDirectSpaceState::_intersect_shape(const Ref<Physics2DShapeQueryP
 	return ret;
 }
 
+Array Physics2DDirectSpaceState::_intersect_shapes_batch(const Ref<Physics2DShapeQueryParameters> &p_shape_query, const Array &p_transforms, int p_max_results) {
+
+	ERR_FAIL_COND_V(!p_shape_query.is_valid(), Array());
+	ERR_FAIL_COND_V(p_max_results <= 0, Array());
+
+	int count = p_transforms.size();
+	Vector<ShapeQuery> queries;
+	queries.resize(count);
+	for (int i = 0; i < count; i++) {
+		queries.write[i].shape = p_shape_query->shape;
+		queries.write[i].xform = p_transforms[i];
+		queries.write[i].motion = p_shape_query->motion;
+	}
+
+	Vector<ShapeResult> sr;
+	sr.resize(count * p_max_results);
+	Vector<int> counts;
+	counts.resize(count);
+
+	intersect_shapes_batch(queries.ptr(), count, p_shape_query->margin, sr.ptrw(), p_max_results, counts.ptrw(), p_shape_query->exclude, p_shape_query->collision_mask, p_shape_query->collide_with_bodies, p_shape_query->collide_with_areas);
+
+	Array ret;
+	ret.resize(count);
+	for (int i = 0; i < count; i++) {
+
+		Array results;
+		results.resize(counts[i]);
+		for (int j = 0; j < counts[i]; j++) {
+
+			const ShapeResult &r = sr[i * p_max_results + j];
+			Dictionary d;
+			d["rid"] = r.rid;
+			d["collider_id"] = r.collider_id;
+			d["collider"] = r.collider;
+			d["shape"] = r.shape;
+			d["metadata"] = r.metadata;
+			results[j] = d;
+		}
+		ret[i] = results;
+	}
+
+	return ret;
+}
+
 Array Physics2DDirectSpaceState::_cast_motion(const Ref<Physics2DShapeQueryParameters> &p_shape_query) {
 
 	ERR_FAIL_COND_V(!p_shape_query.is_valid(), Array());
 
-	float closest_safe, closest_unsafe;
+	real_t closest_safe, closest_unsafe;
 	bool res = cast_motion(p_shape_query->shape, p_shape_query->transform, p_shape_query->motion, p_shape_query->margin, closest_safe, closest_unsafe, p_shape_query->exclude, p_shape_query->collision_mask, p_shape_query->collide_with_bodies, p_shape_query->collide_with_areas);
 	if (!res)
 		return Array();
@@ -409,6 +502,30 @@ Dictionary Physics2DDirectSpaceState::_get_rest_info(const Ref<Physics2DShapeQue
 	return r;
 }
 
+int Physics2DDirectSpaceState::intersect_rays_batch(const RayQuery *p_queries, int p_query_count, RayResult *r_results, bool *r_hits, const Set<RID> &p_exclude, uint32_t p_collision_layer, bool p_collide_with_bodies, bool p_collide_with_areas) {
+
+	int hit_count = 0;
+	for (int i = 0; i < p_query_count; i++) {
+		r_hits[i] = intersect_ray(p_queries[i].from, p_queries[i].to, r_results[i], p_exclude, p_collision_layer, p_collide_with_bodies, p_collide_with_areas);
+		if (r_hits[i]) {
+			hit_count++;
+		}
+	}
+
+	return hit_count;
+}
+
+int Physics2DDirectSpaceState::intersect_shapes_batch(const ShapeQuery *p_queries, int p_query_count, real_t p_margin, ShapeResult *r_results, int p_result_max, int *r_result_counts, const Set<RID> &p_exclude, uint32_t p_collision_layer, bool p_collide_with_bodies, bool p_collide_with_areas) {
+
+	int total = 0;
+	for (int i = 0; i < p_query_count; i++) {
+		r_result_counts[i] = intersect_shape(p_queries[i].shape, p_queries[i].xform, p_queries[i].motion, p_margin, &r_results[i * p_result_max], p_result_max, p_exclude, p_collision_layer, p_collide_with_bodies, p_collide_with_areas);
+		total += r_result_counts[i];
+	}
+
+	return total;
+}
+
 Physics2DDirectSpaceState::Physics2DDirectSpaceState() {
 }
 
@@ -417,7 +534,9 @@ void Physics2DDirectSpaceState::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("intersect_point", "point", "max_results", "exclude", "collision_layer", "collide_with_bodies", "collide_with_areas"), &Physics2DDirectSpaceState::_intersect_point, DEFVAL(32), DEFVAL(Array()), DEFVAL(0x7FFFFFFF), DEFVAL(true), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("intersect_point_on_canvas", "point", "canvas_instance_id", "max_results", "exclude", "collision_layer", "collide_with_bodies", "collide_with_areas"), &Physics2DDirectSpaceState::_intersect_point_on_canvas, DEFVAL(32), DEFVAL(Array()), DEFVAL(0x7FFFFFFF), DEFVAL(true), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("intersect_ray", "from", "to", "exclude", "collision_layer", "collide_with_bodies", "collide_with_areas"), &Physics2DDirectSpaceState::_intersect_ray, DEFVAL(Array()), DEFVAL(0x7FFFFFFF), DEFVAL(true), DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("intersect_rays_batch", "from", "to", "exclude", "collision_layer", "collide_with_bodies", "collide_with_areas"), &Physics2DDirectSpaceState::_intersect_rays_batch, DEFVAL(Array()), DEFVAL(0x7FFFFFFF), DEFVAL(true), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("intersect_shape", "shape", "max_results"), &Physics2DDirectSpaceState::_intersect_shape, DEFVAL(32));
+	ClassDB::bind_method(D_METHOD("intersect_shapes_batch", "shape", "transforms", "max_results"), &Physics2DDirectSpaceState::_intersect_shapes_batch, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("cast_motion", "shape"), &Physics2DDirectSpaceState::_cast_motion);
 	ClassDB::bind_method(D_METHOD("collide_shape", "shape", "max_results"), &Physics2DDirectSpaceState::_collide_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("get_rest_info", "shape"), &Physics2DDirectSpaceState::_get_rest_info);
@@ -529,7 +648,7 @@ Physics2DTestMotionResult::Physics2DTestMotionResult() {
 
 ///////////////////////////////////////
 
-bool Physics2DServer::_body_test_motion(RID p_body, const Transform2D &p_from, const Vector2 &p_motion, bool p_infinite_inertia, float p_margin, const Ref<Physics2DTestMotionResult> &p_result) {
+bool Physics2DServer::_body_test_motion(RID p_body, const Transform2D &p_from, const Vector2 &p_motion, bool p_infinite_inertia, real_t p_margin, const Ref<Physics2DTestMotionResult> &p_result) {
 
 	MotionResult *r = NULL;
 	if (p_result.is_valid())
@@ -537,6 +656,74 @@ bool Physics2DServer::_body_test_motion(RID p_body, const Transform2D &p_from, c
 	return body_test_motion(p_body, p_from, p_motion, p_infinite_inertia, p_margin, r);
 }
 
+Array Physics2DServer::_body_test_motion_batch(const Array &p_bodies, const Array &p_from, const PoolVector2Array &p_motions, bool p_infinite_inertia, real_t p_margin) {
+
+	ERR_FAIL_COND_V(p_bodies.size() != p_from.size() || p_bodies.size() != p_motions.size(), Array());
+
+	int count = p_bodies.size();
+	Vector<MotionQuery> queries;
+	queries.resize(count);
+	{
+		PoolVector2Array::Read motions = p_motions.read();
+		MotionQuery *queries_ptr = queries.ptrw();
+		for (int i = 0; i < count; i++) {
+			queries_ptr[i].body = p_bodies[i];
+			queries_ptr[i].from = p_from[i];
+			queries_ptr[i].motion = motions[i];
+			queries_ptr[i].infinite_inertia = p_infinite_inertia;
+			queries_ptr[i].margin = p_margin;
+		}
+	}
+
+	Vector<MotionResult> results;
+	results.resize(count);
+	Vector<bool> collided;
+	collided.resize(count);
+
+	body_test_motion_batch(queries.ptr(), count, results.ptrw(), collided.ptrw());
+
+	Array ret;
+	ret.resize(count);
+	for (int i = 0; i < count; i++) {
+
+		const MotionResult &result = results[i];
+		Dictionary d;
+		d["collided"] = collided[i];
+		d["motion"] = result.motion;
+		d["remainder"] = result.remainder;
+		if (collided[i]) {
+			d["position"] = result.collision_point;
+			d["normal"] = result.collision_normal;
+			d["collider_velocity"] = result.collider_velocity;
+			d["collider_id"] = result.collider_id;
+			d["collider"] = ObjectDB::get_instance(result.collider_id);
+			d["rid"] = result.collider;
+			d["shape"] = result.collider_shape;
+			d["local_shape"] = result.collision_local_shape;
+			d["metadata"] = result.collider_metadata;
+		}
+		ret[i] = d;
+	}
+
+	return ret;
+}
+
+int Physics2DServer::body_test_motion_batch(const MotionQuery *p_queries, int p_query_count, MotionResult *r_results, bool *r_collided) {
+
+	int collided_count = 0;
+
+	for (int i = 0; i < p_query_count; i++) {
+
+		const MotionQuery &q = p_queries[i];
+		r_collided[i] = body_test_motion(q.body, q.from, q.motion, q.infinite_inertia, q.margin, &r_results[i], q.exclude_raycast_shapes);
+		if (r_collided[i]) {
+			collided_count++;
+		}
+	}
+
+	return collided_count;
+}
+
 void Physics2DServer::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("line_shape_create"), &Physics2DServer::line_shape_create);
@@ -663,6 +850,7 @@ void Physics2DServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("body_set_force_integration_callback", "body", "receiver", "method", "userdata"), &Physics2DServer::body_set_force_integration_callback, DEFVAL(Variant()));
 
 	ClassDB::bind_method(D_METHOD("body_test_motion", "body", "from", "motion", "infinite_inertia", "margin", "result"), &Physics2DServer::_body_test_motion, DEFVAL(0.08), DEFVAL(Variant()));
+	ClassDB::bind_method(D_METHOD("body_test_motion_batch", "bodies", "from", "motions", "infinite_inertia", "margin"), &Physics2DServer::_body_test_motion_batch, DEFVAL(true), DEFVAL(0.08));
 
 	ClassDB::bind_method(D_METHOD("body_get_direct_state", "body"), &Physics2DServer::body_get_direct_state);
 
@@ -283,6 +283,54 @@ Dictionary PhysicsDirectSpaceState::_intersect_ray(const Vector3 &p_from, const
 	return d;
 }
 
+Array PhysicsDirectSpaceState::_intersect_rays_batch(const PoolVector3Array &p_from, const PoolVector3Array &p_to, const Vector<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
+
+	ERR_FAIL_COND_V(p_from.size() != p_to.size(), Array());
+
+	Set<RID> exclude;
+	for (int i = 0; i < p_exclude.size(); i++)
+		exclude.insert(p_exclude[i]);
+
+	int count = p_from.size();
+	Vector<RayQuery> queries;
+	queries.resize(count);
+	{
+		PoolVector3Array::Read from = p_from.read();
+		PoolVector3Array::Read to = p_to.read();
+		RayQuery *queries_ptr = queries.ptrw();
+		for (int i = 0; i < count; i++) {
+			queries_ptr[i].from = from[i];
+			queries_ptr[i].to = to[i];
+		}
+	}
+
+	Vector<RayResult> results;
+	results.resize(count);
+	Vector<bool> hits;
+	hits.resize(count);
+
+	intersect_rays_batch(queries.ptr(), count, results.ptrw(), hits.ptrw(), exclude, p_collision_mask, p_collide_with_bodies, p_collide_with_areas);
+
+	Array ret;
+	ret.resize(count);
+	for (int i = 0; i < count; i++) {
+
+		Dictionary d;
+		if (hits[i]) {
+			const RayResult &inters = results[i];
+			d["position"] = inters.position;
+			d["normal"] = inters.normal;
+			d["collider_id"] = inters.collider_id;
+			d["collider"] = inters.collider;
+			d["shape"] = inters.shape;
+			d["rid"] = inters.rid;
+		}
+		ret[i] = d;
+	}
+
+	return ret;
+}
+
 Array PhysicsDirectSpaceState::_intersect_shape(const Ref<PhysicsShapeQueryParameters> &p_shape_query, int p_max_results) {
 
 	ERR_FAIL_COND_V(!p_shape_query.is_valid(), Array());
@@ -305,11 +353,53 @@ Array PhysicsDirectSpaceState::_intersect_shape(const Ref<PhysicsShapeQueryParam
 	return ret;
 }
 
+Array PhysicsDirectSpaceState::_intersect_shapes_batch(const Ref<PhysicsShapeQueryParameters> &p_shape_query, const Array &p_transforms, int p_max_results) {
+
+	ERR_FAIL_COND_V(!p_shape_query.is_valid(), Array());
+	ERR_FAIL_COND_V(p_max_results <= 0, Array());
+
+	int count = p_transforms.size();
+	Vector<ShapeQuery> queries;
+	queries.resize(count);
+	for (int i = 0; i < count; i++) {
+		queries.write[i].shape = p_shape_query->shape;
+		queries.write[i].xform = p_transforms[i];
+	}
+
+	Vector<ShapeResult> sr;
+	sr.resize(count * p_max_results);
+	Vector<int> counts;
+	counts.resize(count);
+
+	intersect_shapes_batch(queries.ptr(), count, p_shape_query->margin, sr.ptrw(), p_max_results, counts.ptrw(), p_shape_query->exclude, p_shape_query->collision_mask, p_shape_query->collide_with_bodies, p_shape_query->collide_with_areas);
+
+	Array ret;
+	ret.resize(count);
+	for (int i = 0; i < count; i++) {
+
+		Array results;
+		results.resize(counts[i]);
+		for (int j = 0; j < counts[i]; j++) {
+
+			const ShapeResult &r = sr[i * p_max_results + j];
+			Dictionary d;
+			d["rid"] = r.rid;
+			d["collider_id"] = r.collider_id;
+			d["collider"] = r.collider;
+			d["shape"] = r.shape;
+			results[j] = d;
+		}
+		ret[i] = results;
+	}
+
+	return ret;
+}
+
 Array PhysicsDirectSpaceState::_cast_motion(const Ref<PhysicsShapeQueryParameters> &p_shape_query, const Vector3 &p_motion) {
 
 	ERR_FAIL_COND_V(!p_shape_query.is_valid(), Array());
 
-	float closest_safe, closest_unsafe;
+	real_t closest_safe, closest_unsafe;
 	bool res = cast_motion(p_shape_query->shape, p_shape_query->transform, p_motion, p_shape_query->margin, closest_safe, closest_unsafe, p_shape_query->exclude, p_shape_query->collision_mask, p_shape_query->collide_with_bodies, p_shape_query->collide_with_areas);
 	if (!res)
 		return Array();
@@ -356,13 +446,39 @@ Dictionary PhysicsDirectSpaceState::_get_rest_info(const Ref<PhysicsShapeQueryPa
 	return r;
 }
 
+int PhysicsDirectSpaceState::intersect_rays_batch(const RayQuery *p_queries, int p_query_count, RayResult *r_results, bool *r_hits, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
+
+	int hit_count = 0;
+	for (int i = 0; i < p_query_count; i++) {
+		r_hits[i] = intersect_ray(p_queries[i].from, p_queries[i].to, r_results[i], p_exclude, p_collision_mask, p_collide_with_bodies, p_collide_with_areas);
+		if (r_hits[i]) {
+			hit_count++;
+		}
+	}
+
+	return hit_count;
+}
+
+int PhysicsDirectSpaceState::intersect_shapes_batch(const ShapeQuery *p_queries, int p_query_count, real_t p_margin, ShapeResult *r_results, int p_result_max, int *r_result_counts, const Set<RID> &p_exclude, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
+
+	int total = 0;
+	for (int i = 0; i < p_query_count; i++) {
+		r_result_counts[i] = intersect_shape(p_queries[i].shape, p_queries[i].xform, p_margin, &r_results[i * p_result_max], p_result_max, p_exclude, p_collision_mask, p_collide_with_bodies, p_collide_with_areas);
+		total += r_result_counts[i];
+	}
+
+	return total;
+}
+
 PhysicsDirectSpaceState::PhysicsDirectSpaceState() {
 }
 
 void PhysicsDirectSpaceState::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("intersect_ray", "from", "to", "exclude", "collision_mask", "collide_with_bodies", "collide_with_areas"), &PhysicsDirectSpaceState::_intersect_ray, DEFVAL(Array()), DEFVAL(0x7FFFFFFF), DEFVAL(true), DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("intersect_rays_batch", "from", "to", "exclude", "collision_mask", "collide_with_bodies", "collide_with_areas"), &PhysicsDirectSpaceState::_intersect_rays_batch, DEFVAL(Array()), DEFVAL(0x7FFFFFFF), DEFVAL(true), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("intersect_shape", "shape", "max_results"), &PhysicsDirectSpaceState::_intersect_shape, DEFVAL(32));
+	ClassDB::bind_method(D_METHOD("intersect_shapes_batch", "shape", "transforms", "max_results"), &PhysicsDirectSpaceState::_intersect_shapes_batch, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("cast_motion", "shape", "motion"), &PhysicsDirectSpaceState::_cast_motion);
 	ClassDB::bind_method(D_METHOD("collide_shape", "shape", "max_results"), &PhysicsDirectSpaceState::_collide_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("get_rest_info", "shape"), &PhysicsDirectSpaceState::_get_rest_info);
@@ -403,6 +519,72 @@ void PhysicsShapeQueryResult::_bind_methods() {
 
 ///////////////////////////////////////
 
+Array PhysicsServer::_body_test_motion_batch(const Array &p_bodies, const Array &p_from, const PoolVector3Array &p_motions, bool p_infinite_inertia) {
+
+	ERR_FAIL_COND_V(p_bodies.size() != p_from.size() || p_bodies.size() != p_motions.size(), Array());
+
+	int count = p_bodies.size();
+	Vector<MotionQuery> queries;
+	queries.resize(count);
+	{
+		PoolVector3Array::Read motions = p_motions.read();
+		MotionQuery *queries_ptr = queries.ptrw();
+		for (int i = 0; i < count; i++) {
+			queries_ptr[i].body = p_bodies[i];
+			queries_ptr[i].from = p_from[i];
+			queries_ptr[i].motion = motions[i];
+			queries_ptr[i].infinite_inertia = p_infinite_inertia;
+		}
+	}
+
+	Vector<MotionResult> results;
+	results.resize(count);
+	Vector<bool> collided;
+	collided.resize(count);
+
+	body_test_motion_batch(queries.ptr(), count, results.ptrw(), collided.ptrw());
+
+	Array ret;
+	ret.resize(count);
+	for (int i = 0; i < count; i++) {
+
+		const MotionResult &result = results[i];
+		Dictionary d;
+		d["collided"] = collided[i];
+		d["motion"] = result.motion;
+		d["remainder"] = result.remainder;
+		if (collided[i]) {
+			d["position"] = result.collision_point;
+			d["normal"] = result.collision_normal;
+			d["collider_velocity"] = result.collider_velocity;
+			d["collider_id"] = result.collider_id;
+			d["collider"] = ObjectDB::get_instance(result.collider_id);
+			d["rid"] = result.collider;
+			d["shape"] = result.collider_shape;
+			d["local_shape"] = result.collision_local_shape;
+		}
+		ret[i] = d;
+	}
+
+	return ret;
+}
+
+int PhysicsServer::body_test_motion_batch(const MotionQuery *p_queries, int p_query_count, MotionResult *r_results, bool *r_collided) {
+
+	int collided_count = 0;
+
+	for (int i = 0; i < p_query_count; i++) {
+
+		const MotionQuery &q = p_queries[i];
+		r_collided[i] = body_test_motion(q.body, q.from, q.motion, q.infinite_inertia, &r_results[i], q.exclude_raycast_shapes);
+		if (r_collided[i]) {
+			collided_count++;
+		}
+	}
+
+	return collided_count;
+}
+
 void PhysicsServer::_bind_methods() {
 
 #ifndef _3D_DISABLED
@@ -527,6 +709,8 @@ void PhysicsServer::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("body_get_direct_state", "body"), &PhysicsServer::body_get_direct_state);
 
+	ClassDB::bind_method(D_METHOD("body_test_motion_batch", "bodies", "from", "motions", "infinite_inertia"), &PhysicsServer::_body_test_motion_batch, DEFVAL(true));
+
 	/* JOINT API */
 
 	BIND_ENUM_CONSTANT(JOINT_PIN);
@@ -702,6 +886,7 @@ void PhysicsServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(INFO_ACTIVE_OBJECTS);
 	BIND_ENUM_CONSTANT(INFO_COLLISION_PAIRS);
 	BIND_ENUM_CONSTANT(INFO_ISLAND_COUNT);
+	BIND_ENUM_CONSTANT(INFO_SLEEPING_OBJECTS);
 
 	BIND_ENUM_CONSTANT(SPACE_PARAM_CONTACT_RECYCLE_RADIUS);
 	BIND_ENUM_CONSTANT(SPACE_PARAM_CONTACT_MAX_SEPARATION);
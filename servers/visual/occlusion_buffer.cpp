@@ -0,0 +1,520 @@
+/*************************************************************************/
+/*  occlusion_buffer.cpp                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "occlusion_buffer.h"
+
+#include "core/hash_map.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OCCLUSION_BUFFER_SSE
+#include <emmintrin.h>
+#elif (defined(__ARM_NEON) || defined(__ARM_NEON__)) && defined(__aarch64__)
+#define OCCLUSION_BUFFER_NEON
+#include <arm_neon.h>
+#endif
+
+void OcclusionBuffer::set_size(int p_width, int p_height) {
+
+	// Rows are rasterized four pixels at a time.
+	p_width = MAX((p_width + 3) & ~3, 4);
+	p_height = MAX(p_height, 1);
+
+	if (p_width == width && p_height == height)
+		return;
+
+	width = p_width;
+	height = p_height;
+
+	int total = 0;
+	int level_width = width;
+	int level_height = height;
+	level_count = 0;
+
+	while (level_count < MAX_LEVELS) {
+
+		Level &level = levels[level_count++];
+		level.width = level_width;
+		level.height = level_height;
+		level.offset = total;
+		total += level_width * level_height;
+
+		if (level_width == 1 && level_height == 1)
+			break;
+
+		level_width = (level_width + 1) / 2;
+		level_height = (level_height + 1) / 2;
+	}
+
+	if (depth) {
+		memdelete_arr(depth);
+	}
+	depth = memnew_arr(float, total);
+}
+
+void OcclusionBuffer::begin(const CameraMatrix &p_projection, const Transform &p_cam_transform) {
+
+	view_projection = p_projection * CameraMatrix(p_cam_transform.affine_inverse());
+	triangle_count = 0;
+}
+
+void OcclusionBuffer::add_occluder(const Transform &p_xform, const Vector3 *p_vertices, int p_vertex_count, const int *p_indices, int p_index_count, const int *p_neighbors) {
+
+	CameraMatrix mvp = view_projection * CameraMatrix(p_xform);
+
+	clip_vertices.resize(p_vertex_count);
+	vertex_depth.resize(p_vertex_count);
+	Plane *clip = clip_vertices.ptrw();
+	float *vertex_z = vertex_depth.ptrw();
+	for (int i = 0; i < p_vertex_count; i++) {
+		clip[i] = mvp.xform4(Plane(p_vertices[i], 1.0));
+		vertex_z[i] = clip[i].d > CMP_EPSILON ? clip[i].normal.z / clip[i].d : Math_INF;
+	}
+
+	for (int i = 0; i + 2 < p_index_count; i += 3) {
+
+		Plane vertices[3];
+		bool valid = true;
+		for (int j = 0; j < 3; j++) {
+			int index = p_indices[i + j];
+			if (index < 0 || index >= p_vertex_count) {
+				valid = false;
+				break;
+			}
+			vertices[j] = clip[index];
+		}
+
+		if (!valid)
+			continue;
+
+		// Texels on a shared edge may be partly covered by the neighbor, so its depth is a valid bound too.
+		int center_edges = 0;
+		float depth_max = -Math_INF;
+		for (int j = 0; p_neighbors && j < 3; j++) {
+			int neighbor = p_neighbors[i + j];
+			if (neighbor < 0 || neighbor * 3 + 2 >= p_index_count)
+				continue;
+
+			center_edges |= 1 << j;
+			for (int k = 0; k < 3; k++) {
+				int index = p_indices[neighbor * 3 + k];
+				depth_max = MAX(depth_max, (index >= 0 && index < p_vertex_count) ? vertex_z[index] : Math_INF);
+			}
+		}
+
+		_add_clipped_triangle(vertices, center_edges, depth_max);
+	}
+}
+
+void OcclusionBuffer::get_coplanar_neighbors(const Vector3 *p_vertices, int p_vertex_count, const int *p_indices, int p_index_count, Vector<int> &r_neighbors) {
+
+	int triangle_count = p_index_count / 3;
+	r_neighbors.resize(triangle_count * 3);
+	int *neighbors = r_neighbors.ptrw();
+
+	// Directed edge to the triangle that has it, or -1 if several do.
+	HashMap<uint64_t, int> edges;
+	Vector<Vector3> normals;
+	normals.resize(triangle_count);
+
+	for (int i = 0; i < triangle_count; i++) {
+
+		bool valid = true;
+		for (int j = 0; j < 3; j++) {
+			valid = valid && p_indices[i * 3 + j] >= 0 && p_indices[i * 3 + j] < p_vertex_count;
+		}
+		if (!valid) {
+			normals.write[i] = Vector3();
+			continue;
+		}
+
+		const Vector3 &a = p_vertices[p_indices[i * 3 + 0]];
+		const Vector3 &b = p_vertices[p_indices[i * 3 + 1]];
+		const Vector3 &c = p_vertices[p_indices[i * 3 + 2]];
+		Vector3 normal = (b - a).cross(c - a);
+		normals.write[i] = normal.length_squared() > CMP_EPSILON2 ? normal.normalized() : Vector3();
+
+		for (int j = 0; j < 3; j++) {
+			uint64_t key = (uint64_t(uint32_t(p_indices[i * 3 + j])) << 32) | uint32_t(p_indices[i * 3 + (j + 1) % 3]);
+			int *triangle = edges.getptr(key);
+			if (triangle) {
+				*triangle = -1;
+			} else {
+				edges.set(key, i);
+			}
+		}
+	}
+
+	// Only consistently wound triangles in the same plane cover both sides of their edge on screen.
+	for (int i = 0; i < triangle_count; i++) {
+		for (int j = 0; j < 3; j++) {
+
+			neighbors[i * 3 + j] = -1;
+			if (normals[i] == Vector3())
+				continue;
+
+			int from = p_indices[i * 3 + j];
+			int to = p_indices[i * 3 + (j + 1) % 3];
+			const int *own = edges.getptr((uint64_t(uint32_t(from)) << 32) | uint32_t(to));
+			const int *other = edges.getptr((uint64_t(uint32_t(to)) << 32) | uint32_t(from));
+			if (!own || *own != i || !other || *other < 0)
+				continue;
+
+			if (normals[*other].dot(normals[i]) > 0.9999) {
+				neighbors[i * 3 + j] = *other;
+			}
+		}
+	}
+}
+
+void OcclusionBuffer::_add_clipped_triangle(const Plane *p_vertices, int p_center_edges, float p_depth_max) {
+
+	// Vertices are in clip space, with W stored in d.
+	for (int axis = 0; axis < 3; axis++) {
+		if (p_vertices[0].normal[axis] > p_vertices[0].d && p_vertices[1].normal[axis] > p_vertices[1].d && p_vertices[2].normal[axis] > p_vertices[2].d)
+			return;
+		if (p_vertices[0].normal[axis] < -p_vertices[0].d && p_vertices[1].normal[axis] < -p_vertices[1].d && p_vertices[2].normal[axis] < -p_vertices[2].d)
+			return;
+	}
+
+	real_t distance[3];
+	bool clipped = false;
+	for (int i = 0; i < 3; i++) {
+		distance[i] = p_vertices[i].normal.z + p_vertices[i].d;
+		clipped = clipped || distance[i] < 0;
+	}
+
+	if (!clipped) {
+		_add_triangle(p_vertices[0], p_vertices[1], p_vertices[2], p_center_edges, p_depth_max);
+		return;
+	}
+
+	// Only the near plane needs clipping, everything else is clamped to the screen when drawing.
+	// Edges keep how they're sampled, the new edge along the near plane is a silhouette.
+	Plane polygon[4];
+	int center[4];
+	int count = 0;
+	for (int i = 0; i < 3; i++) {
+
+		int j = (i + 1) % 3;
+		int center_edge = (p_center_edges >> i) & 1;
+		if (distance[i] >= 0) {
+			center[count] = center_edge;
+			polygon[count++] = p_vertices[i];
+		}
+		if ((distance[i] >= 0) != (distance[j] >= 0)) {
+			real_t t = distance[i] / (distance[i] - distance[j]);
+			center[count] = distance[i] >= 0 ? 0 : center_edge;
+			polygon[count++] = Plane(p_vertices[i].normal.linear_interpolate(p_vertices[j].normal, t), Math::lerp(p_vertices[i].d, p_vertices[j].d, t));
+		}
+	}
+
+	// Both halves of a quad share its diagonal.
+	for (int i = 0; i < count; i++) {
+		p_depth_max = MAX(p_depth_max, polygon[i].d > CMP_EPSILON ? polygon[i].normal.z / polygon[i].d : Math_INF);
+	}
+
+	if (count == 3) {
+		_add_triangle(polygon[0], polygon[1], polygon[2], center[0] | (center[1] << 1) | (center[2] << 2), p_depth_max);
+	} else if (count == 4) {
+		_add_triangle(polygon[0], polygon[1], polygon[2], center[0] | (center[1] << 1) | (1 << 2), p_depth_max);
+		_add_triangle(polygon[0], polygon[2], polygon[3], 1 | (center[2] << 1) | (center[3] << 2), p_depth_max);
+	}
+}
+
+void OcclusionBuffer::_add_triangle(const Plane &p_a, const Plane &p_b, const Plane &p_c, int p_center_edges, float p_depth_max) {
+
+	const Plane *vertices[3] = { &p_a, &p_b, &p_c };
+	float x[3], y[3], z[3];
+
+	for (int i = 0; i < 3; i++) {
+
+		real_t w = vertices[i]->d;
+		if (w <= CMP_EPSILON)
+			return;
+
+		real_t inv_w = 1.0 / w;
+		x[i] = (vertices[i]->normal.x * inv_w * 0.5 + 0.5) * width;
+		y[i] = (0.5 - vertices[i]->normal.y * inv_w * 0.5) * height;
+		z[i] = vertices[i]->normal.z * inv_w;
+	}
+
+	Triangle tri;
+	tri.min_x = MAX(0, (int)Math::floor(MAX(MIN(MIN(x[0], x[1]), x[2]), -1.0f)));
+	tri.max_x = MIN(width - 1, (int)Math::ceil(MIN(MAX(MAX(x[0], x[1]), x[2]), (float)width)));
+	tri.min_y = MAX(0, (int)Math::floor(MAX(MIN(MIN(y[0], y[1]), y[2]), -1.0f)));
+	tri.max_y = MIN(height - 1, (int)Math::ceil(MIN(MAX(MAX(y[0], y[1]), y[2]), (float)height)));
+
+	if (tri.min_x > tri.max_x || tri.min_y > tri.max_y)
+		return;
+
+	// Edge i is the one opposite to vertex i, so it is zero on the other two.
+	for (int i = 0; i < 3; i++) {
+		int j = (i + 1) % 3;
+		int k = (i + 2) % 3;
+		tri.edge_a[i] = y[j] - y[k];
+		tri.edge_b[i] = x[k] - x[j];
+		tri.edge_c[i] = x[j] * y[k] - y[j] * x[k];
+	}
+
+	float area = tri.edge_a[0] * x[0] + tri.edge_b[0] * y[0] + tri.edge_c[0];
+	if (Math::absf(area) < CMP_EPSILON)
+		return;
+
+	// Occluders are double sided, make the inside positive for either winding.
+	if (area < 0) {
+		area = -area;
+		for (int i = 0; i < 3; i++) {
+			tri.edge_a[i] = -tri.edge_a[i];
+			tri.edge_b[i] = -tri.edge_b[i];
+			tri.edge_c[i] = -tri.edge_c[i];
+		}
+	}
+
+	float inv_area = 1.0 / area;
+	tri.depth_a = (tri.edge_a[0] * z[0] + tri.edge_a[1] * z[1] + tri.edge_a[2] * z[2]) * inv_area;
+	tri.depth_b = (tri.edge_b[0] * z[0] + tri.edge_b[1] * z[1] + tri.edge_b[2] * z[2]) * inv_area;
+	tri.depth_c = (tri.edge_c[0] * z[0] + tri.edge_c[1] * z[1] + tri.edge_c[2] * z[2]) * inv_area;
+	tri.depth_max = MAX(MAX(MAX(z[0], z[1]), z[2]), p_depth_max);
+
+	// A texel is only written when the whole of it is inside, so silhouette edges are tested at the
+	// texel corner that is farthest outside. The depth is pushed to the farthest corner of the texel.
+	for (int i = 0; i < 3; i++) {
+		// Edge i goes from vertex i + 1 to vertex i + 2.
+		if (p_center_edges & (1 << ((i + 1) % 3))) {
+			tri.edge_c[i] += (tri.edge_a[i] + tri.edge_b[i]) * 0.5;
+		} else {
+			tri.edge_c[i] += MIN(tri.edge_a[i], 0.0f) + MIN(tri.edge_b[i], 0.0f);
+		}
+	}
+	tri.depth_c += (tri.depth_a + tri.depth_b + Math::absf(tri.depth_a) + Math::absf(tri.depth_b)) * 0.5;
+
+	if (triangle_count == triangles.size()) {
+		triangles.resize(MAX(triangle_count * 2, 64));
+	}
+	triangles.write[triangle_count++] = tri;
+}
+
+int OcclusionBuffer::get_band_count() const {
+
+	return (height + BAND_HEIGHT - 1) / BAND_HEIGHT;
+}
+
+void OcclusionBuffer::rasterize_band(uint32_t p_band, void *p_userdata) {
+
+	int y_begin = p_band * BAND_HEIGHT;
+	int y_end = MIN(y_begin + (int)BAND_HEIGHT, height);
+
+	for (int i = y_begin * width; i < y_end * width; i++) {
+		depth[i] = Math_INF;
+	}
+
+	const Triangle *tris = triangles.ptr();
+
+	for (int t = 0; t < triangle_count; t++) {
+
+		const Triangle &tri = tris[t];
+
+		int from_y = MAX(tri.min_y, y_begin);
+		int to_y = MIN(tri.max_y + 1, y_end);
+
+#if defined(OCCLUSION_BUFFER_SSE) || defined(OCCLUSION_BUFFER_NEON)
+		// Blocks of four start aligned, the width is a multiple of four so they never pass the row end.
+		int from_x = tri.min_x & ~3;
+#else
+		int from_x = tri.min_x;
+#endif
+
+		for (int y = from_y; y < to_y; y++) {
+
+			float *row = depth + y * width;
+			float e0 = tri.edge_a[0] * from_x + tri.edge_b[0] * y + tri.edge_c[0];
+			float e1 = tri.edge_a[1] * from_x + tri.edge_b[1] * y + tri.edge_c[1];
+			float e2 = tri.edge_a[2] * from_x + tri.edge_b[2] * y + tri.edge_c[2];
+			float z = tri.depth_a * from_x + tri.depth_b * y + tri.depth_c;
+
+#if defined(OCCLUSION_BUFFER_SSE)
+			const __m128 steps = _mm_set_ps(3, 2, 1, 0);
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 depth_max = _mm_set1_ps(tri.depth_max);
+			__m128 v_e0 = _mm_add_ps(_mm_set1_ps(e0), _mm_mul_ps(_mm_set1_ps(tri.edge_a[0]), steps));
+			__m128 v_e1 = _mm_add_ps(_mm_set1_ps(e1), _mm_mul_ps(_mm_set1_ps(tri.edge_a[1]), steps));
+			__m128 v_e2 = _mm_add_ps(_mm_set1_ps(e2), _mm_mul_ps(_mm_set1_ps(tri.edge_a[2]), steps));
+			__m128 v_z = _mm_add_ps(_mm_set1_ps(z), _mm_mul_ps(_mm_set1_ps(tri.depth_a), steps));
+			const __m128 step_e0 = _mm_set1_ps(tri.edge_a[0] * 4);
+			const __m128 step_e1 = _mm_set1_ps(tri.edge_a[1] * 4);
+			const __m128 step_e2 = _mm_set1_ps(tri.edge_a[2] * 4);
+			const __m128 step_z = _mm_set1_ps(tri.depth_a * 4);
+
+			for (int x = from_x; x <= tri.max_x; x += 4) {
+				__m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(v_e0, zero), _mm_cmpge_ps(v_e1, zero)), _mm_cmpge_ps(v_e2, zero));
+				__m128 old = _mm_loadu_ps(row + x);
+				__m128 written = _mm_min_ps(old, _mm_min_ps(v_z, depth_max));
+				_mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, written), _mm_andnot_ps(inside, old)));
+
+				v_e0 = _mm_add_ps(v_e0, step_e0);
+				v_e1 = _mm_add_ps(v_e1, step_e1);
+				v_e2 = _mm_add_ps(v_e2, step_e2);
+				v_z = _mm_add_ps(v_z, step_z);
+			}
+#elif defined(OCCLUSION_BUFFER_NEON)
+			const float steps_array[4] = { 0, 1, 2, 3 };
+			const float32x4_t steps = vld1q_f32(steps_array);
+			const float32x4_t zero = vdupq_n_f32(0);
+			const float32x4_t depth_max = vdupq_n_f32(tri.depth_max);
+			float32x4_t v_e0 = vmlaq_n_f32(vdupq_n_f32(e0), steps, tri.edge_a[0]);
+			float32x4_t v_e1 = vmlaq_n_f32(vdupq_n_f32(e1), steps, tri.edge_a[1]);
+			float32x4_t v_e2 = vmlaq_n_f32(vdupq_n_f32(e2), steps, tri.edge_a[2]);
+			float32x4_t v_z = vmlaq_n_f32(vdupq_n_f32(z), steps, tri.depth_a);
+			const float32x4_t step_e0 = vdupq_n_f32(tri.edge_a[0] * 4);
+			const float32x4_t step_e1 = vdupq_n_f32(tri.edge_a[1] * 4);
+			const float32x4_t step_e2 = vdupq_n_f32(tri.edge_a[2] * 4);
+			const float32x4_t step_z = vdupq_n_f32(tri.depth_a * 4);
+
+			for (int x = from_x; x <= tri.max_x; x += 4) {
+				uint32x4_t inside = vandq_u32(vandq_u32(vcgeq_f32(v_e0, zero), vcgeq_f32(v_e1, zero)), vcgeq_f32(v_e2, zero));
+				float32x4_t old = vld1q_f32(row + x);
+				float32x4_t written = vminq_f32(old, vminq_f32(v_z, depth_max));
+				vst1q_f32(row + x, vbslq_f32(inside, written, old));
+
+				v_e0 = vaddq_f32(v_e0, step_e0);
+				v_e1 = vaddq_f32(v_e1, step_e1);
+				v_e2 = vaddq_f32(v_e2, step_e2);
+				v_z = vaddq_f32(v_z, step_z);
+			}
+#else
+			for (int x = from_x; x <= tri.max_x; x++) {
+				if (e0 >= 0 && e1 >= 0 && e2 >= 0) {
+					row[x] = MIN(row[x], MIN(z, tri.depth_max));
+				}
+
+				e0 += tri.edge_a[0];
+				e1 += tri.edge_a[1];
+				e2 += tri.edge_a[2];
+				z += tri.depth_a;
+			}
+#endif
+		}
+	}
+}
+
+void OcclusionBuffer::finish() {
+
+	for (int i = 1; i < level_count; i++) {
+
+		const Level &src = levels[i - 1];
+		const Level &dst = levels[i];
+		const float *src_depth = depth + src.offset;
+		float *dst_depth = depth + dst.offset;
+
+		for (int y = 0; y < dst.height; y++) {
+
+			const float *row_a = src_depth + (y * 2) * src.width;
+			const float *row_b = src_depth + MIN(y * 2 + 1, src.height - 1) * src.width;
+
+			for (int x = 0; x < dst.width; x++) {
+				int x_a = x * 2;
+				int x_b = MIN(x_a + 1, src.width - 1);
+				dst_depth[y * dst.width + x] = MAX(MAX(row_a[x_a], row_a[x_b]), MAX(row_b[x_a], row_b[x_b]));
+			}
+		}
+	}
+}
+
+bool OcclusionBuffer::is_occluded(const AABB &p_aabb) const {
+
+	if (triangle_count == 0)
+		return false;
+
+	real_t min_x = 1e20, max_x = -1e20;
+	real_t min_y = 1e20, max_y = -1e20;
+	real_t min_z = 1e20;
+
+	for (int i = 0; i < 8; i++) {
+
+		Plane p = view_projection.xform4(Plane(p_aabb.get_endpoint(i), 1.0));
+		if (p.normal.z < -p.d || p.d <= CMP_EPSILON)
+			return false; // crosses the near plane
+
+		real_t inv_w = 1.0 / p.d;
+		real_t x = (p.normal.x * inv_w * 0.5 + 0.5) * width;
+		real_t y = (0.5 - p.normal.y * inv_w * 0.5) * height;
+		min_x = MIN(min_x, x);
+		max_x = MAX(max_x, x);
+		min_y = MIN(min_y, y);
+		max_y = MAX(max_y, y);
+		min_z = MIN(min_z, p.normal.z * inv_w);
+	}
+
+	if (max_x <= 0 || max_y <= 0 || min_x >= width || min_y >= height)
+		return false;
+
+	int x0 = (int)Math::floor(MAX(min_x, (real_t)0));
+	int y0 = (int)Math::floor(MAX(min_y, (real_t)0));
+	int x1 = MAX(x0, (int)Math::ceil(MIN(max_x, (real_t)width)) - 1);
+	int y1 = MAX(y0, (int)Math::ceil(MIN(max_y, (real_t)height)) - 1);
+
+	// Use the level where the box covers at most 4x4 texels.
+	int level = 0;
+	while (level < level_count - 1 && (x1 - x0 >= 4 || y1 - y0 >= 4)) {
+		level++;
+		x0 >>= 1;
+		y0 >>= 1;
+		x1 >>= 1;
+		y1 >>= 1;
+	}
+
+	const Level &lv = levels[level];
+	const float *level_depth = depth + lv.offset;
+
+	for (int y = y0; y <= y1; y++) {
+		for (int x = x0; x <= x1; x++) {
+			if (min_z <= level_depth[y * lv.width + x])
+				return false;
+		}
+	}
+
+	return true;
+}
+
+OcclusionBuffer::OcclusionBuffer() {
+
+	width = 0;
+	height = 0;
+	level_count = 0;
+	depth = NULL;
+	triangle_count = 0;
+}
+
+OcclusionBuffer::~OcclusionBuffer() {
+
+	if (depth) {
+		memdelete_arr(depth);
+	}
+}
@@ -0,0 +1,124 @@
+/*************************************************************************/
+/*  occlusion_buffer.h                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef OCCLUSION_BUFFER_H
+#define OCCLUSION_BUFFER_H
+
+#include "core/math/aabb.h"
+#include "core/math/camera_matrix.h"
+#include "core/vector.h"
+
+/**
+ * Low resolution depth buffer for software occlusion culling.
+ *
+ * Occluder triangles are clipped and set up on the calling thread, then drawn
+ * in horizontal bands that can be rasterized in parallel. Each texel keeps the
+ * farthest depth the occluders can have inside it, and every coarser level keeps
+ * the farthest depth of its children, so an AABB is tested against the few
+ * texels of the level that matches its size on screen.
+ *
+ * Only texels fully covered by an occluder are written. Edges shared with a
+ * coplanar triangle of the same occluder are sampled at texel centers instead,
+ * as the neighbor covers the other side, so flat occluders have no seams.
+ *
+ * Depth is stored as normalized device Z, which is linear in screen space for
+ * both perspective and orthogonal projections.
+ */
+
+class OcclusionBuffer {
+public:
+	enum {
+		BAND_HEIGHT = 8,
+		MAX_LEVELS = 6,
+	};
+
+private:
+	struct Triangle {
+		// Edge functions and depth plane, offset so a texel is tested at its top left corner.
+		float edge_a[3];
+		float edge_b[3];
+		float edge_c[3];
+		float depth_a;
+		float depth_b;
+		float depth_c;
+		float depth_max;
+		int min_x, max_x;
+		int min_y, max_y;
+	};
+
+	struct Level {
+		int width;
+		int height;
+		int offset;
+	};
+
+	int width;
+	int height;
+	int level_count;
+	Level levels[MAX_LEVELS];
+	float *depth;
+
+	CameraMatrix view_projection;
+
+	Vector<Plane> clip_vertices;
+	Vector<float> vertex_depth;
+	Vector<Triangle> triangles;
+	int triangle_count;
+
+	// Bit i of p_center_edges is set when the edge from vertex i to the next one is sampled at texel centers.
+	void _add_triangle(const Plane &p_a, const Plane &p_b, const Plane &p_c, int p_center_edges, float p_depth_max);
+	void _add_clipped_triangle(const Plane *p_vertices, int p_center_edges, float p_depth_max);
+
+public:
+	void set_size(int p_width, int p_height);
+	int get_width() const { return width; }
+	int get_height() const { return height; }
+
+	void begin(const CameraMatrix &p_projection, const Transform &p_cam_transform);
+	// p_neighbors comes from get_coplanar_neighbors(), or is NULL to treat every edge as a silhouette.
+	void add_occluder(const Transform &p_xform, const Vector3 *p_vertices, int p_vertex_count, const int *p_indices, int p_index_count, const int *p_neighbors = NULL);
+	int get_triangle_count() const { return triangle_count; }
+
+	// For each triangle edge, the coplanar triangle on its other side, or -1.
+	static void get_coplanar_neighbors(const Vector3 *p_vertices, int p_vertex_count, const int *p_indices, int p_index_count, Vector<int> &r_neighbors);
+
+	// Bands don't overlap, so they can be rasterized from different threads.
+	int get_band_count() const;
+	void rasterize_band(uint32_t p_band, void *p_userdata = NULL);
+	void finish();
+
+	// Safe to call from several threads once the buffer is finished.
+	bool is_occluded(const AABB &p_aabb) const;
+
+	OcclusionBuffer();
+	~OcclusionBuffer();
+};
+
+#endif // OCCLUSION_BUFFER_H
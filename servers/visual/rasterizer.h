@@ -114,6 +114,7 @@ public:
 		bool redraw_if_visible : 4;
 
 		float depth; //used for sorting
+		int lod_level; //0 is the full mesh, picked each frame from the size on screen
 
 		SelfList<InstanceBase> dependency_item;
 
@@ -131,6 +132,7 @@ public:
 			receive_shadows = true;
 			visible = true;
 			depth_layer = 0;
+			lod_level = 0;
 			layer_mask = 1;
 			baked_light = false;
 			redraw_if_visible = false;
@@ -294,9 +296,15 @@ public:
 	virtual Vector<PoolVector<uint8_t> > mesh_surface_get_blend_shapes(RID p_mesh, int p_surface) const = 0;
 	virtual Vector<AABB> mesh_surface_get_skeleton_aabb(RID p_mesh, int p_surface) const = 0;
 
+	virtual void mesh_surface_set_lods(RID p_mesh, int p_surface, const Vector<PoolVector<uint8_t> > &p_index_arrays) = 0;
+	virtual Vector<PoolVector<uint8_t> > mesh_surface_get_lods(RID p_mesh, int p_surface) const = 0;
+
 	virtual void mesh_remove_surface(RID p_mesh, int p_index) = 0;
 	virtual int mesh_get_surface_count(RID p_mesh) const = 0;
 
+	virtual void mesh_set_lod_errors(RID p_mesh, const Vector<float> &p_errors) = 0;
+	virtual Vector<float> mesh_get_lod_errors(RID p_mesh) const = 0;
+
 	virtual void mesh_set_custom_aabb(RID p_mesh, const AABB &p_aabb) = 0;
 	virtual AABB mesh_get_custom_aabb(RID p_mesh) const = 0;
 
@@ -81,6 +81,309 @@ void _mark_ysort_dirty(VisualServerCanvas::Item *ysort_owner, RID_Owner<VisualSe
 	} while (ysort_owner && ysort_owner->sort_y);
 }
 
+void VisualServerCanvas::_mark_subtree_dirty(Item *p_item) {
+
+	while (p_item && !p_item->subtree_dirty) {
+
+		p_item->subtree_dirty = true;
+
+		Item *parent = p_item->parent_item;
+		if (parent && parent->child_grid) {
+			parent->child_grid->dirty.push_back(p_item);
+		}
+		p_item = parent;
+	}
+}
+
+static _FORCE_INLINE_ uint64_t _grid_cell_key(int p_x, int p_y) {
+
+	return (uint64_t(uint32_t(p_x)) << 32) | uint64_t(uint32_t(p_y));
+}
+
+static _FORCE_INLINE_ int _grid_cell_coord(real_t p_pos, real_t p_cell_size) {
+
+	// Clamped so huge rects don't overflow, they end up spanning too many cells anyway.
+	return (int)CLAMP(Math::floor(p_pos / p_cell_size), -1e9, 1e9);
+}
+
+static _FORCE_INLINE_ Rect2i _grid_cell_range(const Rect2 &p_rect, real_t p_cell_size) {
+
+	int from_x = _grid_cell_coord(p_rect.position.x, p_cell_size);
+	int from_y = _grid_cell_coord(p_rect.position.y, p_cell_size);
+	int to_x = _grid_cell_coord(p_rect.position.x + p_rect.size.x, p_cell_size);
+	int to_y = _grid_cell_coord(p_rect.position.y + p_rect.size.y, p_cell_size);
+	return Rect2i(from_x, from_y, to_x - from_x + 1, to_y - from_y + 1);
+}
+
+void VisualServerCanvas::_grid_insert(ItemGrid *p_grid, Item *p_item) {
+
+	p_item->grid_inserted = false;
+	p_item->grid_large = false;
+
+	if (!p_item->visible || (!p_item->subtree_has_rect && !p_item->subtree_unbounded))
+		return; //draws nothing
+
+	p_item->grid_inserted = true;
+
+	if (p_item->subtree_has_rect) {
+		if (p_grid->has_bounds) {
+			p_grid->bounds = p_grid->bounds.merge(p_item->subtree_rect);
+		} else {
+			p_grid->bounds = p_item->subtree_rect;
+			p_grid->has_bounds = true;
+		}
+	}
+
+	if (!p_item->subtree_unbounded) {
+		p_item->grid_cells = _grid_cell_range(p_item->subtree_rect, p_grid->cell_size);
+	}
+
+	if (p_item->subtree_unbounded || p_item->grid_cells.size.x > ITEM_GRID_MAX_CELLS || p_item->grid_cells.size.y > ITEM_GRID_MAX_CELLS) {
+
+		p_item->grid_large = true;
+		p_grid->large.push_back(p_item);
+		if (p_item->subtree_unbounded) {
+			p_grid->unbounded_count++;
+		}
+		return;
+	}
+
+	for (int i = 0; i < p_item->grid_cells.size.x; i++) {
+		for (int j = 0; j < p_item->grid_cells.size.y; j++) {
+
+			uint64_t key = _grid_cell_key(p_item->grid_cells.position.x + i, p_item->grid_cells.position.y + j);
+			Vector<Item *> *cell = p_grid->cells.getptr(key);
+			if (!cell) {
+				p_grid->cells[key] = Vector<Item *>();
+				cell = p_grid->cells.getptr(key);
+			}
+			cell->push_back(p_item);
+		}
+	}
+}
+
+void VisualServerCanvas::_grid_remove(ItemGrid *p_grid, Item *p_item) {
+
+	if (!p_item->grid_inserted)
+		return;
+
+	p_item->grid_inserted = false;
+
+	if (p_item->grid_large) {
+
+		p_grid->large.erase(p_item);
+		if (p_item->subtree_unbounded) {
+			p_grid->unbounded_count--;
+		}
+		return;
+	}
+
+	for (int i = 0; i < p_item->grid_cells.size.x; i++) {
+		for (int j = 0; j < p_item->grid_cells.size.y; j++) {
+
+			uint64_t key = _grid_cell_key(p_item->grid_cells.position.x + i, p_item->grid_cells.position.y + j);
+			Vector<Item *> *cell = p_grid->cells.getptr(key);
+			ERR_CONTINUE(!cell);
+
+			int idx = cell->find(p_item);
+			ERR_CONTINUE(idx == -1);
+			cell->set(idx, (*cell)[cell->size() - 1]);
+			cell->resize(cell->size() - 1);
+
+			if (cell->empty()) {
+				p_grid->cells.erase(key);
+			}
+		}
+	}
+}
+
+void VisualServerCanvas::_grid_rebuild(Item *p_item) {
+
+	ItemGrid *grid = p_item->child_grid;
+
+	// Children may have been freed or moved to other parents since, so nothing is removed one by one.
+	grid->cells.clear();
+	grid->large.clear();
+	grid->dirty.clear();
+	grid->has_bounds = false;
+	grid->unbounded_count = 0;
+	grid->moves = 0;
+	grid->rebuild = false;
+
+	int child_count = p_item->child_items.size();
+	Item **children = p_item->child_items.ptrw();
+
+	real_t size_sum = 0;
+	int size_count = 0;
+
+	for (int i = 0; i < child_count; i++) {
+
+		Item *child = children[i];
+		if (child->subtree_dirty) {
+			_update_subtree_rect(child);
+		}
+		child->grid_inserted = false;
+
+		if (child->visible && child->subtree_has_rect) {
+			size_sum += MAX(child->subtree_rect.size.x, child->subtree_rect.size.y);
+			size_count++;
+		}
+	}
+
+	// Cells about twice the size of an average child keep most children in one to four cells.
+	grid->cell_size = size_count ? size_sum * 2.0 / size_count : 1.0;
+	if (grid->cell_size < CMP_EPSILON) {
+		grid->cell_size = 1.0;
+	}
+
+	for (int i = 0; i < child_count; i++) {
+		_grid_insert(grid, children[i]);
+	}
+}
+
+void VisualServerCanvas::_grid_cull(ItemGrid *p_grid, const Rect2 &p_rect, Vector<Item *> &r_items) {
+
+	p_grid->pass++;
+
+	for (int i = 0; i < p_grid->large.size(); i++) {
+
+		Item *child = p_grid->large[i];
+		child->grid_pass = p_grid->pass;
+		r_items.push_back(child);
+	}
+
+	Rect2i range = _grid_cell_range(p_rect, p_grid->cell_size);
+
+	if (int64_t(range.size.x) * range.size.y > p_grid->cells.size()) {
+
+		// The view spans more cells than are used, so go through the used ones instead.
+		const uint64_t *key = NULL;
+		while ((key = p_grid->cells.next(key))) {
+
+			const Vector<Item *> &cell = p_grid->cells[*key];
+			for (int i = 0; i < cell.size(); i++) {
+
+				Item *child = cell[i];
+				if (child->grid_pass != p_grid->pass && p_rect.intersects_touch(child->subtree_rect)) {
+					child->grid_pass = p_grid->pass;
+					r_items.push_back(child);
+				}
+			}
+		}
+	} else {
+
+		for (int i = 0; i < range.size.x; i++) {
+			for (int j = 0; j < range.size.y; j++) {
+
+				const Vector<Item *> *cell = p_grid->cells.getptr(_grid_cell_key(range.position.x + i, range.position.y + j));
+				if (!cell)
+					continue;
+
+				for (int k = 0; k < cell->size(); k++) {
+
+					Item *child = (*cell)[k];
+					if (child->grid_pass != p_grid->pass && p_rect.intersects_touch(child->subtree_rect)) {
+						child->grid_pass = p_grid->pass;
+						r_items.push_back(child);
+					}
+				}
+			}
+		}
+	}
+
+	// Draw order is by index, same as child_items.
+	SortArray<Item *, ItemIndexSort> sorter;
+	sorter.sort(r_items.ptrw(), r_items.size());
+}
+
+void VisualServerCanvas::_update_subtree_rect(Item *p_item) {
+
+	Item *ci = p_item;
+
+	ci->subtree_dirty = false;
+
+	// These draw or have side effects regardless of where they are.
+	bool unbounded = ci->copy_back_buffer || ci->vp_render || ci->update_when_visible;
+
+	Rect2 rect;
+	bool has_rect = false;
+
+	if (!ci->commands.empty()) {
+		rect = ci->get_rect();
+		has_rect = true;
+	}
+
+	int child_count = ci->child_items.size();
+	Item **children = ci->child_items.ptrw();
+
+	bool use_grid = !ci->sort_y && child_count >= ITEM_GRID_MIN_CHILDREN;
+
+	if (use_grid && !ci->child_grid) {
+		ci->child_grid = memnew(ItemGrid);
+	} else if (!use_grid && ci->child_grid) {
+		memdelete(ci->child_grid);
+		ci->child_grid = NULL;
+	}
+
+	if (ci->child_grid) {
+
+		ItemGrid *grid = ci->child_grid;
+
+		if (grid->rebuild || grid->moves > child_count) {
+			_grid_rebuild(ci);
+		} else {
+
+			// Bounds only grow here, they are made tight again on rebuild.
+			for (int i = 0; i < grid->dirty.size(); i++) {
+
+				Item *child = grid->dirty[i];
+				if (!child->subtree_dirty)
+					continue; // already updated
+				_grid_remove(grid, child);
+				_update_subtree_rect(child);
+				_grid_insert(grid, child);
+				grid->moves++;
+			}
+			grid->dirty.clear();
+		}
+
+		if (grid->unbounded_count) {
+			unbounded = true;
+		}
+		if (grid->has_bounds) {
+			rect = has_rect ? rect.merge(grid->bounds) : grid->bounds;
+			has_rect = true;
+		}
+
+	} else {
+
+		for (int i = 0; i < child_count; i++) {
+
+			Item *child = children[i];
+			if (child->subtree_dirty) {
+				_update_subtree_rect(child);
+			}
+
+			if (!child->visible)
+				continue;
+
+			if (child->subtree_unbounded) {
+				unbounded = true;
+			}
+			if (child->subtree_has_rect) {
+				rect = has_rect ? rect.merge(child->subtree_rect) : child->subtree_rect;
+				has_rect = true;
+			}
+		}
+	}
+
+	ci->subtree_unbounded = unbounded;
+	ci->subtree_has_rect = has_rect;
+	if (has_rect) {
+		ci->subtree_rect = ci->xform.xform(rect);
+	}
+}
+
 void VisualServerCanvas::_render_canvas_item(Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RasterizerCanvas::Item **z_list, RasterizerCanvas::Item **z_last_list, Item *p_canvas_clip, Item *p_material_owner) {
 
 	Item *ci = p_canvas_item;
@@ -88,6 +391,23 @@ void VisualServerCanvas::_render_canvas_item(Item *p_canvas_item, const Transfor
 	if (!ci->visible)
 		return;
 
+	if (spatial_index) {
+
+		if (ci->subtree_dirty) {
+			_update_subtree_rect(ci);
+		}
+
+		if (!ci->subtree_unbounded) {
+			// Same test as for the item's own rect below, on everything it and its children draw.
+			if (!ci->subtree_has_rect)
+				return;
+			Rect2 subtree_rect = p_transform.xform(ci->subtree_rect);
+			subtree_rect.position += p_clip_rect.position;
+			if (!p_clip_rect.intersects_touch(subtree_rect))
+				return;
+		}
+	}
+
 	if (ci->children_order_dirty) {
 
 		ci->child_items.sort_custom<ItemIndexSort>();
@@ -113,6 +433,7 @@ void VisualServerCanvas::_render_canvas_item(Item *p_canvas_item, const Transfor
 
 	int child_item_count = ci->child_items.size();
 	Item **child_items = ci->child_items.ptrw();
+	Vector<Item *> culled_children;
 
 	if (ci->clip) {
 		if (p_canvas_clip != NULL) {
@@ -141,6 +462,14 @@ void VisualServerCanvas::_render_canvas_item(Item *p_canvas_item, const Transfor
 
 		SortArray<Item *, ItemPtrSort> sorter;
 		sorter.sort(child_items, child_item_count);
+
+	} else if (spatial_index && ci->child_grid && Math::abs(xform.basis_determinant()) > CMP_EPSILON) {
+
+		// Only the children near the view, in local space.
+		Rect2 local_clip = xform.affine_inverse().xform(Rect2(Point2(), p_clip_rect.size));
+		_grid_cull(ci->child_grid, local_clip, culled_children);
+		child_item_count = culled_children.size();
+		child_items = culled_children.ptrw();
 	}
 
 	if (ci->z_relative)
@@ -229,6 +558,8 @@ void VisualServerCanvas::render_canvas(Canvas *p_canvas, const Transform2D &p_tr
 
 	VSG::canvas_render->canvas_begin();
 
+	spatial_index = p_canvas->use_spatial_index;
+
 	if (p_canvas->children_order_dirty) {
 
 		p_canvas->child_items.sort();
@@ -329,6 +660,13 @@ void VisualServerCanvas::canvas_set_disable_scale(bool p_disable) {
 	disable_scale = p_disable;
 }
 
+void VisualServerCanvas::canvas_set_use_spatial_index(RID p_canvas, bool p_enable) {
+
+	Canvas *canvas = canvas_owner.getornull(p_canvas);
+	ERR_FAIL_COND(!canvas);
+	canvas->use_spatial_index = p_enable;
+}
+
 void VisualServerCanvas::canvas_set_parent(RID p_canvas, RID p_parent, float p_scale) {
 
 	Canvas *canvas = canvas_owner.get(p_canvas);
@@ -365,9 +703,15 @@ void VisualServerCanvas::canvas_item_set_parent(RID p_item, RID p_parent) {
 			if (item_owner->sort_y) {
 				_mark_ysort_dirty(item_owner, canvas_item_owner);
 			}
+
+			if (item_owner->child_grid) {
+				item_owner->child_grid->rebuild = true;
+			}
+			_mark_subtree_dirty(item_owner);
 		}
 
 		canvas_item->parent = RID();
+		canvas_item->parent_item = NULL;
 	}
 
 	if (p_parent.is_valid()) {
@@ -388,6 +732,12 @@ void VisualServerCanvas::canvas_item_set_parent(RID p_item, RID p_parent) {
 				_mark_ysort_dirty(item_owner, canvas_item_owner);
 			}
 
+			if (item_owner->child_grid) {
+				item_owner->child_grid->rebuild = true;
+			}
+			canvas_item->parent_item = item_owner;
+			_mark_subtree_dirty(item_owner);
+
 		} else {
 
 			ERR_FAIL_MSG("Invalid parent.");
@@ -404,6 +754,7 @@ void VisualServerCanvas::canvas_item_set_visible(RID p_item, bool p_visible) {
 	canvas_item->visible = p_visible;
 
 	_mark_ysort_dirty(canvas_item, canvas_item_owner);
+	_mark_subtree_dirty(canvas_item);
 }
 void VisualServerCanvas::canvas_item_set_light_mask(RID p_item, int p_mask) {
 
@@ -419,6 +770,7 @@ void VisualServerCanvas::canvas_item_set_transform(RID p_item, const Transform2D
 	ERR_FAIL_COND(!canvas_item);
 
 	canvas_item->xform = p_transform;
+	_mark_subtree_dirty(canvas_item);
 }
 void VisualServerCanvas::canvas_item_set_clip(RID p_item, bool p_clip) {
 
@@ -441,6 +793,7 @@ void VisualServerCanvas::canvas_item_set_custom_rect(RID p_item, bool p_custom_r
 
 	canvas_item->custom_rect = p_custom_rect;
 	canvas_item->rect = p_rect;
+	_mark_subtree_dirty(canvas_item);
 }
 void VisualServerCanvas::canvas_item_set_modulate(RID p_item, const Color &p_color) {
 
@@ -471,6 +824,7 @@ void VisualServerCanvas::canvas_item_set_update_when_visible(RID p_item, bool p_
 	ERR_FAIL_COND(!canvas_item);
 
 	canvas_item->update_when_visible = p_update;
+	_mark_subtree_dirty(canvas_item);
 }
 
 void VisualServerCanvas::canvas_item_add_line(RID p_item, const Point2 &p_from, const Point2 &p_to, const Color &p_color, float p_width, bool p_antialiased) {
@@ -486,6 +840,7 @@ void VisualServerCanvas::canvas_item_add_line(RID p_item, const Point2 &p_from,
 	line->width = p_width;
 	line->antialiased = p_antialiased;
 	canvas_item->rect_dirty = true;
+	_mark_subtree_dirty(canvas_item);
 
 	canvas_item->commands.push_back(line);
 }
@@ -572,6 +927,7 @@ void VisualServerCanvas::canvas_item_add_polyline(RID p_item, const Vector<Point
 		}
 	}
 	canvas_item->rect_dirty = true;
+	_mark_subtree_dirty(canvas_item);
 	canvas_item->commands.push_back(pline);
 }
 
@@ -596,6 +952,7 @@ void VisualServerCanvas::canvas_item_add_multiline(RID p_item, const Vector<Poin
 	}
 
 	canvas_item->rect_dirty = true;
+	_mark_subtree_dirty(canvas_item);
 	canvas_item->commands.push_back(pline);
 }
 
@@ -609,6 +966,7 @@ void VisualServerCanvas::canvas_item_add_rect(RID p_item, const Rect2 &p_rect, c
 	rect->modulate = p_color;
 	rect->rect = p_rect;
 	canvas_item->rect_dirty = true;
+	_mark_subtree_dirty(canvas_item);
 
 	canvas_item->commands.push_back(rect);
 }
@@ -660,6 +1018,7 @@ void VisualServerCanvas::canvas_item_add_texture_rect(RID p_item, const Rect2 &p
 	rect->texture = p_texture;
 	rect->normal_map = p_normal_map;
 	canvas_item->rect_dirty = true;
+	_mark_subtree_dirty(canvas_item);
 	canvas_item->commands.push_back(rect);
 }
 
@@ -708,6 +1067,7 @@ void VisualServerCanvas::canvas_item_add_texture_rect_region(RID p_item, const R
 	}
 
 	canvas_item->rect_dirty = true;
+	_mark_subtree_dirty(canvas_item);
 
 	canvas_item->commands.push_back(rect);
 }
@@ -732,6 +1092,7 @@ void VisualServerCanvas::canvas_item_add_nine_patch(RID p_item, const Rect2 &p_r
 	style->axis_x = p_x_axis_mode;
 	style->axis_y = p_y_axis_mode;
 	canvas_item->rect_dirty = true;
+	_mark_subtree_dirty(canvas_item);
 
 	canvas_item->commands.push_back(style);
 }
@@ -749,6 +1110,7 @@ void VisualServerCanvas::canvas_item_add_primitive(RID p_item, const Vector<Poin
 	prim->colors = p_colors;
 	prim->width = p_width;
 	canvas_item->rect_dirty = true;
+	_mark_subtree_dirty(canvas_item);
 
 	canvas_item->commands.push_back(prim);
 }
@@ -780,6 +1142,7 @@ void VisualServerCanvas::canvas_item_add_polygon(RID p_item, const Vector<Point2
 	polygon->antialiased = p_antialiased;
 	polygon->antialiasing_use_indices = false;
 	canvas_item->rect_dirty = true;
+	_mark_subtree_dirty(canvas_item);
 
 	canvas_item->commands.push_back(polygon);
 }
@@ -826,6 +1189,7 @@ void VisualServerCanvas::canvas_item_add_triangle_array(RID p_item, const Vector
 	polygon->antialiased = p_antialiased;
 	polygon->antialiasing_use_indices = p_antialiasing_use_indices;
 	canvas_item->rect_dirty = true;
+	_mark_subtree_dirty(canvas_item);
 
 	canvas_item->commands.push_back(polygon);
 }
@@ -840,6 +1204,7 @@ void VisualServerCanvas::canvas_item_add_set_transform(RID p_item, const Transfo
 	tr->xform = p_transform;
 
 	canvas_item->commands.push_back(tr);
+	_mark_subtree_dirty(canvas_item);
 }
 
 void VisualServerCanvas::canvas_item_add_mesh(RID p_item, const RID &p_mesh, const Transform2D &p_transform, const Color &p_modulate, RID p_texture, RID p_normal_map) {
@@ -856,6 +1221,7 @@ void VisualServerCanvas::canvas_item_add_mesh(RID p_item, const RID &p_mesh, con
 	m->modulate = p_modulate;
 
 	canvas_item->commands.push_back(m);
+	_mark_subtree_dirty(canvas_item);
 }
 void VisualServerCanvas::canvas_item_add_particles(RID p_item, RID p_particles, RID p_texture, RID p_normal) {
 
@@ -872,6 +1238,7 @@ void VisualServerCanvas::canvas_item_add_particles(RID p_item, RID p_particles,
 	VSG::storage->particles_request_process(p_particles);
 
 	canvas_item->rect_dirty = true;
+	_mark_subtree_dirty(canvas_item);
 	canvas_item->commands.push_back(part);
 }
 
@@ -887,6 +1254,7 @@ void VisualServerCanvas::canvas_item_add_multimesh(RID p_item, RID p_mesh, RID p
 	mm->normal_map = p_normal_map;
 
 	canvas_item->rect_dirty = true;
+	_mark_subtree_dirty(canvas_item);
 	canvas_item->commands.push_back(mm);
 }
 
@@ -900,6 +1268,7 @@ void VisualServerCanvas::canvas_item_add_clip_ignore(RID p_item, bool p_ignore)
 	ci->ignore = p_ignore;
 
 	canvas_item->commands.push_back(ci);
+	_mark_subtree_dirty(canvas_item);
 }
 void VisualServerCanvas::canvas_item_set_sort_children_by_y(RID p_item, bool p_enable) {
 
@@ -909,6 +1278,7 @@ void VisualServerCanvas::canvas_item_set_sort_children_by_y(RID p_item, bool p_e
 	canvas_item->sort_y = p_enable;
 
 	_mark_ysort_dirty(canvas_item, canvas_item_owner);
+	_mark_subtree_dirty(canvas_item);
 }
 void VisualServerCanvas::canvas_item_set_z_index(RID p_item, int p_z) {
 
@@ -952,6 +1322,8 @@ void VisualServerCanvas::canvas_item_set_copy_to_backbuffer(RID p_item, bool p_e
 		canvas_item->copy_back_buffer->rect = p_rect;
 		canvas_item->copy_back_buffer->full = p_rect == Rect2();
 	}
+
+	_mark_subtree_dirty(canvas_item);
 }
 
 void VisualServerCanvas::canvas_item_clear(RID p_item) {
@@ -960,6 +1332,7 @@ void VisualServerCanvas::canvas_item_clear(RID p_item) {
 	ERR_FAIL_COND(!canvas_item);
 
 	canvas_item->clear();
+	_mark_subtree_dirty(canvas_item);
 }
 void VisualServerCanvas::canvas_item_set_draw_index(RID p_item, int p_index) {
 
@@ -1389,12 +1762,18 @@ bool VisualServerCanvas::free(RID p_rid) {
 				if (item_owner->sort_y) {
 					_mark_ysort_dirty(item_owner, canvas_item_owner);
 				}
+
+				if (item_owner->child_grid) {
+					item_owner->child_grid->rebuild = true;
+				}
+				_mark_subtree_dirty(item_owner);
 			}
 		}
 
 		for (int i = 0; i < canvas_item->child_items.size(); i++) {
 
 			canvas_item->child_items[i]->parent = RID();
+			canvas_item->child_items[i]->parent_item = NULL;
 		}
 
 		/*
@@ -1475,6 +1854,7 @@ VisualServerCanvas::VisualServerCanvas() {
 	z_last_list = (RasterizerCanvas::Item **)memalloc(z_range * sizeof(RasterizerCanvas::Item *));
 
 	disable_scale = false;
+	spatial_index = false;
 }
 
 VisualServerCanvas::~VisualServerCanvas() {
@@ -31,14 +31,47 @@
 #ifndef VISUALSERVERCANVAS_H
 #define VISUALSERVERCANVAS_H
 
+#include "core/hash_map.h"
 #include "rasterizer.h"
 #include "visual_server_viewport.h"
 
 class VisualServerCanvas {
 public:
+	enum {
+		ITEM_GRID_MIN_CHILDREN = 64, // items with fewer children just test each of them
+		ITEM_GRID_MAX_CELLS = 16, // children spanning more cells than this per axis are always tested
+	};
+
+	struct Item;
+
+	// Uniform grid of the children of an item, so culling only visits the children near the view.
+	struct ItemGrid {
+
+		real_t cell_size;
+		HashMap<uint64_t, Vector<Item *> > cells;
+		Vector<Item *> large;
+		Vector<Item *> dirty;
+		Rect2 bounds;
+		bool has_bounds;
+		int unbounded_count;
+		int moves;
+		bool rebuild;
+		uint64_t pass;
+
+		ItemGrid() {
+			cell_size = 1.0;
+			has_bounds = false;
+			unbounded_count = 0;
+			moves = 0;
+			rebuild = true;
+			pass = 0;
+		}
+	};
+
 	struct Item : public RasterizerCanvas::Item {
 
 		RID parent; // canvas it belongs to
+		Item *parent_item; // NULL if the parent is a canvas
 		List<Item *>::Element *E;
 		int z_index;
 		bool z_relative;
@@ -55,8 +88,23 @@ public:
 
 		Vector<Item *> child_items;
 
+		// Bounds of this item and its visible children in the parent's space, used for culling.
+		// A dirty item always has dirty ancestors, so updates stop at the first dirty one.
+		Rect2 subtree_rect;
+		bool subtree_has_rect;
+		bool subtree_unbounded;
+		bool subtree_dirty;
+		ItemGrid *child_grid;
+
+		// Cells taken in the parent's grid.
+		Rect2i grid_cells;
+		bool grid_inserted;
+		bool grid_large;
+		uint64_t grid_pass;
+
 		Item() {
 			children_order_dirty = true;
+			parent_item = NULL;
 			E = NULL;
 			z_index = 0;
 			modulate = Color(1, 1, 1, 1);
@@ -68,6 +116,19 @@ public:
 			ysort_children_count = -1;
 			ysort_xform = Transform2D();
 			ysort_pos = Vector2();
+			subtree_has_rect = false;
+			subtree_unbounded = false;
+			subtree_dirty = true;
+			child_grid = NULL;
+			grid_inserted = false;
+			grid_large = false;
+			grid_pass = 0;
+		}
+
+		~Item() {
+			if (child_grid) {
+				memdelete(child_grid);
+			}
 		}
 	};
 
@@ -129,6 +190,7 @@ public:
 		Color modulate;
 		RID parent;
 		float parent_scale;
+		bool use_spatial_index;
 
 		int find_item(Item *p_item) {
 			for (int i = 0; i < child_items.size(); i++) {
@@ -147,6 +209,7 @@ public:
 			modulate = Color(1, 1, 1, 1);
 			children_order_dirty = true;
 			parent_scale = 1.0;
+			use_spatial_index = false;
 		}
 	};
 
@@ -161,9 +224,18 @@ private:
 	void _render_canvas_item(Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RasterizerCanvas::Item **z_list, RasterizerCanvas::Item **z_last_list, Item *p_canvas_clip, Item *p_material_owner);
 	void _light_mask_canvas_items(int p_z, RasterizerCanvas::Item *p_canvas_item, RasterizerCanvas::Light *p_masked_lights);
 
+	void _mark_subtree_dirty(Item *p_item);
+	void _update_subtree_rect(Item *p_item);
+	void _grid_insert(ItemGrid *p_grid, Item *p_item);
+	void _grid_remove(ItemGrid *p_grid, Item *p_item);
+	void _grid_rebuild(Item *p_item);
+	void _grid_cull(ItemGrid *p_grid, const Rect2 &p_rect, Vector<Item *> &r_items);
+
 	RasterizerCanvas::Item **z_list;
 	RasterizerCanvas::Item **z_last_list;
 
+	bool spatial_index; // set while rendering a canvas that uses it
+
 public:
 	void render_canvas(Canvas *p_canvas, const Transform2D &p_transform, RasterizerCanvas::Light *p_lights, RasterizerCanvas::Light *p_masked_lights, const Rect2 &p_clip_rect);
 
@@ -172,6 +244,7 @@ public:
 	void canvas_set_modulate(RID p_canvas, const Color &p_color);
 	void canvas_set_parent(RID p_canvas, RID p_parent, float p_scale);
 	void canvas_set_disable_scale(bool p_disable);
+	void canvas_set_use_spatial_index(RID p_canvas, bool p_enable);
 
 	RID canvas_item_create();
 	void canvas_item_set_parent(RID p_item, RID p_parent);
@@ -109,6 +109,7 @@ void VisualServerRaster::draw(bool p_swap_buffers, double frame_step) {
 	VSG::scene->render_probes();
 	_draw_margins();
 	VSG::rasterizer->end_frame(p_swap_buffers);
+	VSG::scene->end_frame();
 
 	while (frame_drawn_callbacks.front()) {
 
@@ -150,6 +151,15 @@ void VisualServerRaster::finish() {
 
 int VisualServerRaster::get_render_info(RenderInfo p_info) {
 
+	switch (p_info) {
+		case INFO_INSTANCES_UPDATED_IN_FRAME:
+		case INFO_INSTANCE_UPDATE_TIME_IN_FRAME: {
+			return VSG::scene->get_render_info(p_info);
+		} break;
+		default: {
+		}
+	}
+
 	return VSG::storage->get_render_info(p_info);
 }
 
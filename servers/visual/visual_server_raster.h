@@ -235,9 +235,15 @@ public:
 	BIND2RC(Vector<PoolVector<uint8_t> >, mesh_surface_get_blend_shapes, RID, int)
 	BIND2RC(Vector<AABB>, mesh_surface_get_skeleton_aabb, RID, int)
 
+	BIND3(mesh_surface_set_lods, RID, int, const Vector<PoolVector<uint8_t> > &)
+	BIND2RC(Vector<PoolVector<uint8_t> >, mesh_surface_get_lods, RID, int)
+
 	BIND2(mesh_remove_surface, RID, int)
 	BIND1RC(int, mesh_get_surface_count, RID)
 
+	BIND2(mesh_set_lod_errors, RID, const Vector<float> &)
+	BIND1RC(Vector<float>, mesh_get_lod_errors, RID)
+
 	BIND2(mesh_set_custom_aabb, RID, const AABB &)
 	BIND1RC(AABB, mesh_get_custom_aabb, RID)
 
@@ -436,6 +442,11 @@ public:
 	BIND2(camera_set_environment, RID, RID)
 	BIND2(camera_set_use_vertical_aspect, RID, bool)
 
+	/* OCCLUDER API */
+
+	BIND0R(RID, occluder_create)
+	BIND3(occluder_set_mesh, RID, const PoolVector<Vector3> &, const PoolVector<int> &)
+
 #undef BINDBASE
 //from now on, calls forwarded to this singleton
 #define BINDBASE VSG::viewport
@@ -573,6 +584,7 @@ public:
 	BIND2(canvas_set_modulate, RID, const Color &)
 	BIND3(canvas_set_parent, RID, RID, float)
 	BIND1(canvas_set_disable_scale, bool)
+	BIND2(canvas_set_use_spatial_index, RID, bool)
 
 	BIND0R(RID, canvas_item_create)
 	BIND2(canvas_item_set_parent, RID, RID)
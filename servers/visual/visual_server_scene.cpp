@@ -31,6 +31,7 @@
 #include "visual_server_scene.h"
 
 #include "core/os/os.h"
+#include "core/project_settings.h"
 #include "visual_server_globals.h"
 #include "visual_server_raster.h"
 
@@ -103,6 +104,52 @@ void VisualServerScene::camera_set_use_vertical_aspect(RID p_camera, bool p_enab
 	camera->vaspect = p_enable;
 }
 
+/* OCCLUDER API */
+
+RID VisualServerScene::occluder_create() {
+
+	Occluder *occluder = memnew(Occluder);
+	ERR_FAIL_COND_V(!occluder, RID());
+	return occluder_owner.make_rid(occluder);
+}
+
+void VisualServerScene::occluder_set_mesh(RID p_occluder, const PoolVector<Vector3> &p_vertices, const PoolVector<int> &p_indices) {
+
+	Occluder *occluder = occluder_owner.getornull(p_occluder);
+	ERR_FAIL_COND(!occluder);
+	ERR_FAIL_COND(p_indices.size() % 3 != 0);
+
+	{
+		PoolVector<int>::Read r = p_indices.read();
+		for (int i = 0; i < p_indices.size(); i++) {
+			ERR_FAIL_INDEX(r[i], p_vertices.size());
+		}
+	}
+
+	occluder->vertices = p_vertices;
+	occluder->indices = p_indices;
+
+	PoolVector<Vector3>::Read r = p_vertices.read();
+	{
+		PoolVector<int>::Read indices = p_indices.read();
+		OcclusionBuffer::get_coplanar_neighbors(r.ptr(), p_vertices.size(), indices.ptr(), p_indices.size(), occluder->neighbors);
+	}
+
+	AABB aabb;
+	for (int i = 0; i < p_vertices.size(); i++) {
+		if (i == 0) {
+			aabb.position = r[i];
+		} else {
+			aabb.expand_to(r[i]);
+		}
+	}
+	occluder->aabb = aabb;
+
+	for (Set<Instance *>::Element *E = occluder->instances.front(); E; E = E->next()) {
+		_instance_queue_update(E->get(), true);
+	}
+}
+
 /* SCENARIO API */
 
 void *VisualServerScene::_instance_pair(void *p_self, OctreeElementID, Instance *p_A, int, OctreeElementID, Instance *p_B, int) {
@@ -338,7 +385,11 @@ void VisualServerScene::instance_set_base(RID p_instance, RID p_base) {
 	if (instance->base_type != VS::INSTANCE_NONE) {
 		//free anything related to that base
 
-		VSG::storage->instance_remove_dependency(instance->base, instance);
+		if (instance->base_type == VS::INSTANCE_OCCLUDER) {
+			occluder_owner.get(instance->base)->instances.erase(instance);
+		} else {
+			VSG::storage->instance_remove_dependency(instance->base, instance);
+		}
 
 		if (instance->base_type == VS::INSTANCE_GI_PROBE) {
 			//if gi probe is baking, wait until done baking, else race condition may happen when removing it
@@ -432,10 +483,12 @@ void VisualServerScene::instance_set_base(RID p_instance, RID p_base) {
 
 	instance->base_type = VS::INSTANCE_NONE;
 	instance->base = RID();
+	instance->lod_errors.clear();
+	instance->lod_level = 0;
 
 	if (p_base.is_valid()) {
 
-		instance->base_type = VSG::storage->get_base_type(p_base);
+		instance->base_type = occluder_owner.owns(p_base) ? VS::INSTANCE_OCCLUDER : VSG::storage->get_base_type(p_base);
 		ERR_FAIL_COND(instance->base_type == VS::INSTANCE_NONE);
 
 		switch (instance->base_type) {
@@ -493,7 +546,11 @@ void VisualServerScene::instance_set_base(RID p_instance, RID p_base) {
 			}
 		}
 
-		VSG::storage->instance_add_dependency(p_base, instance);
+		if (instance->base_type == VS::INSTANCE_OCCLUDER) {
+			occluder_owner.get(p_base)->instances.insert(instance);
+		} else {
+			VSG::storage->instance_add_dependency(p_base, instance);
+		}
 
 		instance->base = p_base;
 
@@ -898,9 +955,34 @@ void VisualServerScene::instance_geometry_set_draw_range(RID p_instance, float p
 void VisualServerScene::instance_geometry_set_as_instance_lod(RID p_instance, RID p_as_lod_of_instance) {
 }
 
-void VisualServerScene::_update_instance(Instance *p_instance) {
+void VisualServerScene::_update_instance_xform(Instance *p_instance) {
 
 	p_instance->version++;
+	p_instance->update_octree = false;
+
+	if (p_instance->aabb.has_no_surface()) {
+		return;
+	}
+
+	p_instance->mirror = p_instance->transform.basis.determinant() < 0.0;
+
+	AABB new_aabb = p_instance->transform.xform(p_instance->aabb);
+
+	p_instance->update_octree = p_instance->octree_id == 0 || new_aabb != p_instance->transformed_aabb;
+	p_instance->transformed_aabb = new_aabb;
+}
+
+void VisualServerScene::_update_instance_xform_chunk(uint32_t p_chunk, Instance **p_instances) {
+
+	int from = p_chunk * INSTANCE_UPDATE_CHUNK_SIZE;
+	int to = MIN(from + (int)INSTANCE_UPDATE_CHUNK_SIZE, dirty_instance_count);
+
+	for (int i = from; i < to; i++) {
+		_update_instance_xform(p_instances[i]);
+	}
+}
+
+void VisualServerScene::_update_instance(Instance *p_instance) {
 
 	if (p_instance->base_type == VS::INSTANCE_LIGHT) {
 
@@ -949,14 +1031,6 @@ void VisualServerScene::_update_instance(Instance *p_instance) {
 		}
 	}
 
-	p_instance->mirror = p_instance->transform.basis.determinant() < 0.0;
-
-	AABB new_aabb;
-
-	new_aabb = p_instance->transform.xform(p_instance->aabb);
-
-	p_instance->transformed_aabb = new_aabb;
-
 	if (!p_instance->scenario) {
 
 		return;
@@ -981,16 +1055,12 @@ void VisualServerScene::_update_instance(Instance *p_instance) {
 		}
 
 		// not inside octree
-		p_instance->octree_id = p_instance->scenario->octree.create(p_instance, new_aabb, 0, pairable, base_type, pairable_mask);
+		p_instance->octree_id = p_instance->scenario->octree.create(p_instance, p_instance->transformed_aabb, 0, pairable, base_type, pairable_mask);
 
-	} else {
-
-		/*
-		if (new_aabb==p_instance->data.transformed_aabb)
-			return;
-		*/
+	} else if (p_instance->update_octree) {
 
-		p_instance->scenario->octree.move(p_instance->octree_id, new_aabb);
+		// Pairs only depend on the AABB, so there is nothing to do if it did not change.
+		p_instance->scenario->octree.move(p_instance->octree_id, p_instance->transformed_aabb);
 	}
 }
 
@@ -1012,6 +1082,11 @@ void VisualServerScene::_update_instance_aabb(Instance *p_instance) {
 			else
 				new_aabb = VSG::storage->mesh_get_aabb(p_instance->base, p_instance->skeleton);
 
+			p_instance->lod_errors = VSG::storage->mesh_get_lod_errors(p_instance->base);
+			if (p_instance->lod_level > p_instance->lod_errors.size()) {
+				p_instance->lod_level = p_instance->lod_errors.size();
+			}
+
 		} break;
 
 		case VisualServer::INSTANCE_MULTIMESH: {
@@ -1057,6 +1132,11 @@ void VisualServerScene::_update_instance_aabb(Instance *p_instance) {
 
 			new_aabb = VSG::storage->lightmap_capture_get_bounds(p_instance->base);
 
+		} break;
+		case VisualServer::INSTANCE_OCCLUDER: {
+
+			new_aabb = occluder_owner.get(p_instance->base)->aabb;
+
 		} break;
 		default: {
 		}
@@ -1180,7 +1260,7 @@ _FORCE_INLINE_ static void _light_capture_sample_octree(const RasterizerStorage:
 		}
 	}
 
-	float target_level_size = size >> target_level;
+	real_t target_level_size = size >> target_level;
 	Vector3 pos_fract[2];
 
 	pos_fract[0].x = Math::fmod(pos.x, target_level_size) / target_level_size;
@@ -1208,15 +1288,15 @@ _FORCE_INLINE_ static void _light_capture_sample_octree(const RasterizerStorage:
 
 		color_interp[i] = blend_z0.linear_interpolate(blend_z1, pos_fract[i].z);
 
-		float alpha_x00 = Math::lerp(alpha[i][0], alpha[i][1], pos_fract[i].x);
-		float alpha_xy0 = Math::lerp(alpha[i][2], alpha[i][3], pos_fract[i].x);
-		float alpha_z0 = Math::lerp(alpha_x00, alpha_xy0, pos_fract[i].y);
+		float alpha_x00 = Math::lerp(alpha[i][0], alpha[i][1], (float)pos_fract[i].x);
+		float alpha_xy0 = Math::lerp(alpha[i][2], alpha[i][3], (float)pos_fract[i].x);
+		float alpha_z0 = Math::lerp(alpha_x00, alpha_xy0, (float)pos_fract[i].y);
 
-		float alpha_x0z = Math::lerp(alpha[i][4], alpha[i][5], pos_fract[i].x);
-		float alpha_xyz = Math::lerp(alpha[i][6], alpha[i][7], pos_fract[i].x);
-		float alpha_z1 = Math::lerp(alpha_x0z, alpha_xyz, pos_fract[i].y);
+		float alpha_x0z = Math::lerp(alpha[i][4], alpha[i][5], (float)pos_fract[i].x);
+		float alpha_xyz = Math::lerp(alpha[i][6], alpha[i][7], (float)pos_fract[i].x);
+		float alpha_z1 = Math::lerp(alpha_x0z, alpha_xyz, (float)pos_fract[i].y);
 
-		alpha_interp[i] = Math::lerp(alpha_z0, alpha_z1, pos_fract[i].z);
+		alpha_interp[i] = Math::lerp(alpha_z0, alpha_z1, (float)pos_fract[i].z);
 	}
 
 	r_color = color_interp[0].linear_interpolate(color_interp[1], level_filter);
@@ -1302,15 +1382,34 @@ void VisualServerScene::_update_instance_lightmap_captures(Instance *p_instance)
 	}
 }
 
-bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_shadow_atlas, Scenario *p_scenario) {
+VisualServerScene::ShadowPass &VisualServerScene::_add_shadow_pass(Instance *p_light, int p_pass) {
+
+	if (shadow_pass_count == shadow_passes.size()) {
+		shadow_passes.resize(shadow_pass_count + 1);
+	}
+
+	ShadowPass &pass = shadow_passes.write[shadow_pass_count++];
+	pass.light = p_light;
+	pass.pass = p_pass;
+	pass.plane_count = 0;
+	pass.projection = CameraMatrix();
+	pass.far = 0;
+	pass.split = 0;
+	pass.bias_scale = 1.0;
+	pass.directional = false;
+	pass.restore_paraboloid = false;
+	pass.cull_count = 0;
+	pass.animated_material_found = false;
+	return pass;
+}
+
+void VisualServerScene::_light_instance_setup_shadow(Instance *p_instance, const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, const ShadowCasterRange &p_caster_range) {
 
 	InstanceLightData *light = static_cast<InstanceLightData *>(p_instance->base_data);
 
 	Transform light_transform = p_instance->transform;
 	light_transform.orthonormalize(); //scale does not count on lights
 
-	bool animated_material_found = false;
-
 	switch (VSG::storage->light_get_type(p_instance->base)) {
 
 		case VS::LIGHT_DIRECTIONAL: {
@@ -1325,46 +1424,10 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 
 			VS::LightDirectionalShadowDepthRangeMode depth_range_mode = VSG::storage->light_directional_get_shadow_depth_range_mode(p_instance->base);
 
-			if (depth_range_mode == VS::LIGHT_DIRECTIONAL_SHADOW_DEPTH_RANGE_OPTIMIZED) {
-				//optimize min/max
-				Vector<Plane> planes = p_cam_projection.get_projection_planes(p_cam_transform);
-				int cull_count = p_scenario->octree.cull_convex(planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, VS::INSTANCE_GEOMETRY_MASK);
-				Plane base(p_cam_transform.origin, -p_cam_transform.basis.get_axis(2));
-				//check distance max and min
-
-				bool found_items = false;
-				float z_max = -1e20;
-				float z_min = 1e20;
-
-				for (int i = 0; i < cull_count; i++) {
-
-					Instance *instance = instance_shadow_cull_result[i];
-					if (!instance->visible || !((1 << instance->base_type) & VS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
-						continue;
-					}
-
-					if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-						animated_material_found = true;
-					}
-
-					float max, min;
-					instance->transformed_aabb.project_range_in_plane(base, min, max);
-
-					if (max > z_max) {
-						z_max = max;
-					}
-
-					if (min < z_min) {
-						z_min = min;
-					}
-
-					found_items = true;
-				}
-
-				if (found_items) {
-					min_distance = MAX(min_distance, z_min);
-					max_distance = MIN(max_distance, z_max);
-				}
+			if (depth_range_mode == VS::LIGHT_DIRECTIONAL_SHADOW_DEPTH_RANGE_OPTIMIZED && p_caster_range.found) {
+				//optimize min/max, range was gathered while processing the camera cull
+				min_distance = MAX(min_distance, p_caster_range.min);
+				max_distance = MIN(max_distance, p_caster_range.max);
 			}
 
 			float range = max_distance - min_distance;
@@ -1513,59 +1576,32 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 
 				//now that we now all ranges, we can proceed to make the light frustum planes, for culling octree
 
-				Vector<Plane> light_frustum_planes;
-				light_frustum_planes.resize(6);
+				ShadowPass &pass = _add_shadow_pass(p_instance, i);
+				pass.plane_count = 6;
 
 				//right/left
-				light_frustum_planes.write[0] = Plane(x_vec, x_max);
-				light_frustum_planes.write[1] = Plane(-x_vec, -x_min);
+				pass.planes[0] = Plane(x_vec, x_max);
+				pass.planes[1] = Plane(-x_vec, -x_min);
 				//top/bottom
-				light_frustum_planes.write[2] = Plane(y_vec, y_max);
-				light_frustum_planes.write[3] = Plane(-y_vec, -y_min);
+				pass.planes[2] = Plane(y_vec, y_max);
+				pass.planes[3] = Plane(-y_vec, -y_min);
 				//near/far
-				light_frustum_planes.write[4] = Plane(z_vec, z_max + 1e6);
-				light_frustum_planes.write[5] = Plane(-z_vec, -z_min); // z_min is ok, since casters further than far-light plane are not needed
-
-				int cull_count = p_scenario->octree.cull_convex(light_frustum_planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, VS::INSTANCE_GEOMETRY_MASK);
-
-				// a pre pass will need to be needed to determine the actual z-near to be used
-
-				Plane near_plane(light_transform.origin, -light_transform.basis.get_axis(2));
-
-				for (int j = 0; j < cull_count; j++) {
-
-					float min, max;
-					Instance *instance = instance_shadow_cull_result[j];
-					if (!instance->visible || !((1 << instance->base_type) & VS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
-						cull_count--;
-						SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
-						j--;
-						continue;
-					}
-
-					instance->transformed_aabb.project_range_in_plane(Plane(z_vec, 0), min, max);
-					instance->depth = near_plane.distance_to(instance->transform.origin);
-					instance->depth_layer = 0;
-					if (max > z_max)
-						z_max = max;
-				}
-
-				{
-
-					CameraMatrix ortho_camera;
-					real_t half_x = (x_max_cam - x_min_cam) * 0.5;
-					real_t half_y = (y_max_cam - y_min_cam) * 0.5;
-
-					ortho_camera.set_orthogonal(-half_x, half_x, -half_y, half_y, 0, (z_max - z_min_cam));
-
-					Transform ortho_transform;
-					ortho_transform.basis = transform.basis;
-					ortho_transform.origin = x_vec * (x_min_cam + half_x) + y_vec * (y_min_cam + half_y) + z_vec * z_max;
-
-					VSG::scene_render->light_instance_set_shadow_transform(light->instance, ortho_camera, ortho_transform, 0, distances[i + 1], i, bias_scale);
-				}
-
-				VSG::scene_render->render_shadow(light->instance, p_shadow_atlas, i, (RasterizerScene::InstanceBase **)instance_shadow_cull_result, cull_count);
+				pass.planes[4] = Plane(z_vec, z_max + 1e6);
+				pass.planes[5] = Plane(-z_vec, -z_min); // z_min is ok, since casters further than far-light plane are not needed
+
+				pass.near_plane = Plane(light_transform.origin, -light_transform.basis.get_axis(2));
+
+				// the ortho camera depends on the casters found, so it is set up after culling
+				pass.directional = true;
+				pass.transform = transform;
+				pass.x_min_cam = x_min_cam;
+				pass.x_max_cam = x_max_cam;
+				pass.y_min_cam = y_min_cam;
+				pass.y_max_cam = y_max_cam;
+				pass.z_min_cam = z_min_cam;
+				pass.z_max = z_max;
+				pass.split = distances[i + 1];
+				pass.bias_scale = bias_scale;
 			}
 
 		} break;
@@ -1582,36 +1618,17 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 					float radius = VSG::storage->light_get_param(p_instance->base, VS::LIGHT_PARAM_RANGE);
 
 					float z = i == 0 ? -1 : 1;
-					Vector<Plane> planes;
-					planes.resize(5);
-					planes.write[0] = light_transform.xform(Plane(Vector3(0, 0, z), radius));
-					planes.write[1] = light_transform.xform(Plane(Vector3(1, 0, z).normalized(), radius));
-					planes.write[2] = light_transform.xform(Plane(Vector3(-1, 0, z).normalized(), radius));
-					planes.write[3] = light_transform.xform(Plane(Vector3(0, 1, z).normalized(), radius));
-					planes.write[4] = light_transform.xform(Plane(Vector3(0, -1, z).normalized(), radius));
-
-					int cull_count = p_scenario->octree.cull_convex(planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, VS::INSTANCE_GEOMETRY_MASK);
-					Plane near_plane(light_transform.origin, light_transform.basis.get_axis(2) * z);
-
-					for (int j = 0; j < cull_count; j++) {
-
-						Instance *instance = instance_shadow_cull_result[j];
-						if (!instance->visible || !((1 << instance->base_type) & VS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
-							cull_count--;
-							SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
-							j--;
-						} else {
-							if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-								animated_material_found = true;
-							}
-
-							instance->depth = near_plane.distance_to(instance->transform.origin);
-							instance->depth_layer = 0;
-						}
-					}
-
-					VSG::scene_render->light_instance_set_shadow_transform(light->instance, CameraMatrix(), light_transform, radius, 0, i);
-					VSG::scene_render->render_shadow(light->instance, p_shadow_atlas, i, (RasterizerScene::InstanceBase **)instance_shadow_cull_result, cull_count);
+					ShadowPass &pass = _add_shadow_pass(p_instance, i);
+					pass.plane_count = 5;
+					pass.planes[0] = light_transform.xform(Plane(Vector3(0, 0, z), radius));
+					pass.planes[1] = light_transform.xform(Plane(Vector3(1, 0, z).normalized(), radius));
+					pass.planes[2] = light_transform.xform(Plane(Vector3(-1, 0, z).normalized(), radius));
+					pass.planes[3] = light_transform.xform(Plane(Vector3(0, 1, z).normalized(), radius));
+					pass.planes[4] = light_transform.xform(Plane(Vector3(0, -1, z).normalized(), radius));
+
+					pass.near_plane = Plane(light_transform.origin, light_transform.basis.get_axis(2) * z);
+					pass.transform = light_transform;
+					pass.far = radius;
 				}
 			} else { //shadow cube
 
@@ -1644,31 +1661,20 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 
 					Vector<Plane> planes = cm.get_projection_planes(xform);
 
-					int cull_count = p_scenario->octree.cull_convex(planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, VS::INSTANCE_GEOMETRY_MASK);
-
-					Plane near_plane(xform.origin, -xform.basis.get_axis(2));
-					for (int j = 0; j < cull_count; j++) {
-
-						Instance *instance = instance_shadow_cull_result[j];
-						if (!instance->visible || !((1 << instance->base_type) & VS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
-							cull_count--;
-							SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
-							j--;
-						} else {
-							if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-								animated_material_found = true;
-							}
-							instance->depth = near_plane.distance_to(instance->transform.origin);
-							instance->depth_layer = 0;
-						}
+					ShadowPass &pass = _add_shadow_pass(p_instance, i);
+					pass.plane_count = planes.size();
+					for (int j = 0; j < planes.size(); j++) {
+						pass.planes[j] = planes[j];
 					}
 
-					VSG::scene_render->light_instance_set_shadow_transform(light->instance, cm, xform, radius, 0, i);
-					VSG::scene_render->render_shadow(light->instance, p_shadow_atlas, i, (RasterizerScene::InstanceBase **)instance_shadow_cull_result, cull_count);
-				}
+					pass.near_plane = Plane(xform.origin, -xform.basis.get_axis(2));
+					pass.projection = cm;
+					pass.transform = xform;
+					pass.far = radius;
 
-				//restore the regular DP matrix
-				VSG::scene_render->light_instance_set_shadow_transform(light->instance, CameraMatrix(), light_transform, radius, 0, 0);
+					//restore the regular DP matrix once the last face is drawn
+					pass.restore_paraboloid = i == 5;
+				}
 			}
 
 		} break;
@@ -1681,32 +1687,128 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 			cm.set_perspective(angle * 2.0, 1.0, 0.01, radius);
 
 			Vector<Plane> planes = cm.get_projection_planes(light_transform);
-			int cull_count = p_scenario->octree.cull_convex(planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, VS::INSTANCE_GEOMETRY_MASK);
-
-			Plane near_plane(light_transform.origin, -light_transform.basis.get_axis(2));
-			for (int j = 0; j < cull_count; j++) {
 
-				Instance *instance = instance_shadow_cull_result[j];
-				if (!instance->visible || !((1 << instance->base_type) & VS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
-					cull_count--;
-					SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
-					j--;
-				} else {
-					if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-						animated_material_found = true;
-					}
-					instance->depth = near_plane.distance_to(instance->transform.origin);
-					instance->depth_layer = 0;
-				}
+			ShadowPass &pass = _add_shadow_pass(p_instance, 0);
+			pass.plane_count = planes.size();
+			for (int j = 0; j < planes.size(); j++) {
+				pass.planes[j] = planes[j];
 			}
 
-			VSG::scene_render->light_instance_set_shadow_transform(light->instance, cm, light_transform, radius, 0, 0);
-			VSG::scene_render->render_shadow(light->instance, p_shadow_atlas, 0, (RasterizerScene::InstanceBase **)instance_shadow_cull_result, cull_count);
+			pass.near_plane = Plane(light_transform.origin, -light_transform.basis.get_axis(2));
+			pass.projection = cm;
+			pass.transform = light_transform;
+			pass.far = radius;
 
 		} break;
 	}
+}
+
+void VisualServerScene::_cull_shadow_pass(uint32_t p_index, ShadowCullParams *p_params) {
+
+	ShadowPass &pass = p_params->passes[p_index];
+
+	// Each pass culls into its own buffer, grown until the result fits.
+	if (pass.cull_result.empty()) {
+		pass.cull_result.resize(SHADOW_CULL_INITIAL_SIZE);
+	}
+
+	while (true) {
+		int cull_max = pass.cull_result.size();
+		pass.cull_count = p_params->scenario->octree.cull_convex_threadsafe(pass.planes, pass.plane_count, pass.cull_result.ptrw(), cull_max, VS::INSTANCE_GEOMETRY_MASK);
+		if (pass.cull_count < cull_max || cull_max >= MAX_INSTANCE_CULL)
+			break;
+		pass.cull_result.resize(MIN(cull_max * 2, (int)MAX_INSTANCE_CULL));
+	}
+
+	Instance **cull_result = pass.cull_result.ptrw();
+	Vector3 z_vec = pass.transform.basis.get_axis(Vector3::AXIS_Z).normalized();
+
+	for (int j = 0; j < pass.cull_count; j++) {
+
+		Instance *instance = cull_result[j];
+		if (!instance->visible || !((1 << instance->base_type) & VS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
+			pass.cull_count--;
+			SWAP(cull_result[j], cull_result[pass.cull_count]);
+			j--;
+			continue;
+		}
+
+		if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
+			pass.animated_material_found = true;
+		}
+
+		if (pass.directional) {
+			real_t min, max;
+			instance->transformed_aabb.project_range_in_plane(Plane(z_vec, 0), min, max);
+			if (max > pass.z_max)
+				pass.z_max = max;
+		}
+	}
 
-	return animated_material_found;
+	if (pass.directional) {
+
+		Vector3 x_vec = pass.transform.basis.get_axis(Vector3::AXIS_X).normalized();
+		Vector3 y_vec = pass.transform.basis.get_axis(Vector3::AXIS_Y).normalized();
+
+		real_t half_x = (pass.x_max_cam - pass.x_min_cam) * 0.5;
+		real_t half_y = (pass.y_max_cam - pass.y_min_cam) * 0.5;
+
+		pass.projection.set_orthogonal(-half_x, half_x, -half_y, half_y, 0, (pass.z_max - pass.z_min_cam));
+
+		Transform ortho_transform;
+		ortho_transform.basis = pass.transform.basis;
+		ortho_transform.origin = x_vec * (pass.x_min_cam + half_x) + y_vec * (pass.y_min_cam + half_y) + z_vec * pass.z_max;
+		pass.transform = ortho_transform;
+	}
+}
+
+void VisualServerScene::_render_shadow_passes(Scenario *p_scenario, RID p_shadow_atlas) {
+
+	if (shadow_pass_count == 0)
+		return;
+
+	ShadowCullParams params;
+	params.scenario = p_scenario;
+	params.passes = shadow_passes.ptrw();
+	thread_pool.do_work(shadow_pass_count, this, &VisualServerScene::_cull_shadow_pass, &params);
+
+	// Rendering stays on this thread, in the order the passes were added.
+	int i = 0;
+	while (i < shadow_pass_count) {
+
+		Instance *ins = params.passes[i].light;
+		InstanceLightData *light = static_cast<InstanceLightData *>(ins->base_data);
+		bool animated_material_found = false;
+
+		for (; i < shadow_pass_count && params.passes[i].light == ins; i++) {
+
+			const ShadowPass &pass = params.passes[i];
+			Instance **cull_result = params.passes[i].cull_result.ptrw();
+
+			// Instances are shared between passes, so their depth is only set right before drawing.
+			for (int j = 0; j < pass.cull_count; j++) {
+				cull_result[j]->depth = pass.near_plane.distance_to(cull_result[j]->transform.origin);
+				cull_result[j]->depth_layer = 0;
+			}
+
+			VSG::scene_render->light_instance_set_shadow_transform(light->instance, pass.projection, pass.transform, pass.far, pass.split, pass.pass, pass.bias_scale);
+			VSG::scene_render->render_shadow(light->instance, p_shadow_atlas, pass.pass, (RasterizerScene::InstanceBase **)cull_result, pass.cull_count);
+
+			if (pass.restore_paraboloid) {
+				Transform light_transform = ins->transform;
+				light_transform.orthonormalize();
+				VSG::scene_render->light_instance_set_shadow_transform(light->instance, CameraMatrix(), light_transform, pass.far, 0, 0);
+			}
+
+			animated_material_found = animated_material_found || pass.animated_material_found;
+		}
+
+		if (VSG::storage->light_get_type(ins->base) != VS::LIGHT_DIRECTIONAL) {
+			light->shadow_dirty = animated_material_found;
+		}
+	}
+
+	shadow_pass_count = 0;
 }
 
 void VisualServerScene::render_camera(RID p_camera, RID p_scenario, Size2 p_viewport_size, RID p_shadow_atlas) {
@@ -1755,7 +1857,7 @@ void VisualServerScene::render_camera(RID p_camera, RID p_scenario, Size2 p_view
 		} break;
 	}
 
-	_prepare_scene(camera->transform, camera_matrix, ortho, camera->env, camera->visible_layers, p_scenario, p_shadow_atlas, RID());
+	_prepare_scene(camera->transform, camera_matrix, ortho, camera->env, camera->visible_layers, p_scenario, p_shadow_atlas, RID(), p_viewport_size.height);
 	_render_scene(camera->transform, camera_matrix, ortho, camera->env, p_scenario, p_shadow_atlas, RID(), -1);
 #endif
 }
@@ -1834,17 +1936,17 @@ void VisualServerScene::render_camera(Ref<ARVRInterface> &p_interface, ARVRInter
 		mono_transform *= apply_z_shift;
 
 		// now prepare our scene with our adjusted transform projection matrix
-		_prepare_scene(mono_transform, combined_matrix, false, camera->env, camera->visible_layers, p_scenario, p_shadow_atlas, RID());
+		_prepare_scene(mono_transform, combined_matrix, false, camera->env, camera->visible_layers, p_scenario, p_shadow_atlas, RID(), p_viewport_size.height);
 	} else if (p_eye == ARVRInterface::EYE_MONO) {
 		// For mono render, prepare as per usual
-		_prepare_scene(cam_transform, camera_matrix, false, camera->env, camera->visible_layers, p_scenario, p_shadow_atlas, RID());
+		_prepare_scene(cam_transform, camera_matrix, false, camera->env, camera->visible_layers, p_scenario, p_shadow_atlas, RID(), p_viewport_size.height);
 	}
 
 	// And render our scene...
 	_render_scene(cam_transform, camera_matrix, false, camera->env, p_scenario, p_shadow_atlas, RID(), -1);
 };
 
-void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_force_environment, uint32_t p_visible_layers, RID p_scenario, RID p_shadow_atlas, RID p_reflection_probe) {
+void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_force_environment, uint32_t p_visible_layers, RID p_scenario, RID p_shadow_atlas, RID p_reflection_probe, float p_screen_height) {
 	// Note, in stereo rendering:
 	// - p_cam_transform will be a transform in the middle of our two eyes
 	// - p_cam_projection is a wider frustrum that encompasses both eyes
@@ -1864,7 +1966,8 @@ void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const Ca
 	float z_far = p_cam_projection.get_z_far();
 
 	/* STEP 2 - CULL */
-	instance_cull_count = scenario->octree.cull_convex(planes, instance_cull_result, MAX_INSTANCE_CULL);
+	// Occluders are only drawn into the occlusion buffer.
+	instance_cull_count = scenario->octree.cull_convex(planes, instance_cull_result, MAX_INSTANCE_CULL, ~(uint32_t(1) << VS::INSTANCE_OCCLUDER));
 	light_cull_count = 0;
 
 	reflection_probe_cull_count = 0;
@@ -1883,16 +1986,53 @@ void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const Ca
 
 	/* STEP 4 - REMOVE FURTHER CULLED OBJECTS, ADD LIGHTS */
 
+	// Directional shadows with an optimized depth range need the range of the casters in view.
+	bool need_caster_range = false;
+	if (p_shadow_atlas.is_valid()) {
+		for (List<Instance *>::Element *E = scenario->directional_lights.front(); E; E = E->next()) {
+			if (E->get()->visible && VSG::storage->light_has_shadow(E->get()->base) && VSG::storage->light_directional_get_shadow_depth_range_mode(E->get()->base) == VS::LIGHT_DIRECTIONAL_SHADOW_DEPTH_RANGE_OPTIMIZED) {
+				need_caster_range = true;
+				break;
+			}
+		}
+	}
+
+	InstanceCullParams cull_params;
+	cull_params.camera_layer_mask = camera_layer_mask;
+	cull_params.near_plane = near_plane;
+	cull_params.z_far = z_far;
+	cull_params.caster_range = need_caster_range;
+	cull_params.caster_range_plane = Plane(p_cam_transform.origin, -p_cam_transform.basis.get_axis(2));
+	cull_params.update_lod = p_screen_height > 0 && lod_threshold > 0;
+	cull_params.lod_orthogonal = p_cam_orthogonal;
+	cull_params.lod_origin = p_cam_transform.origin;
+	// matrix[1][1] is the cotangent of half the vertical FOV, or 2 / height for orthogonal cameras.
+	cull_params.lod_scale = p_cam_projection.matrix[1][1] * p_screen_height * 0.5 / MAX(lod_threshold, CMP_EPSILON);
+	cull_params.occlusion_culling = occlusion_culling && _render_occluders(scenario, planes, p_cam_transform, p_cam_projection, camera_layer_mask);
+
+	int chunk_count = (instance_cull_count + INSTANCE_CULL_CHUNK_SIZE - 1) / INSTANCE_CULL_CHUNK_SIZE;
+	thread_pool.do_work(chunk_count, this, &VisualServerScene::_process_instance_cull_chunk, &cull_params);
+
+	ShadowCasterRange caster_range;
+	for (int i = 0; i < chunk_count; i++) {
+		const ShadowCasterRange &chunk_range = instance_cull_chunk_ranges[i];
+		if (!chunk_range.found)
+			continue;
+		caster_range.min = caster_range.found ? MIN(caster_range.min, chunk_range.min) : chunk_range.min;
+		caster_range.max = caster_range.found ? MAX(caster_range.max, chunk_range.max) : chunk_range.max;
+		caster_range.found = true;
+	}
+
+	// Whatever touches shared lists or other servers is done here, in cull order.
 	for (int i = 0; i < instance_cull_count; i++) {
 
 		Instance *ins = instance_cull_result[i];
 
-		bool keep = false;
-
-		if ((camera_layer_mask & ins->layer_mask) == 0) {
+		bool keep = instance_cull_state[i] == INSTANCE_CULL_KEEP;
 
-			//failure
-		} else if (ins->base_type == VS::INSTANCE_LIGHT && ins->visible) {
+		if (instance_cull_state[i] != INSTANCE_CULL_PROCESS) {
+			//already decided
+		} else if (ins->base_type == VS::INSTANCE_LIGHT) {
 
 			if (light_cull_count < MAX_LIGHTS_CULLED) {
 
@@ -1909,7 +2049,7 @@ void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const Ca
 					light_cull_count++;
 				}
 			}
-		} else if (ins->base_type == VS::INSTANCE_REFLECTION_PROBE && ins->visible) {
+		} else if (ins->base_type == VS::INSTANCE_REFLECTION_PROBE) {
 
 			if (reflection_probe_cull_count < MAX_REFLECTION_PROBES_CULLED) {
 
@@ -1938,19 +2078,17 @@ void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const Ca
 				}
 			}
 
-		} else if (ins->base_type == VS::INSTANCE_GI_PROBE && ins->visible) {
+		} else if (ins->base_type == VS::INSTANCE_GI_PROBE) {
 
 			InstanceGIProbeData *gi_probe = static_cast<InstanceGIProbeData *>(ins->base_data);
 			if (!gi_probe->update_element.in_list()) {
 				gi_probe_update_list.add(&gi_probe->update_element);
 			}
 
-		} else if (((1 << ins->base_type) & VS::INSTANCE_GEOMETRY_MASK) && ins->visible && ins->cast_shadows != VS::SHADOW_CASTING_SETTING_SHADOWS_ONLY) {
+		} else {
 
 			keep = true;
 
-			InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(ins->base_data);
-
 			if (ins->redraw_if_visible) {
 				VisualServerRaster::redraw_request();
 			}
@@ -1966,60 +2104,13 @@ void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const Ca
 					VisualServerRaster::redraw_request();
 				}
 			}
-
-			if (geom->lighting_dirty) {
-				int l = 0;
-				//only called when lights AABB enter/exit this geometry
-				ins->light_instances.resize(geom->lighting.size());
-
-				for (List<Instance *>::Element *E = geom->lighting.front(); E; E = E->next()) {
-
-					InstanceLightData *light = static_cast<InstanceLightData *>(E->get()->base_data);
-
-					ins->light_instances.write[l++] = light->instance;
-				}
-
-				geom->lighting_dirty = false;
-			}
-
-			if (geom->reflection_dirty) {
-				int l = 0;
-				//only called when reflection probe AABB enter/exit this geometry
-				ins->reflection_probe_instances.resize(geom->reflection_probes.size());
-
-				for (List<Instance *>::Element *E = geom->reflection_probes.front(); E; E = E->next()) {
-
-					InstanceReflectionProbeData *reflection_probe = static_cast<InstanceReflectionProbeData *>(E->get()->base_data);
-
-					ins->reflection_probe_instances.write[l++] = reflection_probe->instance;
-				}
-
-				geom->reflection_dirty = false;
-			}
-
-			if (geom->gi_probes_dirty) {
-				int l = 0;
-				//only called when reflection probe AABB enter/exit this geometry
-				ins->gi_probe_instances.resize(geom->gi_probes.size());
-
-				for (List<Instance *>::Element *E = geom->gi_probes.front(); E; E = E->next()) {
-
-					InstanceGIProbeData *gi_probe = static_cast<InstanceGIProbeData *>(E->get()->base_data);
-
-					ins->gi_probe_instances.write[l++] = gi_probe->probe_instance;
-				}
-
-				geom->gi_probes_dirty = false;
-			}
-
-			ins->depth = near_plane.distance_to(ins->transform.origin);
-			ins->depth_layer = CLAMP(int(ins->depth * 16 / z_far), 0, 15);
 		}
 
 		if (!keep) {
 			// remove, no reason to keep
 			instance_cull_count--;
 			SWAP(instance_cull_result[i], instance_cull_result[instance_cull_count]);
+			SWAP(instance_cull_state[i], instance_cull_state[instance_cull_count]);
 			i--;
 			ins->last_render_pass = 0; // make invalid
 		} else {
@@ -2065,7 +2156,7 @@ void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const Ca
 
 		for (int i = 0; i < directional_shadow_count; i++) {
 
-			_light_instance_update_shadow(lights_with_shadow[i], p_cam_transform, p_cam_projection, p_cam_orthogonal, p_shadow_atlas, scenario);
+			_light_instance_setup_shadow(lights_with_shadow[i], p_cam_transform, p_cam_projection, p_cam_orthogonal, caster_range);
 		}
 	}
 
@@ -2163,11 +2254,171 @@ void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const Ca
 			bool redraw = VSG::scene_render->shadow_atlas_update_light(p_shadow_atlas, light->instance, coverage, light->last_version);
 
 			if (redraw) {
-				//must redraw!
-				light->shadow_dirty = _light_instance_update_shadow(ins, p_cam_transform, p_cam_projection, p_cam_orthogonal, p_shadow_atlas, scenario);
+				//must redraw! shadow_dirty is updated once the passes are drawn
+				_light_instance_setup_shadow(ins, p_cam_transform, p_cam_projection, p_cam_orthogonal, caster_range);
+			}
+		}
+	}
+
+	// Every shadow pass of the frame is culled in parallel, then drawn in order.
+	_render_shadow_passes(scenario, p_shadow_atlas);
+}
+
+void VisualServerScene::_process_instance_cull_chunk(uint32_t p_chunk, InstanceCullParams *p_params) {
+
+	int from = p_chunk * INSTANCE_CULL_CHUNK_SIZE;
+	int to = MIN(from + (int)INSTANCE_CULL_CHUNK_SIZE, instance_cull_count);
+
+	ShadowCasterRange &range = instance_cull_chunk_ranges[p_chunk];
+	range.found = false;
+
+	for (int i = from; i < to; i++) {
+
+		Instance *ins = instance_cull_result[i];
+		bool geometry = ((1 << ins->base_type) & VS::INSTANCE_GEOMETRY_MASK) && ins->visible;
+
+		if (p_params->caster_range && geometry && static_cast<InstanceGeometryData *>(ins->base_data)->can_cast_shadows) {
+			real_t min, max;
+			ins->transformed_aabb.project_range_in_plane(p_params->caster_range_plane, min, max);
+			range.min = range.found ? MIN(range.min, min) : min;
+			range.max = range.found ? MAX(range.max, max) : max;
+			range.found = true;
+		}
+
+		if (p_params->update_lod && geometry && ins->lod_errors.size()) {
+			_update_instance_lod(ins, p_params);
+		}
+
+		if ((p_params->camera_layer_mask & ins->layer_mask) == 0) {
+			//failure
+			instance_cull_state[i] = INSTANCE_CULL_DISCARD;
+		} else if (!ins->visible) {
+			instance_cull_state[i] = INSTANCE_CULL_DISCARD;
+		} else if (geometry && p_params->occlusion_culling && occlusion_buffer.is_occluded(ins->transformed_aabb)) {
+			instance_cull_state[i] = INSTANCE_CULL_DISCARD;
+		} else if (ins->base_type == VS::INSTANCE_LIGHT || ins->base_type == VS::INSTANCE_REFLECTION_PROBE || ins->base_type == VS::INSTANCE_GI_PROBE) {
+			instance_cull_state[i] = INSTANCE_CULL_PROCESS;
+		} else if (geometry && ins->cast_shadows != VS::SHADOW_CASTING_SETTING_SHADOWS_ONLY) {
+
+			// Only this instance is written to, so this is safe to run on any thread.
+			InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(ins->base_data);
+
+			if (geom->lighting_dirty) {
+				int l = 0;
+				//only called when lights AABB enter/exit this geometry
+				ins->light_instances.resize(geom->lighting.size());
+
+				for (List<Instance *>::Element *E = geom->lighting.front(); E; E = E->next()) {
+
+					InstanceLightData *light = static_cast<InstanceLightData *>(E->get()->base_data);
+
+					ins->light_instances.write[l++] = light->instance;
+				}
+
+				geom->lighting_dirty = false;
+			}
+
+			if (geom->reflection_dirty) {
+				int l = 0;
+				//only called when reflection probe AABB enter/exit this geometry
+				ins->reflection_probe_instances.resize(geom->reflection_probes.size());
+
+				for (List<Instance *>::Element *E = geom->reflection_probes.front(); E; E = E->next()) {
+
+					InstanceReflectionProbeData *reflection_probe = static_cast<InstanceReflectionProbeData *>(E->get()->base_data);
+
+					ins->reflection_probe_instances.write[l++] = reflection_probe->instance;
+				}
+
+				geom->reflection_dirty = false;
+			}
+
+			if (geom->gi_probes_dirty) {
+				int l = 0;
+				//only called when reflection probe AABB enter/exit this geometry
+				ins->gi_probe_instances.resize(geom->gi_probes.size());
+
+				for (List<Instance *>::Element *E = geom->gi_probes.front(); E; E = E->next()) {
+
+					InstanceGIProbeData *gi_probe = static_cast<InstanceGIProbeData *>(E->get()->base_data);
+
+					ins->gi_probe_instances.write[l++] = gi_probe->probe_instance;
+				}
+
+				geom->gi_probes_dirty = false;
 			}
+
+			ins->depth = p_params->near_plane.distance_to(ins->transform.origin);
+			ins->depth_layer = CLAMP(int(ins->depth * 16 / p_params->z_far), 0, 15);
+
+			instance_cull_state[i] = (ins->redraw_if_visible || ins->base_type == VS::INSTANCE_PARTICLES) ? INSTANCE_CULL_PROCESS : INSTANCE_CULL_KEEP;
+		} else {
+			instance_cull_state[i] = INSTANCE_CULL_DISCARD;
+		}
+	}
+}
+
+void VisualServerScene::_update_instance_lod(Instance *p_instance, InstanceCullParams *p_params) {
+
+	// Errors are relative to the mesh size, so scale them by the on screen size of the
+	// instance, in units of the threshold, and pick the coarsest level that stays below one.
+	real_t size = p_instance->transformed_aabb.size.length();
+	real_t pixel_scale = p_params->lod_scale * size;
+
+	if (!p_params->lod_orthogonal) {
+		Vector3 center = p_instance->transformed_aabb.position + p_instance->transformed_aabb.size * 0.5;
+		real_t distance = p_params->lod_origin.distance_to(center) - size * 0.5;
+		if (distance <= CMP_EPSILON) {
+			p_instance->lod_level = 0;
+			return;
 		}
+		pixel_scale /= distance;
 	}
+
+	// Switching needs the error to pass the threshold by a margin, so LODs don't flicker at the boundary.
+	const Vector<float> &errors = p_instance->lod_errors;
+	int lod = MIN(p_instance->lod_level, errors.size());
+
+	while (lod < errors.size() && errors[lod] * pixel_scale < 1.0 - lod_hysteresis) {
+		lod++;
+	}
+	while (lod > 0 && errors[lod - 1] * pixel_scale > 1.0 + lod_hysteresis) {
+		lod--;
+	}
+
+	p_instance->lod_level = lod;
+}
+
+bool VisualServerScene::_render_occluders(Scenario *p_scenario, const Vector<Plane> &p_planes, const Transform p_cam_transform, const CameraMatrix &p_cam_projection, uint32_t p_visible_layers) {
+
+	int occluder_count = p_scenario->octree.cull_convex(p_planes, occluder_cull_result, MAX_OCCLUDERS_CULLED, 1 << VS::INSTANCE_OCCLUDER);
+	if (occluder_count == 0)
+		return false;
+
+	// Follow the aspect of the view, so texels stay square.
+	real_t aspect = p_cam_projection.matrix[1][1] / p_cam_projection.matrix[0][0];
+	occlusion_buffer.set_size(occlusion_buffer_width, MAX(int(occlusion_buffer_width / aspect), 1));
+	occlusion_buffer.begin(p_cam_projection, p_cam_transform);
+
+	for (int i = 0; i < occluder_count; i++) {
+
+		Instance *ins = occluder_cull_result[i];
+		if (!ins->visible || (p_visible_layers & ins->layer_mask) == 0)
+			continue;
+
+		Occluder *occluder = occluder_owner.get(ins->base);
+		PoolVector<Vector3>::Read vertices = occluder->vertices.read();
+		PoolVector<int>::Read indices = occluder->indices.read();
+		occlusion_buffer.add_occluder(ins->transform, vertices.ptr(), occluder->vertices.size(), indices.ptr(), occluder->indices.size(), occluder->neighbors.ptr());
+	}
+
+	if (occlusion_buffer.get_triangle_count() == 0)
+		return false;
+
+	thread_pool.do_work(occlusion_buffer.get_band_count(), &occlusion_buffer, &OcclusionBuffer::rasterize_band, (void *)NULL);
+	occlusion_buffer.finish();
+
+	return true;
 }
 
 void VisualServerScene::_render_scene(const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_force_environment, RID p_scenario, RID p_shadow_atlas, RID p_reflection_probe, int p_reflection_probe_pass) {
@@ -2264,7 +2515,8 @@ bool VisualServerScene::_render_reflection_probe_step(Instance *p_instance, int
 			shadow_atlas = scenario->reflection_probe_shadow_atlas;
 		}
 
-		_prepare_scene(xform, cm, false, RID(), VSG::storage->reflection_probe_get_cull_mask(p_instance->base), p_instance->scenario->self, shadow_atlas, reflection_probe->instance);
+		// Probes keep the LOD the cameras picked, so they pass no screen height.
+		_prepare_scene(xform, cm, false, RID(), VSG::storage->reflection_probe_get_cull_mask(p_instance->base), p_instance->scenario->self, shadow_atlas, reflection_probe->instance, 0);
 		_render_scene(xform, cm, false, RID(), p_instance->scenario->self, shadow_atlas, reflection_probe->instance, p_step);
 
 	} else {
@@ -3285,7 +3537,7 @@ void VisualServerScene::render_probes() {
 	}
 }
 
-void VisualServerScene::_update_dirty_instance(Instance *p_instance) {
+void VisualServerScene::_update_instance_data(Instance *p_instance) {
 
 	if (p_instance->update_aabb) {
 		_update_instance_aabb(p_instance);
@@ -3448,20 +3700,80 @@ void VisualServerScene::_update_dirty_instance(Instance *p_instance) {
 
 	_instance_update_list.remove(&p_instance->update_item);
 
-	_update_instance(p_instance);
-
 	p_instance->update_aabb = false;
 	p_instance->update_materials = false;
 }
 
+void VisualServerScene::_update_dirty_instance(Instance *p_instance) {
+
+	_update_instance_data(p_instance);
+	_update_instance_xform(p_instance);
+	_update_instance(p_instance);
+}
+
 void VisualServerScene::update_dirty_instances() {
 
 	VSG::storage->update_dirty_resources();
 
+	if (!_instance_update_list.first())
+		return;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+
+	// Pairing may queue more instances, so repeat until none are left.
 	while (_instance_update_list.first()) {
 
-		_update_dirty_instance(_instance_update_list.first()->self());
+		// Bases and materials are read from the storage, which is not thread safe.
+		dirty_instance_count = 0;
+		while (_instance_update_list.first()) {
+
+			Instance *instance = _instance_update_list.first()->self();
+			_update_instance_data(instance);
+
+			if (dirty_instance_count == dirty_instances.size()) {
+				dirty_instances.resize(MAX(dirty_instance_count * 2, (int)INSTANCE_UPDATE_CHUNK_SIZE));
+			}
+			dirty_instances.write[dirty_instance_count++] = instance;
+		}
+
+		// Transforms only write to their own instance.
+		int chunk_count = (dirty_instance_count + INSTANCE_UPDATE_CHUNK_SIZE - 1) / INSTANCE_UPDATE_CHUNK_SIZE;
+		thread_pool.do_work(chunk_count, this, &VisualServerScene::_update_instance_xform_chunk, dirty_instances.ptrw());
+
+		// Lights, probes and the octree are shared, so they are updated afterwards in a single pass.
+		for (int i = 0; i < dirty_instance_count; i++) {
+			_update_instance(dirty_instances[i]);
+
+			// Material only updates don't move the instance, so they are not counted.
+			if (dirty_instances[i]->update_octree) {
+				update_info.instances++;
+			}
+		}
 	}
+
+	update_info.usec += OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+void VisualServerScene::end_frame() {
+
+	update_info_final = update_info;
+	update_info = UpdateInfo();
+}
+
+int VisualServerScene::get_render_info(VS::RenderInfo p_info) const {
+
+	switch (p_info) {
+		case VS::INFO_INSTANCES_UPDATED_IN_FRAME: {
+			return update_info_final.instances;
+		} break;
+		case VS::INFO_INSTANCE_UPDATE_TIME_IN_FRAME: {
+			return update_info_final.usec;
+		} break;
+		default: {
+		}
+	}
+
+	return 0;
 }
 
 bool VisualServerScene::free(RID p_rid) {
@@ -3473,6 +3785,16 @@ bool VisualServerScene::free(RID p_rid) {
 		camera_owner.free(p_rid);
 		memdelete(camera);
 
+	} else if (occluder_owner.owns(p_rid)) {
+
+		Occluder *occluder = occluder_owner.get(p_rid);
+
+		while (occluder->instances.front()) {
+			instance_set_base(occluder->instances.front()->get()->self, RID());
+		}
+		occluder_owner.free(p_rid);
+		memdelete(occluder);
+
 	} else if (scenario_owner.owns(p_rid)) {
 
 		Scenario *scenario = scenario_owner.get(p_rid);
@@ -3522,6 +3844,19 @@ VisualServerScene::VisualServerScene() {
 
 	render_pass = 1;
 	singleton = this;
+
+	shadow_pass_count = 0;
+	dirty_instance_count = 0;
+	thread_pool.init(GLOBAL_DEF("rendering/threads/parallel_culling", true) ? -1 : 0);
+
+	lod_threshold = GLOBAL_DEF("rendering/quality/lod/threshold_pixels", 1.0);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/quality/lod/threshold_pixels", PropertyInfo(Variant::REAL, "rendering/quality/lod/threshold_pixels", PROPERTY_HINT_RANGE, "0,16,0.01"));
+	lod_hysteresis = GLOBAL_DEF("rendering/quality/lod/hysteresis", 0.25);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/quality/lod/hysteresis", PropertyInfo(Variant::REAL, "rendering/quality/lod/hysteresis", PROPERTY_HINT_RANGE, "0,0.9,0.01"));
+
+	occlusion_culling = GLOBAL_DEF("rendering/quality/occlusion_culling/enabled", true);
+	occlusion_buffer_width = GLOBAL_DEF("rendering/quality/occlusion_culling/buffer_width", 256);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/quality/occlusion_culling/buffer_width", PropertyInfo(Variant::INT, "rendering/quality/occlusion_culling/buffer_width", PROPERTY_HINT_RANGE, "64,1024,4"));
 }
 
 VisualServerScene::~VisualServerScene() {
@@ -3535,4 +3870,6 @@ VisualServerScene::~VisualServerScene() {
 	memdelete(probe_bake_mutex);
 
 #endif
+
+	thread_pool.finish();
 }
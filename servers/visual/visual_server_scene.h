@@ -37,8 +37,10 @@
 #include "core/math/octree.h"
 #include "core/os/semaphore.h"
 #include "core/os/thread.h"
+#include "core/os/thread_work_pool.h"
 #include "core/self_list.h"
 #include "servers/arvr/arvr_interface.h"
+#include "servers/visual/occlusion_buffer.h"
 
 class VisualServerScene {
 public:
@@ -47,8 +49,12 @@ public:
 		MAX_INSTANCE_CULL = 65536,
 		MAX_LIGHTS_CULLED = 4096,
 		MAX_REFLECTION_PROBES_CULLED = 4096,
+		MAX_OCCLUDERS_CULLED = 1024,
 		MAX_ROOM_CULL = 32,
 		MAX_EXTERIOR_PORTALS = 128,
+		INSTANCE_CULL_CHUNK_SIZE = 256,
+		INSTANCE_UPDATE_CHUNK_SIZE = 256,
+		SHADOW_CULL_INITIAL_SIZE = 1024,
 	};
 
 	uint64_t render_pass;
@@ -99,10 +105,27 @@ public:
 	virtual void camera_set_environment(RID p_camera, RID p_env);
 	virtual void camera_set_use_vertical_aspect(RID p_camera, bool p_enable);
 
-	/* SCENARIO API */
+	/* OCCLUDER API */
 
 	struct Instance;
 
+	// Occluders only exist on the CPU, so they are kept here instead of in the storage.
+	struct Occluder : RID_Data {
+
+		PoolVector<Vector3> vertices;
+		PoolVector<int> indices;
+		Vector<int> neighbors; // coplanar neighbor of each triangle edge
+		AABB aabb;
+		Set<Instance *> instances;
+	};
+
+	mutable RID_Owner<Occluder> occluder_owner;
+
+	virtual RID occluder_create();
+	virtual void occluder_set_mesh(RID p_occluder, const PoolVector<Vector3> &p_vertices, const PoolVector<int> &p_indices);
+
+	/* SCENARIO API */
+
 	struct Scenario : RID_Data {
 
 		VS::ScenarioDebugMode debug;
@@ -151,6 +174,7 @@ public:
 		//aabb stuff
 		bool update_aabb;
 		bool update_materials;
+		bool update_octree; // transformed_aabb changed in the last update
 
 		SelfList<Instance> update_item;
 
@@ -166,6 +190,8 @@ public:
 		float lod_end_hysteresis;
 		RID lod_instance;
 
+		Vector<float> lod_errors; // of the base mesh, see mesh_set_lod_errors()
+
 		uint64_t last_render_pass;
 		uint64_t last_frame_pass;
 
@@ -192,6 +218,7 @@ public:
 
 			update_aabb = false;
 			update_materials = false;
+			update_octree = false;
 
 			extra_margin = 0;
 
@@ -422,9 +449,84 @@ public:
 		}
 	};
 
+	enum InstanceCullState {
+		INSTANCE_CULL_DISCARD,
+		INSTANCE_CULL_KEEP,
+		INSTANCE_CULL_PROCESS, // needs work that is not thread safe, done after the parallel pass
+	};
+
+	struct InstanceCullParams {
+		uint32_t camera_layer_mask;
+		Plane near_plane;
+		float z_far;
+		bool caster_range;
+		Plane caster_range_plane;
+		bool update_lod;
+		bool lod_orthogonal;
+		Vector3 lod_origin;
+		real_t lod_scale; // screen height in units of the LOD threshold, per unit at distance 1
+		bool occlusion_culling;
+	};
+
+	// Depth range of the shadow casters in view, for optimized directional shadows.
+	struct ShadowCasterRange {
+		bool found;
+		real_t min;
+		real_t max;
+
+		ShadowCasterRange() {
+			found = false;
+			min = 0;
+			max = 0;
+		}
+	};
+
+	struct ShadowPass {
+		Instance *light;
+		int pass;
+		Plane planes[6];
+		int plane_count;
+		Plane near_plane;
+
+		CameraMatrix projection;
+		Transform transform;
+		float far;
+		float split;
+		float bias_scale;
+		bool restore_paraboloid;
+
+		// Directional cascades build their projection after culling, from the depth of the casters.
+		bool directional;
+		real_t x_min_cam, x_max_cam;
+		real_t y_min_cam, y_max_cam;
+		real_t z_min_cam, z_max;
+
+		Vector<Instance *> cull_result;
+		int cull_count;
+		bool animated_material_found;
+	};
+
+	struct ShadowCullParams {
+		Scenario *scenario;
+		ShadowPass *passes;
+	};
+
+	ThreadWorkPool thread_pool;
+
+	float lod_threshold;
+	float lod_hysteresis;
+
+	bool occlusion_culling;
+	int occlusion_buffer_width;
+	OcclusionBuffer occlusion_buffer;
+	Instance *occluder_cull_result[MAX_OCCLUDERS_CULLED];
+
 	int instance_cull_count;
 	Instance *instance_cull_result[MAX_INSTANCE_CULL];
-	Instance *instance_shadow_cull_result[MAX_INSTANCE_CULL]; //used for generating shadowmaps
+	uint8_t instance_cull_state[MAX_INSTANCE_CULL];
+	ShadowCasterRange instance_cull_chunk_ranges[MAX_INSTANCE_CULL / INSTANCE_CULL_CHUNK_SIZE];
+	Vector<ShadowPass> shadow_passes;
+	int shadow_pass_count;
 	Instance *light_cull_result[MAX_LIGHTS_CULLED];
 	RID light_instance_cull_result[MAX_LIGHTS_CULLED];
 	int light_cull_count;
@@ -466,19 +568,48 @@ public:
 	virtual void instance_geometry_set_as_instance_lod(RID p_instance, RID p_as_lod_of_instance);
 
 	_FORCE_INLINE_ void _update_instance(Instance *p_instance);
+	_FORCE_INLINE_ void _update_instance_xform(Instance *p_instance);
 	_FORCE_INLINE_ void _update_instance_aabb(Instance *p_instance);
+	_FORCE_INLINE_ void _update_instance_data(Instance *p_instance);
 	_FORCE_INLINE_ void _update_dirty_instance(Instance *p_instance);
+	void _update_instance_xform_chunk(uint32_t p_chunk, Instance **p_instances);
 	_FORCE_INLINE_ void _update_instance_lightmap_captures(Instance *p_instance);
 
-	_FORCE_INLINE_ bool _light_instance_update_shadow(Instance *p_instance, const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_shadow_atlas, Scenario *p_scenario);
+	ShadowPass &_add_shadow_pass(Instance *p_light, int p_pass);
+	void _light_instance_setup_shadow(Instance *p_instance, const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, const ShadowCasterRange &p_caster_range);
+	void _cull_shadow_pass(uint32_t p_index, ShadowCullParams *p_params);
+	void _render_shadow_passes(Scenario *p_scenario, RID p_shadow_atlas);
+	void _process_instance_cull_chunk(uint32_t p_chunk, InstanceCullParams *p_params);
+	void _update_instance_lod(Instance *p_instance, InstanceCullParams *p_params);
+	bool _render_occluders(Scenario *p_scenario, const Vector<Plane> &p_planes, const Transform p_cam_transform, const CameraMatrix &p_cam_projection, uint32_t p_visible_layers);
 
-	void _prepare_scene(const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_force_environment, uint32_t p_visible_layers, RID p_scenario, RID p_shadow_atlas, RID p_reflection_probe);
+	void _prepare_scene(const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_force_environment, uint32_t p_visible_layers, RID p_scenario, RID p_shadow_atlas, RID p_reflection_probe, float p_screen_height);
 	void _render_scene(const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_force_environment, RID p_scenario, RID p_shadow_atlas, RID p_reflection_probe, int p_reflection_probe_pass);
 	void render_empty_scene(RID p_scenario, RID p_shadow_atlas);
 
 	void render_camera(RID p_camera, RID p_scenario, Size2 p_viewport_size, RID p_shadow_atlas);
 	void render_camera(Ref<ARVRInterface> &p_interface, ARVRInterface::Eyes p_eye, RID p_camera, RID p_scenario, Size2 p_viewport_size, RID p_shadow_atlas);
+
+	Vector<Instance *> dirty_instances;
+	int dirty_instance_count;
+
+	// Work done by update_dirty_instances(), in the current and the last frame.
+	struct UpdateInfo {
+		int instances;
+		uint64_t usec;
+
+		UpdateInfo() {
+			instances = 0;
+			usec = 0;
+		}
+	};
+
+	UpdateInfo update_info;
+	UpdateInfo update_info_final;
+
 	void update_dirty_instances();
+	void end_frame();
+	int get_render_info(VS::RenderInfo p_info) const;
 
 	//probes
 	struct GIProbeDataHeader {
@@ -152,6 +152,7 @@ void VisualServerWrapMT::finish() {
 	lightmap_capture_free_cached_ids();
 	particles_free_cached_ids();
 	camera_free_cached_ids();
+	occluder_free_cached_ids();
 	viewport_free_cached_ids();
 	environment_free_cached_ids();
 	scenario_free_cached_ids();
@@ -171,9 +171,15 @@ public:
 	FUNC2RC(Vector<PoolVector<uint8_t> >, mesh_surface_get_blend_shapes, RID, int)
 	FUNC2RC(Vector<AABB>, mesh_surface_get_skeleton_aabb, RID, int)
 
+	FUNC3(mesh_surface_set_lods, RID, int, const Vector<PoolVector<uint8_t> > &)
+	FUNC2RC(Vector<PoolVector<uint8_t> >, mesh_surface_get_lods, RID, int)
+
 	FUNC2(mesh_remove_surface, RID, int)
 	FUNC1RC(int, mesh_get_surface_count, RID)
 
+	FUNC2(mesh_set_lod_errors, RID, const Vector<float> &)
+	FUNC1RC(Vector<float>, mesh_get_lod_errors, RID)
+
 	FUNC2(mesh_set_custom_aabb, RID, const AABB &)
 	FUNC1RC(AABB, mesh_get_custom_aabb, RID)
 
@@ -366,6 +372,11 @@ public:
 	FUNC2(camera_set_environment, RID, RID)
 	FUNC2(camera_set_use_vertical_aspect, RID, bool)
 
+	/* OCCLUDER API */
+
+	FUNCRID(occluder)
+	FUNC3(occluder_set_mesh, RID, const PoolVector<Vector3> &, const PoolVector<int> &)
+
 	/* VIEWPORT TARGET API */
 
 	FUNCRID(viewport)
@@ -491,6 +502,7 @@ public:
 	FUNC2(canvas_set_modulate, RID, const Color &)
 	FUNC3(canvas_set_parent, RID, RID, float)
 	FUNC1(canvas_set_disable_scale, bool)
+	FUNC2(canvas_set_use_spatial_index, RID, bool)
 
 	FUNCRID(canvas_item)
 	FUNC2(canvas_item_set_parent, RID, RID)
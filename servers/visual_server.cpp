@@ -394,7 +394,7 @@ Error VisualServer::_surface_set_data(Array p_arrays, uint32_t p_format, uint32_
 					} else {
 						for (int i = 0; i < p_vertex_array_len; i++) {
 
-							float vector[2] = { src[i].x, src[i].y };
+							float vector[2] = { (float)src[i].x, (float)src[i].y };
 
 							copymem(&vw[p_offsets[ai] + i * p_stride], vector, sizeof(float) * 2);
 
@@ -440,7 +440,7 @@ Error VisualServer::_surface_set_data(Array p_arrays, uint32_t p_format, uint32_
 					} else {
 						for (int i = 0; i < p_vertex_array_len; i++) {
 
-							float vector[3] = { src[i].x, src[i].y, src[i].z };
+							float vector[3] = { (float)src[i].x, (float)src[i].y, (float)src[i].z };
 
 							copymem(&vw[p_offsets[ai] + i * p_stride], vector, sizeof(float) * 3);
 
@@ -487,7 +487,7 @@ Error VisualServer::_surface_set_data(Array p_arrays, uint32_t p_format, uint32_
 				} else {
 					for (int i = 0; i < p_vertex_array_len; i++) {
 
-						float vector[3] = { src[i].x, src[i].y, src[i].z };
+						float vector[3] = { (float)src[i].x, (float)src[i].y, (float)src[i].z };
 						copymem(&vw[p_offsets[ai] + i * p_stride], vector, 3 * 4);
 					}
 				}
@@ -522,10 +522,10 @@ Error VisualServer::_surface_set_data(Array p_arrays, uint32_t p_format, uint32_
 					for (int i = 0; i < p_vertex_array_len; i++) {
 
 						float xyzw[4] = {
-							src[i * 4 + 0],
-							src[i * 4 + 1],
-							src[i * 4 + 2],
-							src[i * 4 + 3]
+							(float)src[i * 4 + 0],
+							(float)src[i * 4 + 1],
+							(float)src[i * 4 + 2],
+							(float)src[i * 4 + 3]
 						};
 
 						copymem(&vw[p_offsets[ai] + i * p_stride], xyzw, 4 * 4);
@@ -589,7 +589,7 @@ Error VisualServer::_surface_set_data(Array p_arrays, uint32_t p_format, uint32_
 				} else {
 					for (int i = 0; i < p_vertex_array_len; i++) {
 
-						float uv[2] = { src[i].x, src[i].y };
+						float uv[2] = { (float)src[i].x, (float)src[i].y };
 
 						copymem(&vw[p_offsets[ai] + i * p_stride], uv, 2 * 4);
 					}
@@ -620,7 +620,7 @@ Error VisualServer::_surface_set_data(Array p_arrays, uint32_t p_format, uint32_
 				} else {
 					for (int i = 0; i < p_vertex_array_len; i++) {
 
-						float uv[2] = { src[i].x, src[i].y };
+						float uv[2] = { (float)src[i].x, (float)src[i].y };
 
 						copymem(&vw[p_offsets[ai] + i * p_stride], uv, 2 * 4);
 					}
@@ -1863,6 +1863,9 @@ void VisualServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("camera_set_environment", "camera", "env"), &VisualServer::camera_set_environment);
 	ClassDB::bind_method(D_METHOD("camera_set_use_vertical_aspect", "camera", "enable"), &VisualServer::camera_set_use_vertical_aspect);
 
+	ClassDB::bind_method(D_METHOD("occluder_create"), &VisualServer::occluder_create);
+	ClassDB::bind_method(D_METHOD("occluder_set_mesh", "occluder", "vertices", "indices"), &VisualServer::occluder_set_mesh);
+
 	ClassDB::bind_method(D_METHOD("viewport_create"), &VisualServer::viewport_create);
 	ClassDB::bind_method(D_METHOD("viewport_set_use_arvr", "viewport", "use_arvr"), &VisualServer::viewport_set_use_arvr);
 	ClassDB::bind_method(D_METHOD("viewport_set_size", "viewport", "width", "height"), &VisualServer::viewport_set_size);
@@ -1953,6 +1956,7 @@ void VisualServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("canvas_create"), &VisualServer::canvas_create);
 	ClassDB::bind_method(D_METHOD("canvas_set_item_mirroring", "canvas", "item", "mirroring"), &VisualServer::canvas_set_item_mirroring);
 	ClassDB::bind_method(D_METHOD("canvas_set_modulate", "canvas", "color"), &VisualServer::canvas_set_modulate);
+	ClassDB::bind_method(D_METHOD("canvas_set_use_spatial_index", "canvas", "enable"), &VisualServer::canvas_set_use_spatial_index);
 
 	ClassDB::bind_method(D_METHOD("canvas_item_create"), &VisualServer::canvas_item_create);
 	ClassDB::bind_method(D_METHOD("canvas_item_set_parent", "item", "parent"), &VisualServer::canvas_item_set_parent);
@@ -2209,6 +2213,7 @@ void VisualServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(INSTANCE_REFLECTION_PROBE);
 	BIND_ENUM_CONSTANT(INSTANCE_GI_PROBE);
 	BIND_ENUM_CONSTANT(INSTANCE_LIGHTMAP_CAPTURE);
+	BIND_ENUM_CONSTANT(INSTANCE_OCCLUDER);
 	BIND_ENUM_CONSTANT(INSTANCE_MAX);
 	BIND_ENUM_CONSTANT(INSTANCE_GEOMETRY_MASK);
 
@@ -2251,6 +2256,8 @@ void VisualServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(INFO_VIDEO_MEM_USED);
 	BIND_ENUM_CONSTANT(INFO_TEXTURE_MEM_USED);
 	BIND_ENUM_CONSTANT(INFO_VERTEX_MEM_USED);
+	BIND_ENUM_CONSTANT(INFO_INSTANCES_UPDATED_IN_FRAME);
+	BIND_ENUM_CONSTANT(INFO_INSTANCE_UPDATE_TIME_IN_FRAME);
 
 	BIND_ENUM_CONSTANT(FEATURE_SHADERS);
 	BIND_ENUM_CONSTANT(FEATURE_MULTITHREADED);